@@ -207,6 +207,21 @@ void rs2_update_firmware_cpp(const rs2_device* device, const void* fw_image, int
 */
 void rs2_update_firmware(const rs2_device* device, const void* fw_image, int fw_image_size, rs2_update_progress_callback_ptr callback, void* client_data, rs2_error** error);
 
+/**
+* Update several devices to the provided firmware at once, each device must be extendable to RS2_EXTENSION_UPDATE_DEVICE.
+* This call blocks the caller's thread until all devices are done; the callback is called from worker threads, but never
+* concurrently. A device that fails to update does not stop the others, and is reported to the callback.
+* \param[in]  devices        Devices to update
+* \param[in]  count          Number of devices
+* \param[in]  fw_image       Firmware image buffer
+* \param[in]  fw_image_size  Firmware image buffer size
+* \param[in]  max_concurrent Maximum number of devices to update at the same time, or 0 for all of them
+* \param[in]  callback       Optional callback for each device's progress notifications (normalized to 1) and result (a null error on success)
+* \param[out] error          If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                    The number of devices that failed to update
+*/
+int rs2_update_firmware_devices_cpp(const rs2_device* const* devices, int count, const void* fw_image, int fw_image_size, int max_concurrent, rs2_devices_update_callback* callback, rs2_error** error);
+
 /**
 * Create backup of camera flash memory. Such backup does not constitute valid firmware image, and cannot be
 * loaded back to the device, but it does contain all calibration and device information.
@@ -90,6 +90,24 @@ typedef enum rs2_calib_target_type
 } rs2_calib_target_type;
 const char* rs2_calib_target_type_to_string(rs2_calib_target_type type);
 
+/** \brief Statistics of the depth of a frame, over the region of interest of the depth statistics block that computed them. Depths are in meters. */
+typedef struct rs2_depth_statistics
+{
+    int   total_pixels;   /**< Pixels in the region of interest */
+    int   valid_pixels;   /**< Pixels with depth, among them */
+    float valid_fraction; /**< valid_pixels / total_pixels */
+    float min;            /**< Nearest valid depth; 0 when no pixel is valid (as are all the depths below) */
+    float max;            /**< Farthest valid depth */
+    float mean;           /**< Mean valid depth */
+    float percentile_5;   /**< Valid depth 5% of the valid pixels are at or nearer than */
+    float percentile_25;  /**< Valid depth 25% of the valid pixels are at or nearer than */
+    float median;         /**< Valid depth half of the valid pixels are at or nearer than */
+    float percentile_75;  /**< Valid depth 75% of the valid pixels are at or nearer than */
+    float percentile_95;  /**< Valid depth 95% of the valid pixels are at or nearer than */
+    int   grid_columns;   /**< Columns of the grid the region of interest is divided into, see rs2_depth_frame_get_region_means */
+    int   grid_rows;      /**< Rows of the grid the region of interest is divided into */
+} rs2_depth_statistics;
+
 /**
 * retrieve metadata from frame handle
 * \param[in] frame      handle returned from a callback
@@ -180,6 +198,27 @@ int rs2_get_frame_height(const rs2_frame* frame, rs2_error** error);
 */
 float rs2_depth_frame_get_units( const rs2_frame* frame, rs2_error** error );
 
+/**
+* retrieve the depth statistics a depth statistics processing block attached to a frame; frames processed from it
+* further down carry them too
+* \param[in] frame       handle returned from a callback
+* \param[out] statistics receives the statistics, if the frame has them
+* \param[out] error      if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                1 if the frame has depth statistics, 0 otherwise
+*/
+int rs2_depth_frame_get_statistics( const rs2_frame* frame, rs2_depth_statistics* statistics, rs2_error** error );
+
+/**
+* retrieve the mean valid depth, in meters, of each region of the depth statistics grid, row by row (0 for regions
+* without depth)
+* \param[in] frame   handle returned from a callback
+* \param[out] means  receives the means of up to 'count' regions
+* \param[in] count   number of means 'means' can hold
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return            number of regions in the grid; 0 if the frame has no depth statistics
+*/
+int rs2_depth_frame_get_region_means( const rs2_frame* frame, float* means, int count, rs2_error** error );
+
 /**
 * retrieve frame stride in bytes (number of bytes from start of line N to start of line N+1)
 * \param[in] frame      handle returned from a callback
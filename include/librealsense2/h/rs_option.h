@@ -124,6 +124,15 @@ extern "C" {
         RS2_OPTION_OHM_TEMPERATURE, /**< Temperature of the Optical Head Sensor */
         RS2_OPTION_SOC_PVT_TEMPERATURE, /**< Temperature of PVT SOC */
         RS2_OPTION_GYRO_SENSITIVITY,/**< Control of the gyro sensitivity level, see rs2_gyro_sensitivity for values */ 
+        RS2_OPTION_VOXEL_SIZE, /**< Edge length, in meters, of the voxels a point cloud is downsampled into; 0 for no downsampling */
+        RS2_OPTION_ROI_MIN_X, /**< Left edge of a processing block's region of interest, as a fraction [0,1] of the image width */
+        RS2_OPTION_ROI_MIN_Y, /**< Top edge of a processing block's region of interest, as a fraction [0,1] of the image height */
+        RS2_OPTION_ROI_MAX_X, /**< Right edge of a processing block's region of interest, as a fraction [0,1] of the image width */
+        RS2_OPTION_ROI_MAX_Y, /**< Bottom edge of a processing block's region of interest, as a fraction [0,1] of the image height */
+        RS2_OPTION_ALIGN_INTERPOLATION, /**< How align samples the streams it aligns to depth: 0 for the nearest pixel, 1 for bilinear interpolation */
+        RS2_OPTION_ALIGN_DEPTH_CHANGE_THRESHOLD, /**< Depth change, in depth units, beyond which align maps a depth pixel again; pixels that changed less keep where they mapped before. 0 keeps alignment exact */
+        RS2_OPTION_STATISTICS_GRID_COLUMNS, /**< Columns of the grid of regions the depth statistics block computes the mean depth of, across its region of interest */
+        RS2_OPTION_STATISTICS_GRID_ROWS, /**< Rows of the grid of regions the depth statistics block computes the mean depth of, across its region of interest */
         RS2_OPTION_COUNT /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
     } rs2_option;
 
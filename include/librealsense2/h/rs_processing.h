@@ -162,6 +162,17 @@ void rs2_delete_processing_block(rs2_processing_block* block);
 */
 rs2_frame_queue* rs2_create_frame_queue(int capacity, rs2_error** error);
 
+/**
+* create a frame queue that does not take a lock to enqueue or dequeue frames, with the same behavior as one created by
+* rs2_create_frame_queue. Waiting for a frame (or for room) spins briefly before blocking, using some CPU while waiting.
+* Whether it is any faster than rs2_create_frame_queue depends on the machine and the number of threads involved: measure
+* before choosing it
+* \param[in] capacity max number of frames to allow to be stored in the queue before older frames will start to get dropped
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return handle to the frame queue, must be released using rs2_delete_frame_queue
+*/
+rs2_frame_queue* rs2_create_lock_free_frame_queue(int capacity, rs2_error** error);
+
 /**
 * deletes frame queue and releases all frames inside it
 * \param[in] queue queue to delete
@@ -285,6 +296,112 @@ rs2_processing_block* rs2_create_hdr_merge_processing_block(rs2_error** error);
 */
 rs2_processing_block* rs2_create_sequence_id_filter(rs2_error** error);
 
+/**
+* Creates a depth fusion processing block.
+* The block merges the depth of several calibrated cameras into a single point cloud, in the coordinate system of the
+* first depth stream it receives, optionally downsampled into voxels (see RS2_OPTION_VOXEL_SIZE)
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_depth_fusion_block(rs2_error** error);
+
+/**
+* Creates a voxel filter processing block.
+* The block turns depth frames into a point cloud downsampled into voxels (see RS2_OPTION_VOXEL_SIZE), one point per
+* occupied voxel, without producing the full-resolution cloud. Only the RS2_OPTION_ROI_* region is used.
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_voxel_filter_block(rs2_error** error);
+
+/**
+* Creates a sparse pointcloud processing block.
+* The block turns depth frames into an organized point cloud of every Nth pixel (see RS2_OPTION_FILTER_MAGNITUDE) in
+* each direction, within the RS2_OPTION_ROI_* region.
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_sparse_pointcloud_block(rs2_error** error);
+
+/**
+* Creates a surface normals processing block.
+* The block meshes organized points (or depth) and adds two frames of the same resolution to its input: the vertex
+* normals (RS2_FORMAT_XYZ32F) and a per-quad mesh mask (RS2_FORMAT_Y8, nonzero where the quad of the pixel and its
+* right, lower and lower-right neighbors is meshed). RS2_OPTION_FILTER_SMOOTH_DELTA is the meshing threshold in meters.
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_surface_normals_block(rs2_error** error);
+
+/**
+* Creates a sequence demultiplexer processing block.
+* The block splits depth frames captured with a sequence of exposures (HDR or a subpreset) by their
+* RS2_FRAME_METADATA_SEQUENCE_ID: a frame of sequence id n is output with its own depth stream profile of index n + 1.
+* Frames outside a sequence pass through unchanged.
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_sequence_demux_block(rs2_error** error);
+
+/**
+* Creates a quality governor processing block.
+* The block runs a chain of processing blocks (see rs2_quality_governor_add_block) and keeps it within the frame
+* interval of the stream: when the chain falls behind, it raises the decimation magnitude, lowers the spatial filter
+* iterations, runs the temporal filter on alternate frames and skips hole filling, one step at a time and in the
+* configured order, and restores them when there is headroom again. Every change is reported as a notification of
+* category RS2_NOTIFICATION_CATEGORY_PROCESSING_QUALITY.
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_quality_governor_block(rs2_error** error);
+
+/**
+* Appends a block to the chain of a quality governor. From then on, the block is driven by the governor.
+* \param[in]  governor      The quality governor
+* \param[in]  block         The processing block to run after the ones already added
+* \param[in]  degrade_order Blocks are degraded in increasing order, and restored in reverse; negative to never degrade
+* \param[out] error         If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_quality_governor_add_block(rs2_processing_block* governor, rs2_processing_block* block, int degrade_order, rs2_error** error);
+
+/**
+* Sets the callback receiving the decisions of a quality governor
+* \param[in]  governor        The quality governor
+* \param[in]  on_notification Function to be called on every change of quality
+* \param[in]  user            User argument to be passed to the callback
+* \param[out] error           If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_quality_governor_notifications_callback(rs2_processing_block* governor, rs2_notification_callback_ptr on_notification, void* user, rs2_error** error);
+
+/**
+* Sets the callback receiving the decisions of a quality governor
+* \param[in]  governor  The quality governor
+* \param[in]  callback  Callback object, called on every change of quality
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_quality_governor_notifications_callback_cpp(rs2_processing_block* governor, rs2_notifications_callback* callback, rs2_error** error);
+
+/**
+* \param[in]  governor  The quality governor
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return               The number of degradation steps currently in effect; 0 at full quality
+*/
+int rs2_get_quality_governor_level(const rs2_processing_block* governor, rs2_error** error);
+
+/**
+* Creates an aligned pointcloud processing block.
+* The block aligns depth to a texture stream and computes the textured point cloud in a single pass, deprojecting
+* each depth pixel only once. Its output holds the depth aligned to the texture stream, the points (with texture
+* coordinates into the texture stream) and the texture frame, the same as align followed by pointcloud.
+* \param[in]  texture_stream  The stream depth is aligned to and texture coordinates refer to (not depth)
+* \param[out] error           if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_aligned_pointcloud(rs2_stream texture_stream, rs2_error** error);
+
+/**
+* Creates a depth statistics processing block.
+* The block computes the statistics of each depth frame over its region of interest in a single pass -- the fraction
+* of valid pixels, the nearest, farthest and mean depth and its percentiles, and the mean depth of each region of a
+* grid (RS2_OPTION_STATISTICS_GRID_COLUMNS x RS2_OPTION_STATISTICS_GRID_ROWS) -- and outputs the depth with the
+* statistics attached, to be read with rs2_depth_frame_get_statistics and rs2_depth_frame_get_region_means.
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_depth_statistics_block(rs2_error** error);
+
 /**
 * Retrieve processing block specific information, like name.
 * \param[in]  block     The processing block
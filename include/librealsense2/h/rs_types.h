@@ -22,6 +22,7 @@ typedef enum rs2_notification_category{
     RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR,                /**< Received unknown error from the device */
     RS2_NOTIFICATION_CATEGORY_FIRMWARE_UPDATE_RECOMMENDED,  /**< Current firmware version installed is not the latest available */
     RS2_NOTIFICATION_CATEGORY_POSE_RELOCALIZATION,          /**< A relocalization event has updated the pose provided by a pose sensor */
+    RS2_NOTIFICATION_CATEGORY_PROCESSING_QUALITY,           /**< A quality governor has lowered or restored the quality of its processing blocks */
     RS2_NOTIFICATION_CATEGORY_COUNT                         /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
 } rs2_notification_category;
 const char* rs2_notification_category_to_string(rs2_notification_category category);
@@ -189,6 +190,14 @@ typedef enum rs2_extension
     RS2_EXTENSION_MAX_USABLE_RANGE_SENSOR,
     RS2_EXTENSION_DEBUG_STREAM_SENSOR,
     RS2_EXTENSION_CALIBRATION_CHANGE_DEVICE,
+    RS2_EXTENSION_DEPTH_FUSION,
+    RS2_EXTENSION_VOXEL_FILTER,
+    RS2_EXTENSION_SPARSE_POINTCLOUD,
+    RS2_EXTENSION_SURFACE_NORMALS,
+    RS2_EXTENSION_SEQUENCE_DEMUX,
+    RS2_EXTENSION_QUALITY_GOVERNOR,
+    RS2_EXTENSION_ALIGNED_POINTCLOUD,
+    RS2_EXTENSION_DEPTH_STATISTICS,
     RS2_EXTENSION_COUNT
 } rs2_extension;
 const char* rs2_extension_type_to_string(rs2_extension type);
@@ -245,6 +254,7 @@ typedef struct rs2_processing_block rs2_processing_block;
 typedef struct rs2_frame_processor_callback rs2_frame_processor_callback;
 typedef struct rs2_playback_status_changed_callback rs2_playback_status_changed_callback;
 typedef struct rs2_update_progress_callback rs2_update_progress_callback;
+typedef struct rs2_devices_update_callback rs2_devices_update_callback;
 typedef struct rs2_context rs2_context;
 typedef struct rs2_device_hub rs2_device_hub;
 typedef struct rs2_sensor_list rs2_sensor_list;
@@ -350,6 +350,51 @@ namespace rs2
         }
     };
 
+    template<class T>
+    class devices_update_callback : public rs2_devices_update_callback
+    {
+        T _callback;
+        std::vector<std::string>& _errors;
+
+    public:
+        devices_update_callback(T callback, std::vector<std::string>& errors) : _callback(callback), _errors(errors) {}
+
+        void on_update_progress(int device_index, float progress) override
+        {
+            _callback(device_index, progress);
+        }
+
+        void on_update_done(int device_index, const char* error) override
+        {
+            if (error)
+                _errors[device_index] = error;
+        }
+
+        void release() override { delete this; }
+    };
+
+    // Update several update devices to the provided firmware at once, at most max_concurrent (0 for all) at a time.
+    // This call blocks until all are done; the callback gets each device's index and progress, never concurrently.
+    // Returns, for each device, why its update failed, or an empty string on success.
+    template<class T>
+    std::vector<std::string> update_firmware(const std::vector<update_device>& devices, const std::vector<uint8_t>& fw_image, T callback, int max_concurrent = 0)
+    {
+        std::vector<const rs2_device*> devs;
+        for (auto&& dev : devices)
+            devs.push_back(dev.get().get());
+        std::vector<std::string> errors(devices.size());
+        rs2_error* e = nullptr;
+        rs2_update_firmware_devices_cpp(devs.data(), int(devs.size()), fw_image.data(), int(fw_image.size()), max_concurrent,
+            new devices_update_callback<T>(std::move(callback), errors), &e);
+        error::handle(e);
+        return errors;
+    }
+
+    inline std::vector<std::string> update_firmware(const std::vector<update_device>& devices, const std::vector<uint8_t>& fw_image, int max_concurrent = 0)
+    {
+        return update_firmware(devices, fw_image, [](int, float) {}, max_concurrent);
+    }
+
     typedef std::vector<uint8_t> calibration_table;
 
     class calibrated_device : public device
@@ -87,8 +87,8 @@ namespace rs2
             std::vector<rs2::vertex> new_verts;
             std::vector<vec3d> normals;
             std::vector<std::array<uint8_t, 3>> new_tex;
-            std::map<size_t, size_t> idx_map;
-            std::map<size_t, std::vector<vec3d>> index_to_normals;
+            const size_t invalid_index = size_t(-1);
+            std::vector<size_t> idx_map(p.size(), invalid_index);
 
             new_verts.reserve(p.size());
             if (use_texcoords) new_tex.reserve(p.size());
@@ -99,7 +99,7 @@ namespace rs2
                 if (fabs(verts[i].x) >= min_distance || fabs(verts[i].y) >= min_distance ||
                     fabs(verts[i].z) >= min_distance)
                 {
-                    idx_map[int(i)] = int(new_verts.size());
+                    idx_map[i] = new_verts.size();
                     new_verts.push_back({ verts[i].x, -1 * verts[i].y, -1 * verts[i].z });
                     if (use_texcoords)
                     {
@@ -111,60 +111,55 @@ namespace rs2
 
             auto profile = p.get_profile().as<video_stream_profile>();
             auto width = profile.width(), height = profile.height();
-            static const auto threshold = get_option(OPTION_PLY_THRESHOLD);
+            const auto threshold = get_option(OPTION_PLY_THRESHOLD);
             std::vector<std::array<size_t, 3>> faces;
+            // Only clouds laid out like an image can be meshed; the mesh and normals come from the surface_normals block
+            mesh = mesh && p.size() == size_t(width) * height;
             if (mesh)
             {
+                _normals.set_option(RS2_OPTION_FILTER_SMOOTH_DELTA, threshold);
+                auto mesh_set = _normals.process(p).as<frameset>();
+                const uint8_t* quads = nullptr;
+                const vertex* vertex_normals = nullptr;
+                for (auto f : mesh_set)
+                {
+                    if (f.is<points>())
+                        continue;
+                    if (f.get_profile().format() == RS2_FORMAT_Y8)
+                        quads = reinterpret_cast<const uint8_t*>(f.get_data());
+                    else if (f.get_profile().format() == RS2_FORMAT_XYZ32F)
+                        vertex_normals = reinterpret_cast<const vertex*>(f.get_data());
+                }
+                if (!quads || !vertex_normals)
+                    throw std::runtime_error("Failed to compute the mesh for PLY");
+
                 for (size_t x = 0; x < width - 1; ++x) {
                     for (size_t y = 0; y < height - 1; ++y) {
+                        if (!quads[y * width + x])
+                            continue;
                         auto a = y * width + x, b = y * width + x + 1, c = (y + 1)*width + x, d = (y + 1)*width + x + 1;
-                        if (verts[a].z && verts[b].z && verts[c].z && verts[d].z
-                            && fabs(verts[a].z - verts[b].z) < threshold && fabs(verts[a].z - verts[c].z) < threshold
-                            && fabs(verts[b].z - verts[d].z) < threshold && fabs(verts[c].z - verts[d].z) < threshold)
-                        {
-                            if (idx_map.count(a) == 0 || idx_map.count(b) == 0 || idx_map.count(c) == 0 ||
-                                idx_map.count(d) == 0)
-                                continue;
-                            faces.push_back({ idx_map[a], idx_map[d], idx_map[b] });
-                            faces.push_back({ idx_map[d], idx_map[a], idx_map[c] });
-
-                            if (use_normals)
-                            {
-                                vec3d point_a = { verts[a].x ,  -1 * verts[a].y,  -1 * verts[a].z };
-                                vec3d point_b = { verts[b].x ,  -1 * verts[b].y,  -1 * verts[b].z };
-                                vec3d point_c = { verts[c].x ,  -1 * verts[c].y,  -1 * verts[c].z };
-                                vec3d point_d = { verts[d].x ,  -1 * verts[d].y,  -1 * verts[d].z };
-
-                                auto n1 = cross(point_d - point_a, point_b - point_a);
-                                auto n2 = cross(point_c - point_a, point_d - point_a);
-
-                                index_to_normals[idx_map[a]].push_back(n1);
-                                index_to_normals[idx_map[a]].push_back(n2);
-
-                                index_to_normals[idx_map[b]].push_back(n1);
-
-                                index_to_normals[idx_map[c]].push_back(n2);
-
-                                index_to_normals[idx_map[d]].push_back(n1);
-                                index_to_normals[idx_map[d]].push_back(n2);
-                            }
-                        }
+                        if (idx_map[a] == invalid_index || idx_map[b] == invalid_index || idx_map[c] == invalid_index ||
+                            idx_map[d] == invalid_index)
+                            continue;
+                        faces.push_back({ idx_map[a], idx_map[d], idx_map[b] });
+                        faces.push_back({ idx_map[d], idx_map[a], idx_map[c] });
                     }
                 }
-            }
 
-            if (mesh && use_normals)
-            {
-                for (size_t i = 0; i < new_verts.size(); ++i)
+                if (use_normals)
                 {
-                    auto normals_vec = index_to_normals[i];
-                    vec3d sum = { 0, 0, 0 };
-                    for (auto& n : normals_vec)
-                        sum = sum + n;
-                    if (normals_vec.size() > 0)
-                        normals.push_back((sum.normalize()));
-                    else
-                        normals.push_back({ 0, 0, 0 });
+                    // Normals are in the camera's coordinates, flipped here like the vertices
+                    normals.reserve(new_verts.size());
+                    for (size_t i = 0; i < p.size(); ++i)
+                    {
+                        if (idx_map[i] == invalid_index)
+                            continue;
+                        auto const & n = vertex_normals[i];
+                        if (n.x || n.y || n.z)
+                            normals.push_back({ n.x, -1 * n.y, -1 * n.z });
+                        else
+                            normals.push_back({ 0, 0, 0 });
+                    }
                 }
             }
 
@@ -286,6 +281,7 @@ namespace rs2
 
         std::string fname;
         pointcloud _pc;
+        surface_normals _normals;
     };
 
     class save_single_frameset : public filter {
@@ -853,6 +853,37 @@ namespace rs2
             error::handle( e );
             return r;
         }
+
+        /**
+        * Retrieve the statistics a depth_statistics block attached to the frame
+        * \param[out] statistics - receives the statistics of the depth, when the frame has them
+        * \return bool - whether the frame has depth statistics
+        */
+        bool get_statistics( rs2_depth_statistics & statistics ) const
+        {
+            rs2_error * e = nullptr;
+            auto r = rs2_depth_frame_get_statistics( get(), &statistics, &e );
+            error::handle( e );
+            return r != 0;
+        }
+
+        /**
+        * Retrieve the mean valid depth, in meters, of each region of the depth statistics grid, row by row
+        * \return std::vector<float> - the means, empty if the frame has no depth statistics
+        */
+        std::vector< float > get_region_means() const
+        {
+            rs2_error * e = nullptr;
+            auto count = rs2_depth_frame_get_region_means( get(), nullptr, 0, &e );
+            error::handle( e );
+            std::vector< float > means( count );
+            if( count )
+            {
+                rs2_depth_frame_get_region_means( get(), means.data(), count, &e );
+                error::handle( e );
+            }
+            return means;
+        }
     };
 
     class disparity_frame : public depth_frame
@@ -139,12 +139,15 @@ namespace rs2
         * to help developers who are not using async APIs
         * param[in] capacity size of the frame queue
         * param[in] keep_frames  if set to true, the queue automatically calls keep() on every frame enqueued into it.
+        * param[in] lock_free    if set to true, the queue does not take a lock to enqueue or dequeue frames, and spins
+        *                       briefly before blocking when waiting, using some CPU. Whether it is any faster depends
+        *                       on the machine and the threads involved: measure before choosing it
         */
-        explicit frame_queue(unsigned int capacity, bool keep_frames = false) : _capacity(capacity), _keep(keep_frames)
+        explicit frame_queue(unsigned int capacity, bool keep_frames = false, bool lock_free = false) : _capacity(capacity), _keep(keep_frames)
         {
             rs2_error* e = nullptr;
             _queue = std::shared_ptr<rs2_frame_queue>(
-                rs2_create_frame_queue(capacity, &e),
+                lock_free ? rs2_create_lock_free_frame_queue(capacity, &e) : rs2_create_frame_queue(capacity, &e),
                 rs2_delete_frame_queue);
             error::handle(e);
         }
@@ -1188,5 +1191,381 @@ namespace rs2
             return block;
         }
     };
+
+    class depth_fusion : public filter
+    {
+    public:
+        /**
+        * Create depth_fusion processing block
+        * the processing merges the depth of several calibrated cameras into a single point cloud.
+        * Depth frames (or framesets) of all the cameras are passed to the same block; whenever a frame of the first
+        * depth stream it received (the reference) arrives, the latest depth of every camera with known extrinsics
+        * to the reference is deprojected into the reference's coordinate system and output as points.
+        * A stream that stops delivering frames (e.g., after a restart) is dropped; if it was the reference, the next
+        * depth stream to deliver becomes the reference.
+        */
+        depth_fusion() : filter(init(), 1) {}
+
+        /**
+        * Create depth_fusion processing block
+        * \param[in] voxel_size - edge length, in meters, of the voxels to downsample the merged cloud into; 0 keeps
+        *                          every point.
+        */
+        depth_fusion(float voxel_size) : filter(init(), 1)
+        {
+            set_option(RS2_OPTION_VOXEL_SIZE, voxel_size);
+        }
+
+        depth_fusion(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_DEPTH_FUSION, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_depth_fusion_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class voxel_filter : public filter
+    {
+    public:
+        /**
+        * Create voxel_filter processing block
+        * the processing turns depth frames into a point cloud with one point (the centroid) per occupied voxel,
+        * without producing the full-resolution cloud first.
+        */
+        voxel_filter() : filter(init(), 1) {}
+
+        /**
+        * Create voxel_filter processing block
+        * \param[in] voxel_size - edge length of the voxels, in meters.
+        */
+        voxel_filter(float voxel_size) : filter(init(), 1)
+        {
+            set_option(RS2_OPTION_VOXEL_SIZE, voxel_size);
+        }
+
+        voxel_filter(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_VOXEL_FILTER, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_voxel_filter_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class sparse_pointcloud : public filter
+    {
+    public:
+        /**
+        * Create sparse_pointcloud processing block
+        * the processing deprojects only every Nth depth pixel, in each direction, of the region of interest, and
+        * outputs an organized (ROI width / N) x (ROI height / N) point cloud.
+        */
+        sparse_pointcloud() : filter(init(), 1) {}
+
+        /**
+        * Create sparse_pointcloud processing block
+        * \param[in] stride - deproject every stride-th pixel, in each direction.
+        */
+        sparse_pointcloud(int stride) : filter(init(), 1)
+        {
+            set_option(RS2_OPTION_FILTER_MAGNITUDE, float(stride));
+        }
+
+        sparse_pointcloud(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_SPARSE_POINTCLOUD, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_sparse_pointcloud_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class surface_normals : public filter
+    {
+    public:
+        /**
+        * Create surface_normals processing block
+        * the processing meshes organized points (or depth) and outputs them along with the per-vertex normals
+        * (an RS2_FORMAT_XYZ32F video frame) and the mesh (an RS2_FORMAT_Y8 video frame with one byte per quad,
+        * nonzero when the quad is made of triangles (a,d,b) and (d,a,c), where a is the pixel, b its right neighbor,
+        * c the one below and d the one below-right).
+        */
+        surface_normals() : filter(init(), 1) {}
+
+        /**
+        * Create surface_normals processing block
+        * \param[in] threshold - max depth difference, in meters, between neighboring vertices to connect them.
+        */
+        surface_normals(float threshold) : filter(init(), 1)
+        {
+            set_option(RS2_OPTION_FILTER_SMOOTH_DELTA, threshold);
+        }
+
+        surface_normals(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_SURFACE_NORMALS, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_surface_normals_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class sequence_demux : public filter
+    {
+    public:
+        /**
+        * Create sequence_demux processing block
+        * the processing splits depth frames captured with a sequence of exposures (HDR or a subpreset) into one
+        * logical depth stream per sequence id: a frame of sequence id n comes out with stream index n + 1, so a
+        * separate filter (or queue) can be used per exposure.
+        */
+        sequence_demux() : filter(init(), 1) {}
+
+        sequence_demux(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_SEQUENCE_DEMUX, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_sequence_demux_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    template<class T> class notifications_callback;  // see rs_sensor.hpp
+
+    class quality_governor : public filter
+    {
+    public:
+        /**
+        * Create quality_governor processing block
+        * the processing runs a chain of filters, and lowers their quality one step at a time when the chain takes longer
+        * than the frame interval of the stream (higher decimation magnitude, fewer spatial iterations, temporal filter
+        * on alternate frames, no hole filling), restoring it when there is headroom again.
+        */
+        quality_governor() : filter(init(), 1) {}
+
+        quality_governor(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_QUALITY_GOVERNOR, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+        /**
+        * Append a filter to the chain; from then on it is driven by the governor, and cannot be used on its own.
+        * \param[in] block         filter to run after the ones already added
+        * \param[in] degrade_order filters are degraded in increasing order, and restored in reverse; negative to never degrade
+        */
+        void add(const filter& block, int degrade_order)
+        {
+            rs2_error* e = nullptr;
+            rs2_quality_governor_add_block(get(), block.get(), degrade_order, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Register a callback for the changes of quality, reported as notifications of category
+        * RS2_NOTIFICATION_CATEGORY_PROCESSING_QUALITY
+        * \param[in] callback   function receiving an rs2::notification
+        */
+        template<class T>
+        void set_notifications_callback(T callback) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_quality_governor_notifications_callback_cpp(get(),
+                new notifications_callback<T>(std::move(callback)), &e);
+            error::handle(e);
+        }
+
+        /**
+        * \return the number of degradation steps currently in effect; 0 at full quality
+        */
+        int get_level() const
+        {
+            rs2_error* e = nullptr;
+            auto res = rs2_get_quality_governor_level(get(), &e);
+            error::handle(e);
+            return res;
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_quality_governor_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class aligned_pointcloud : public filter
+    {
+    public:
+        /**
+        * Create aligned_pointcloud processing block
+        * the processing aligns depth to the texture stream and computes the point cloud textured by it, in a single
+        * pass over the depth. The output frameset holds the depth aligned to the texture stream, the points (at depth
+        * resolution, with texture coordinates into the texture stream) and the texture frame, the same as running
+        * align and then pointcloud.
+        * \param[in] texture_stream - the stream to align depth to, and to take texture coordinates in.
+        */
+        aligned_pointcloud(rs2_stream texture_stream = RS2_STREAM_COLOR) : filter(init(texture_stream), 1) {}
+
+        aligned_pointcloud(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_ALIGNED_POINTCLOUD, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+        using filter::process;
+
+        frameset process(frameset frames)
+        {
+            return filter::process(frames);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init(rs2_stream texture_stream)
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_aligned_pointcloud(texture_stream, &e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class depth_statistics : public filter
+    {
+    public:
+        /**
+        * Create depth_statistics processing block
+        * the processing computes the statistics of the depth in its region of interest in a single pass: the valid
+        * fraction, the nearest, farthest and mean depth and its percentiles, and the mean depth of each region of a
+        * grid (RS2_OPTION_STATISTICS_GRID_COLUMNS x RS2_OPTION_STATISTICS_GRID_ROWS). The output depth frame carries
+        * them, see depth_frame::get_statistics and depth_frame::get_region_means.
+        */
+        depth_statistics() : filter(init(), 1) {}
+
+        depth_statistics(filter f) :filter(f)
+        {
+            rs2_error* e = nullptr;
+            if (!rs2_is_processing_block_extendable_to(f.get(), RS2_EXTENSION_DEPTH_STATISTICS, &e) && !e)
+            {
+                _block.reset();
+            }
+            error::handle(e);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_depth_statistics_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
 }
 #endif // LIBREALSENSE_RS2_PROCESSING_HPP
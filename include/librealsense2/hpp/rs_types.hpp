@@ -96,6 +96,15 @@ struct rs2_update_progress_callback
 };
 typedef std::shared_ptr<rs2_update_progress_callback> rs2_update_progress_callback_sptr;
 
+struct rs2_devices_update_callback
+{
+    virtual void                            on_update_progress(int device_index, float update_progress) = 0;
+    virtual void                            on_update_done(int device_index, const char* error) = 0;
+    virtual void                            release() = 0;
+    virtual                                 ~rs2_devices_update_callback() {}
+};
+typedef std::shared_ptr<rs2_devices_update_callback> rs2_devices_update_callback_sptr;
+
 struct rs2_options_changed_callback
 {
     virtual void on_value_changed( rs2_options_list * list ) = 0;
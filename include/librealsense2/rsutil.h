@@ -25,6 +25,15 @@ void rs2_deproject_pixel_to_point(float point[3], const rs2_intrinsics* intrin,
 /* Transform 3D coordinates relative to one sensor to 3D coordinates relative to another viewpoint */
 void rs2_transform_point_to_point(float to_point[3], const rs2_extrinsics* extrin, const float from_point[3]);
 
+/* Array version of rs2_project_point_to_pixel: 'points' holds 'count' (x,y,z) triplets, and 'pixels' receives 'count' (x,y) pairs */
+void rs2_project_points_to_pixels(float* pixels, const rs2_intrinsics* intrin, const float* points, int count);
+
+/* Array version of rs2_deproject_pixel_to_point: 'pixels' holds 'count' (x,y) pairs with a depth each in 'depths', and 'points' receives 'count' (x,y,z) triplets */
+void rs2_deproject_pixels_to_points(float* points, const rs2_intrinsics* intrin, const float* pixels, const float* depths, int count);
+
+/* Array version of rs2_transform_point_to_point: 'from_points' and 'to_points' hold 'count' (x,y,z) triplets, and may be the same array */
+void rs2_transform_points_to_points(float* to_points, const rs2_extrinsics* extrin, const float* from_points, int count);
+
 /* Calculate horizontal and vertical feild of view, based on video intrinsics */
 void rs2_fov(const rs2_intrinsics* intrin, float to_fov[2]);
 
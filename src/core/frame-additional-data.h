@@ -7,6 +7,8 @@
 #include <map>
 #include <memory>
 #include <array>
+#include <atomic>
+#include <vector>
 #include <cstring>  // memcpy
 
 
@@ -50,6 +52,74 @@ static_assert( sizeof( metadata_array_value ) == sizeof( rs2_metadata_type ) + 1
                "unexpected size for metadata array members" );
 
 
+// The metadata structs of a frame that the table parsers (see metadata-tables.h) decoded: each is decoded once, by the
+// first parser that needs it, and the values of all its attributes are kept for the others. Copies start out empty,
+// since whatever they are copied with may be given other metadata.
+class md_decode_cache
+{
+public:
+    static constexpr int max_structs = 6;
+    static constexpr int max_fields = 16;
+
+    enum : uint8_t
+    {
+        not_decoded,
+        decoding,     // by another thread: read the struct directly meanwhile
+        decoded,
+        not_present,  // the blob holds no such struct at the offset
+    };
+
+    struct entry
+    {
+        std::atomic< uint8_t > state;
+        unsigned long long offset;  // of the struct within the metadata blob
+        uint32_t flags;
+        rs2_metadata_type values[max_fields];
+    };
+
+    md_decode_cache() { reset(); }
+    md_decode_cache( md_decode_cache const & ) { reset(); }
+    md_decode_cache & operator=( md_decode_cache const & )
+    {
+        reset();
+        return *this;
+    }
+
+    entry & operator[]( int i ) { return _entries[i]; }
+
+    void reset()
+    {
+        for( auto & e : _entries )
+            e.state.store( not_decoded, std::memory_order_relaxed );
+    }
+
+private:
+    entry _entries[max_structs];
+};
+
+
+// The region of interest a frame was processed in, as fractions of its width and height (see roi_options); region-aware
+// blocks without a region of their own use the one of their input and record it on their output, so a region set once
+// follows the frame through a chain of such blocks. Any other block's output is a whole frame again.
+struct frame_roi
+{
+    float min_x = 0.f;
+    float min_y = 0.f;
+    float max_x = 1.f;
+    float max_y = 1.f;
+
+    bool is_full_frame() const { return ! min_x && ! min_y && max_x == 1.f && max_y == 1.f; }
+};
+
+
+// Statistics of the depth of a frame, as computed by the depth statistics block; shared by the frames processed from it
+struct frame_depth_statistics
+{
+    rs2_depth_statistics summary = {};
+    std::vector< float > region_means;  // summary.grid_rows x summary.grid_columns, row by row, in meters
+};
+
+
 struct frame_additional_data : frame_header
 {
     uint32_t metadata_size = 0;
@@ -66,6 +136,12 @@ struct frame_additional_data : frame_header
 
     uint32_t raw_size = 0;  // The frame transmitted size (payload only)
 
+    frame_roi roi;  // Set by processing blocks; the whole frame for frames from sensors
+
+    std::shared_ptr< const frame_depth_statistics > depth_statistics;  // Set by the depth statistics block
+
+    mutable md_decode_cache md_decoded;  // Of metadata_blob
+
     frame_additional_data() {}
 
     frame_additional_data( metadata_array const & metadata )
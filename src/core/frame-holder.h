@@ -19,7 +19,7 @@ public:
 
     frame_holder() = default;
     frame_holder( const frame_holder & other ) = delete;
-    frame_holder( frame_holder && other ) { std::swap( frame, other.frame ); }
+    frame_holder( frame_holder && other ) noexcept { std::swap( frame, other.frame ); }
     // non-acquiring ctor: will assume the frame has already been acquired!
     frame_holder( frame_interface * const f ) { frame = f; }
     ~frame_holder() { reset(); }
@@ -3,6 +3,7 @@
 
 #include <src/core/options-watcher.h>
 #include <proc/synthetic-stream.h>
+#include <src/thread-policy.h>
 #include <rsutils/json.h>
 
 using rsutils::json;
@@ -70,6 +71,7 @@ void options_watcher::start()
     if( ! _updater.joinable() ) // If not already started
     {
         _updater = std::thread( [this]() {
+            thread_policy::apply( thread_role::options_watcher );
             update_options();
             thread_loop();
         } );
@@ -83,10 +83,17 @@ struct hash< librealsense::stream_profile >
 {
     size_t operator()( const librealsense::stream_profile & k ) const
     {
-        using std::hash;
-
-        return ( hash< uint32_t >()( k.height ) ) ^ ( hash< uint32_t >()( k.width ) ) ^ ( hash< uint32_t >()( k.fps ) )
-             ^ ( hash< uint32_t >()( k.format ) ) ^ ( hash< uint32_t >()( k.stream ) );
+        // Combined rather than xor'ed: the fields are small numbers (and width^height is the same for many
+        // resolutions), so xor'ing them would leave most profiles of a sensor in a handful of buckets
+        size_t seed = 0;
+        auto combine = [&seed]( uint32_t v ) { seed ^= std::hash< uint32_t >()( v ) + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 ); };
+        combine( k.width );
+        combine( k.height );
+        combine( k.fps );
+        combine( k.format );
+        combine( k.stream );
+        combine( uint32_t( k.index ) );
+        return seed;
     }
 };
 
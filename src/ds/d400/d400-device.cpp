@@ -5,6 +5,7 @@
 #include <src/device.h>
 #include <src/image.h>
 #include <src/metadata-parser.h>
+#include <src/metadata-tables.h>
 #include <src/metadata.h>
 #include <src/backend.h>
 
@@ -38,6 +39,7 @@
 #include <src/fw-update/fw-update-unsigned.h>
 
 #include <rsutils/string/hexdump.h>
+#include <rsutils/string/hexarray.h>
 #include <regex>
 #include <iterator>
 
@@ -519,6 +521,24 @@ namespace librealsense
         init( dev_info->get_context(), dev_info->get_group() );
     }
 
+    // The responses to these never change for a given unit and firmware, unless one of the writes below is issued.
+    // Only calibration tables are cached, and only those whose headers are in the validation token (see init): the
+    // depth coefficients and RGB tables, the only ones read with GETINTCAL. Neither the advanced-mode status nor the
+    // RECPARAMSGET parameters are cached: another host can change them without us knowing.
+    static std::shared_ptr< hw_monitor_cache > create_hw_monitor_cache( context const & ctx )
+    {
+        auto directory = ctx.get_settings().nested( "hw-monitor-cache" ).string_ref_or_empty();
+        if( directory.empty() )
+            return {};
+
+        using namespace ds;
+        return std::make_shared< hw_monitor_cache >(
+            directory,
+            std::set< uint8_t >{ GETINTCAL },
+            std::set< uint8_t >{ SETINTCAL, SETINTCALNEW, CAL_RESTORE_DFLT, CALIBRECALC, AUTO_CALIB, EN_ADV,
+                                 FWB, FES, FEF, DFU } );
+    }
+
     void d400_device::init(std::shared_ptr<context> ctx,
         const platform::backend_device_group& group)
     {
@@ -534,20 +554,25 @@ namespace librealsense
             return get_d400_raw_calibration_table(d400_calibration_table_id::rgb_calibration_id);
         };
 
+        std::shared_ptr< locked_transfer > transfer;
         if (((hw_mon_over_xu) && (RS400_IMU_PID != _pid)) || (!group.usb_devices.size()))
         {
-            _hw_monitor = std::make_shared<hw_monitor>(
-                std::make_shared<locked_transfer>(
-                    std::make_shared<command_transfer_over_xu>( *raw_sensor, depth_xu, DS5_HWMONITOR ),
-                    raw_sensor ) );
+            transfer = std::make_shared<locked_transfer>(
+                std::make_shared<command_transfer_over_xu>( *raw_sensor, depth_xu, DS5_HWMONITOR ),
+                raw_sensor );
         }
         else
         {
             if( ! mipi_sensor )
-                _hw_monitor = std::make_shared< hw_monitor >(
-                    std::make_shared< locked_transfer >(
-                        get_backend()->create_usb_device( group.usb_devices.front() ),
-                        raw_sensor ) );
+                transfer = std::make_shared< locked_transfer >(
+                    get_backend()->create_usb_device( group.usb_devices.front() ),
+                    raw_sensor );
+        }
+        if( transfer )
+        {
+            _hw_monitor = std::make_shared< hw_monitor >( transfer );
+            _hw_monitor_cache = create_hw_monitor_cache( *ctx );
+            transfer->set_cache( _hw_monitor_cache );
         }
         set_hw_monitor_for_auto_calib(_hw_monitor);
 
@@ -594,6 +619,30 @@ namespace librealsense
 
             std::string fwv;
             _ds_device_common->get_fw_details( gvd_buff, optic_serial, asic_serial, fwv );
+            if( _hw_monitor_cache )
+            {
+                // The headers of the cached calibration tables (version, size and CRC), read from the device since the
+                // cache is not bound yet, change with any recalibration of either: by us, or by another process or host
+                try
+                {
+                    std::vector< uint8_t > headers;
+                    auto add_header = [&]( d400_calibration_table_id id )
+                    {
+                        auto table = get_d400_raw_calibration_table( id );
+                        if( table.size() < sizeof( table_header ) )
+                            throw std::runtime_error( "calibration table too small" );
+                        headers.insert( headers.end(), table.begin(), table.begin() + sizeof( table_header ) );
+                    };
+                    add_header( d400_calibration_table_id::coefficients_table_id );
+                    if( gvd_buff[rgb_sensor] )
+                        add_header( d400_calibration_table_id::rgb_calibration_id );
+                    _hw_monitor_cache->bind( optic_serial, fwv, rsutils::string::hexarray::to_string( headers ) );
+                }
+                catch( std::exception const & e )
+                {
+                    LOG_DEBUG( "hw-monitor cache disabled: failed to read the calibration tables: " << e.what() );
+                }
+            }
 
             _fw_version = firmware_version(fwv);
 
@@ -986,7 +1035,7 @@ namespace librealsense
             offsetof(md_depth_mode, depth_y_mode) +
             offsetof(md_depth_y_normal_mode, intel_capture_timing);
 
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_FRAME_COUNTER, make_attribute_parser(&md_capture_timing::frame_counter, md_capture_timing_attributes::frame_counter_attribute, md_prop_offset));
+        register_md_layout< md_capture_timing >( depth_sensor, md_prop_offset );
         depth_sensor.register_metadata(RS2_FRAME_METADATA_SENSOR_TIMESTAMP, make_rs400_sensor_ts_parser(make_uvc_header_parser(&platform::uvc_header::timestamp),
             make_attribute_parser(&md_capture_timing::sensor_timestamp, md_capture_timing_attributes::sensor_timestamp_attribute, md_prop_offset)));
 
@@ -995,76 +1044,36 @@ namespace librealsense
             offsetof(md_depth_mode, depth_y_mode) +
             offsetof(md_depth_y_normal_mode, intel_capture_stats);
 
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_WHITE_BALANCE, make_attribute_parser(&md_capture_stats::white_balance, md_capture_stat_attributes::white_balance_attribute, md_prop_offset));
+        register_md_layout< md_capture_stats >( depth_sensor, md_prop_offset );
 
         // attributes of md_depth_control
         md_prop_offset = metadata_raw_mode_offset +
             offsetof(md_depth_mode, depth_y_mode) +
             offsetof(md_depth_y_normal_mode, intel_depth_control);
 
-
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_GAIN_LEVEL, make_attribute_parser(&md_depth_control::manual_gain, md_depth_control_attributes::gain_attribute, md_prop_offset));
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_ACTUAL_EXPOSURE, make_attribute_parser(&md_depth_control::manual_exposure, md_depth_control_attributes::exposure_attribute, md_prop_offset));
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_AUTO_EXPOSURE, make_attribute_parser(&md_depth_control::auto_exposure_mode, md_depth_control_attributes::ae_mode_attribute, md_prop_offset));
-
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_FRAME_LASER_POWER, make_attribute_parser(&md_depth_control::laser_power, md_depth_control_attributes::laser_pwr_attribute, md_prop_offset));
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_FRAME_LASER_POWER_MODE, make_attribute_parser(&md_depth_control::emitterMode, md_depth_control_attributes::emitter_mode_attribute, md_prop_offset,
-            [](const rs2_metadata_type& param) { return param == 1 ? 1 : 0; })); // starting at version 2.30.1 this control is superceeded by RS2_FRAME_METADATA_FRAME_EMITTER_MODE
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_EXPOSURE_PRIORITY, make_attribute_parser(&md_depth_control::exposure_priority, md_depth_control_attributes::exposure_priority_attribute, md_prop_offset));
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_EXPOSURE_ROI_LEFT, make_attribute_parser(&md_depth_control::exposure_roi_left, md_depth_control_attributes::roi_attribute, md_prop_offset));
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_EXPOSURE_ROI_RIGHT, make_attribute_parser(&md_depth_control::exposure_roi_right, md_depth_control_attributes::roi_attribute, md_prop_offset));
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_EXPOSURE_ROI_TOP, make_attribute_parser(&md_depth_control::exposure_roi_top, md_depth_control_attributes::roi_attribute, md_prop_offset));
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_EXPOSURE_ROI_BOTTOM, make_attribute_parser(&md_depth_control::exposure_roi_bottom, md_depth_control_attributes::roi_attribute, md_prop_offset));
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_FRAME_EMITTER_MODE, make_attribute_parser(&md_depth_control::emitterMode, md_depth_control_attributes::emitter_mode_attribute, md_prop_offset));
-        depth_sensor.register_metadata(RS2_FRAME_METADATA_FRAME_LED_POWER, make_attribute_parser(&md_depth_control::ledPower, md_depth_control_attributes::led_power_attribute, md_prop_offset));
+        register_md_layout< md_depth_control >( depth_sensor, md_prop_offset );
 
         // md_configuration - will be used for internal validation only
         md_prop_offset = metadata_raw_mode_offset + offsetof(md_depth_mode, depth_y_mode) + offsetof(md_depth_y_normal_mode, intel_configuration);
 
-        depth_sensor.register_metadata((rs2_frame_metadata_value)RS2_FRAME_METADATA_HW_TYPE, make_attribute_parser(&md_configuration::hw_type, md_configuration_attributes::hw_type_attribute, md_prop_offset));
-        depth_sensor.register_metadata((rs2_frame_metadata_value)RS2_FRAME_METADATA_SKU_ID, make_attribute_parser(&md_configuration::sku_id, md_configuration_attributes::sku_id_attribute, md_prop_offset));
-        depth_sensor.register_metadata((rs2_frame_metadata_value)RS2_FRAME_METADATA_FORMAT, make_attribute_parser(&md_configuration::format, md_configuration_attributes::format_attribute, md_prop_offset));
-        depth_sensor.register_metadata((rs2_frame_metadata_value)RS2_FRAME_METADATA_WIDTH, make_attribute_parser(&md_configuration::width, md_configuration_attributes::width_attribute, md_prop_offset));
-        depth_sensor.register_metadata((rs2_frame_metadata_value)RS2_FRAME_METADATA_HEIGHT, make_attribute_parser(&md_configuration::height, md_configuration_attributes::height_attribute, md_prop_offset));
+        bool const has_gpio = _fw_version >= firmware_version("5.12.7.0");
+        bool const has_sub_preset = _fw_version >= hdr_firmware_version;
+        register_md_layout< md_configuration >( depth_sensor, md_prop_offset,
+            [&]( rs2_frame_metadata_value key )
+            {
+                switch( key )
+                {
+                case RS2_FRAME_METADATA_GPIO_INPUT_DATA:
+                    return has_gpio;
+                case RS2_FRAME_METADATA_SEQUENCE_SIZE:
+                case RS2_FRAME_METADATA_SEQUENCE_ID:
+                case RS2_FRAME_METADATA_SEQUENCE_NAME:
+                    return has_sub_preset;
+                default:
+                    return true;
+                }
+            } );
         depth_sensor.register_metadata((rs2_frame_metadata_value)RS2_FRAME_METADATA_ACTUAL_FPS, std::make_shared<ds_md_attribute_actual_fps>());
-
-        if (_fw_version >= firmware_version("5.12.7.0"))
-        {
-            depth_sensor.register_metadata(RS2_FRAME_METADATA_GPIO_INPUT_DATA, make_attribute_parser(&md_configuration::gpioInputData, md_configuration_attributes::gpio_input_data_attribute, md_prop_offset));
-        }
-
-        if (_fw_version >= hdr_firmware_version)
-        {
-            // attributes of md_capture_timing
-            auto md_prop_offset = metadata_raw_mode_offset + offsetof(md_depth_mode, depth_y_mode) + offsetof(md_depth_y_normal_mode, intel_configuration);
-
-            depth_sensor.register_metadata(RS2_FRAME_METADATA_SEQUENCE_SIZE,
-                make_attribute_parser(&md_configuration::sub_preset_info,
-                    md_configuration_attributes::sub_preset_info_attribute, md_prop_offset,
-                    [](const rs2_metadata_type& param) {
-                        // bit mask and offset used to get data from bitfield
-                        return (param & md_configuration::SUB_PRESET_BIT_MASK_SEQUENCE_SIZE)
-                            >> md_configuration::SUB_PRESET_BIT_OFFSET_SEQUENCE_SIZE;
-                    }));
-
-            depth_sensor.register_metadata(RS2_FRAME_METADATA_SEQUENCE_ID,
-                make_attribute_parser(&md_configuration::sub_preset_info,
-                    md_configuration_attributes::sub_preset_info_attribute, md_prop_offset,
-                    [](const rs2_metadata_type& param) {
-                        // bit mask and offset used to get data from bitfield
-                        return (param & md_configuration::SUB_PRESET_BIT_MASK_SEQUENCE_ID)
-                            >> md_configuration::SUB_PRESET_BIT_OFFSET_SEQUENCE_ID;
-                    }));
-
-            depth_sensor.register_metadata(RS2_FRAME_METADATA_SEQUENCE_NAME,
-                make_attribute_parser(&md_configuration::sub_preset_info,
-                    md_configuration_attributes::sub_preset_info_attribute, md_prop_offset,
-                    [](const rs2_metadata_type& param) {
-                        // bit mask and offset used to get data from bitfield
-                        return (param & md_configuration::SUB_PRESET_BIT_MASK_ID)
-                            >> md_configuration::SUB_PRESET_BIT_OFFSET_ID;
-                    }));
-        }
     }
 
     void d400_device::register_metadata_mipi(const synthetic_sensor &depth_sensor, const firmware_version& hdr_firmware_version) const
@@ -92,6 +92,7 @@ namespace librealsense
         friend class d400_depth_sensor;
 
         std::shared_ptr<hw_monitor> _hw_monitor;
+        std::shared_ptr<hw_monitor_cache> _hw_monitor_cache;  // null unless enabled in the context settings
         firmware_version            _fw_version;
         firmware_version            _recommended_fw_version;
         ds::ds_caps               _device_capabilities;
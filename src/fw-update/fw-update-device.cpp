@@ -10,12 +10,15 @@
 #include <rsutils/string/hexdump.h>
 
 #include <chrono>
+#include <cstring>
 #include <stdexcept>
 #include <algorithm>
 #include <thread>
 
 #define DEFAULT_TIMEOUT 100
+#define DEFAULT_TRANSFER_SIZE 1024
 #define FW_UPDATE_INTERFACE_NUMBER 0
+#define USB_DT_DFU_FUNCTIONAL 0x21
 namespace librealsense
 {
     std::string get_formatted_fw_version(uint32_t fw_last_version)
@@ -81,10 +84,29 @@ namespace librealsense
         LOG_INFO("DFU status: " << lock_status << " , DFU version is: " << payload.dfu_version);
     }
 
+    size_t update_device::read_transfer_size() const
+    {
+        // Fewer, larger blocks mean fewer round-trips (each block is followed by a status request); use the most the
+        // device says it can take -- which is also the most it can take, so a smaller size is used as is
+        for( auto & desc : _usb_device->get_descriptors() )
+        {
+            if( desc.type != USB_DT_DFU_FUNCTIONAL || desc.data.size() < sizeof( dfu_functional_descriptor ) )
+                continue;
+            dfu_functional_descriptor dfu;
+            std::memcpy( &dfu, desc.data.data(), sizeof( dfu ) );
+            if( dfu.wTransferSize )
+                return dfu.wTransferSize;
+            LOG_WARNING( "DFU - ignoring a transfer size of 0" );
+        }
+        return DEFAULT_TRANSFER_SIZE;
+    }
+
     bool update_device::wait_for_state(std::shared_ptr<platform::usb_messenger> messenger, const rs2_dfu_state state, size_t timeout) const
     {
-        std::chrono::milliseconds elapsed_milliseconds;
-        auto start = std::chrono::system_clock::now();
+        // Most requests are acknowledged on the first status request, or very soon after; only long operations (erase,
+        // manifest) take longer, so start polling quickly and back off
+        auto poll_interval = std::chrono::milliseconds( 1 );
+        auto const deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds( timeout );
         do {
             dfu_status_payload status;
             uint32_t transferred = 0;
@@ -103,11 +125,9 @@ namespace librealsense
             }
 
             // FW doesn't set the bwPollTimeout value, therefore it is wrong to use status.bwPollTimeout
-            std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_TIMEOUT));
-
-            auto curr = std::chrono::system_clock::now();
-            elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(curr - start);
-        } while (elapsed_milliseconds < std::chrono::milliseconds(timeout));
+            std::this_thread::sleep_for( poll_interval );
+            poll_interval = std::min( poll_interval * 2, std::chrono::milliseconds( DEFAULT_TIMEOUT ) );
+        } while( std::chrono::steady_clock::now() < deadline );
 
         return false;
     }
@@ -129,6 +149,7 @@ namespace librealsense
                 detach(messenger);
 
             read_device_info(messenger);
+            _transfer_size = read_transfer_size();
         }
         else
         {
@@ -154,10 +175,11 @@ namespace librealsense
 
         auto messenger = _usb_device->open(FW_UPDATE_INTERFACE_NUMBER);
 
-        const size_t transfer_size = 1024;
+        const size_t transfer_size = _transfer_size;
+        LOG_DEBUG( "DFU - downloading " << fw_image_size << " bytes in blocks of " << transfer_size );
 
         size_t remaining_bytes = fw_image_size;
-        uint16_t blocks_count = uint16_t( fw_image_size / transfer_size );
+        uint16_t blocks_count = uint16_t( ( fw_image_size + transfer_size - 1 ) / transfer_size );
         uint16_t block_number = 0;
 
         size_t offset = 0;
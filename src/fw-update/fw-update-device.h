@@ -76,6 +76,20 @@ namespace librealsense
         rs2_dfu_status get_status() { return static_cast<rs2_dfu_status>(bStatus); }
     };
 
+#pragma pack(push, 1)
+    // Found among the DFU interface's descriptors: tells, among others, the most data the device accepts in a single
+    // DFU_DNLOAD
+    struct dfu_functional_descriptor
+    {
+        uint8_t  bLength;
+        uint8_t  bDescriptorType;
+        uint8_t  bmAttributes;
+        uint16_t wDetachTimeOut;
+        uint16_t wTransferSize;
+        uint16_t bcdDFUVersion;
+    };
+#pragma pack(pop)
+
     struct serial_number_data
     {
         uint8_t serial[6];
@@ -147,6 +161,7 @@ namespace librealsense
         void detach(std::shared_ptr<platform::usb_messenger> messenger) const;
         bool wait_for_state(std::shared_ptr<platform::usb_messenger> messenger, const rs2_dfu_state state, size_t timeout = 1000) const;
         void read_device_info(std::shared_ptr<platform::usb_messenger> messenger);
+        size_t read_transfer_size() const;
 
         const std::string & get_name() const { return _name; }
         const std::string & get_product_line() const { return _product_line; }
@@ -161,6 +176,7 @@ namespace librealsense
         std::string _physical_port;
         std::string _pid;
         bool _is_dfu_locked = false;
+        size_t _transfer_size = 0;
         std::string _name;
         std::string _product_line;
         std::string _serial_number;
@@ -0,0 +1,116 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "fw-update-orchestrator.h"
+#include <src/librealsense-exception.h>
+
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+
+namespace librealsense
+{
+    namespace
+    {
+        class device_progress : public rs2_update_progress_callback
+        {
+            std::function< void( float ) > _on_progress;
+
+        public:
+            explicit device_progress( std::function< void( float ) > on_progress )
+                : _on_progress( std::move( on_progress ) )
+            {
+            }
+
+            void on_update_progress( const float progress ) override { _on_progress( progress ); }
+            void release() override { delete this; }
+        };
+    }
+
+    fw_update_orchestrator::fw_update_orchestrator( std::vector< update_device_interface const * > devices,
+                                                    size_t max_concurrent )
+        : _devices( std::move( devices ) )
+        , _max_concurrent( max_concurrent )
+    {
+        std::set< update_device_interface const * > unique;
+        for( auto dev : _devices )
+        {
+            if( ! dev )
+                throw invalid_value_exception( "null device to update" );
+            // Two updates of the same device would interleave their DFU blocks
+            if( ! unique.insert( dev ).second )
+                throw invalid_value_exception( "the same device cannot be updated twice at once" );
+        }
+    }
+
+    size_t fw_update_orchestrator::update( const void * fw_image,
+                                           int fw_image_size,
+                                           progress_callback on_progress,
+                                           done_callback on_done ) const
+    {
+        std::mutex callback_mutex;
+        auto notify = [&]( std::function< void() > const & f )
+        {
+            std::lock_guard< std::mutex > lock( callback_mutex );
+            try
+            {
+                f();
+            }
+            catch( ... )
+            {
+                LOG_ERROR( "Received an exception from firmware update callback!" );
+            }
+        };
+
+        std::atomic< size_t > next( 0 );
+        std::atomic< size_t > failures( 0 );
+        auto worker = [&]()
+        {
+            for( size_t i = next++; i < _devices.size(); i = next++ )
+            {
+                rs2_update_progress_callback_sptr progress;
+                if( on_progress )
+                    progress.reset( new device_progress( [&, i]( float p ) { notify( [&] { on_progress( i, p ); } ); } ),
+                                    []( rs2_update_progress_callback * p ) { p->release(); } );
+                std::string error;
+                try
+                {
+                    _devices[i]->update( fw_image, fw_image_size, progress );
+                }
+                catch( std::exception const & e )
+                {
+                    error = e.what();
+                }
+                catch( ... )
+                {
+                    error = "unknown error";
+                }
+                if( ! error.empty() )
+                {
+                    LOG_ERROR( "Firmware update of device " << i << " failed: " << error );
+                    ++failures;
+                }
+                if( on_done )
+                    notify( [&] { on_done( i, error ); } );
+            }
+        };
+
+        auto n_workers = _devices.size();
+        if( _max_concurrent )
+            n_workers = std::min( n_workers, _max_concurrent );
+        // The calling thread is one of the workers
+        std::vector< std::thread > threads;
+        for( size_t t = 1; t < n_workers; ++t )
+            threads.emplace_back( worker );
+        worker();
+        for( auto & t : threads )
+            t.join();
+
+        return failures;
+    }
+}
@@ -0,0 +1,40 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include "fw-update-device-interface.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace librealsense
+{
+    // Updates the firmware of several devices, each already in its update state, at the same time.
+    //
+    // Every device is updated on its own worker thread, with at most max_concurrent of them running at once (0 for no
+    // limit). A failure in one device does not affect the others: it is reported and the rest go on.
+    //
+    // Callbacks are serialized, so they need not be thread-safe, but they are called from the workers and should
+    // return quickly.
+    class fw_update_orchestrator
+    {
+    public:
+        typedef std::function< void( size_t device_index, float progress ) > progress_callback;
+        // Called once per device when its update is over, with an empty error on success
+        typedef std::function< void( size_t device_index, std::string const & error ) > done_callback;
+
+        fw_update_orchestrator( std::vector< update_device_interface const * > devices, size_t max_concurrent = 0 );
+
+        // Returns the number of devices that failed
+        size_t update( const void * fw_image,
+                       int fw_image_size,
+                       progress_callback on_progress = nullptr,
+                       done_callback on_done = nullptr ) const;
+
+    private:
+        std::vector< update_device_interface const * > _devices;
+        size_t _max_concurrent;
+    };
+}
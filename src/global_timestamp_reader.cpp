@@ -1,6 +1,7 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2015 Intel Corporation. All Rights Reserved.
 #include "global_timestamp_reader.h"
+#include "thread-policy.h"
 #include <chrono>
 
 using namespace std::chrono;
@@ -247,6 +248,7 @@ namespace librealsense
 
     void time_diff_keeper::polling(dispatcher::cancellable_timer cancellable_timer)
     {
+        thread_policy::apply( thread_role::time_diff_keeper );
         update_diff_time();
         unsigned int time_to_sleep = _poll_intervals_ms + _coefs.is_full() * (9 * _poll_intervals_ms);
         if (!cancellable_timer.try_sleep( std::chrono::milliseconds( time_to_sleep )))
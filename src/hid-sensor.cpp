@@ -219,57 +219,60 @@ void hid_sensor::start( rs2_frame_callback_sptr callback )
                 return;
             }
 
-            const auto && fr = generate_frame_from_data( sensor_data.fo,
-                                                         system_time,
-                                                         timestamp_reader,
-                                                         last_timestamp,
-                                                         last_frame_number,
-                                                         request );
-            auto && frame_counter = fr->additional_data.frame_number;
-            const auto && timestamp_domain = timestamp_reader->get_frame_timestamp_domain( fr );
-            auto && timestamp = fr->additional_data.timestamp;
-            const auto && bpp = get_image_bpp( request->get_format() );
-            auto && data_size = sensor_data.fo.frame_size;
-
-            LOG_DEBUG( "FrameAccepted," << get_string( request->get_stream_type() ) << ",Counter," << std::dec
-                                        << frame_counter << ",Index,0"
-                                        << ",BackEndTS," << std::fixed << sensor_data.fo.backend_time << ",SystemTime,"
-                                        << std::fixed << system_time << " ,diff_ts[Sys-BE],"
-                                        << system_time - sensor_data.fo.backend_time << ",TS," << std::fixed
-                                        << timestamp << ",TS_Domain,"
-                                        << rs2_timestamp_domain_to_string( timestamp_domain ) << ",last_frame_number,"
-                                        << last_frame_number << ",last_timestamp," << last_timestamp );
-
-            last_frame_number = frame_counter;
-            last_timestamp = timestamp;
-            frame_holder frame = _source.alloc_frame(
-                { request->get_stream_type(), request->get_stream_index(), RS2_EXTENSION_MOTION_FRAME },
-                data_size,
-                std::move( fr->additional_data ),
-                true );
-            memcpy( (void *)frame->get_frame_data(),
-                    sensor_data.fo.pixels,
-                    sizeof( uint8_t ) * sensor_data.fo.frame_size );
-            if( ! frame )
+            // Samples read together are all handled here, in order
+            auto const sample_count = sensor_data.samples ? sensor_data.sample_count : 1;
+            for( size_t i = 0; i < sample_count; ++i )
             {
-                LOG_INFO( "Dropped frame. alloc_frame(...) returned nullptr" );
-                return;
+                auto & fo = sensor_data.samples ? sensor_data.samples[i] : sensor_data.fo;
+                const auto && fr = generate_frame_from_data( fo,
+                                                             system_time,
+                                                             timestamp_reader,
+                                                             last_timestamp,
+                                                             last_frame_number,
+                                                             request );
+                auto && frame_counter = fr->additional_data.frame_number;
+                const auto && timestamp_domain = timestamp_reader->get_frame_timestamp_domain( fr );
+                auto && timestamp = fr->additional_data.timestamp;
+                auto && data_size = fo.frame_size;
+
+                LOG_DEBUG( "FrameAccepted," << get_string( request->get_stream_type() ) << ",Counter," << std::dec
+                                            << frame_counter << ",Index,0"
+                                            << ",BackEndTS," << std::fixed << fo.backend_time << ",SystemTime,"
+                                            << std::fixed << system_time << " ,diff_ts[Sys-BE],"
+                                            << system_time - fo.backend_time << ",TS," << std::fixed
+                                            << timestamp << ",TS_Domain,"
+                                            << rs2_timestamp_domain_to_string( timestamp_domain ) << ",last_frame_number,"
+                                            << last_frame_number << ",last_timestamp," << last_timestamp );
+
+                last_frame_number = frame_counter;
+                last_timestamp = timestamp;
+                frame_holder frame = _source.alloc_frame(
+                    { request->get_stream_type(), request->get_stream_index(), RS2_EXTENSION_MOTION_FRAME },
+                    data_size,
+                    std::move( fr->additional_data ),
+                    true );
+                if( ! frame )
+                {
+                    LOG_INFO( "Dropped frame. alloc_frame(...) returned nullptr" );
+                    return;
+                }
+                memcpy( (void *)frame->get_frame_data(), fo.pixels, sizeof( uint8_t ) * fo.frame_size );
+                frame->set_stream( request );
+                frame->set_timestamp_domain( timestamp_domain );
+
+                // Gather info for logging the callback ended
+                auto fps = frame->get_stream()->get_framerate();
+                auto stream_type = frame->get_stream()->get_stream_type();
+                auto frame_number = frame->get_frame_number();
+
+                // Invoke first callback
+                auto callback_start_time = time_service::get_time();
+                auto callback = frame->get_owner()->begin_callback();
+                _source.invoke_callback( std::move( frame ) );
+
+                // Log callback ended
+                log_callback_end( fps, callback_start_time, time_service::get_time(), stream_type, frame_number );
             }
-            frame->set_stream( request );
-            frame->set_timestamp_domain( timestamp_domain );
-
-            // Gather info for logging the callback ended
-            auto fps = frame->get_stream()->get_framerate();
-            auto stream_type = frame->get_stream()->get_stream_type();
-            auto frame_number = frame->get_frame_number();
-
-            // Invoke first callback
-            auto callback_start_time = time_service::get_time();
-            auto callback = frame->get_owner()->begin_callback();
-            _source.invoke_callback( std::move( frame ) );
-
-            // Log callback ended
-            log_callback_end( fps, callback_start_time, time_service::get_time(), stream_type, frame_number );
         } );
     _is_streaming = true;
 }
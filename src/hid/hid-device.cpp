@@ -4,6 +4,7 @@
 #include <queue>
 #include "hid-device.h"
 #include <src/platform/hid-data.h>
+#include <src/thread-policy.h>
 
 #include <rsutils/string/from.h>
 #include <rsutils/string/hexdump.h>
@@ -149,6 +150,7 @@ namespace librealsense
 #endif
                 _handle_interrupts_thread = std::make_shared<active_object<>>([this](dispatcher::cancellable_timer cancellable_timer)
                 {
+                    thread_policy::apply( thread_role::hid );
                     handle_interrupt();
                 });
 
@@ -0,0 +1,172 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "hw-monitor-cache.h"
+
+#include <rsutils/json-config.h>
+#include <rsutils/string/hexarray.h>
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+
+namespace librealsense
+{
+    // See hw_monitor::fill_usb_buffer for the layout of a request
+    static uint8_t get_opcode( uint8_t const * pb, size_t cb )
+    {
+        return cb > 4 ? pb[4] : 0;
+    }
+
+    // Requests may be sent in a full-sized buffer; only the header and the data are significant
+    static std::string get_key( uint8_t const * pb, size_t cb )
+    {
+        if( cb >= 2 )
+        {
+            uint16_t length;
+            std::memcpy( &length, pb, sizeof( length ) );
+            cb = std::min( cb, size_t( length ) + 4 );
+        }
+        return rsutils::string::hexarray::to_string( std::vector< uint8_t >( pb, pb + cb ) );
+    }
+
+    // The response starts with the opcode it answers, or with an error code
+    static bool is_success( uint8_t opcode, std::vector< uint8_t > const & response )
+    {
+        if( response.size() < sizeof( uint32_t ) )
+            return false;
+        uint32_t op;
+        std::memcpy( &op, response.data(), sizeof( op ) );
+        return op == opcode;
+    }
+
+
+    hw_monitor_cache::hw_monitor_cache( std::string const & directory,
+                                        std::set< uint8_t > cacheable_opcodes,
+                                        std::set< uint8_t > invalidating_opcodes )
+        : _directory( directory )
+        , _cacheable( std::move( cacheable_opcodes ) )
+        , _invalidating( std::move( invalidating_opcodes ) )
+        , _responses( rsutils::json::object() )
+    {
+    }
+
+    std::string hw_monitor_cache::get_filename( std::string const & serial, std::string const & firmware_version ) const
+    {
+        std::string filename = _directory;
+        if( ! filename.empty() && filename.back() != '/' && filename.back() != '\\' )
+            filename += '/';
+        return filename + "hwm-" + serial + '-' + firmware_version + ".json";
+    }
+
+    void hw_monitor_cache::bind( std::string const & serial,
+                                 std::string const & firmware_version,
+                                 std::string const & validation )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _filename = get_filename( serial, firmware_version );
+        _validation = validation;
+        _responses = rsutils::json::object();
+        try
+        {
+            auto j = rsutils::json_config::load_from_file( _filename );
+            if( j.is_object() )
+            {
+                if( j.nested( "validation" ).string_ref_or_empty() == validation )
+                    _responses = j.nested( "responses" ).default_object();
+                else
+                {
+                    std::remove( _filename.c_str() );
+                    LOG_DEBUG( "hw-monitor cache " << _filename << " is stale" );
+                }
+            }
+        }
+        catch( std::exception const & e )
+        {
+            LOG_DEBUG( "ignoring hw-monitor cache " << _filename << ": " << e.what() );
+        }
+        LOG_DEBUG( "hw-monitor cache " << _filename << ": " << _responses.size() << " responses" );
+    }
+
+    bool hw_monitor_cache::is_bound() const
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        return ! _filename.empty();
+    }
+
+    bool hw_monitor_cache::lookup( uint8_t const * pb, size_t cb, std::vector< uint8_t > & response ) const
+    {
+        if( ! _cacheable.count( get_opcode( pb, cb ) ) )
+            return false;
+
+        std::lock_guard< std::mutex > lock( _mutex );
+        if( _filename.empty() )
+            return false;
+        auto it = _responses.find( get_key( pb, cb ) );
+        if( it == _responses.end() )
+            return false;
+        try
+        {
+            response = it->get< rsutils::string::hexarray >().detach();
+        }
+        catch( std::exception const & )
+        {
+            return false;
+        }
+        return true;
+    }
+
+    void hw_monitor_cache::update( uint8_t const * pb, size_t cb, std::vector< uint8_t > const & response )
+    {
+        auto const opcode = get_opcode( pb, cb );
+        if( _invalidating.count( opcode ) )
+        {
+            invalidate();
+            return;
+        }
+        if( ! _cacheable.count( opcode ) || ! is_success( opcode, response ) )
+            return;
+
+        std::lock_guard< std::mutex > lock( _mutex );
+        if( _filename.empty() )
+            return;
+        _responses[get_key( pb, cb )] = rsutils::string::hexarray::to_string( response );
+        save();
+    }
+
+    void hw_monitor_cache::invalidate()
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        if( _filename.empty() || _responses.empty() )
+            return;
+        _responses = rsutils::json::object();
+        std::remove( _filename.c_str() );
+        LOG_DEBUG( "hw-monitor cache " << _filename << " invalidated" );
+    }
+
+    void hw_monitor_cache::save() const
+    {
+        // Write to a temporary file first, so a concurrent reader never sees a partial file
+        auto const tmp = _filename + ".tmp";
+        {
+            std::ofstream f( tmp, std::ios::trunc );
+            if( ! f.good() )
+            {
+                LOG_DEBUG( "failed to write hw-monitor cache " << tmp );
+                return;
+            }
+            rsutils::json j;
+            j["validation"] = _validation;
+            j["responses"] = _responses;
+            f << j.dump( 1 );
+            if( ! f.good() )
+                return;
+        }
+        std::remove( _filename.c_str() );  // rename does not overwrite on Windows
+        if( std::rename( tmp.c_str(), _filename.c_str() ) )
+            LOG_DEBUG( "failed to write hw-monitor cache " << _filename );
+    }
+}
@@ -0,0 +1,66 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <rsutils/json.h>
+
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace librealsense
+{
+    // Persistent cache of immutable hw-monitor responses (e.g., calibration tables)
+    //
+    // Device creation and the first use of a device issue a burst of HW-monitor commands whose answers never change
+    // for a given unit and firmware. The cache remembers the raw responses to a set of 'cacheable' opcodes in a file
+    // per serial-number and firmware-version, so later runs can answer them without a round-trip to the device.
+    //
+    // Until bind() is called, nothing is served from the cache: the device identity must come from the device itself
+    // (normally the GVD, which is never cached), as must a validation token that changes whenever the cached
+    // responses may (e.g., the version and CRC of the calibration table). An entry stored with another token was made
+    // stale by another process or host, and is dropped. Any 'invalidating' opcode seen afterwards (calibration writes,
+    // flash writes, advanced-mode toggles...) drops the entry too, both in memory and on disk, since it may change
+    // what the cacheable commands return.
+    //
+    // Requests and responses are the raw hw-monitor buffers (see hw_monitor::fill_usb_buffer): the request is the key,
+    // and only successful responses (echoing the request opcode) are kept.
+    //
+    class hw_monitor_cache
+    {
+    public:
+        hw_monitor_cache( std::string const & directory,
+                          std::set< uint8_t > cacheable_opcodes,
+                          std::set< uint8_t > invalidating_opcodes );
+
+        // Select (and load, if present and stored with the same validation token) the entry of a specific device
+        void bind( std::string const & serial, std::string const & firmware_version, std::string const & validation );
+        bool is_bound() const;
+
+        // Returns true and fills 'response' if the request can be answered without the device
+        bool lookup( uint8_t const * pb, size_t cb, std::vector< uint8_t > & response ) const;
+
+        // Let the cache know of a request that went to the device and its response
+        void update( uint8_t const * pb, size_t cb, std::vector< uint8_t > const & response );
+
+        // The file holding the entry of a device
+        std::string get_filename( std::string const & serial, std::string const & firmware_version ) const;
+
+    private:
+        void save() const;
+        void invalidate();
+
+        std::string const _directory;
+        std::set< uint8_t > const _cacheable;
+        std::set< uint8_t > const _invalidating;
+
+        mutable std::mutex _mutex;
+        std::string _filename;  // empty until bound
+        std::string _validation;
+        rsutils::json _responses;  // request hexarray -> response hexarray
+    };
+}
@@ -6,6 +6,7 @@
 #include "uvc-sensor.h"
 #include <mutex>
 #include "platform/command-transfer.h"
+#include "hw-monitor-cache.h"
 #include <string>
 #include <algorithm>
 #include <vector>
@@ -198,9 +199,11 @@ namespace librealsense
     class locked_transfer
     {
     public:
+        // Without a sensor (uvc_ep is null), commands are sent as-is with no power management
         locked_transfer(std::shared_ptr<platform::command_transfer> command_transfer, const std::shared_ptr< uvc_sensor > & uvc_ep)
             :_command_transfer(command_transfer),
-            _uvc_sensor_base(uvc_ep)
+            _uvc_sensor_base(uvc_ep),
+            _powered( uvc_ep != nullptr )
         {}
 
         std::vector<uint8_t> send_receive(
@@ -215,17 +218,35 @@ namespace librealsense
             if( !token.get() ) throw io_exception( "heap allocation failed" );
 
             std::lock_guard<std::recursive_mutex> lock(_local_mtx);
-            auto strong_uvc = _uvc_sensor_base.lock();
-            if( ! strong_uvc )
-                return std::vector< uint8_t >();
-
-            return strong_uvc->invoke_powered([&] ( platform::uvc_device & dev )
-                {
-                    std::lock_guard<platform::uvc_device> lock(dev);
-                    return _command_transfer->send_receive(pb, cb, timeout_ms, require_response);
-                });
+            std::vector< uint8_t > response;
+            if( _cache && _cache->lookup( pb, cb, response ) )
+                return response;
+
+            if( ! _powered )
+            {
+                response = _command_transfer->send_receive( pb, cb, timeout_ms, require_response );
+            }
+            else
+            {
+                auto strong_uvc = _uvc_sensor_base.lock();
+                if( ! strong_uvc )
+                    return std::vector< uint8_t >();
+
+                response = strong_uvc->invoke_powered( [&]( platform::uvc_device & dev )
+                    {
+                        std::lock_guard<platform::uvc_device> lock(dev);
+                        return _command_transfer->send_receive(pb, cb, timeout_ms, require_response);
+                    });
+            }
+            if( _cache )
+                _cache->update( pb, cb, response );
+            return response;
         }
 
+        // Responses found in the cache are returned without powering up the device
+        void set_cache( std::shared_ptr< hw_monitor_cache > cache ) { _cache = std::move( cache ); }
+        std::shared_ptr< hw_monitor_cache > const & get_cache() const { return _cache; }
+
         ~locked_transfer()
         {
             try
@@ -240,6 +261,8 @@ namespace librealsense
     private:
         std::shared_ptr<platform::command_transfer> _command_transfer;
         std::weak_ptr< uvc_sensor> _uvc_sensor_base;
+        bool _powered;
+        std::shared_ptr< hw_monitor_cache > _cache;
         std::recursive_mutex _local_mtx;
         small_heap<int, 256> _heap;
     };
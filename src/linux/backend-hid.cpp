@@ -3,8 +3,10 @@
 
 #include "metadata.h"
 #include "backend-hid.h"
+#include "iio-sample-batch.h"
 #include "backend.h"
 #include "types.h"
+#include <src/thread-policy.h>
 
 #include <rsutils/string/from.h>
 
@@ -255,6 +257,7 @@ namespace librealsense
             _callback = sensor_callback;
             _is_capturing = true;
             _hid_thread = std::unique_ptr<std::thread>(new std::thread([this, read_device_path_str](){
+                thread_policy::apply( thread_role::hid );
                 const uint32_t channel_size = 24; // TODO: why 24?
                 std::vector<uint8_t> raw_data(channel_size * hid_buf_len);
 
@@ -460,6 +463,7 @@ namespace librealsense
               _iio_device_path(device_path),
               _sensor_name(""),
               _sampling_frequency_name(""),
+              _frequency(frequency),
               _callback(nullptr),
               _is_capturing(false),
               _pm_dispatcher(16)    // queue for async power management commands
@@ -536,11 +540,11 @@ namespace librealsense
             _callback = sensor_callback;
             _is_capturing = true;
             _hid_thread = std::unique_ptr<std::thread>(new std::thread([this](){
+                thread_policy::apply( thread_role::hid );
                 const uint32_t channel_size = get_channel_size();
-                size_t raw_data_size = channel_size*hid_buf_len;
-
-                std::vector<uint8_t> raw_data(raw_data_size);
-                auto metadata = has_metadata();
+                iio_sample_batch batch(channel_size, has_metadata() ? HID_METADATA_SIZE : 0, _frequency, hid_buf_len);
+                sensor_data sens_data{};
+                sens_data.sensor = hid_sensor{get_sensor_name()};
 
                 do {
                     fd_set fds;
@@ -574,7 +578,7 @@ namespace librealsense
                         }
                         else if (FD_ISSET(_fd, &fds))
                         {
-                            read_size = read(_fd, raw_data.data(), raw_data_size);
+                            read_size = read(_fd, batch.data(), batch.size());
                             if (read_size < 0 )
                                 continue;
                         }
@@ -585,55 +589,16 @@ namespace librealsense
                             continue;
                         }
 
-                        auto sz= read_size / channel_size;
-                        if (sz > 2)
-                        {
-                            LOG_DEBUG("HID: Going to handle " <<  sz << " packets");
-                        }
-                        // TODO: code refactoring to reduce latency
-                        for (auto i = 0; i < sz; ++i)
-                        {
-                            auto now_ts = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
-                            auto p_raw_data = raw_data.data() + channel_size * i;
-                            sensor_data sens_data{};
-                            sens_data.sensor = hid_sensor{get_sensor_name()};
-
-                            auto hid_data_size = channel_size - (metadata ? HID_METADATA_SIZE : 0);
-                            // Populate HID IMU data - Header
-                            metadata_hid_raw meta_data{};
-                            meta_data.header.report_type = md_hid_report_type::hid_report_imu;
-                            meta_data.header.length = hid_header_size + metadata_imu_report_size;
-                            meta_data.header.timestamp = *(reinterpret_cast<uint64_t *>(&p_raw_data[16]));
-                            // Payload:
-                            meta_data.report_type.imu_report.header.md_type_id = md_type::META_DATA_HID_IMU_REPORT_ID;
-                            meta_data.report_type.imu_report.header.md_size = metadata_imu_report_size;
-//                            meta_data.report_type.imu_report.flags = static_cast<uint8_t>( md_hid_imu_attributes::custom_timestamp_attirbute |
-//                                                                                            md_hid_imu_attributes::imu_counter_attribute |
-//                                                                                            md_hid_imu_attributes::usb_counter_attribute);
-//                            meta_data.report_type.imu_report.custom_timestamp = meta_data.header.timestamp;
-//                            meta_data.report_type.imu_report.imu_counter = p_raw_data[30];
-//                            meta_data.report_type.imu_report.usb_counter = p_raw_data[31];
-
-                            sens_data.fo = {hid_data_size, metadata? meta_data.header.length: uint8_t(0),
-                                            p_raw_data,  metadata? &meta_data : nullptr, now_ts};
-                            //Linux HID provides timestamps in nanosec. Convert to usec (FW default)
-                            if (metadata)
-                            {
-                                //auto* ts_nsec = reinterpret_cast<uint64_t*>(const_cast<void*>(sens_data.fo.metadata));
-                                //*ts_nsec /=1000;
-                                meta_data.header.timestamp /=1000;
-                            }
-
-//                            for (auto i=0ul; i<channel_size; i++)
-//                                std::cout << std::hex << int(p_raw_data[i]) << " ";
-//                            std::cout << std::dec << std::endl;
-
-                            this->_callback(sens_data);
-                        }
-                        if (sz > 2)
-                        {
-                            LOG_DEBUG("HID: Finished to handle " <<  sz << " packets");
-                        }
+                        // All the samples buffered up to the watermark are handled in a single callback
+                        auto now_ts = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+                        auto sz = batch.parse(read_size, now_ts);
+                        if (!sz)
+                            continue;
+                        LOG_DEBUG_HID("HID: Going to handle " << sz << " packets");
+                        sens_data.fo = batch.samples()[0];
+                        sens_data.samples = batch.samples();
+                        sens_data.sample_count = sz;
+                        this->_callback(sens_data);
                     }
                     else
                     {
@@ -709,6 +674,19 @@ namespace librealsense
             iio_device_file.close();
         }
 
+        void iio_hid_sensor::set_watermark(uint32_t samples)
+        {
+            // Kernels before 4.2 wake the reader for every sample
+            auto watermark_path = _iio_device_path + "/buffer/watermark";
+            if (!std::ifstream(watermark_path).good())
+            {
+                LOG_DEBUG("No IIO buffer watermark for " << _sensor_name << "; reading a sample at a time");
+                return;
+            }
+            if (!write_fs_attribute(watermark_path, samples))
+                LOG_WARNING("HID set_watermark " << samples << " failed for " << watermark_path);
+        }
+
         void iio_hid_sensor::set_sensitivity( float sensitivity ) 
         {
             auto sensitivity_path = _iio_device_path + "/" + _sensitivity_name;
@@ -847,6 +825,7 @@ namespace librealsense
             set_frequency(frequency);
             set_sensitivity( sensitivity );
             write_fs_attribute(_iio_device_path + "/buffer/length", hid_buf_len);
+            set_watermark(iio_sample_batch::watermark(frequency, hid_buf_len));
         }
 
         // calculate the storage size of a scan
@@ -147,6 +147,8 @@ namespace librealsense
             void clear_buffer();
 
             void set_frequency(uint32_t frequency);
+            // samples to buffer in the kernel before the capture thread is woken up
+            void set_watermark(uint32_t samples);
             void set_sensitivity( float sensitivity );
             void set_power(bool on);
 
@@ -180,6 +182,7 @@ namespace librealsense
             std::string _iio_device_path;
             std::string _sensor_name;
             std::string _sampling_frequency_name;
+            uint32_t _frequency;
             std::string _sensitivity_name;
             std::list<hid_input*> _inputs;
             std::list<hid_input*> _channels;
@@ -9,6 +9,7 @@
 #include "backend-hid.h"
 #include "backend.h"
 #include "types.h"
+#include <src/thread-policy.h>
 #if defined(USING_UDEV)
 #include "udev-device-watcher.h"
 #else
@@ -1149,7 +1150,16 @@ namespace librealsense
               _fd(-1),
               _stop_pipe_fd{},
               _buf_dispatch(use_memory_map),
-              _frame_drop_monitor(DEFAULT_KPI_FRAME_DROPS_PERCENTAGE)
+              _frame_drop_monitor(DEFAULT_KPI_FRAME_DROPS_PERCENTAGE),
+              _video_md_syncer([](int fd, v4l2_buffer& buf)
+              {
+                  // Enqueue of buffer before throwing its content away
+                  LOG_DEBUG_V4L("video_md_syncer - Enqueue buf " << std::dec << buf.index << " for fd " << fd << " before dropping it");
+                  if (xioctl(fd, VIDIOC_QBUF, &buf) < 0)
+                  {
+                      LOG_ERROR("xioctl(VIDIOC_QBUF) failed when requesting new frame! fd: " << fd << " error: " << strerror(errno));
+                  }
+              })
         {
             foreach_uvc_device([&info, this](const uvc_device_info& i, const std::string& name)
             {
@@ -1623,7 +1633,7 @@ namespace librealsense
                                     else
                                     {
                                         // saving video buffer to syncer
-                                        _video_md_syncer.push_video({std::make_shared<v4l2_buffer>(buf), _fd, buf.index});
+                                        _video_md_syncer.push_video(buf, _fd);
                                         buf_mgr.handle_buffer(e_video_buf, -1);
                                     }
                                 }
@@ -1671,8 +1681,8 @@ namespace librealsense
         void v4l_uvc_device::upload_video_and_metadata_from_syncer(buffers_mgr& buf_mgr)
         {
             // uploading to user's callback
-            std::shared_ptr<v4l2_buffer> video_v4l2_buffer;
-            std::shared_ptr<v4l2_buffer> md_v4l2_buffer;
+            v4l2_buffer video_v4l2_buffer{};
+            v4l2_buffer md_v4l2_buffer{};
 
             if (_is_started && is_metadata_streamed())
             {
@@ -1680,33 +1690,33 @@ namespace librealsense
                 if (_video_md_syncer.pull_video_with_metadata(video_v4l2_buffer, md_v4l2_buffer, video_fd, md_fd))
                 {
                     // Preparing video buffer
-                    auto video_buffer = get_video_buffer(video_v4l2_buffer->index);
-                    video_buffer->attach_buffer(*video_v4l2_buffer);
+                    auto video_buffer = get_video_buffer(video_v4l2_buffer.index);
+                    video_buffer->attach_buffer(video_v4l2_buffer);
 
                     // happens when the video did not arrive on
                     // the current polling iteration (was taken from the syncer's video queue)
                     if (buf_mgr.get_buffers()[e_video_buf]._file_desc == -1)
                     {
-                        buf_mgr.handle_buffer(e_video_buf, video_fd, *video_v4l2_buffer, video_buffer);
+                        buf_mgr.handle_buffer(e_video_buf, video_fd, video_v4l2_buffer, video_buffer);
                     }
                     buf_mgr.handle_buffer(e_video_buf, -1); // transfer new buffer request to the frame callback
 
                     // Preparing metadata buffer
-                    auto metadata_buffer = get_md_buffer(md_v4l2_buffer->index);
-                    set_metadata_attributes(buf_mgr, md_v4l2_buffer->bytesused, metadata_buffer->get_frame_start());
-                    metadata_buffer->attach_buffer(*md_v4l2_buffer);
+                    auto metadata_buffer = get_md_buffer(md_v4l2_buffer.index);
+                    set_metadata_attributes(buf_mgr, md_v4l2_buffer.bytesused, metadata_buffer->get_frame_start());
+                    metadata_buffer->attach_buffer(md_v4l2_buffer);
 
                     if (buf_mgr.get_buffers()[e_metadata_buf]._file_desc == -1)
                     {
-                        buf_mgr.handle_buffer(e_metadata_buf, md_fd, *md_v4l2_buffer, metadata_buffer);
+                        buf_mgr.handle_buffer(e_metadata_buf, md_fd, md_v4l2_buffer, metadata_buffer);
                     }
                     buf_mgr.handle_buffer(e_metadata_buf, -1); // transfer new buffer request to the frame callback
 
-                    auto frame_sz = buf_mgr.md_node_present() ? video_v4l2_buffer->bytesused :
-                                        std::min(video_v4l2_buffer->bytesused - buf_mgr.metadata_size(),
+                    auto frame_sz = buf_mgr.md_node_present() ? video_v4l2_buffer.bytesused :
+                                        std::min(video_v4l2_buffer.bytesused - buf_mgr.metadata_size(),
                                                  video_buffer->get_length_frame_only());
 
-                    auto timestamp = (double)video_v4l2_buffer->timestamp.tv_sec * 1000.f + (double)video_v4l2_buffer->timestamp.tv_usec / 1000.f;
+                    auto timestamp = (double)video_v4l2_buffer.timestamp.tv_sec * 1000.f + (double)video_v4l2_buffer.timestamp.tv_usec / 1000.f;
                     timestamp = monotonic_to_realtime(timestamp);
 
                     // D457 work - to work with "normal camera", use frame_sz as the first input to the following frame_object:
@@ -2078,6 +2088,7 @@ namespace librealsense
 
         void v4l_uvc_device::capture_loop()
         {
+            thread_policy::apply( thread_role::capture, _info.unique_id );
             try
             {
                 while(_is_capturing)
@@ -2541,7 +2552,7 @@ namespace librealsense
                 buf_mgr.handle_buffer(e_metadata_buf, _md_fd, buf, buffer);
 
                 // pushing metadata buffer to syncer
-                _video_md_syncer.push_metadata({std::make_shared<v4l2_buffer>(buf), _md_fd, buf.index});
+                _video_md_syncer.push_metadata(buf, _md_fd);
                 buf_mgr.handle_buffer(e_metadata_buf, -1);
             }
         }
@@ -2819,180 +2830,5 @@ namespace librealsense
         {
             return std::make_shared<v4l_backend>();
         }
-
-        void v4l2_video_md_syncer::push_video(const sync_buffer& video_buffer)
-        {
-            std::lock_guard<std::mutex> lock(_syncer_mutex);
-            if(!_is_ready)
-            {
-                LOG_DEBUG_V4L("video_md_syncer - push_video called but syncer not ready");
-                return;
-            }
-            _video_queue.push(video_buffer);
-            LOG_DEBUG_V4L("video_md_syncer - video pushed with sequence " << video_buffer._v4l2_buf->sequence << ", buf " << video_buffer._buffer_index);
-
-            // remove old video_buffer
-            if (_video_queue.size() > 2)
-            {
-                // Enqueue of video buffer before throwing its content away
-                enqueue_front_buffer_before_throwing_it(_video_queue);
-            }
-        }
-
-        void v4l2_video_md_syncer::push_metadata(const sync_buffer& md_buffer)
-        {
-            std::lock_guard<std::mutex> lock(_syncer_mutex);
-            if(!_is_ready)
-            {
-                LOG_DEBUG_V4L("video_md_syncer - push_metadata called but syncer not ready");
-                return;
-            }
-            // override front buffer if it has the same sequence that the new buffer - happens with metadata sequence 0
-            if (_md_queue.size() > 0 && _md_queue.front()._v4l2_buf->sequence == md_buffer._v4l2_buf->sequence)
-            {
-                LOG_DEBUG_V4L("video_md_syncer - calling enqueue_front_buffer_before_throwing_it - md buf " << md_buffer._buffer_index << " and md buf " << _md_queue.front()._buffer_index << " have same sequence");
-                enqueue_front_buffer_before_throwing_it(_md_queue);
-            }
-            _md_queue.push(md_buffer);
-            LOG_DEBUG_V4L("video_md_syncer - md pushed with sequence " << md_buffer._v4l2_buf->sequence << ", buf " << md_buffer._buffer_index);
-            LOG_DEBUG_V4L("video_md_syncer - md queue size = " << _md_queue.size());
-
-            // remove old md_buffer
-            if (_md_queue.size() > 2)
-            {
-                LOG_DEBUG_V4L("video_md_syncer - calling enqueue_front_buffer_before_throwing_it - md queue size is: " << _md_queue.size());
-                // Enqueue of md buffer before throwing its content away
-                enqueue_front_buffer_before_throwing_it(_md_queue);
-            }
-        }
-
-        bool v4l2_video_md_syncer::pull_video_with_metadata(std::shared_ptr<v4l2_buffer>& video_buffer, std::shared_ptr<v4l2_buffer>& md_buffer,
-                                                            int& video_fd, int& md_fd)
-        {
-            std::lock_guard<std::mutex> lock(_syncer_mutex);
-            if(!_is_ready)
-            {
-                LOG_DEBUG_V4L("video_md_syncer - pull_video_with_metadata called but syncer not ready");
-                return false;
-            }
-            if (_video_queue.empty())
-            {
-                LOG_DEBUG_V4L("video_md_syncer - video queue is empty");
-                return false;
-            }
-
-            if (_md_queue.empty())
-            {
-                LOG_DEBUG_V4L("video_md_syncer - md queue is empty");
-                return false;
-            }
-
-            sync_buffer video_candidate = _video_queue.front();
-            sync_buffer md_candidate = _md_queue.front();
-
-            // set video and md file descriptors
-            video_fd = video_candidate._fd;
-            md_fd = md_candidate._fd;
-
-            // sync is ok if latest video and md have the same sequence
-            if (video_candidate._v4l2_buf->sequence == md_candidate._v4l2_buf->sequence)
-            {
-                video_buffer = video_candidate._v4l2_buf;
-                md_buffer = md_candidate._v4l2_buf;
-                // removing from queues
-                _video_queue.pop();
-                _md_queue.pop();
-                LOG_DEBUG_V4L("video_md_syncer - video and md pulled with sequence " << video_candidate._v4l2_buf->sequence);
-                return true;
-            }
-
-            LOG_DEBUG_V4L("video_md_syncer - video_candidate seq " << video_candidate._v4l2_buf->sequence << ", md_candidate seq " << md_candidate._v4l2_buf->sequence);
-
-            if (video_candidate._v4l2_buf->sequence > md_candidate._v4l2_buf->sequence && _md_queue.size() > 1)
-            {
-                // Enqueue of md buffer before throwing its content away
-                enqueue_buffer_before_throwing_it(md_candidate);
-                _md_queue.pop();
-
-                // checking remaining metadata buffer in queue
-                auto alternative_md_candidate = _md_queue.front();
-                // sync is ok if latest video and md have the same sequence
-                if (video_candidate._v4l2_buf->sequence == alternative_md_candidate._v4l2_buf->sequence)
-                {
-                    video_buffer = video_candidate._v4l2_buf;
-                    md_buffer = alternative_md_candidate._v4l2_buf;
-                    // removing from queues
-                    _video_queue.pop();
-                    _md_queue.pop();
-                    LOG_DEBUG_V4L("video_md_syncer - video and md pulled with sequence " << video_candidate._v4l2_buf->sequence);
-                    return true;
-                }
-            }
-            if (video_candidate._v4l2_buf->sequence < md_candidate._v4l2_buf->sequence && _video_queue.size() > 1)
-            {
-                // Enqueue of md buffer before throwing its content away
-                enqueue_buffer_before_throwing_it(video_candidate);
-                _video_queue.pop();
-
-                // checking remaining video buffer in queue
-                auto alternative_video_candidate = _video_queue.front();
-                // sync is ok if latest video and md have the same sequence
-                if (alternative_video_candidate._v4l2_buf->sequence == md_candidate._v4l2_buf->sequence)
-                {
-                    video_buffer = alternative_video_candidate._v4l2_buf;
-                    md_buffer = md_candidate._v4l2_buf;
-                    // removing from queues
-                    _video_queue.pop();
-                    _md_queue.pop();
-                    LOG_DEBUG_V4L("video_md_syncer - video and md pulled with sequence " << md_candidate._v4l2_buf->sequence);
-                    return true;
-                }
-            }
-            return false;
-        }
-
-        void v4l2_video_md_syncer::enqueue_buffer_before_throwing_it(const sync_buffer& sb) const
-        {
-            // Enqueue of buffer before throwing its content away
-            LOG_DEBUG_V4L("video_md_syncer - Enqueue buf " << std::dec << sb._buffer_index << " for fd " << sb._fd << " before dropping it");
-            if (xioctl(sb._fd, VIDIOC_QBUF, sb._v4l2_buf.get()) < 0)
-            {
-                LOG_ERROR("xioctl(VIDIOC_QBUF) failed when requesting new frame! fd: " << sb._fd << " error: " << strerror(errno));
-            }
-        }
-
-        void v4l2_video_md_syncer::enqueue_front_buffer_before_throwing_it(std::queue<sync_buffer>& sync_queue)
-        {
-            // Enqueue of buffer before throwing its content away
-            LOG_DEBUG_V4L("video_md_syncer - Enqueue buf " << std::dec << sync_queue.front()._buffer_index << " for fd " << sync_queue.front()._fd << " before dropping it");
-            if (xioctl(sync_queue.front()._fd, VIDIOC_QBUF, sync_queue.front()._v4l2_buf.get()) < 0)
-            {
-                LOG_ERROR("xioctl(VIDIOC_QBUF) failed when requesting new frame! fd: " << sync_queue.front()._fd << " error: " << strerror(errno));
-            }
-            sync_queue.pop();
-        }
-
-
-        void v4l2_video_md_syncer::stop()
-        {
-             _is_ready = false;
-             flush_queues();
-        }
-
-        void v4l2_video_md_syncer::flush_queues()
-        {
-            // Empty queues
-            LOG_DEBUG_V4L("video_md_syncer - flush video and md queues");
-            std::lock_guard<std::mutex> lock(_syncer_mutex);
-            while(!_video_queue.empty())
-            {
-                _video_queue.pop();
-            }
-            while(!_md_queue.empty())
-            {
-                _md_queue.pop();
-            }
-            LOG_DEBUG_V4L("video_md_syncer - flush video and md queues done - mq_q size = " << _md_queue.size() << ", video_q size = " << _video_queue.size());
-        }
     }
 }
@@ -7,6 +7,7 @@
 #include <src/platform/uvc-device.h>
 #include <src/metadata.h>
 #include "types.h"
+#include "v4l2-md-syncer.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -254,42 +255,6 @@ namespace librealsense
             virtual void acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds, bool compressed_format) = 0;
         };
 
-        class v4l2_video_md_syncer
-        {
-        public:
-            v4l2_video_md_syncer() : _is_ready(false){}
-
-            struct sync_buffer
-            {
-                std::shared_ptr<v4l2_buffer> _v4l2_buf;
-                int _fd;
-                __u32 _buffer_index;
-            };
-
-            // pushing video buffer to the video queue
-            void push_video(const sync_buffer& video_buffer);
-            // pushing metadata buffer to the metadata queue
-            void push_metadata(const sync_buffer& md_buffer);
-
-            // pulling synced data
-            // if returned value is true - the data could have been pulled
-            // if returned value is false - no data is returned via the inout params because data could not be synced
-            bool pull_video_with_metadata(std::shared_ptr<v4l2_buffer>& video_buffer, std::shared_ptr<v4l2_buffer>& md_buffer, int& video_fd, int& md_fd);
-
-            inline void start() {_is_ready = true;}
-            void stop();
-
-        private:
-            void enqueue_buffer_before_throwing_it(const sync_buffer& sb) const;
-            void enqueue_front_buffer_before_throwing_it(std::queue<sync_buffer>& sync_queue);
-            void flush_queues();
-
-            std::mutex _syncer_mutex;
-            std::queue<sync_buffer> _video_queue;
-            std::queue<sync_buffer> _md_queue;
-            bool _is_ready;
-        };
-
         // The aim of the frame_drop_monitor is to check the frames drops kpi - which requires
         // that no more than some percentage of the frames are dropped
         // It is checked using the fps, and the previous corrupted frames, on the last 30 seconds
@@ -0,0 +1,92 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "iio-sample-batch.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace librealsense
+{
+    namespace platform
+    {
+        // Offset of the HW timestamp (nsec) in a scan with metadata
+        static const size_t hw_timestamp_offset = 16;
+        // No batch spans this long
+        static const uint64_t max_hw_timestamp_spread_ns = 1000000000ull;
+
+        constexpr double iio_sample_batch::max_latency_ms;
+
+        uint32_t iio_sample_batch::watermark( uint32_t frequency, uint32_t buffer_length )
+        {
+            auto const samples = uint32_t( frequency * max_latency_ms / 1000. );
+            return std::max( 1u, std::min( samples, buffer_length / 2 ) );
+        }
+
+        iio_sample_batch::iio_sample_batch( uint32_t channel_size,
+                                            uint32_t metadata_size,
+                                            uint32_t frequency,
+                                            uint32_t buffer_length )
+            : _channel_size( channel_size )
+            , _metadata_size( metadata_size )
+            , _period_ms( frequency ? 1000. / frequency : 0. )
+            , _raw( channel_size * buffer_length )
+            , _samples( buffer_length )
+            , _metadata( buffer_length )
+        {
+        }
+
+        size_t iio_sample_batch::parse( size_t read_size, rs2_time_t now )
+        {
+            auto const n = read_size / _channel_size;
+            if( ! n )
+                return 0;
+
+            // The HW timestamp of the last sample, which was just read
+            uint64_t last_ts = 0;
+            if( _metadata_size )
+                std::memcpy( &last_ts, _raw.data() + _channel_size * ( n - 1 ) + hw_timestamp_offset, sizeof( last_ts ) );
+
+            for( size_t i = 0; i < n; ++i )
+            {
+                auto p_raw_data = _raw.data() + _channel_size * i;
+                auto & fo = _samples[i];
+                fo.frame_size = _channel_size - _metadata_size;
+                fo.pixels = p_raw_data;
+                fo.backend_time = now - ( n - 1 - i ) * _period_ms;
+                if( ! _metadata_size )
+                {
+                    fo.metadata_size = 0;
+                    fo.metadata = nullptr;
+                    continue;
+                }
+
+                // Populate HID IMU data - Header
+                auto & meta_data = _metadata[i];
+                meta_data = {};
+                meta_data.header.report_type = md_hid_report_type::hid_report_imu;
+                meta_data.header.length = hid_header_size + metadata_imu_report_size;
+                uint64_t ts;
+                std::memcpy( &ts, p_raw_data + hw_timestamp_offset, sizeof( ts ) );
+                // Linux HID provides timestamps in nanosec. Convert to usec (FW default)
+                meta_data.header.timestamp = ts / 1000;
+                // Payload:
+                meta_data.report_type.imu_report.header.md_type_id = md_type::META_DATA_HID_IMU_REPORT_ID;
+                meta_data.report_type.imu_report.header.md_size = metadata_imu_report_size;
+
+                fo.metadata_size = meta_data.header.length;
+                fo.metadata = &meta_data;
+                // Out-of-order or distant timestamps (wrap-around, device reset) fall back to the sampling frequency
+                if( ts <= last_ts && last_ts - ts < max_hw_timestamp_spread_ns )
+                    fo.backend_time = now - ( last_ts - ts ) / 1e6;
+            }
+
+            // A batch read late does not reach back before the previous one
+            for( size_t i = 0; i < n && _samples[i].backend_time < _last_backend_time; ++i )
+                _samples[i].backend_time = _last_backend_time;
+            _last_backend_time = now;
+            return n;
+        }
+    }
+}
@@ -0,0 +1,55 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include "../platform/frame-object.h"
+#include "../metadata.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace librealsense
+{
+    namespace platform
+    {
+        // Splits what a single read() of an IIO buffer returned into the samples (scans) it holds.
+        //
+        // With a watermark set, the kernel wakes the reader only once several samples are buffered, so they all arrive
+        // at the same time: the backend time of each is reconstructed back from the time of the read, using the spacing
+        // of their HW timestamps when there is metadata, or the sampling frequency otherwise -- but never back before
+        // the previous batch, should that one have been read late.
+        // All buffers are allocated up-front, so nothing is allocated while streaming.
+        class iio_sample_batch
+        {
+        public:
+            // How long, at most, a sample may wait in the kernel buffer for the rest of its batch
+            static constexpr double max_latency_ms = 5.;
+
+            // Samples to buffer in the kernel before waking the reader (the IIO buffer/watermark attribute), at least one
+            // and no more than half of the buffer, so the kernel does not drop samples while the reader catches up
+            static uint32_t watermark( uint32_t frequency, uint32_t buffer_length );
+
+            // channel_size: of a scan, metadata included; metadata_size: of the metadata at the end of a scan
+            iio_sample_batch( uint32_t channel_size, uint32_t metadata_size, uint32_t frequency, uint32_t buffer_length );
+
+            uint8_t * data() { return _raw.data(); }
+            size_t size() const { return _raw.size(); }
+
+            // Parses the read_size bytes read into data() at now (system time, ms), returning the number of samples
+            size_t parse( size_t read_size, rs2_time_t now );
+
+            const frame_object * samples() const { return _samples.data(); }
+
+        private:
+            uint32_t _channel_size;
+            uint32_t _metadata_size;
+            double _period_ms;
+            rs2_time_t _last_backend_time = 0;  // of the last sample parsed
+            std::vector< uint8_t > _raw;
+            std::vector< frame_object > _samples;
+            std::vector< metadata_hid_raw > _metadata;
+        };
+    }
+}
@@ -2,6 +2,7 @@
 // Copyright(c) 2021 Intel Corporation. All Rights Reserved.
 
 #include "udev-device-watcher.h"
+#include <src/thread-policy.h>
 
 #include <poll.h>
 
@@ -86,6 +87,7 @@ namespace librealsense {
 udev_device_watcher::udev_device_watcher( const platform::backend * backend )
     : _backend( backend )
     , _active_object( [this]( dispatcher::cancellable_timer timer ) {
+        thread_policy::apply( thread_role::device_watcher );
         struct pollfd fds;
         fds.fd = _udev_monitor_fd;
         fds.events = POLLIN;
@@ -0,0 +1,107 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "v4l2-md-syncer.h"
+
+
+namespace librealsense
+{
+    namespace platform
+    {
+        constexpr size_t v4l2_video_md_syncer::max_pending;
+
+        v4l2_video_md_syncer::v4l2_video_md_syncer( enqueue_callback enqueue )
+            : _enqueue( std::move( enqueue ) )
+        {
+        }
+
+        void v4l2_video_md_syncer::push_video( const v4l2_buffer & buf, int fd )
+        {
+            std::lock_guard< std::mutex > lock( _syncer_mutex );
+            if( ! _is_ready )
+                return;
+            push( _video_queue, buf, fd );
+        }
+
+        void v4l2_video_md_syncer::push_metadata( const v4l2_buffer & buf, int fd )
+        {
+            std::lock_guard< std::mutex > lock( _syncer_mutex );
+            if( ! _is_ready )
+                return;
+            push( _md_queue, buf, fd );
+        }
+
+        void v4l2_video_md_syncer::push( sync_ring & ring, const v4l2_buffer & buf, int fd )
+        {
+            // A buffer with the same sequence as the last one replaces it - happens with metadata sequence 0
+            if( ! ring.empty() && ring.back().buf.sequence == buf.sequence )
+            {
+                auto last = ring.back();
+                ring.pop_back();
+                ++_dropped;
+                if( _enqueue )
+                    _enqueue( last.fd, last.buf );
+            }
+            // remove the oldest buffer to make room
+            if( ring.size() == max_pending )
+                drop_front( ring );
+            ring.push( buf, fd );
+        }
+
+        bool v4l2_video_md_syncer::pull_video_with_metadata( v4l2_buffer & video_buffer, v4l2_buffer & md_buffer,
+                                                             int & video_fd, int & md_fd )
+        {
+            std::lock_guard< std::mutex > lock( _syncer_mutex );
+            if( ! _is_ready )
+                return false;
+
+            // Each node dequeues in sequence order, so a front buffer older than the other stream's front can no longer
+            // be paired: its counterpart was dropped by the kernel (or by us)
+            while( ! _video_queue.empty() && ! _md_queue.empty() )
+            {
+                auto const video_sequence = _video_queue.front().buf.sequence;
+                auto const md_sequence = _md_queue.front().buf.sequence;
+                if( video_sequence == md_sequence )
+                {
+                    auto & video = _video_queue.front();
+                    auto & md = _md_queue.front();
+                    video_buffer = video.buf;
+                    video_fd = video.fd;
+                    md_buffer = md.buf;
+                    md_fd = md.fd;
+                    _video_queue.pop();
+                    _md_queue.pop();
+                    return true;
+                }
+                drop_front( video_sequence < md_sequence ? _video_queue : _md_queue );
+            }
+            return false;
+        }
+
+        void v4l2_video_md_syncer::drop_front( sync_ring & ring )
+        {
+            // Enqueue of buffer before throwing its content away
+            auto & front = ring.front();
+            ++_dropped;
+            if( _enqueue )
+                _enqueue( front.fd, front.buf );
+            ring.pop();
+        }
+
+        void v4l2_video_md_syncer::start()
+        {
+            std::lock_guard< std::mutex > lock( _syncer_mutex );
+            _dropped = 0;
+            _is_ready = true;
+        }
+
+        void v4l2_video_md_syncer::stop()
+        {
+            // Empty queues: the buffers are reclaimed by the kernel when streaming stops
+            std::lock_guard< std::mutex > lock( _syncer_mutex );
+            _is_ready = false;
+            _video_queue.clear();
+            _md_queue.clear();
+        }
+    }
+}
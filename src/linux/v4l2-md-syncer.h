@@ -0,0 +1,93 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <linux/videodev2.h>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+
+
+namespace librealsense
+{
+    namespace platform
+    {
+        // Pairs video and metadata buffers, dequeued separately from their nodes, by their V4L2 sequence number.
+        // Buffers are held by value in fixed-size rings, so nothing is allocated once streaming: a pending buffer is
+        // the V4L2 descriptor of a kernel buffer (by index) that has not been given back to the kernel yet. Any
+        // buffer that can no longer be paired is given back (see enqueue_callback) before it is forgotten.
+        class v4l2_video_md_syncer
+        {
+        public:
+            // Returns a dropped buffer to the kernel (VIDIOC_QBUF on its node)
+            typedef std::function< void( int fd, v4l2_buffer & buf ) > enqueue_callback;
+
+            // How many buffers of each stream wait for their counterpart; any older one is dropped
+            static constexpr size_t max_pending = 2;
+
+            explicit v4l2_video_md_syncer( enqueue_callback enqueue );
+
+            // pushing video buffer to the video queue
+            void push_video( const v4l2_buffer & buf, int fd );
+            // pushing metadata buffer to the metadata queue
+            void push_metadata( const v4l2_buffer & buf, int fd );
+
+            // pulling synced data
+            // if returned value is true - the data could have been pulled
+            // if returned value is false - no data is returned via the inout params because data could not be synced
+            bool pull_video_with_metadata( v4l2_buffer & video_buffer, v4l2_buffer & md_buffer, int & video_fd, int & md_fd );
+
+            void start();
+            void stop();
+
+            // Number of buffers dropped (given back to the kernel) since start()
+            size_t dropped() const { return _dropped; }
+
+        private:
+            struct sync_buffer
+            {
+                v4l2_buffer buf;
+                int fd;
+            };
+
+            // A FIFO of at most max_pending buffers
+            class sync_ring
+            {
+            public:
+                size_t size() const { return _size; }
+                bool empty() const { return ! _size; }
+                sync_buffer & front() { return _slots[_head]; }
+                sync_buffer & back() { return _slots[( _head + _size - 1 ) % max_pending]; }
+                void push( const v4l2_buffer & buf, int fd )
+                {
+                    _slots[( _head + _size ) % max_pending] = { buf, fd };
+                    ++_size;
+                }
+                void pop()
+                {
+                    _head = ( _head + 1 ) % max_pending;
+                    --_size;
+                }
+                void pop_back() { --_size; }
+                void clear() { _head = _size = 0; }
+
+            private:
+                std::array< sync_buffer, max_pending > _slots;
+                size_t _head = 0;
+                size_t _size = 0;
+            };
+
+            void push( sync_ring & ring, const v4l2_buffer & buf, int fd );
+            void drop_front( sync_ring & ring );
+
+            enqueue_callback _enqueue;
+            std::mutex _syncer_mutex;
+            sync_ring _video_queue;
+            sync_ring _md_queue;
+            size_t _dropped = 0;
+            bool _is_ready = false;
+        };
+    }
+}
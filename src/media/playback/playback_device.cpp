@@ -9,6 +9,7 @@
 #include "media/ros/ros_reader.h"
 #include "environment.h"
 #include "sync.h"
+#include <src/thread-policy.h>
 #include <src/depth-sensor.h>
 #include <src/color-sensor.h>
 #include <src/pose.h>
@@ -49,6 +50,7 @@ playback_device::playback_device( std::shared_ptr< const device_info > const & d
 
     m_reader = serializer;
     (*m_read_thread)->start();
+    (*m_read_thread)->invoke( []( dispatcher::cancellable_timer ) { thread_policy::apply( thread_role::playback ); } );
 
     //Read header and build device from recorded device snapshot
     m_device_description = m_reader->query_device_description(nanoseconds(0));
@@ -6,6 +6,7 @@
 #include "core/motion.h"
 #include <map>
 #include "types.h"
+#include <src/thread-policy.h>
 #include "ds/d400/d400-options.h"
 #include "media/ros/ros_reader.h"
 
@@ -89,15 +90,17 @@ void playback_sensor::open(const stream_profiles& requests)
     //For each stream, create a dedicated dispatching thread
     for (auto&& profile : requests)
     {
-        auto on_drop_callback = [profile]( dispatcher::action act ) {
+        auto on_drop_callback = [profile]( rsutils::concurrency::inline_action const & ) {
             LOG_DEBUG( "Dropping frame from dispatcher " << profile_to_string( profile ) );
         };
 
         m_dispatchers.emplace( std::make_pair(
             profile->get_unique_id(),
-            std::make_shared< dispatcher >( _default_queue_size, on_drop_callback ) ) );
+            std::make_shared< rsutils::concurrency::inline_dispatcher >( _default_queue_size, on_drop_callback ) ) );
 
         m_dispatchers[profile->get_unique_id()]->start();
+        m_dispatchers[profile->get_unique_id()]->invoke(
+            []( dispatcher::cancellable_timer ) { thread_policy::apply( thread_role::playback ); } );
 
         device_serializer::stream_identifier f{ get_device_index(), m_sensor_id, profile->get_stream_type(), static_cast<uint32_t>(profile->get_stream_index()) };
         opened_streams.push_back(f);
@@ -10,6 +10,7 @@
 #include "../../types.h"
 
 #include <rsutils/signal.h>
+#include <rsutils/concurrency/inline-dispatcher.h>
 
 
 namespace librealsense
@@ -95,7 +96,7 @@ namespace librealsense
         rs2_frame_callback_sptr m_user_callback;
         notifications_processor _notifications_processor;
         using stream_unique_id = int;
-        std::map<stream_unique_id, std::shared_ptr<dispatcher>> m_dispatchers;
+        std::map<stream_unique_id, std::shared_ptr<rsutils::concurrency::inline_dispatcher>> m_dispatchers;
         std::atomic<bool> m_is_started;
         device_serializer::sensor_snapshot m_sensor_description;
         uint32_t m_sensor_id;
@@ -129,16 +130,15 @@ namespace librealsense
                 frame->set_stream(m_streams[std::make_pair(type, index)]);
                 frame->set_sensor(shared_from_this());
                 auto stream_id = frame.frame->get_stream()->get_unique_id();
-                //TODO: Ziv, remove usage of shared_ptr when frame_holder is cpoyable
-                auto pf = std::make_shared<frame_holder>(std::move(frame));
 
-                auto callback = [this, is_real_time, stream_id, pf, calc_sleep, is_paused, update_last_pushed_frame](dispatcher::cancellable_timer t)
+                // The dispatcher holds the callback inline, frame and all: no allocation per frame
+                auto callback = [this, is_real_time, stream_id, pf = std::move(frame), calc_sleep, is_paused, update_last_pushed_frame](dispatcher::cancellable_timer t) mutable
                 {                  
                     device_serializer::nanoseconds sleep_for = calc_sleep();
                     if (sleep_for.count() > 0)
                         t.try_sleep( sleep_for );
 
-                    LOG_DEBUG("callback--> "<< *pf);
+                    LOG_DEBUG("callback--> "<< pf);
 
                     frame_interface* pframe = nullptr;
 
@@ -148,7 +148,7 @@ namespace librealsense
                     if (is_paused())
                         return;
 
-                    std::swap((*pf).frame, pframe);
+                    std::swap(pf.frame, pframe);
                     
                     // We want to make sure that we have a valid reference to this shared_ptr so if
                     // "reset()" it will not destroy the object
@@ -159,7 +159,7 @@ namespace librealsense
                     update_last_pushed_frame();
                     
                 };
-                m_dispatchers.at(stream_id)->invoke(callback, !is_real_time);
+                m_dispatchers.at(stream_id)->invoke(std::move(callback), !is_real_time);
 
                 // On non-real-time, we want the playback to run in synchronous mode:
                 // The playback will dispatch each frame and wait for it callback to finish before
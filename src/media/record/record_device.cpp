@@ -6,6 +6,7 @@
 #include <core/advanced_mode.h>
 #include "record_device.h"
 #include <src/platform/backend-device-group.h>
+#include <src/thread-policy.h>
 
 using namespace librealsense;
 
@@ -28,6 +29,7 @@ librealsense::record_device::record_device(std::shared_ptr<librealsense::device_
     m_device = device;
     m_ros_writer = serializer;
     (*m_write_thread)->start(); //Start thread before creating the sensors (since they might write right away)
+    (*m_write_thread)->invoke( []( dispatcher::cancellable_timer ) { thread_policy::apply( thread_role::record ); } );
     m_sensors = create_record_sensors(m_device);
     LOG_DEBUG("Created record_device");
 }
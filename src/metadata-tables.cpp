@@ -0,0 +1,14 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "metadata-tables.h"
+
+
+namespace librealsense
+{
+    constexpr md_field md_layout< md_capture_timing >::fields[];
+    constexpr md_field md_layout< md_capture_stats >::fields[];
+    constexpr md_field md_layout< md_depth_control >::fields[];
+    constexpr md_field md_layout< md_rgb_control >::fields[];
+    constexpr md_field md_layout< md_configuration >::fields[];
+}
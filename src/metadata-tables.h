@@ -0,0 +1,318 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+// Metadata layouts described as constant tables
+//
+// Each metadata struct of src/metadata.h that has a table describes, once, which of its attributes provide which
+// frame metadata values: where the attribute is, the flag that validates it, and how its raw value is adjusted. From
+// the table we get both the per-attribute parsers the sensors register, and a decoder of all attributes of a struct at
+// once, with the struct header validated only once and no per-attribute branching. The parsers decode each struct of a
+// frame once, the first time any of its attributes is asked for, and then only look up their value.
+
+#include "metadata-parser.h"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+
+namespace librealsense
+{
+    /**\brief Post-processing adjustment of a raw attribute, as a table can describe it */
+    enum class md_field_transform : uint8_t
+    {
+        none,
+        as_short,  // low 16 bits, sign-extended: for attributes that can be negative
+        is_one,    // 1 if the attribute is 1, 0 otherwise
+        bits       // ( attribute & mask ) >> shift
+    };
+
+    /**\brief One attribute of a metadata struct, and the frame metadata value it provides */
+    struct md_field
+    {
+        rs2_frame_metadata_value key;
+        uint32_t flag;       // Bit in the struct's flags that indicates whether the attribute is active
+        uint16_t offset;     // Of the attribute within the struct
+        uint8_t size;        // Of the attribute, in bytes
+        bool is_signed;
+        md_field_transform transform;
+        uint32_t mask;       // For md_field_transform::bits
+        uint8_t shift;
+    };
+
+    constexpr md_field md_transformed( md_field field, md_field_transform transform, uint32_t mask = 0, uint8_t shift = 0 )
+    {
+        field.transform = transform;
+        field.mask = mask;
+        field.shift = shift;
+        return field;
+    }
+
+#define MD_FIELD( S, attribute, flag, key )                                                                            \
+    librealsense::md_field{ static_cast< rs2_frame_metadata_value >( key ),                                           \
+                            static_cast< uint32_t >( flag ),                                                           \
+                            static_cast< uint16_t >( offsetof( S, attribute ) ),                                       \
+                            static_cast< uint8_t >( sizeof( S::attribute ) ),                                          \
+                            std::is_signed< decltype( S::attribute ) >::value,                                         \
+                            librealsense::md_field_transform::none,                                                    \
+                            0,                                                                                         \
+                            0 }
+
+    /**\brief md_layout - the table of attributes of metadata struct S, as 'static constexpr md_field fields[]', and
+     *  the slot its decoded values take in a frame's md_decode_cache, as 'static constexpr int slot'.
+     *  Specialized below for every struct that has one; the tables are defined in metadata-tables.cpp */
+    template< class S >
+    struct md_layout;
+
+    template<>
+    struct md_layout< md_capture_timing >
+    {
+        static constexpr int slot = 0;  // in md_decode_cache
+        static constexpr md_field fields[] = {
+            // sensor_timestamp holds only an offset from the frame timestamp: see md_rs400_sensor_timestamp
+            MD_FIELD( md_capture_timing, frame_counter, md_capture_timing_attributes::frame_counter_attribute, RS2_FRAME_METADATA_FRAME_COUNTER ),
+        };
+    };
+
+    template<>
+    struct md_layout< md_capture_stats >
+    {
+        static constexpr int slot = 1;  // in md_decode_cache
+        static constexpr md_field fields[] = {
+            MD_FIELD( md_capture_stats, white_balance, md_capture_stat_attributes::white_balance_attribute, RS2_FRAME_METADATA_WHITE_BALANCE ),
+        };
+    };
+
+    template<>
+    struct md_layout< md_depth_control >
+    {
+        static constexpr int slot = 2;  // in md_decode_cache
+        static constexpr md_field fields[] = {
+            MD_FIELD( md_depth_control, manual_gain, md_depth_control_attributes::gain_attribute, RS2_FRAME_METADATA_GAIN_LEVEL ),
+            MD_FIELD( md_depth_control, manual_exposure, md_depth_control_attributes::exposure_attribute, RS2_FRAME_METADATA_ACTUAL_EXPOSURE ),
+            MD_FIELD( md_depth_control, auto_exposure_mode, md_depth_control_attributes::ae_mode_attribute, RS2_FRAME_METADATA_AUTO_EXPOSURE ),
+            MD_FIELD( md_depth_control, laser_power, md_depth_control_attributes::laser_pwr_attribute, RS2_FRAME_METADATA_FRAME_LASER_POWER ),
+            // starting at version 2.30.1 this control is superceeded by RS2_FRAME_METADATA_FRAME_EMITTER_MODE
+            md_transformed( MD_FIELD( md_depth_control, emitterMode, md_depth_control_attributes::emitter_mode_attribute, RS2_FRAME_METADATA_FRAME_LASER_POWER_MODE ),
+                            md_field_transform::is_one ),
+            MD_FIELD( md_depth_control, exposure_priority, md_depth_control_attributes::exposure_priority_attribute, RS2_FRAME_METADATA_EXPOSURE_PRIORITY ),
+            MD_FIELD( md_depth_control, exposure_roi_left, md_depth_control_attributes::roi_attribute, RS2_FRAME_METADATA_EXPOSURE_ROI_LEFT ),
+            MD_FIELD( md_depth_control, exposure_roi_right, md_depth_control_attributes::roi_attribute, RS2_FRAME_METADATA_EXPOSURE_ROI_RIGHT ),
+            MD_FIELD( md_depth_control, exposure_roi_top, md_depth_control_attributes::roi_attribute, RS2_FRAME_METADATA_EXPOSURE_ROI_TOP ),
+            MD_FIELD( md_depth_control, exposure_roi_bottom, md_depth_control_attributes::roi_attribute, RS2_FRAME_METADATA_EXPOSURE_ROI_BOTTOM ),
+            MD_FIELD( md_depth_control, emitterMode, md_depth_control_attributes::emitter_mode_attribute, RS2_FRAME_METADATA_FRAME_EMITTER_MODE ),
+            MD_FIELD( md_depth_control, ledPower, md_depth_control_attributes::led_power_attribute, RS2_FRAME_METADATA_FRAME_LED_POWER ),
+        };
+    };
+
+    template<>
+    struct md_layout< md_rgb_control >
+    {
+        static constexpr int slot = 3;  // in md_decode_cache
+        // ae_mode is interpreted differently by different devices and firmware versions, so it is not in the table
+        static constexpr md_field fields[] = {
+            MD_FIELD( md_rgb_control, gain, md_rgb_control_attributes::gain_attribute, RS2_FRAME_METADATA_GAIN_LEVEL ),
+            MD_FIELD( md_rgb_control, manual_exp, md_rgb_control_attributes::manual_exp_attribute, RS2_FRAME_METADATA_ACTUAL_EXPOSURE ),
+            md_transformed( MD_FIELD( md_rgb_control, brightness, md_rgb_control_attributes::brightness_attribute, RS2_FRAME_METADATA_BRIGHTNESS ),
+                            md_field_transform::as_short ),
+            MD_FIELD( md_rgb_control, contrast, md_rgb_control_attributes::contrast_attribute, RS2_FRAME_METADATA_CONTRAST ),
+            MD_FIELD( md_rgb_control, saturation, md_rgb_control_attributes::saturation_attribute, RS2_FRAME_METADATA_SATURATION ),
+            MD_FIELD( md_rgb_control, sharpness, md_rgb_control_attributes::sharpness_attribute, RS2_FRAME_METADATA_SHARPNESS ),
+            MD_FIELD( md_rgb_control, awb_temp, md_rgb_control_attributes::awb_temp_attribute, RS2_FRAME_METADATA_AUTO_WHITE_BALANCE_TEMPERATURE ),
+            MD_FIELD( md_rgb_control, backlight_comp, md_rgb_control_attributes::backlight_comp_attribute, RS2_FRAME_METADATA_BACKLIGHT_COMPENSATION ),
+            MD_FIELD( md_rgb_control, gamma, md_rgb_control_attributes::gamma_attribute, RS2_FRAME_METADATA_GAMMA ),
+            md_transformed( MD_FIELD( md_rgb_control, hue, md_rgb_control_attributes::hue_attribute, RS2_FRAME_METADATA_HUE ),
+                            md_field_transform::as_short ),
+            MD_FIELD( md_rgb_control, manual_wb, md_rgb_control_attributes::manual_wb_attribute, RS2_FRAME_METADATA_MANUAL_WHITE_BALANCE ),
+            MD_FIELD( md_rgb_control, power_line_frequency, md_rgb_control_attributes::power_line_frequency_attribute, RS2_FRAME_METADATA_POWER_LINE_FREQUENCY ),
+            MD_FIELD( md_rgb_control, low_light_comp, md_rgb_control_attributes::low_light_comp_attribute, RS2_FRAME_METADATA_LOW_LIGHT_COMPENSATION ),
+        };
+    };
+
+    template<>
+    struct md_layout< md_configuration >
+    {
+        static constexpr int slot = 4;  // in md_decode_cache
+        static constexpr md_field fields[] = {
+            MD_FIELD( md_configuration, hw_type, md_configuration_attributes::hw_type_attribute, RS2_FRAME_METADATA_HW_TYPE ),
+            MD_FIELD( md_configuration, sku_id, md_configuration_attributes::sku_id_attribute, RS2_FRAME_METADATA_SKU_ID ),
+            MD_FIELD( md_configuration, format, md_configuration_attributes::format_attribute, RS2_FRAME_METADATA_FORMAT ),
+            MD_FIELD( md_configuration, width, md_configuration_attributes::width_attribute, RS2_FRAME_METADATA_WIDTH ),
+            MD_FIELD( md_configuration, height, md_configuration_attributes::height_attribute, RS2_FRAME_METADATA_HEIGHT ),
+            MD_FIELD( md_configuration, gpioInputData, md_configuration_attributes::gpio_input_data_attribute, RS2_FRAME_METADATA_GPIO_INPUT_DATA ),
+            md_transformed( MD_FIELD( md_configuration, sub_preset_info, md_configuration_attributes::sub_preset_info_attribute, RS2_FRAME_METADATA_SEQUENCE_SIZE ),
+                            md_field_transform::bits,
+                            md_configuration::SUB_PRESET_BIT_MASK_SEQUENCE_SIZE,
+                            md_configuration::SUB_PRESET_BIT_OFFSET_SEQUENCE_SIZE ),
+            md_transformed( MD_FIELD( md_configuration, sub_preset_info, md_configuration_attributes::sub_preset_info_attribute, RS2_FRAME_METADATA_SEQUENCE_ID ),
+                            md_field_transform::bits,
+                            md_configuration::SUB_PRESET_BIT_MASK_SEQUENCE_ID,
+                            md_configuration::SUB_PRESET_BIT_OFFSET_SEQUENCE_ID ),
+            md_transformed( MD_FIELD( md_configuration, sub_preset_info, md_configuration_attributes::sub_preset_info_attribute, RS2_FRAME_METADATA_SEQUENCE_NAME ),
+                            md_field_transform::bits,
+                            md_configuration::SUB_PRESET_BIT_MASK_ID,
+                            md_configuration::SUB_PRESET_BIT_OFFSET_ID ),
+        };
+    };
+
+#undef MD_FIELD
+
+    template< class S >
+    constexpr size_t md_layout_size()
+    {
+        return std::extent< decltype( md_layout< S >::fields ) >::value;
+    }
+
+    /**\brief Whether 's' holds a struct of type S: the header matches the type and is big enough */
+    template< class S >
+    bool md_struct_valid( const uint8_t * s )
+    {
+        md_header header;
+        std::memcpy( &header, s, sizeof( header ) );
+        return ( header.md_type_id == md_type_trait< S >::type ) & ( header.md_size >= sizeof( S ) );
+    }
+
+    /**\brief The (adjusted) value of an attribute within the struct at 's'
+     *  Metadata is little-endian, like all the platforms we run on */
+    inline rs2_metadata_type md_field_value( md_field const & field, const uint8_t * s )
+    {
+        uint64_t raw = 0;
+        std::memcpy( &raw, s + field.offset, field.size );
+        if( field.is_signed && field.size < sizeof( raw ) )
+        {
+            uint64_t const sign = uint64_t( 1 ) << ( field.size * 8 - 1 );
+            raw = ( raw ^ sign ) - sign;
+        }
+        auto value = static_cast< rs2_metadata_type >( raw );
+        switch( field.transform )
+        {
+        case md_field_transform::as_short:
+            return static_cast< int16_t >( static_cast< uint16_t >( value ) );
+        case md_field_transform::is_one:
+            return value == 1 ? 1 : 0;
+        case md_field_transform::bits:
+            return ( value & field.mask ) >> field.shift;
+        default:
+            return value;
+        }
+    }
+
+    namespace detail
+    {
+        // Decodes fields[I]: the field being a constant, this is a single load and mask
+        template< class S, size_t I >
+        void md_decode_field( const uint8_t * s, rs2_metadata_type * values )
+        {
+            constexpr md_field field = md_layout< S >::fields[I];
+            values[I] = md_field_value( field, s );
+        }
+
+        template< class S, size_t... I >
+        void md_decode_fields( const uint8_t * s, rs2_metadata_type * values, std::index_sequence< I... > )
+        {
+            int expand[] = { 0, ( md_decode_field< S, I >( s, values ), 0 )... };
+            (void)expand;
+        }
+    }
+
+    /**\brief Decodes all the attributes in the table of S, from the S at 's', into 'values' (in table order) and its
+     *  flags into 'flags'. Returns false, leaving both untouched, if 's' does not hold an S */
+    template< class S >
+    bool md_decode( const uint8_t * s, uint32_t & flags, rs2_metadata_type * values )
+    {
+        if( ! md_struct_valid< S >( s ) )
+            return false;
+        std::memcpy( &flags, s + offsetof( S, flags ), sizeof( flags ) );
+        detail::md_decode_fields< S >( s, values, std::make_index_sequence< md_layout_size< S >() >() );
+        return true;
+    }
+
+    /**\brief A parser of one attribute from the table of S, for sensors to register
+     *  The first parser of S to be asked decodes the whole S into the frame's md_decode_cache; the rest look it up */
+    template< class S >
+    class md_table_attribute_parser : public md_attribute_parser_base
+    {
+        static_assert( md_layout< S >::slot < md_decode_cache::max_structs, "not enough md_decode_cache slots" );
+        static_assert( md_layout_size< S >() <= md_decode_cache::max_fields, "not enough md_decode_cache fields" );
+
+    public:
+        md_table_attribute_parser( size_t index, unsigned long long offset )
+            : _field( md_layout< S >::fields[index] )
+            , _index( index )
+            , _offset( offset )
+        {
+        }
+
+        bool find( const frame & frm, rs2_metadata_type * p_value ) const override
+        {
+            auto s = frm.additional_data.metadata_blob.data() + _offset;
+            auto & decoded = frm.additional_data.md_decoded[md_layout< S >::slot];
+            auto state = decoded.state.load( std::memory_order_acquire );
+            if( state == md_decode_cache::not_decoded
+                && decoded.state.compare_exchange_strong( state, md_decode_cache::decoding, std::memory_order_acquire ) )
+            {
+                decoded.offset = _offset;
+                state = md_decode< S >( s, decoded.flags, decoded.values ) ? md_decode_cache::decoded
+                                                                           : md_decode_cache::not_present;
+                decoded.state.store( state, std::memory_order_release );
+            }
+
+            uint32_t flags;
+            rs2_metadata_type value;
+            if( state == md_decode_cache::decoded && decoded.offset == _offset )
+            {
+                flags = decoded.flags;
+                value = decoded.values[_index];
+            }
+            else if( state != md_decode_cache::not_present || decoded.offset != _offset )
+            {
+                // Still being decoded by another thread, or decoded from elsewhere in the blob
+                if( ! md_struct_valid< S >( s ) )
+                    return mismatch();
+                std::memcpy( &flags, s + offsetof( S, flags ), sizeof( flags ) );
+                value = md_field_value( _field, s );
+            }
+            else
+                return mismatch();
+
+            if( ! ( flags & _field.flag ) )
+                return false;
+            if( p_value )
+                *p_value = value;
+            return true;
+        }
+
+    private:
+        static bool mismatch()
+        {
+            md_type expected_type = md_type_trait< S >::type;
+            LOG_DEBUG( "Metadata mismatch - expected: " << md_type_desc.at( expected_type ) );
+            return false;
+        }
+
+        md_field _field;
+        size_t _index;               // Of the field in the table
+        unsigned long long _offset;  // Of the struct within the metadata blob
+    };
+
+    /**\brief Registers a parser with 'sensor' for each attribute in the table of S, of the S at 'offset' within the
+     *  metadata blob, for which 'include(key)' is true */
+    template< class S, class Sensor, class Predicate >
+    void register_md_layout( Sensor const & sensor, unsigned long long offset, Predicate && include )
+    {
+        for( size_t i = 0; i < md_layout_size< S >(); ++i )
+        {
+            auto const key = md_layout< S >::fields[i].key;
+            if( include( key ) )
+                sensor.register_metadata( key, std::make_shared< md_table_attribute_parser< S > >( i, offset ) );
+        }
+    }
+
+    template< class S, class Sensor >
+    void register_md_layout( Sensor const & sensor, unsigned long long offset )
+    {
+        register_md_layout< S >( sensor, offset, []( rs2_frame_metadata_value ) { return true; } );
+    }
+}
@@ -69,9 +69,16 @@ namespace librealsense
         std::shared_ptr<profile> config::get_cached_resolved_profile()
         {
             std::lock_guard<std::mutex> lock(_mtx);
+            if (!is_resolved_profile_valid())
+                _resolved_profile.reset();
             return _resolved_profile;
         }
 
+        bool config::is_resolved_profile_valid() const
+        {
+            return _resolved_profile && !*_devices_changed;
+        }
+
         void config::disable_stream(rs2_stream stream, int index)
         {
             std::lock_guard<std::mutex> lock(_mtx);
@@ -188,8 +195,26 @@ namespace librealsense
         std::shared_ptr<profile> config::resolve(std::shared_ptr<pipeline> pipe, const std::chrono::milliseconds& timeout)
         {
             std::lock_guard<std::mutex> lock(_mtx);
+            auto ctx = pipe->get_context();
+            // A recording profile writes to its file, so it is never reused
+            if (is_resolved_profile_valid() && _resolved_context.lock() == ctx && _device_request.record_output.empty())
+                return _resolved_profile;
             _resolved_profile.reset();
 
+            // Any device change from here on may change the result. The flag is shared rather than the callback taking
+            // our lock: devices may be added from within this function (playback) and the callback could outlive us.
+            if (_resolved_context.lock() != ctx)
+            {
+                auto devices_changed = _devices_changed;
+                _devices_changed_subscription = ctx->on_device_changes(
+                    [devices_changed](std::vector<std::shared_ptr<device_info>> const&, std::vector<std::shared_ptr<device_info>> const&)
+                    {
+                        *devices_changed = true;
+                    });
+                _resolved_context = ctx;
+            }
+            *_devices_changed = false;
+
             //Resolve the the device that was specified by the user, this call will wait in case the device is not availabe.
             auto requested_device = resolve_device_requests(pipe, timeout);
             if (requested_device != nullptr)
@@ -232,6 +257,9 @@ namespace librealsense
             try
             {    // Try to resolve from connected devices. Non-blocking call
                 resolve(pipe);
+
+                // Nobody asked for the result: don't keep its device (or playback file, or recorder) open for it
+                std::lock_guard<std::mutex> lock(_mtx);
                 _resolved_profile.reset();
             }
             catch (const std::exception& e)
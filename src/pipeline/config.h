@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <utility>
 
 #include "resolver.h"
+#include <rsutils/subscription.h>
 
 namespace librealsense
 {
@@ -43,6 +45,8 @@ namespace librealsense
                 _playback_loop = other._playback_loop;
             }
         private:
+            bool is_resolved_profile_valid() const;
+
             struct device_request
             {
                 std::string serial;
@@ -60,6 +64,11 @@ namespace librealsense
             std::mutex _mtx;
             bool _enable_all_streams = false;
             std::shared_ptr<profile> _resolved_profile;
+            // The resolved profile is kept until the request changes or any device is added or removed, so restarting
+            // a pipeline does not resolve again (can_resolve does not keep it, as it would keep its device open)
+            std::weak_ptr<context> _resolved_context;
+            std::shared_ptr<std::atomic<bool>> _devices_changed = std::make_shared<std::atomic<bool>>(false);
+            rsutils::subscription _devices_changed_subscription;
             bool _playback_loop = false;
             std::vector<std::pair<rs2_stream, int>> _streams_to_disable;
         };
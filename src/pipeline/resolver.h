@@ -25,6 +25,43 @@ namespace librealsense
             highest_framerate,
         };
 
+        // The profiles of a sensor, bucketed by stream type, each bucket in the original order of the profiles.
+        //
+        // Any profile matching a request for a specific stream type is in that stream's bucket, so the first match in
+        // the bucket is also the first match in the whole list, and resolving a request only needs to look at the
+        // profiles of its own stream. Requests for any stream (and sensors reporting profiles for any stream) use the
+        // whole list.
+        class profile_index
+        {
+        public:
+            explicit profile_index( stream_profiles profiles )
+                : _all( std::move( profiles ) )
+            {
+                for( auto & p : _all )
+                {
+                    auto stream = p->get_stream_type();
+                    if( stream == RS2_STREAM_ANY )
+                        _has_any = true;
+                    _by_stream[stream].push_back( p );
+                }
+            }
+
+            // The profiles that may match a request for the given stream
+            const stream_profiles & candidates( rs2_stream stream ) const
+            {
+                if( stream == RS2_STREAM_ANY || _has_any )
+                    return _all;
+                auto it = _by_stream.find( stream );
+                return it == _by_stream.end() ? _none : it->second;
+            }
+
+        private:
+            stream_profiles _all;
+            std::map< rs2_stream, stream_profiles > _by_stream;
+            stream_profiles _none;
+            bool _has_any = false;
+        };
+
         class config
         {
         public:
@@ -345,12 +382,12 @@ namespace librealsense
                 return sort_highest_framerate(lhs, rhs);
             }
 
-            static void auto_complete(std::vector<stream_profile> &requests, stream_profiles candidates, const device_interface* dev)
+            static void auto_complete(std::vector<stream_profile> &requests, const profile_index & profiles, const device_interface* dev)
             {
                 for (auto & request : requests)
                 {
                     if (!has_wildcards(request)) continue;
-                    for (auto candidate : candidates)
+                    for (auto & candidate : profiles.candidates(request.stream))
                     {
                         if (match(candidate.get(), request) && !dev->contradicts(candidate.get(), requests))
                         {
@@ -383,7 +420,7 @@ namespace librealsense
                 return r;
             }
 
-            stream_profiles map_sub_device(stream_profiles profiles,const device_interface* dev) const
+            stream_profiles map_sub_device(const profile_index & profiles, const device_interface* dev) const
             {
                 stream_profiles rv;
                 std::set<index_type> satisfied_streams;
@@ -397,11 +434,12 @@ namespace librealsense
                         if (satisfied_streams.count(kvp.first)) continue; // skip satisfied requests
 
                          // if any profile on the subdevice can supply this request, consider it satisfiable
-                        auto it = std::find_if(begin(profiles), end(profiles), [&kvp](const std::shared_ptr<stream_profile_interface>& profile)
+                        auto & candidates = profiles.candidates(kvp.second.stream);
+                        auto it = std::find_if(begin(candidates), end(candidates), [&kvp](const std::shared_ptr<stream_profile_interface>& profile)
                         {
                             return match(profile.get(), kvp.second);
                         });
-                        if (it != end(profiles))
+                        if (it != end(candidates))
                         {
                             targets.push_back(kvp.second); // store that this request is going to this subdevice
                             satisfied_streams.insert(kvp.first); // mark stream as satisfied
@@ -414,7 +452,7 @@ namespace librealsense
 
                         for (auto && t : targets)
                         {
-                            for (auto && p : profiles)
+                            for (auto && p : profiles.candidates(t.stream))
                             {
                                 if (match(p.get(), t))
                                 {
@@ -442,8 +480,8 @@ namespace librealsense
                 {
                     auto&& sub = dev->get_sensor(i);
 
-                    auto default_profiles = map_sub_device(sub.get_stream_profiles(profile_tag::PROFILE_TAG_SUPERSET), dev);
-                    auto any_profiles = map_sub_device(sub.get_stream_profiles(profile_tag::PROFILE_TAG_ANY), dev);
+                    auto default_profiles = map_sub_device(profile_index(sub.get_stream_profiles(profile_tag::PROFILE_TAG_SUPERSET)), dev);
+                    auto any_profiles = map_sub_device(profile_index(sub.get_stream_profiles(profile_tag::PROFILE_TAG_ANY)), dev);
 
                     //use any streams if default streams wasn't satisfy
                     auto profiles = default_profiles.size() == any_profiles.size() ? default_profiles : any_profiles;
@@ -39,6 +39,10 @@ struct sensor_data
 {
     hid_sensor sensor;
     frame_object fo;
+    // A backend that reads several samples at once delivers them in a single callback: all of them, in order, with fo
+    // being the first. Otherwise fo is the only sample.
+    const frame_object * samples = nullptr;
+    size_t sample_count = 0;
 };
 
 #pragma pack( push, 1 )
@@ -5,6 +5,7 @@
 #include "core/video.h"
 #include "core/video-frame.h"
 #include "core/frame-holder.h"
+#include "proc/organized-mesh.h"
 #include "librealsense-exception.h"
 #include <fstream>
 #include <cmath>
@@ -47,7 +48,7 @@ void points::export_to_ply( const std::string & fname, const frame_holder & text
     const auto texcoords = get_texture_coordinates();
     std::vector< float3 > new_vertices;
     std::vector< std::tuple< uint8_t, uint8_t, uint8_t > > new_tex;
-    std::map< int, int > index2reducedIndex;
+    std::vector< int > index2reducedIndex( get_vertex_count(), -1 );
 
     new_vertices.reserve( get_vertex_count() );
     new_tex.reserve( get_vertex_count() );
@@ -66,30 +67,28 @@ void points::export_to_ply( const std::string & fname, const frame_holder & text
         }
 
     const auto threshold = 0.05f;
-    auto width = video_stream_profile->get_width();
+    int width = video_stream_profile->get_width();
+    int height = video_stream_profile->get_height();
     std::vector< std::tuple< int, int, int > > faces;
-    for( uint32_t x = 0; x < width - 1; ++x )
+    // Only clouds laid out like the stream's image can be triangulated; merged or downsampled ones are exported as
+    // vertices alone
+    if( size_t( width ) * height == get_vertex_count() )
     {
-        for( uint32_t y = 0; y < video_stream_profile->get_height() - 1; ++y )
+        std::vector< uint8_t > quads( get_vertex_count() );
+        compute_organized_mesh( quads.data(), vertices, width, height, threshold );
+        for( int x = 0; x < width - 1; ++x )
         {
-            auto a = y * width + x, b = y * width + x + 1, c = ( y + 1 ) * width + x,
-                 d = ( y + 1 ) * width + x + 1;
-            if( vertices[a].z && vertices[b].z && vertices[c].z && vertices[d].z
-                && std::abs( vertices[a].z - vertices[b].z ) < threshold
-                && std::abs( vertices[a].z - vertices[c].z ) < threshold
-                && std::abs( vertices[b].z - vertices[d].z ) < threshold
-                && std::abs( vertices[c].z - vertices[d].z ) < threshold )
+            for( int y = 0; y < height - 1; ++y )
             {
-                if( index2reducedIndex.count( a ) == 0 || index2reducedIndex.count( b ) == 0
-                    || index2reducedIndex.count( c ) == 0 || index2reducedIndex.count( d ) == 0 )
+                if( ! quads[y * width + x] )
                     continue;
-
-                faces.emplace_back( index2reducedIndex[a],
-                                    index2reducedIndex[d],
-                                    index2reducedIndex[b] );
-                faces.emplace_back( index2reducedIndex[d],
-                                    index2reducedIndex[a],
-                                    index2reducedIndex[c] );
+                auto a = y * width + x, b = y * width + x + 1, c = ( y + 1 ) * width + x,
+                     d = ( y + 1 ) * width + x + 1;
+                if( index2reducedIndex[a] < 0 || index2reducedIndex[b] < 0 || index2reducedIndex[c] < 0
+                    || index2reducedIndex[d] < 0 )
+                    continue;
+                faces.emplace_back( index2reducedIndex[a], index2reducedIndex[d], index2reducedIndex[b] );
+                faces.emplace_back( index2reducedIndex[d], index2reducedIndex[a], index2reducedIndex[c] );
             }
         }
     }
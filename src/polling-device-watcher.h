@@ -7,6 +7,7 @@
 #include "platform/device-watcher.h"
 #include <rsutils/concurrency/concurrency.h>
 #include "callback-invocation.h"
+#include "thread-policy.h"
 
 
 namespace librealsense {
@@ -29,6 +30,7 @@ public:
 
     void polling( dispatcher::cancellable_timer cancellable_timer )
     {
+        thread_policy::apply( thread_role::device_watcher );
         if( cancellable_timer.try_sleep( std::chrono::milliseconds( POLLING_DEVICES_INTERVAL_MS ) ) )
         {
             platform::backend_device_group curr( _backend->query_uvc_devices(),
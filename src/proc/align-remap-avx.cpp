@@ -0,0 +1,176 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "align-remap.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#include <cstring>
+#endif
+
+
+namespace librealsense
+{
+#ifdef __AVX2__
+
+    namespace
+    {
+        // Gathers the pixels at eight indices into 32-bit lanes, zero in the lanes not in the mask.
+        // Pixels of less than 4 bytes are read with the bytes that follow them, or for the last pixels of the image
+        // with those that precede them, and shifted into place.
+        inline __m256i gather_pixels( const uint8_t * source, __m256i last, int bpp, __m256i index, __m256i mask )
+        {
+            auto const zero = _mm256_setzero_si256();
+            auto const base = reinterpret_cast< const int * >( source );
+            if( bpp == 4 )
+                return _mm256_mask_i32gather_epi32( zero, base, index, mask, 4 );
+
+            auto const offset = _mm256_mullo_epi32( index, _mm256_set1_epi32( bpp ) );
+            auto const clamped = _mm256_min_epi32( offset, last );
+            auto const pixels = _mm256_mask_i32gather_epi32( zero, base, clamped, mask, 1 );
+            return _mm256_srlv_epi32( pixels, _mm256_slli_epi32( _mm256_sub_epi32( offset, clamped ), 3 ) );
+        }
+
+        // Writes eight pixels, held in the low bytes of each lane, as bpp*8 contiguous bytes
+        inline void store_pixels( uint8_t * dest, int bpp, __m256i pixels )
+        {
+            switch( bpp )
+            {
+            case 1:
+            {
+                auto const masked = _mm256_and_si256( pixels, _mm256_set1_epi32( 0xff ) );
+                auto const words = _mm256_packus_epi32( masked, masked );
+                auto const bytes = _mm256_packus_epi16( words, words );
+                int32_t const lo = _mm256_cvtsi256_si32( bytes ), hi = _mm256_extract_epi32( bytes, 4 );
+                std::memcpy( dest, &lo, 4 );
+                std::memcpy( dest + 4, &hi, 4 );
+                break;
+            }
+            case 2:
+            {
+                auto words = _mm256_and_si256( pixels, _mm256_set1_epi32( 0xffff ) );
+                words = _mm256_packus_epi32( words, words );
+                words = _mm256_permute4x64_epi64( words, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+                _mm_storeu_si128( reinterpret_cast< __m128i * >( dest ), _mm256_castsi256_si128( words ) );
+                break;
+            }
+            case 3:
+            {
+                // Drop the 4th byte of each lane, then bring the 12 bytes of each half together
+                auto const shuffle = _mm256_setr_epi8( 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                                       0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1 );
+                auto packed = _mm256_shuffle_epi8( pixels, shuffle );
+                packed = _mm256_permutevar8x32_epi32( packed, _mm256_setr_epi32( 0, 1, 2, 4, 5, 6, 3, 7 ) );
+                _mm_storeu_si128( reinterpret_cast< __m128i * >( dest ), _mm256_castsi256_si128( packed ) );
+                _mm_storel_epi64( reinterpret_cast< __m128i * >( dest + 16 ), _mm256_extracti128_si256( packed, 1 ) );
+                break;
+            }
+            default:
+                _mm256_storeu_si256( reinterpret_cast< __m256i * >( dest ), pixels );
+                break;
+            }
+        }
+    }
+
+    size_t remap_nearest_avx2( const uint8_t * source, size_t source_size, int bpp, const int32_t * index,
+                               uint8_t * dest, size_t count )
+    {
+        if( bpp < 1 || bpp > 4 || source_size < 4 )
+            return 0;
+
+        auto const last = _mm256_set1_epi32( int( source_size - 4 ) );
+        auto const none = _mm256_set1_epi32( -1 );
+        size_t i = 0;
+        for( ; i + 8 <= count; i += 8 )
+        {
+            auto const idx = _mm256_loadu_si256( reinterpret_cast< const __m256i * >( index + i ) );
+            auto const valid = _mm256_cmpgt_epi32( idx, none );
+            store_pixels( dest + i * bpp, bpp, gather_pixels( source, last, bpp, idx, valid ) );
+        }
+        return i;
+    }
+
+    size_t remap_bilinear_avx2( const uint8_t * source, int width, int height, int bpp, int channel_bits,
+                                const float2 * position, uint8_t * dest, size_t count )
+    {
+        if( bpp < 1 || bpp > 4 || width < 2 || height < 2 )
+            return 0;
+
+        int const channels = bpp * 8 / channel_bits;
+        auto const last = _mm256_set1_epi32( width * height * bpp - 4 );
+        auto const channel_mask = _mm256_set1_epi32( ( 1 << channel_bits ) - 1 );
+        auto const min_uv = _mm256_set1_ps( -0.5f );
+        auto const max_u = _mm256_set1_ps( width - 0.5f );
+        auto const max_v = _mm256_set1_ps( height - 0.5f );
+        auto const zero = _mm256_setzero_ps();
+        auto const last_u = _mm256_set1_ps( float( width - 1 ) );
+        auto const last_v = _mm256_set1_ps( float( height - 1 ) );
+        auto const last_x0 = _mm256_set1_epi32( width - 2 );
+        auto const last_y0 = _mm256_set1_epi32( height - 2 );
+        auto const stride = _mm256_set1_epi32( width );
+        auto const one = _mm256_set1_epi32( 1 );
+        auto const half = _mm256_set1_ps( 0.5f );
+
+        size_t i = 0;
+        for( ; i + 8 <= count; i += 8 )
+        {
+            // u0 v0 u1 v1 ... into u0..u7 and v0..v7
+            auto const a = _mm256_loadu_ps( &position[i].x );
+            auto const b = _mm256_loadu_ps( &position[i + 4].x );
+            auto const u = _mm256_castpd_ps(
+                _mm256_permute4x64_pd( _mm256_castps_pd( _mm256_shuffle_ps( a, b, _MM_SHUFFLE( 2, 0, 2, 0 ) ) ),
+                                       _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+            auto const v = _mm256_castpd_ps(
+                _mm256_permute4x64_pd( _mm256_castps_pd( _mm256_shuffle_ps( a, b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) ),
+                                       _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+
+            auto const valid = _mm256_castps_si256(
+                _mm256_and_ps( _mm256_and_ps( _mm256_cmp_ps( u, min_uv, _CMP_GE_OQ ), _mm256_cmp_ps( u, max_u, _CMP_LT_OQ ) ),
+                               _mm256_and_ps( _mm256_cmp_ps( v, min_uv, _CMP_GE_OQ ), _mm256_cmp_ps( v, max_v, _CMP_LT_OQ ) ) ) );
+
+            auto const uc = _mm256_min_ps( _mm256_max_ps( u, zero ), last_u );
+            auto const vc = _mm256_min_ps( _mm256_max_ps( v, zero ), last_v );
+            auto const x0 = _mm256_min_epi32( _mm256_cvttps_epi32( uc ), last_x0 );
+            auto const y0 = _mm256_min_epi32( _mm256_cvttps_epi32( vc ), last_y0 );
+            auto const fx = _mm256_sub_ps( uc, _mm256_cvtepi32_ps( x0 ) );
+            auto const fy = _mm256_sub_ps( vc, _mm256_cvtepi32_ps( y0 ) );
+
+            auto const i00 = _mm256_add_epi32( _mm256_mullo_epi32( y0, stride ), x0 );
+            auto const i01 = _mm256_add_epi32( i00, stride );
+            auto const p00 = gather_pixels( source, last, bpp, i00, valid );
+            auto const p10 = gather_pixels( source, last, bpp, _mm256_add_epi32( i00, one ), valid );
+            auto const p01 = gather_pixels( source, last, bpp, i01, valid );
+            auto const p11 = gather_pixels( source, last, bpp, _mm256_add_epi32( i01, one ), valid );
+
+            auto result = _mm256_setzero_si256();
+            for( int c = 0; c < channels; ++c )
+            {
+                auto const shift = _mm_cvtsi32_si128( c * channel_bits );
+                auto channel = [&]( __m256i p ) {
+                    return _mm256_cvtepi32_ps( _mm256_and_si256( _mm256_srl_epi32( p, shift ), channel_mask ) );
+                };
+                auto const c00 = channel( p00 ), c10 = channel( p10 ), c01 = channel( p01 ), c11 = channel( p11 );
+                auto const top = _mm256_add_ps( c00, _mm256_mul_ps( fx, _mm256_sub_ps( c10, c00 ) ) );
+                auto const bottom = _mm256_add_ps( c01, _mm256_mul_ps( fx, _mm256_sub_ps( c11, c01 ) ) );
+                auto const value = _mm256_add_ps( _mm256_add_ps( top, _mm256_mul_ps( fy, _mm256_sub_ps( bottom, top ) ) ), half );
+                result = _mm256_or_si256( result, _mm256_sll_epi32( _mm256_cvttps_epi32( value ), shift ) );
+            }
+            store_pixels( dest + i * bpp, bpp, _mm256_and_si256( result, valid ) );
+        }
+        return i;
+    }
+
+#else
+
+    size_t remap_nearest_avx2( const uint8_t *, size_t, int, const int32_t *, uint8_t *, size_t )
+    {
+        return 0;
+    }
+
+    size_t remap_bilinear_avx2( const uint8_t *, int, int, int, int, const float2 *, uint8_t *, size_t )
+    {
+        return 0;
+    }
+
+#endif
+}
@@ -0,0 +1,258 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "align-remap.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace librealsense
+{
+    namespace
+    {
+        template< int N > struct bytes { uint8_t b[N]; };
+
+        bool cpu_has_avx2()
+        {
+#if defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+            return __builtin_cpu_supports( "avx2" );
+#else
+            return false;
+#endif
+        }
+
+        template< int N >
+        void remap_nearest_bytes( const uint8_t * source, const int32_t * index, uint8_t * dest, size_t count )
+        {
+            auto in = reinterpret_cast< const bytes< N > * >( source );
+            auto out = reinterpret_cast< bytes< N > * >( dest );
+            for( size_t i = 0; i < count; ++i )
+            {
+                if( index[i] >= 0 )
+                    out[i] = in[index[i]];
+                else
+                    out[i] = {};
+            }
+        }
+
+        template< class T >
+        void remap_bilinear_channels( const uint8_t * source, int width, int height, int channels,
+                                      const float2 * position, uint8_t * dest, size_t count )
+        {
+            auto in = reinterpret_cast< const T * >( source );
+            auto out = reinterpret_cast< T * >( dest );
+            float const max_u = width - 0.5f, max_v = height - 0.5f;
+            for( size_t i = 0; i < count; ++i, out += channels )
+            {
+                float const u = position[i].x, v = position[i].y;
+                if( ! ( u >= -0.5f && u < max_u && v >= -0.5f && v < max_v ) )
+                {
+                    std::fill( out, out + channels, T( 0 ) );
+                    continue;
+                }
+                float const uc = std::min( std::max( u, 0.f ), float( width - 1 ) );
+                float const vc = std::min( std::max( v, 0.f ), float( height - 1 ) );
+                int const x0 = std::min( int( uc ), std::max( width - 2, 0 ) );
+                int const y0 = std::min( int( vc ), std::max( height - 2, 0 ) );
+                int const x1 = std::min( x0 + 1, width - 1 );
+                int const y1 = std::min( y0 + 1, height - 1 );
+                float const fx = uc - x0, fy = vc - y0;
+
+                auto p00 = in + ( size_t( y0 ) * width + x0 ) * channels;
+                auto p10 = in + ( size_t( y0 ) * width + x1 ) * channels;
+                auto p01 = in + ( size_t( y1 ) * width + x0 ) * channels;
+                auto p11 = in + ( size_t( y1 ) * width + x1 ) * channels;
+                for( int c = 0; c < channels; ++c )
+                {
+                    float const top = p00[c] + fx * ( float( p10[c] ) - p00[c] );
+                    float const bottom = p01[c] + fx * ( float( p11[c] ) - p01[c] );
+                    out[c] = T( top + fy * ( bottom - top ) + 0.5f );
+                }
+            }
+        }
+    }
+
+    void remap_nearest( const uint8_t * source, size_t source_size, int bpp, const int32_t * index, uint8_t * dest,
+                        size_t count )
+    {
+        static bool const avx2 = cpu_has_avx2();
+        if( avx2 )
+        {
+            auto const done = remap_nearest_avx2( source, source_size, bpp, index, dest, count );
+            index += done;
+            dest += done * bpp;
+            count -= done;
+        }
+
+        switch( bpp )
+        {
+        case 1: remap_nearest_bytes< 1 >( source, index, dest, count ); break;
+        case 2: remap_nearest_bytes< 2 >( source, index, dest, count ); break;
+        case 3: remap_nearest_bytes< 3 >( source, index, dest, count ); break;
+        case 4: remap_nearest_bytes< 4 >( source, index, dest, count ); break;
+        default:
+            for( size_t i = 0; i < count; ++i, dest += bpp )
+            {
+                if( index[i] >= 0 )
+                    std::memcpy( dest, source + size_t( index[i] ) * bpp, bpp );
+                else
+                    std::memset( dest, 0, bpp );
+            }
+            break;
+        }
+    }
+
+    void remap_bilinear( const uint8_t * source, int width, int height, int bpp, int channel_bits,
+                         const float2 * position, uint8_t * dest, size_t count )
+    {
+        static bool const avx2 = cpu_has_avx2();
+        if( avx2 )
+        {
+            auto const done = remap_bilinear_avx2( source, width, height, bpp, channel_bits, position, dest, count );
+            position += done;
+            dest += done * bpp;
+            count -= done;
+        }
+
+        if( channel_bits == 16 )
+            remap_bilinear_channels< uint16_t >( source, width, height, bpp / 2, position, dest, count );
+        else
+            remap_bilinear_channels< uint8_t >( source, width, height, bpp, position, dest, count );
+    }
+
+    bool other_to_depth_map::can_interpolate( rs2_format format )
+    {
+        switch( format )
+        {
+        case RS2_FORMAT_Y8:
+        case RS2_FORMAT_Y16:
+        case RS2_FORMAT_Z16:
+        case RS2_FORMAT_RGB8:
+        case RS2_FORMAT_BGR8:
+        case RS2_FORMAT_RGBA8:
+        case RS2_FORMAT_BGRA8:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    constexpr size_t depth_change_tracker::block_size;
+
+    bool depth_change_tracker::update( const uint16_t * depth, size_t count, uint16_t threshold )
+    {
+        _changed.clear();
+        if( _reference.size() != count )
+        {
+            _reference.assign( depth, depth + count );
+            return true;
+        }
+
+        auto block_changed = [&]( size_t begin, size_t end )
+        {
+            for( size_t i = begin; i < end; ++i )
+            {
+                auto const d = depth[i], r = _reference[i];
+                if( ( d > r ? d - r : r - d ) > threshold || ! d != ! r )
+                    return true;
+            }
+            return false;
+        };
+
+        size_t const blocks = count / block_size;
+        auto reference = _reference.data();
+#ifdef __SSE2__
+        auto const t = _mm_set1_epi16( short( threshold ) );
+        auto const zero = _mm_setzero_si128();
+        for( size_t b = 0; b < blocks; ++b )
+        {
+            auto const d = _mm_loadu_si128( reinterpret_cast< const __m128i * >( depth + b * block_size ) );
+            auto const r = _mm_loadu_si128( reinterpret_cast< const __m128i * >( reference + b * block_size ) );
+            // Unsigned |d - r| > t, or only one of them zero
+            auto const diff = _mm_or_si128( _mm_subs_epu16( d, r ), _mm_subs_epu16( r, d ) );
+            auto const beyond = _mm_subs_epu16( diff, t );
+            auto const validity = _mm_xor_si128( _mm_cmpeq_epi16( d, zero ), _mm_cmpeq_epi16( r, zero ) );
+            if( _mm_movemask_epi8( _mm_cmpeq_epi16( _mm_or_si128( beyond, validity ), zero ) ) != 0xffff )
+                _changed.push_back( uint32_t( b ) );
+        }
+#else
+        for( size_t b = 0; b < blocks; ++b )
+            if( block_changed( b * block_size, ( b + 1 ) * block_size ) )
+                _changed.push_back( uint32_t( b ) );
+#endif
+        if( blocks * block_size < count && block_changed( blocks * block_size, count ) )
+            _changed.push_back( uint32_t( blocks ) );
+
+        if( _changed.size() * 2 > blocks )
+        {
+            _changed.clear();
+            _reference.assign( depth, depth + count );
+            return true;
+        }
+        for( auto b : _changed )
+        {
+            auto const begin = b * block_size, end = std::min( begin + block_size, count );
+            std::copy( depth + begin, depth + end, reference + begin );
+        }
+        return false;
+    }
+
+    bool other_to_depth_map::update( const uint16_t * depth, size_t count, float depth_units,
+                                     align_interpolation interpolation, rs2_format other_format,
+                                     uint16_t depth_change_threshold )
+    {
+        if( ! can_interpolate( other_format ) )
+            interpolation = align_nearest;
+        _format = other_format;
+
+        if( _depth_units != depth_units || _interpolation != interpolation )
+        {
+            _depth.reset();
+            _depth_units = depth_units;
+            _interpolation = interpolation;
+        }
+        if( ! _depth.update( depth, count, depth_change_threshold ) )
+            return false;
+
+        if( interpolation == align_bilinear )
+            position.resize( count );
+        else
+            index.resize( count );
+        return true;
+    }
+
+    bool depth_to_other_map::update( const uint16_t * depth, size_t count, float depth_units,
+                                     uint16_t depth_change_threshold )
+    {
+        if( _depth_units != depth_units )
+        {
+            _depth.reset();
+            _depth_units = depth_units;
+        }
+        if( ! _depth.update( depth, count, depth_change_threshold ) )
+            return false;
+
+        top_left.resize( count );
+        bottom_right.resize( count );
+        return true;
+    }
+
+    void other_to_depth_map::remap( const uint8_t * other, int other_width, int other_height, int bpp,
+                                    uint8_t * aligned ) const
+    {
+        if( _interpolation == align_bilinear )
+        {
+            bool const wide = _format == RS2_FORMAT_Y16 || _format == RS2_FORMAT_Z16;
+            remap_bilinear( other, other_width, other_height, bpp, wide ? 16 : 8, position.data(), aligned,
+                            _depth.size() );
+        }
+        else
+            remap_nearest( other, size_t( other_width ) * other_height * bpp, bpp, index.data(), aligned,
+                           _depth.size() );
+    }
+}
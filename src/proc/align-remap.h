@@ -0,0 +1,120 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/h/rs_types.h>
+#include <librealsense2/h/rs_sensor.h>
+#include <src/float3.h>
+
+#include <cstdint>
+#include <vector>
+
+
+namespace librealsense
+{
+    // How an image aligned to depth samples the other image
+    enum align_interpolation : uint8_t
+    {
+        align_nearest = 0,   // the pixel covered by the depth pixel
+        align_bilinear = 1,  // interpolated at the center of the depth pixel (Y8, Y16, Z16, RGB8/BGR8, RGBA8/BGRA8)
+    };
+
+    // Tells which depth pixels changed since a map was computed from them, for their place in the map to be recomputed:
+    // those whose depth changed by more than a threshold (in depth units), or that gained or lost depth.
+    //
+    // Pixels are compared to the reference in blocks of 8 (with SSE2 where available), and a changed block takes the new
+    // depth as its reference, so a pixel never drifts further than the threshold from the depth its map is computed
+    // from. With a threshold of 0 the map stays exact.
+    //
+    class depth_change_tracker
+    {
+    public:
+        static constexpr size_t block_size = 8;
+
+        // Returns true when the whole map must be computed: for the first frame, when the size changes, or when most
+        // blocks changed (when computing everything is cheaper). Otherwise changed_blocks() lists the blocks that need
+        // recomputing, possibly none.
+        bool update( const uint16_t * depth, size_t count, uint16_t threshold );
+
+        const std::vector< uint32_t > & changed_blocks() const { return _changed; }
+        size_t size() const { return _reference.size(); }
+        void reset() { _reference.clear(); }
+
+    private:
+        std::vector< uint16_t > _reference;
+        std::vector< uint32_t > _changed;
+    };
+
+    // Where each depth pixel samples the other image: the index of an other pixel (-1 for none) when sampling the
+    // nearest pixel, or the position of the depth pixel center in the other image (negative when outside) when
+    // interpolating.
+    //
+    // Computing the map means projecting every depth pixel onto the other image, while remapping is a gather: the map
+    // is kept from frame to frame, and only the blocks of pixels whose depth changed are recomputed. For a static scene
+    // this leaves the gather as the whole cost of alignment.
+    //
+    class other_to_depth_map
+    {
+    public:
+        // Returns true if the whole map must be computed for this depth frame; otherwise only changed_blocks().
+        // Formats that cannot be interpolated are always sampled at the nearest pixel.
+        bool update( const uint16_t * depth, size_t count, float depth_units, align_interpolation interpolation,
+                     rs2_format other_format, uint16_t depth_change_threshold = 0 );
+
+        const std::vector< uint32_t > & changed_blocks() const { return _depth.changed_blocks(); }
+
+        void invalidate() { _depth.reset(); }
+
+        // What the map holds, index or position
+        align_interpolation interpolation() const { return _interpolation; }
+
+        static bool can_interpolate( rs2_format format );
+
+        // Fills the image aligned to depth, one pixel per depth pixel; pixels with nothing to sample are zeroed
+        void remap( const uint8_t * other, int other_width, int other_height, int bpp, uint8_t * aligned ) const;
+
+        std::vector< int32_t > index;
+        std::vector< float2 > position;
+
+    private:
+        depth_change_tracker _depth;
+        float _depth_units = 0;
+        align_interpolation _interpolation = align_nearest;
+        rs2_format _format = RS2_FORMAT_ANY;
+    };
+
+    // The pixels of the other image each depth pixel covers, from top_left to bottom_right, for depth to be scattered
+    // into the other image. Like other_to_depth_map, it is kept from frame to frame and recomputed where depth changed.
+    //
+    class depth_to_other_map
+    {
+    public:
+        // Returns true if the whole map must be computed for this depth frame; otherwise only changed_blocks()
+        bool update( const uint16_t * depth, size_t count, float depth_units, uint16_t depth_change_threshold = 0 );
+
+        const std::vector< uint32_t > & changed_blocks() const { return _depth.changed_blocks(); }
+
+        void invalidate() { _depth.reset(); }
+
+        std::vector< int2 > top_left;
+        std::vector< int2 > bottom_right;
+
+    private:
+        depth_change_tracker _depth;
+        float _depth_units = 0;
+    };
+
+    // The remapping kernels, exposed for testing: they fall back to plain C++ when AVX2 is not available
+    void remap_nearest( const uint8_t * source, size_t source_size, int bpp, const int32_t * index, uint8_t * dest,
+                        size_t count );
+    void remap_bilinear( const uint8_t * source, int width, int height, int bpp, int channel_bits,
+                         const float2 * position, uint8_t * dest, size_t count );
+
+    // AVX2 versions, built with -mavx2 when possible. They return how many pixels were remapped, the remainder of
+    // what does not fill 8 lanes being left to the caller: 0 when not built with AVX2 or not applicable.
+    size_t remap_nearest_avx2( const uint8_t * source, size_t source_size, int bpp, const int32_t * index,
+                               uint8_t * dest, size_t count );
+    size_t remap_bilinear_avx2( const uint8_t * source, int width, int height, int bpp, int channel_bits,
+                                const float2 * position, uint8_t * dest, size_t count );
+}
@@ -8,6 +8,7 @@
 #include "core/depth-frame.h"
 #include "proc/synthetic-stream.h"
 #include "environment.h"
+#include "option.h"
 #include "align.h"
 #include "stream.h"
 
@@ -19,8 +20,6 @@
 
 namespace librealsense
 {
-    template<int N> struct bytes { uint8_t b[N]; };
-
     std::shared_ptr<align> align::create_align(rs2_stream align_to)
     {
         #if defined(RS2_USE_CUDA)
@@ -32,55 +31,77 @@ namespace librealsense
         #endif
     }
 
-    template<class GET_DEPTH, class TRANSFER_PIXEL>
-    void align_images(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other,
-        const rs2_intrinsics& other_intrin, GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel)
+    // Calls map_pixel(x, y, index) for every depth pixel, or only for those of the blocks that changed
+    template<class MAP_PIXEL>
+    void map_depth_pixels(const rs2_intrinsics& depth_intrin, bool whole, const std::vector<uint32_t>& changed_blocks, MAP_PIXEL map_pixel)
     {
-        // Iterate over the pixels of the depth image
-#pragma omp parallel for schedule(dynamic)
-        for (int depth_y = 0; depth_y < depth_intrin.height; ++depth_y)
+        if (whole)
         {
-            int depth_pixel_index = depth_y * depth_intrin.width;
-            for (int depth_x = 0; depth_x < depth_intrin.width; ++depth_x, ++depth_pixel_index)
+#pragma omp parallel for schedule(dynamic)
+            for (int depth_y = 0; depth_y < depth_intrin.height; ++depth_y)
             {
-                // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
-                if (float depth = get_depth(depth_pixel_index))
-                {
-                    // Map the top-left corner of the depth pixel onto the other image
-                    float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, depth_point[3], other_point[3], other_pixel[2];
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
-                    rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
-                    rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
-                    const int other_x0 = static_cast<int>(other_pixel[0] + 0.5f);
-                    const int other_y0 = static_cast<int>(other_pixel[1] + 0.5f);
-
-                    // Map the bottom-right corner of the depth pixel onto the other image
-                    depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
-                    rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
-                    rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
-                    const int other_x1 = static_cast<int>(other_pixel[0] + 0.5f);
-                    const int other_y1 = static_cast<int>(other_pixel[1] + 0.5f);
-
-                    if (other_x0 < 0 || other_y0 < 0 || other_x1 >= other_intrin.width || other_y1 >= other_intrin.height)
-                        continue;
-
-                    // Transfer between the depth pixels and the pixels inside the rectangle on the other image
-                    for (int y = other_y0; y <= other_y1; ++y)
-                    {
-                        for (int x = other_x0; x <= other_x1; ++x)
-                        {
-                            transfer_pixel(depth_pixel_index, y * other_intrin.width + x);
-                        }
-                    }
-                }
+                int depth_pixel_index = depth_y * depth_intrin.width;
+                for (int depth_x = 0; depth_x < depth_intrin.width; ++depth_x, ++depth_pixel_index)
+                    map_pixel(depth_x, depth_y, depth_pixel_index);
             }
+            return;
+        }
+
+        const size_t count = size_t(depth_intrin.width) * depth_intrin.height;
+        for (auto block : changed_blocks)
+        {
+            size_t begin = block * depth_change_tracker::block_size;
+            size_t end = std::min(begin + depth_change_tracker::block_size, count);
+            for (size_t i = begin; i < end; ++i)
+                map_pixel(int(i % depth_intrin.width), int(i / depth_intrin.width), int(i));
         }
     }
 
+    // Maps the corners of a depth pixel onto the other image, into the pixels of the other image it covers
+    void map_depth_pixel_corners(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other,
+        const rs2_intrinsics& other_intrin, int depth_x, int depth_y, float depth, int2& top_left, int2& bottom_right)
+    {
+        // Map the top-left corner of the depth pixel onto the other image
+        float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, depth_point[3], other_point[3], other_pixel[2];
+        rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+        rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
+        rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
+        top_left.x = static_cast<int>(other_pixel[0] + 0.5f);
+        top_left.y = static_cast<int>(other_pixel[1] + 0.5f);
+
+        // Map the bottom-right corner of the depth pixel onto the other image
+        depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
+        rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+        rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
+        rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
+        bottom_right.x = static_cast<int>(other_pixel[0] + 0.5f);
+        bottom_right.y = static_cast<int>(other_pixel[1] + 0.5f);
+    }
+
+    // Only depth pixels that fall entirely inside the other image are aligned
+    inline bool inside_other(const int2& top_left, const int2& bottom_right, const rs2_intrinsics& other_intrin)
+    {
+        return top_left.x >= 0 && top_left.y >= 0 && bottom_right.x < other_intrin.width && bottom_right.y < other_intrin.height;
+    }
+
     align::align(rs2_stream to_stream) : align(to_stream, "Align")
     {}
 
+    align::align(rs2_stream to_stream, const char* name)
+        : generic_processing_block(name),
+          _to_stream_type(to_stream), _depth_scale(0), _interpolation(align_nearest), _depth_change_threshold(0)
+    {
+        auto interpolation = std::make_shared<ptr_option<uint8_t>>(align_nearest, align_bilinear, 1, align_nearest,
+            &_interpolation, "How streams aligned to depth are sampled");
+        interpolation->set_description(align_nearest, "Nearest");
+        interpolation->set_description(align_bilinear, "Bilinear");
+        register_option(RS2_OPTION_ALIGN_INTERPOLATION, interpolation);
+
+        auto depth_change_threshold = std::make_shared<ptr_option<uint16_t>>(0, 1000, 1, 0, &_depth_change_threshold,
+            "Depth change, in depth units, pixels must exceed to be mapped again; 0 keeps alignment exact");
+        register_option(RS2_OPTION_ALIGN_DEPTH_CHANGE_THRESHOLD, depth_change_threshold);
+    }
+
     void align::align_z_to_other(rs2::video_frame& aligned, 
         const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale)
     {
@@ -97,55 +118,78 @@ namespace librealsense
         auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
         auto out_z = (uint16_t *)(aligned_data);
 
-        align_images(z_intrin, z_to_other, other_intrin,
-            [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
-            [out_z, z_pixels](int z_pixel_index, int other_pixel_index)
+        // The pixels covered by each depth pixel are only mapped again where depth changed
+        auto& map = _depth_to_other_map;
+        bool whole = map.update(z_pixels, size_t(z_intrin.width) * z_intrin.height, z_scale, _depth_change_threshold);
+        map_depth_pixels(z_intrin, whole, map.changed_blocks(), [&](int depth_x, int depth_y, int depth_pixel_index)
         {
-            out_z[other_pixel_index] = out_z[other_pixel_index] ?
-                std::min((int)out_z[other_pixel_index], (int)z_pixels[z_pixel_index]) :
-                z_pixels[z_pixel_index];
+            // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
+            if (float depth = z_scale * z_pixels[depth_pixel_index])
+                map_depth_pixel_corners(z_intrin, z_to_other, other_intrin, depth_x, depth_y, depth,
+                    map.top_left[depth_pixel_index], map.bottom_right[depth_pixel_index]);
         });
-    }
 
-    template<int N, class GET_DEPTH>
-    void align_other_to_depth_bytes( uint8_t * other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin, const uint8_t * other_pixels)
-    {
-        auto in_other = (const bytes<N> *)(other_pixels);
-        auto out_other = (bytes<N> *)(other_aligned_to_depth);
-        align_images(depth_intrin, depth_to_other, other_intrin, get_depth,
-            [out_other, in_other](int depth_pixel_index, int other_pixel_index) { out_other[depth_pixel_index] = in_other[other_pixel_index]; });
+        // Transfer between the depth pixels and the pixels inside the rectangle on the other image
+        for (int depth_pixel_index = 0; depth_pixel_index < z_intrin.width * z_intrin.height; ++depth_pixel_index)
+        {
+            auto z = z_pixels[depth_pixel_index];
+            auto& top_left = map.top_left[depth_pixel_index];
+            auto& bottom_right = map.bottom_right[depth_pixel_index];
+            if (!z || !inside_other(top_left, bottom_right, other_intrin))
+                continue;
+
+            for (int y = top_left.y; y <= bottom_right.y; ++y)
+            {
+                for (int x = top_left.x; x <= bottom_right.x; ++x)
+                {
+                    auto& out = out_z[y * other_intrin.width + x];
+                    out = out ? std::min(out, z) : z;
+                }
+            }
+        }
     }
 
-    template<class GET_DEPTH>
-    void align_other_to_depth( uint8_t * other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics & depth_to_other, const rs2_intrinsics& other_intrin, const uint8_t * other_pixels, rs2_format other_format)
+    // Where each depth pixel samples the other image
+    void map_other_to_depth(other_to_depth_map& map, bool whole, const uint16_t* z_pixels, float z_scale, const rs2_intrinsics& depth_intrin,
+        const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin)
     {
-        switch (other_format)
+        if (map.interpolation() == align_bilinear)
+        {
+            // The center of the depth pixel, in the other image
+            map_depth_pixels(depth_intrin, whole, map.changed_blocks(), [&](int depth_x, int depth_y, int depth_pixel_index)
+            {
+                auto& position = map.position[depth_pixel_index];
+                position = { -1.f, -1.f };
+                if (float depth = z_scale * z_pixels[depth_pixel_index])
+                {
+                    float depth_pixel[2] = { float(depth_x), float(depth_y) }, depth_point[3], other_point[3];
+                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
+                    rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
+                    rs2_project_point_to_pixel(&position.x, &other_intrin, other_point);
+                }
+            });
+        }
+        else
         {
-        case RS2_FORMAT_Y8:
-            align_other_to_depth_bytes<1>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
-            break;
-        case RS2_FORMAT_Y16:
-        case RS2_FORMAT_Z16:
-            align_other_to_depth_bytes<2>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
-            break;
-        case RS2_FORMAT_RGB8:
-        case RS2_FORMAT_BGR8:
-            align_other_to_depth_bytes<3>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
-            break;
-        case RS2_FORMAT_RGBA8:
-        case RS2_FORMAT_BGRA8:
-            align_other_to_depth_bytes<4>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
-            break;
-        default:
-            assert(false); // NOTE: rs2_align_other_to_depth_bytes<2>(...) is not appropriate for RS2_FORMAT_YUYV/RS2_FORMAT_RAW10 images, no logic prevents U/V channels from being written to one another
+            // The last pixel of the covered rectangle, as copying the whole rectangle would leave
+            map_depth_pixels(depth_intrin, whole, map.changed_blocks(), [&](int depth_x, int depth_y, int depth_pixel_index)
+            {
+                auto& index = map.index[depth_pixel_index];
+                index = -1;
+                if (float depth = z_scale * z_pixels[depth_pixel_index])
+                {
+                    int2 top_left, bottom_right;
+                    map_depth_pixel_corners(depth_intrin, depth_to_other, other_intrin, depth_x, depth_y, depth, top_left, bottom_right);
+                    if (inside_other(top_left, bottom_right, other_intrin) && top_left.x <= bottom_right.x && top_left.y <= bottom_right.y)
+                        index = bottom_right.y * other_intrin.width + bottom_right.x;
+                }
+            });
         }
     }
 
     void align::align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale)
     {
         uint8_t * aligned_data = reinterpret_cast<uint8_t *>(const_cast<void*>(aligned.get_data()));
-        auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
-        memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
 
         auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
         auto other_profile = other.get_profile().as<rs2::video_stream_profile>();
@@ -157,8 +201,12 @@ namespace librealsense
         auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
         auto other_pixels = reinterpret_cast<const uint8_t *>(other.get_data());
 
-        align_other_to_depth(aligned_data, [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
-            z_intrin, z_to_other, other_intrin, other_pixels, other_profile.format());
+        // The map is only computed again where depth changed; remapping fills every pixel
+        auto& map = _other_maps[other_profile.get()->profile];
+        bool whole = map.update(z_pixels, size_t(z_intrin.width) * z_intrin.height, z_scale, align_interpolation(_interpolation),
+            other_profile.format(), _depth_change_threshold);
+        map_other_to_depth(map, whole, z_pixels, z_scale, z_intrin, z_to_other, other_intrin);
+        map.remap(other_pixels, other_intrin.width, other_intrin.height, other.get_bytes_per_pixel(), aligned_data);
     }
 
     std::shared_ptr<rs2::video_stream_profile> align::create_aligned_profile(
@@ -189,6 +237,8 @@ namespace librealsense
             }
         }
         _align_stream_unique_ids[from_to] = aligned_profile;
+        _other_maps.clear();
+        _depth_to_other_map.invalidate();
         reset_cache(original_profile.stream_type(), to_profile.stream_type());
         return aligned_profile;
     }
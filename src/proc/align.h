@@ -3,6 +3,7 @@
 #pragma once
 
 #include "synthetic-stream.h"
+#include "align-remap.h"
 
 #include <src/basics.h>
 #include <map>
@@ -18,10 +19,7 @@ namespace librealsense
         static std::shared_ptr<align> create_align(rs2_stream align_to);
 
     protected:
-        align(rs2_stream to_stream, const char* name)
-            : generic_processing_block(name),
-              _to_stream_type(to_stream), _depth_scale(0)
-        {}
+        align(rs2_stream to_stream, const char* name);
 
         bool should_process(const rs2::frame& frame) override;
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
@@ -49,8 +47,20 @@ namespace librealsense
         rs2::stream_profile _source_stream_profile;
         float _depth_scale;
 
-    private:
+        // When aligning to depth: how the other streams are sampled (RS2_OPTION_ALIGN_INTERPOLATION), and where, per
+        // other stream
+        uint8_t _interpolation;
+        std::map<stream_profile_interface*, other_to_depth_map> _other_maps;
+
+        // When aligning depth to another stream: the pixels each depth pixel covers
+        depth_to_other_map _depth_to_other_map;
+
+        // The maps are only computed again for depth pixels that changed by more than this (RS2_OPTION_ALIGN_DEPTH_CHANGE_THRESHOLD)
+        uint16_t _depth_change_threshold;
+
         rs2::video_frame allocate_aligned_frame(const rs2::frame_source& source, const rs2::video_frame& from, const rs2::video_frame& to);
+
+    private:
         void align_frames(rs2::video_frame& aligned, const rs2::video_frame& from, const rs2::video_frame& to);
     };
 }
@@ -0,0 +1,161 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "aligned-pointcloud.h"
+#include "batch-projection.h"
+#include <src/core/depth-frame.h>
+
+#include <librealsense2/rs.hpp>
+
+#include <rsutils/concurrency/worker-pool.h>
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace librealsense
+{
+    aligned_pointcloud::aligned_pointcloud( rs2_stream texture_stream )
+        : align( texture_stream, "Aligned Pointcloud" )
+    {
+        if( texture_stream == RS2_STREAM_DEPTH )
+            throw invalid_value_exception( "aligned pointcloud needs a texture stream other than depth" );
+
+        // Only depth is aligned, to the texture stream
+        unregister_option( RS2_OPTION_ALIGN_INTERPOLATION );
+        unregister_option( RS2_OPTION_ALIGN_DEPTH_CHANGE_THRESHOLD );
+    }
+
+    void aligned_pointcloud::update_calibration( const rs2::depth_frame & depth, const rs2::video_frame & other )
+    {
+        auto depth_profile = depth.get_profile().as< rs2::video_stream_profile >();
+        auto other_profile = other.get_profile().as< rs2::video_stream_profile >();
+        if( depth_profile.get() != _depth_profile.get() || other_profile.get() != _other_profile.get() )
+        {
+            _depth_profile = depth_profile;
+            _other_profile = other_profile;
+            _other_intrinsics = other_profile.get_intrinsics();
+            _depth_to_other = depth_profile.get_extrinsics_to( other_profile );
+            _points_profile = depth_profile.clone( RS2_STREAM_DEPTH, depth_profile.stream_index(), RS2_FORMAT_XYZ32F );
+        }
+
+        // The tables are only rebuilt when the calibration or the depth units change
+        auto const depth_intrinsics = depth_profile.get_intrinsics();
+        _rays.update( depth_intrinsics, _depth_scale );
+
+        // Deprojecting pixel (x,y) with the principal point moved by half a pixel gives the point of a corner
+        auto corner = depth_intrinsics;
+        corner.ppx += 0.5f;
+        corner.ppy += 0.5f;
+        _top_left_rays.update( corner, _depth_scale, _depth_to_other );
+        corner.ppx -= 1.f;
+        corner.ppy -= 1.f;
+        _bottom_right_rays.update( corner, _depth_scale, _depth_to_other );
+    }
+
+    // Deprojects a row of depth once, into its vertices, texture coordinates and the texture pixels it covers.
+    // other_points and other_pixels are scratch space for three points per pixel.
+    void aligned_pointcloud::map_row( int y, const uint16_t * depth_row, float3 * vertices, float2 * texcoords,
+                                      float3 * other_points, float2 * other_pixels )
+    {
+        int const width = _rays.width();
+        auto const center = _rays.row( y );
+        auto const top_left = _top_left_rays.row( y );
+        auto const bottom_right = _bottom_right_rays.row( y );
+        auto const & r = _depth_to_other.rotation;
+        auto const & t = _depth_to_other.translation;
+        auto const corner_t = _top_left_rays.translation();
+
+        auto centers = other_points;
+        auto top_lefts = centers + width;
+        auto bottom_rights = top_lefts + width;
+        for( int x = 0; x < width; ++x )
+        {
+            float const d = depth_row[x];
+            float3 const v = center[x] * d;
+            vertices[x] = v;
+            centers[x] = { r[0] * v.x + r[3] * v.y + r[6] * v.z + t[0],
+                           r[1] * v.x + r[4] * v.y + r[7] * v.z + t[1],
+                           r[2] * v.x + r[5] * v.y + r[8] * v.z + t[2] };
+            top_lefts[x] = top_left[x] * d + corner_t;
+            bottom_rights[x] = bottom_right[x] * d + corner_t;
+        }
+        project_points_to_pixels( &other_pixels[0].x, _other_intrinsics, &other_points[0].x, size_t( width ) * 3 );
+
+        auto const pixel_top_left = other_pixels + width;
+        auto const pixel_bottom_right = pixel_top_left + width;
+        auto tl = _top_left.data() + size_t( y ) * width;
+        auto br = _bottom_right.data() + size_t( y ) * width;
+        for( int x = 0; x < width; ++x )
+        {
+            if( ! depth_row[x] )
+            {
+                texcoords[x] = { 0.f, 0.f };
+                continue;
+            }
+            texcoords[x] = { other_pixels[x].x / _other_intrinsics.width, other_pixels[x].y / _other_intrinsics.height };
+            tl[x] = { static_cast< int >( pixel_top_left[x].x + 0.5f ), static_cast< int >( pixel_top_left[x].y + 0.5f ) };
+            br[x] = { static_cast< int >( pixel_bottom_right[x].x + 0.5f ),
+                      static_cast< int >( pixel_bottom_right[x].y + 0.5f ) };
+        }
+    }
+
+    rs2::frame aligned_pointcloud::process_frame( const rs2::frame_source & source, const rs2::frame & f )
+    {
+        auto frames = f.as< rs2::frameset >();
+        auto depth = frames.first_or_default( RS2_STREAM_DEPTH, RS2_FORMAT_Z16 ).as< rs2::depth_frame >();
+        auto other = frames.first_or_default( _to_stream_type ).as< rs2::video_frame >();
+        if( ! depth || ! other )
+            return {};
+
+        _depth_scale = ( (librealsense::depth_frame *)depth.get() )->get_units();
+        update_calibration( depth, other );
+
+        int const width = _rays.width();
+        int const height = _rays.height();
+        auto const depth_pixels = reinterpret_cast< const uint16_t * >( depth.get_data() );
+        auto points = source.allocate_points( _points_profile, depth ).as< rs2::points >();
+        auto vertices = (float3 *)points.get_vertices();
+        auto texcoords = (float2 *)points.get_texture_coordinates();
+        _top_left.resize( size_t( width ) * height );
+        _bottom_right.resize( size_t( width ) * height );
+
+        rsutils::concurrency::worker_pool::shared().parallel_for(
+            height,
+            16,
+            [&]( size_t begin, size_t end )
+            {
+                std::vector< float3 > other_points( size_t( width ) * 3 );
+                std::vector< float2 > other_pixels( size_t( width ) * 3 );
+                for( auto y = begin; y < end; ++y )
+                {
+                    auto const offset = y * width;
+                    map_row( int( y ), depth_pixels + offset, vertices + offset, texcoords + offset,
+                             other_points.data(), other_pixels.data() );
+                }
+            } );
+
+        // Depth pixels may cover the same texture pixels, the nearest winning: this part stays serial
+        auto aligned = allocate_aligned_frame( source, depth, other );
+        auto const other_width = _other_intrinsics.width;
+        auto const other_height = _other_intrinsics.height;
+        auto out = reinterpret_cast< uint16_t * >( const_cast< void * >( aligned.get_data() ) );
+        std::memset( out, 0, size_t( other_width ) * other_height * sizeof( uint16_t ) );
+        for( size_t i = 0, n = size_t( width ) * height; i < n; ++i )
+        {
+            auto const z = depth_pixels[i];
+            if( ! z )
+                continue;
+            int const x0 = std::max( _top_left[i].x, 0 ), x1 = std::min( _bottom_right[i].x, other_width - 1 );
+            int const y0 = std::max( _top_left[i].y, 0 ), y1 = std::min( _bottom_right[i].y, other_height - 1 );
+            for( int y = y0; y <= y1; ++y )
+            {
+                auto row = out + size_t( y ) * other_width;
+                for( int x = x0; x <= x1; ++x )
+                    row[x] = row[x] ? std::min( row[x], z ) : z;
+            }
+        }
+
+        return source.allocate_composite_frame( { aligned, points } );
+    }
+}
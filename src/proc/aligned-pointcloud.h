@@ -0,0 +1,52 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "align.h"
+#include "depth-rays.h"
+#include <src/float3.h>
+
+#include <vector>
+
+
+namespace librealsense
+{
+    // Aligns depth to a texture stream and turns it into a point cloud textured by that stream, in a single pass.
+    //
+    // align and pointcloud each deproject every depth pixel and project it onto the other image; here each depth pixel
+    // is deprojected once, through cached ray tables, and the point gives both its vertex and texture coordinates,
+    // while the points of its corners give the pixels of the texture image it covers in the aligned depth.
+    //
+    // The output holds the depth aligned to the texture stream, the points (at depth resolution, with texture
+    // coordinates) and the texture frame itself. Up to float rounding, it matches align followed by pointcloud.
+    //
+    class aligned_pointcloud : public align
+    {
+    public:
+        aligned_pointcloud( rs2_stream texture_stream );
+
+    protected:
+        rs2::frame process_frame( const rs2::frame_source & source, const rs2::frame & f ) override;
+
+    private:
+        void update_calibration( const rs2::depth_frame & depth, const rs2::video_frame & other );
+        void map_row( int y, const uint16_t * depth_row, float3 * vertices, float2 * texcoords, float3 * other_points,
+                      float2 * other_pixels );
+
+        rs2::stream_profile _depth_profile;
+        rs2::stream_profile _other_profile;
+        rs2::stream_profile _points_profile;
+        rs2_intrinsics _other_intrinsics{};
+        rs2_extrinsics _depth_to_other{};
+
+        depth_rays _rays;               // pixel centers, in depth coordinates
+        depth_rays _top_left_rays;      // pixel corners, in texture coordinates
+        depth_rays _bottom_right_rays;
+
+        // The texture pixels covered by each depth pixel
+        std::vector< int2 > _top_left;
+        std::vector< int2 > _bottom_right;
+    };
+    MAP_EXTENSION( RS2_EXTENSION_ALIGNED_POINTCLOUD, librealsense::aligned_pointcloud );
+}
@@ -0,0 +1,325 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "batch-projection.h"
+
+#include <librealsense2/rsutil.h>
+#include <rsutils/concurrency/worker-pool.h>
+
+#include <algorithm>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+
+namespace librealsense
+{
+    namespace
+    {
+        // Batches smaller than this are not worth waking up other threads for
+        const size_t parallel_threshold = 16 * 1024;
+        const size_t block_size = 64;  // points converted to SoA at a time; must be a multiple of 4
+
+        // Calls fn(begin,end) over the whole range, in blocks of up to block_size, possibly in parallel
+        template< class Fn >
+        void for_each_block( size_t count, Fn fn )
+        {
+            auto blocks = [&fn]( size_t begin, size_t end )
+            {
+                for( auto i = begin; i < end; i += block_size )
+                    fn( i, std::min( i + block_size, end ) );
+            };
+            if( count < parallel_threshold )
+                blocks( 0, count );
+            else
+                rsutils::concurrency::worker_pool::shared().parallel_for( count, parallel_threshold / 2, blocks );
+        }
+
+#ifdef __SSSE3__
+
+        struct sse_coeffs
+        {
+            __m128 c[5];
+            __m128 one = _mm_set_ps1( 1.f );
+            __m128 two = _mm_set_ps1( 2.f );
+
+            explicit sse_coeffs( const rs2_intrinsics & intrin )
+            {
+                for( int i = 0; i < 5; ++i )
+                    c[i] = _mm_set_ps1( intrin.coeffs[i] );
+            }
+
+            // 1 + c0*r2 + c1*r2^2 + c4*r2^3, in the same order of evaluation as rs2_project_point_to_pixel
+            __m128 radial( __m128 r2 ) const
+            {
+                auto f = _mm_add_ps( one, _mm_mul_ps( c[0], r2 ) );
+                f = _mm_add_ps( f, _mm_mul_ps( _mm_mul_ps( c[1], r2 ), r2 ) );
+                return _mm_add_ps( f, _mm_mul_ps( _mm_mul_ps( _mm_mul_ps( c[4], r2 ), r2 ), r2 ) );
+            }
+
+            // 2*ca*x*y + cb*(r2 + 2*x*x)
+            __m128 tangential( __m128 ca, __m128 cb, __m128 x, __m128 y, __m128 r2 ) const
+            {
+                auto t1 = _mm_mul_ps( _mm_mul_ps( _mm_mul_ps( two, ca ), x ), y );
+                auto t2 = _mm_mul_ps( cb, _mm_add_ps( r2, _mm_mul_ps( _mm_mul_ps( two, x ), x ) ) );
+                return _mm_add_ps( t1, t2 );
+            }
+        };
+
+        template< rs2_distortion model >
+        inline void distort( __m128 & x, __m128 & y, const sse_coeffs & k )
+        {
+        }
+
+        template<>
+        inline void distort< RS2_DISTORTION_MODIFIED_BROWN_CONRADY >( __m128 & x, __m128 & y, const sse_coeffs & k )
+        {
+            auto r2 = _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) );
+            auto f = k.radial( r2 );
+            x = _mm_mul_ps( x, f );
+            y = _mm_mul_ps( y, f );
+            auto dx = _mm_add_ps( x, k.tangential( k.c[2], k.c[3], x, y, r2 ) );
+            auto dy = _mm_add_ps( y, k.tangential( k.c[3], k.c[2], y, x, r2 ) );
+            x = dx;
+            y = dy;
+        }
+
+        template<>
+        inline void distort< RS2_DISTORTION_INVERSE_BROWN_CONRADY >( __m128 & x, __m128 & y, const sse_coeffs & k )
+        {
+            distort< RS2_DISTORTION_MODIFIED_BROWN_CONRADY >( x, y, k );
+        }
+
+        template<>
+        inline void distort< RS2_DISTORTION_BROWN_CONRADY >( __m128 & x, __m128 & y, const sse_coeffs & k )
+        {
+            auto r2 = _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) );
+            auto f = k.radial( r2 );
+            auto dx = _mm_add_ps( _mm_mul_ps( x, f ), k.tangential( k.c[2], k.c[3], x, y, r2 ) );
+            auto dy = _mm_add_ps( _mm_mul_ps( y, f ), k.tangential( k.c[3], k.c[2], y, x, r2 ) );
+            x = dx;
+            y = dy;
+        }
+
+        template< rs2_distortion model >
+        inline void undistort( __m128 & x, __m128 & y, const sse_coeffs & k )
+        {
+        }
+
+        // 1 / (1 + ((c4*r2 + c1)*r2 + c0)*r2)
+        inline __m128 inverse_radial( __m128 r2, const sse_coeffs & k )
+        {
+            auto d = _mm_add_ps( _mm_mul_ps( k.c[4], r2 ), k.c[1] );
+            d = _mm_add_ps( _mm_mul_ps( d, r2 ), k.c[0] );
+            d = _mm_add_ps( k.one, _mm_mul_ps( d, r2 ) );
+            return _mm_div_ps( k.one, d );
+        }
+
+        template<>
+        inline void undistort< RS2_DISTORTION_INVERSE_BROWN_CONRADY >( __m128 & x, __m128 & y, const sse_coeffs & k )
+        {
+            auto xo = x;
+            auto yo = y;
+            // Same fixed number of iterations as rs2_deproject_pixel_to_point
+            for( int i = 0; i < 10; i++ )
+            {
+                auto r2 = _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) );
+                auto icdist = inverse_radial( r2, k );
+                auto xq = _mm_div_ps( x, icdist );
+                auto yq = _mm_div_ps( y, icdist );
+                auto delta_x = k.tangential( k.c[2], k.c[3], xq, yq, r2 );
+                auto delta_y = k.tangential( k.c[3], k.c[2], yq, xq, r2 );
+                x = _mm_mul_ps( _mm_sub_ps( xo, delta_x ), icdist );
+                y = _mm_mul_ps( _mm_sub_ps( yo, delta_y ), icdist );
+            }
+        }
+
+        template<>
+        inline void undistort< RS2_DISTORTION_BROWN_CONRADY >( __m128 & x, __m128 & y, const sse_coeffs & k )
+        {
+            auto xo = x;
+            auto yo = y;
+            for( int i = 0; i < 10; i++ )
+            {
+                auto r2 = _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) );
+                auto icdist = inverse_radial( r2, k );
+                auto delta_x = k.tangential( k.c[2], k.c[3], x, y, r2 );
+                auto delta_y = k.tangential( k.c[3], k.c[2], y, x, r2 );
+                x = _mm_mul_ps( _mm_sub_ps( xo, delta_x ), icdist );
+                y = _mm_mul_ps( _mm_sub_ps( yo, delta_y ), icdist );
+            }
+        }
+
+        // Structure-of-arrays staging area for one block
+        struct soa_block
+        {
+            alignas( 16 ) float x[block_size];
+            alignas( 16 ) float y[block_size];
+            alignas( 16 ) float z[block_size];
+        };
+
+        template< rs2_distortion model >
+        void project_sse( float * pixels, const rs2_intrinsics & intrin, const float * points, size_t count )
+        {
+            for_each_block( count, [&]( size_t begin, size_t end )
+            {
+                soa_block b;
+                size_t const n = end - begin;
+                auto p = points + 3 * begin;
+                for( size_t i = 0; i < n; ++i, p += 3 )
+                {
+                    b.x[i] = p[0];
+                    b.y[i] = p[1];
+                    b.z[i] = p[2];
+                }
+                size_t const n4 = ( n + 3 ) & ~size_t( 3 );
+                for( size_t i = n; i < n4; ++i )
+                {
+                    b.x[i] = b.y[i] = 0.f;
+                    b.z[i] = 1.f;
+                }
+
+                sse_coeffs const k( intrin );
+                auto const fx = _mm_set_ps1( intrin.fx ), fy = _mm_set_ps1( intrin.fy );
+                auto const ppx = _mm_set_ps1( intrin.ppx ), ppy = _mm_set_ps1( intrin.ppy );
+                for( size_t i = 0; i < n4; i += 4 )
+                {
+                    auto z = _mm_load_ps( b.z + i );
+                    auto x = _mm_div_ps( _mm_load_ps( b.x + i ), z );
+                    auto y = _mm_div_ps( _mm_load_ps( b.y + i ), z );
+                    distort< model >( x, y, k );
+                    _mm_store_ps( b.x + i, _mm_add_ps( _mm_mul_ps( x, fx ), ppx ) );
+                    _mm_store_ps( b.y + i, _mm_add_ps( _mm_mul_ps( y, fy ), ppy ) );
+                }
+
+                auto px = pixels + 2 * begin;
+                for( size_t i = 0; i < n; ++i, px += 2 )
+                {
+                    px[0] = b.x[i];
+                    px[1] = b.y[i];
+                }
+            } );
+        }
+
+        template< rs2_distortion model >
+        void deproject_sse( float * points,
+                            const rs2_intrinsics & intrin,
+                            const float * pixels,
+                            const float * depths,
+                            size_t count )
+        {
+            for_each_block( count, [&]( size_t begin, size_t end )
+            {
+                soa_block b;
+                size_t const n = end - begin;
+                auto px = pixels + 2 * begin;
+                for( size_t i = 0; i < n; ++i, px += 2 )
+                {
+                    b.x[i] = px[0];
+                    b.y[i] = px[1];
+                    b.z[i] = depths[begin + i];
+                }
+                size_t const n4 = ( n + 3 ) & ~size_t( 3 );
+                for( size_t i = n; i < n4; ++i )
+                    b.x[i] = b.y[i] = b.z[i] = 0.f;
+
+                sse_coeffs const k( intrin );
+                auto const fx = _mm_set_ps1( intrin.fx ), fy = _mm_set_ps1( intrin.fy );
+                auto const ppx = _mm_set_ps1( intrin.ppx ), ppy = _mm_set_ps1( intrin.ppy );
+                for( size_t i = 0; i < n4; i += 4 )
+                {
+                    auto x = _mm_div_ps( _mm_sub_ps( _mm_load_ps( b.x + i ), ppx ), fx );
+                    auto y = _mm_div_ps( _mm_sub_ps( _mm_load_ps( b.y + i ), ppy ), fy );
+                    undistort< model >( x, y, k );
+                    auto depth = _mm_load_ps( b.z + i );
+                    _mm_store_ps( b.x + i, _mm_mul_ps( depth, x ) );
+                    _mm_store_ps( b.y + i, _mm_mul_ps( depth, y ) );
+                }
+
+                auto p = points + 3 * begin;
+                for( size_t i = 0; i < n; ++i, p += 3 )
+                {
+                    p[0] = b.x[i];
+                    p[1] = b.y[i];
+                    p[2] = b.z[i];
+                }
+            } );
+        }
+
+#endif // __SSSE3__
+    }
+
+
+    void project_points_to_pixels( float * pixels, const rs2_intrinsics & intrin, const float * points, size_t count )
+    {
+#ifdef __SSSE3__
+        switch( intrin.model )
+        {
+        case RS2_DISTORTION_NONE:
+            return project_sse< RS2_DISTORTION_NONE >( pixels, intrin, points, count );
+        case RS2_DISTORTION_MODIFIED_BROWN_CONRADY:
+            return project_sse< RS2_DISTORTION_MODIFIED_BROWN_CONRADY >( pixels, intrin, points, count );
+        case RS2_DISTORTION_INVERSE_BROWN_CONRADY:
+            return project_sse< RS2_DISTORTION_INVERSE_BROWN_CONRADY >( pixels, intrin, points, count );
+        case RS2_DISTORTION_BROWN_CONRADY:
+            return project_sse< RS2_DISTORTION_BROWN_CONRADY >( pixels, intrin, points, count );
+        }
+#endif
+        // The trigonometric models (and everything when there's no SSE) use the single-point implementation
+        for_each_block( count, [&]( size_t begin, size_t end )
+        {
+            for( auto i = begin; i < end; ++i )
+                rs2_project_point_to_pixel( pixels + 2 * i, &intrin, points + 3 * i );
+        } );
+    }
+
+
+    void deproject_pixels_to_points( float * points,
+                                     const rs2_intrinsics & intrin,
+                                     const float * pixels,
+                                     const float * depths,
+                                     size_t count )
+    {
+#ifdef __SSSE3__
+        switch( intrin.model )
+        {
+        case RS2_DISTORTION_NONE:
+        case RS2_DISTORTION_MODIFIED_BROWN_CONRADY:  // cannot be deprojected; treated as undistorted, as in the single-point version
+            return deproject_sse< RS2_DISTORTION_NONE >( points, intrin, pixels, depths, count );
+        case RS2_DISTORTION_INVERSE_BROWN_CONRADY:
+            return deproject_sse< RS2_DISTORTION_INVERSE_BROWN_CONRADY >( points, intrin, pixels, depths, count );
+        case RS2_DISTORTION_BROWN_CONRADY:
+            return deproject_sse< RS2_DISTORTION_BROWN_CONRADY >( points, intrin, pixels, depths, count );
+        }
+#endif
+        for_each_block( count, [&]( size_t begin, size_t end )
+        {
+            for( auto i = begin; i < end; ++i )
+                rs2_deproject_pixel_to_point( points + 3 * i, &intrin, pixels + 2 * i, depths[i] );
+        } );
+    }
+
+
+    void transform_points_to_points( float * to_points,
+                                     const rs2_extrinsics & extrin,
+                                     const float * from_points,
+                                     size_t count )
+    {
+        // Simple enough for the compiler to vectorize on its own
+        auto const & r = extrin.rotation;
+        auto const & t = extrin.translation;
+        for_each_block( count, [&]( size_t begin, size_t end )
+        {
+            auto from = from_points + 3 * begin;
+            auto to = to_points + 3 * begin;
+            for( auto i = begin; i < end; ++i, from += 3, to += 3 )
+            {
+                float const x = from[0], y = from[1], z = from[2];
+                to[0] = r[0] * x + r[3] * y + r[6] * z + t[0];
+                to[1] = r[1] * x + r[4] * y + r[7] * z + t[1];
+                to[2] = r[2] * x + r[5] * y + r[8] * z + t[2];
+            }
+        } );
+    }
+}
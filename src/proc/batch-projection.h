@@ -0,0 +1,38 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/h/rs_types.h>
+#include <librealsense2/h/rs_sensor.h>
+#include <cstddef>
+
+
+namespace librealsense
+{
+    // Array versions of rs2_project_point_to_pixel, rs2_deproject_pixel_to_point and rs2_transform_point_to_point.
+    //
+    // Points are 'count' interleaved (x,y,z) triplets and pixels are interleaved (x,y) pairs, i.e. the layout of an
+    // Nx3 / Nx2 row-major array. Results match the single-point functions (up to float rounding).
+    //
+    // The distortion model is dispatched once per call rather than per point; the Brown-Conrady variants and the
+    // undistorted model are computed four points at a time with SSE, and large batches are split over the shared
+    // worker pool.
+    //
+    void project_points_to_pixels( float * pixels,
+                                   const rs2_intrinsics & intrin,
+                                   const float * points,
+                                   size_t count );
+
+    // 'depths' holds one depth per pixel, in the same units the resulting points will be in
+    void deproject_pixels_to_points( float * points,
+                                     const rs2_intrinsics & intrin,
+                                     const float * pixels,
+                                     const float * depths,
+                                     size_t count );
+
+    void transform_points_to_points( float * to_points,
+                                     const rs2_extrinsics & extrin,
+                                     const float * from_points,
+                                     size_t count );
+}
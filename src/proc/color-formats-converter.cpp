@@ -7,6 +7,11 @@
 #include "image-avx.h"
 #include "image.h"
 
+#include <rsutils/concurrency/worker-pool.h>
+
+#include <algorithm>
+#include <limits>
+
 #define STB_IMAGE_STATIC
 #define STB_IMAGE_IMPLEMENTATION
 #include "../third-party/stb_image.h"
@@ -745,27 +750,80 @@ namespace librealsense
 #endif // __SSSE3__
     }
 
-    void unpack_yuy2(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size)
+    namespace
+    {
+        // Frames smaller than this (in pixels) are converted on the calling thread: not worth waking up others for
+        const size_t parallel_threshold = 256 * 1024;
+
+        typedef void ( *unpack_function )( uint8_t * const d[], const uint8_t * s, int width, int height, int actual_size );
+
+        // Unpacks the frame in bands of rows, in parallel on the pool when it is large enough. Bands are made of whole
+        // steps of 'step_rows' rows, 'src_step' bytes apart in the source and 'dst_step' bytes in the destination, and
+        // the last band takes any rows left over.
+        void unpack_in_bands( unpack_function unpack, uint8_t * const d[], const uint8_t * s, int width, int height,
+                              int actual_size, int step_rows, size_t src_step, size_t dst_step,
+                              rsutils::concurrency::worker_pool * pool )
+        {
+            size_t const steps = height / step_rows;
+            if( size_t( width ) * height < parallel_threshold || steps < 2 )
+            {
+                unpack( d, s, width, height, actual_size );
+                return;
+            }
+
+            if( ! pool )
+                pool = &rsutils::concurrency::worker_pool::shared();
+            auto min_steps = std::max< size_t >( 1, parallel_threshold / 4 / ( size_t( width ) * step_rows ) );
+            pool->parallel_for( steps, min_steps, [&]( size_t begin, size_t end )
+            {
+                int const rows = ( end == steps ? height : int( end ) * step_rows ) - int( begin ) * step_rows;
+                uint8_t * const band[] = { d[0] + begin * dst_step };
+                unpack( band, s + begin * src_step, width, rows, actual_size );
+            } );
+        }
+
+        // The SIMD loops convert 16 (SSSE3) or 32 (AVX2) pixels at a time, so YUY2 and UYVY bands hold whole multiples
+        // of 32 pixels, which leaves the frame's own remainder to the last band
+        int packed_yuv_step_rows( int width )
+        {
+#ifdef RS2_USE_CUDA
+            return std::numeric_limits< int >::max();  // CUDA converts the whole frame at once
+#else
+            int rows = 1;
+            while( width * rows % 32 )
+                ++rows;
+            return rows;
+#endif
+        }
+    }
+
+    void unpack_yuy2(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size, rsutils::concurrency::worker_pool * pool)
     {
+        auto const step_rows = packed_yuv_step_rows( w );
+        auto in_bands = [&]( unpack_function unpack, int bpp )
+        {
+            unpack_in_bands( unpack, d, s, w, h, actual_size, step_rows, size_t( w ) * step_rows * 2,
+                             size_t( w ) * step_rows * bpp, pool );
+        };
         switch (dst_format)
         {
         case RS2_FORMAT_RGB8:
-            unpack_yuy2<RS2_FORMAT_RGB8>(d, s, w, h, actual_size);
+            in_bands(unpack_yuy2<RS2_FORMAT_RGB8>, 3);
             break;
         case RS2_FORMAT_Y8:
-            unpack_yuy2<RS2_FORMAT_Y8>(d, s, w, h, actual_size);
+            in_bands(unpack_yuy2<RS2_FORMAT_Y8>, 1);
             break;
         case RS2_FORMAT_RGBA8:
-            unpack_yuy2<RS2_FORMAT_RGBA8>(d, s, w, h, actual_size);
+            in_bands(unpack_yuy2<RS2_FORMAT_RGBA8>, 4);
             break;
         case RS2_FORMAT_BGR8:
-            unpack_yuy2<RS2_FORMAT_BGR8>(d, s, w, h, actual_size);
+            in_bands(unpack_yuy2<RS2_FORMAT_BGR8>, 3);
             break;
         case RS2_FORMAT_BGRA8:
-            unpack_yuy2<RS2_FORMAT_BGRA8>(d, s, w, h, actual_size);
+            in_bands(unpack_yuy2<RS2_FORMAT_BGRA8>, 4);
             break;
         case RS2_FORMAT_Y16:
-            unpack_yuy2<RS2_FORMAT_Y16>( d, s, w, h, actual_size );
+            in_bands(unpack_yuy2<RS2_FORMAT_Y16>, 2);
             break;
         default:
             LOG_ERROR("Unsupported format for YUY2 conversion.");
@@ -773,28 +831,33 @@ namespace librealsense
         }
     }
 
-    void unpack_m420(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size)
+    void unpack_m420(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size, rsutils::concurrency::worker_pool * pool)
     {
         LOG_DEBUG("unpack m420 called with dst_format: " << rs2_format_to_string(dst_format));
+        // Bands of line pairs, which share a line of UV
+        auto in_bands = [&]( unpack_function unpack, int bpp )
+        {
+            unpack_in_bands( unpack, d, s, w, h, actual_size, 2, size_t( w ) * 3, size_t( w ) * 2 * bpp, pool );
+        };
         switch (dst_format)
         {
         case RS2_FORMAT_Y8:
-            unpack_m420<RS2_FORMAT_Y8>(d, s, w, h, actual_size);
+            in_bands(unpack_m420<RS2_FORMAT_Y8>, 1);
             break;
         case RS2_FORMAT_Y16:
-            unpack_m420<RS2_FORMAT_Y16>(d, s, w, h, actual_size);
+            in_bands(unpack_m420<RS2_FORMAT_Y16>, 2);
             break;
         case RS2_FORMAT_RGB8:
-            unpack_m420<RS2_FORMAT_RGB8>(d, s, w, h, actual_size);
+            in_bands(unpack_m420<RS2_FORMAT_RGB8>, 3);
             break;
         case RS2_FORMAT_RGBA8:
-            unpack_m420<RS2_FORMAT_RGBA8>(d, s, w, h, actual_size);
+            in_bands(unpack_m420<RS2_FORMAT_RGBA8>, 4);
             break;
         case RS2_FORMAT_BGR8:
-            unpack_m420<RS2_FORMAT_BGR8>(d, s, w, h, actual_size);
+            in_bands(unpack_m420<RS2_FORMAT_BGR8>, 3);
             break;
         case RS2_FORMAT_BGRA8:
-            unpack_m420<RS2_FORMAT_BGRA8>(d, s, w, h, actual_size);
+            in_bands(unpack_m420<RS2_FORMAT_BGRA8>, 4);
             break;
         default:
             LOG_ERROR("Unsupported format for M420 conversion.");
@@ -1046,21 +1109,27 @@ namespace librealsense
 #endif
     }
 
-    void unpack_uyvyc(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size)
+    void unpack_uyvyc(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size, rsutils::concurrency::worker_pool * pool)
     {
+        auto const step_rows = packed_yuv_step_rows( w );
+        auto in_bands = [&]( unpack_function unpack, int bpp )
+        {
+            unpack_in_bands( unpack, d, s, w, h, actual_size, step_rows, size_t( w ) * step_rows * 2,
+                             size_t( w ) * step_rows * bpp, pool );
+        };
         switch (dst_format)
         {
         case RS2_FORMAT_RGB8:
-            unpack_uyvy<RS2_FORMAT_RGB8>(d, s, w, h, actual_size);
+            in_bands(unpack_uyvy<RS2_FORMAT_RGB8>, 3);
             break;
         case RS2_FORMAT_RGBA8:
-            unpack_uyvy<RS2_FORMAT_RGBA8>(d, s, w, h, actual_size);
+            in_bands(unpack_uyvy<RS2_FORMAT_RGBA8>, 4);
             break;
         case RS2_FORMAT_BGR8:
-            unpack_uyvy<RS2_FORMAT_BGR8>(d, s, w, h, actual_size);
+            in_bands(unpack_uyvy<RS2_FORMAT_BGR8>, 3);
             break;
         case RS2_FORMAT_BGRA8:
-            unpack_uyvy<RS2_FORMAT_BGRA8>(d, s, w, h, actual_size);
+            in_bands(unpack_uyvy<RS2_FORMAT_BGRA8>, 4);
             break;
         default:
             LOG_ERROR("Unsupported format for UYVY conversion.");
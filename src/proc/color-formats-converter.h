@@ -5,8 +5,23 @@
 
 #include "synthetic-stream.h"
 
+namespace rsutils {
+namespace concurrency {
+    class worker_pool;
+}
+}
+
 namespace librealsense
 {
+    // YUY2, UYVY and M420 unpacking. Large frames are split into bands of rows, converted in parallel on the pool (the
+    // shared pool when none is given); small ones are converted on the calling thread.
+    void unpack_yuy2(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size,
+        rsutils::concurrency::worker_pool * pool = nullptr);
+    void unpack_uyvyc(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size,
+        rsutils::concurrency::worker_pool * pool = nullptr);
+    void unpack_m420(rs2_format dst_format, rs2_stream dst_stream, uint8_t * const d[], const uint8_t * s, int w, int h, int actual_size,
+        rsutils::concurrency::worker_pool * pool = nullptr);
+
     class LRS_EXTENSION_API color_converter : public functional_processing_block
     {
     protected:
@@ -238,6 +238,7 @@ namespace librealsense
         register_option(RS2_OPTION_VISUAL_PRESET, preset_opt);
 
         register_option(RS2_OPTION_HISTOGRAM_EQUALIZATION_ENABLED, hist_opt);
+        _roi.register_to(*this);
     }
 
     bool colorizer::should_process(const rs2::frame& frame)
@@ -270,6 +271,7 @@ namespace librealsense
         {
             auto depth_format = depth.get_profile().format();
             const auto w = depth.get_width(), h = depth.get_height();
+            auto roi = _roi.get(depth, w, h);
             auto rgb_data = reinterpret_cast<uint8_t*>(const_cast<void *>(rgb.get_data()));
             auto coloring_function = [&, this](float data) {
                 auto hist_data = _hist_data[(int)data];
@@ -280,14 +282,14 @@ namespace librealsense
             if (depth_format == RS2_FORMAT_DISPARITY32)
             {
                 auto depth_data = reinterpret_cast<const float*>(depth.get_data());
-                update_histogram(_hist_data, depth_data, w, h);
-                make_rgb_data<float>(depth_data, rgb_data, w, h, coloring_function);
+                update_histogram(_hist_data, depth_data, w, roi);
+                make_rgb_data<float>(depth_data, rgb_data, w, h, roi, coloring_function);
             }
             else if (depth_format == RS2_FORMAT_Z16)
             {
                 auto depth_data = reinterpret_cast<const uint16_t*>(depth.get_data());
-                update_histogram(_hist_data, depth_data, w, h);
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+                update_histogram(_hist_data, depth_data, w, roi);
+                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, roi, coloring_function);
             }
         };
 
@@ -295,6 +297,7 @@ namespace librealsense
         {
             auto depth_format = depth.get_profile().format();
             const auto w = depth.get_width(), h = depth.get_height();
+            auto roi = _roi.get(depth, w, h);
             auto rgb_data = reinterpret_cast<uint8_t*>(const_cast<void *>(rgb.get_data()));
 
             if (depth_format == RS2_FORMAT_DISPARITY32)
@@ -309,7 +312,7 @@ namespace librealsense
                 auto coloring_function = [&, this](float data) {
                     return (data - min) / (max - min);
                 };
-                make_rgb_data<float>(depth_data, rgb_data, w, h, coloring_function);
+                make_rgb_data<float>(depth_data, rgb_data, w, h, roi, coloring_function);
             }
             else if (depth_format == RS2_FORMAT_Z16)
             {
@@ -320,7 +323,7 @@ namespace librealsense
                     if (min >= max) return 0.f;
                     return (data * _depth_units - min) / (max - min);
                 };
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, roi, coloring_function);
             }
         };
 
@@ -328,6 +331,7 @@ namespace librealsense
 
         auto vf = f.as<rs2::video_frame>();
         ret = source.allocate_video_frame(_target_stream_profile, f, 3, vf.get_width(), vf.get_height(), vf.get_width() * 3, RS2_EXTENSION_VIDEO_FRAME);
+        _roi.apply(f, ret);
 
         if (_equalize)
             make_equalized_histogram(f, ret);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <src/float3.h>
+#include "roi-options.h"
 
 #include <map>
 #include <vector>
@@ -103,13 +104,23 @@ namespace librealsense {
 
         template<typename T>
         static void update_histogram(int* hist, const T* depth_data, int w, int h)
+        {
+            update_histogram(hist, depth_data, w, pixel_roi{ 0, 0, w, h });
+        }
+
+        // Histogram of the region of interest only, of an image w pixels wide
+        template<typename T>
+        static void update_histogram(int* hist, const T* depth_data, int w, const pixel_roi& roi)
         {
             memset(hist, 0, MAX_DEPTH * sizeof(int));
-            for (auto i = 0; i < w*h; ++i)
+            for (auto y = roi.min_y; y < roi.max_y; ++y)
             {
-                T depth_val = depth_data[i];
-                int index = static_cast< int >( depth_val );
-                hist[index] += 1;
+                for (auto i = y * w + roi.min_x, row_end = y * w + roi.max_x; i < row_end; ++i)
+                {
+                    T depth_val = depth_data[i];
+                    int index = static_cast< int >( depth_val );
+                    hist[index] += 1;
+                }
             }
 
             for (auto i = 2; i < MAX_DEPTH; ++i) hist[i] += hist[i - 1]; // Build a cumulative histogram for the indices in [1,0xFFFF]
@@ -124,14 +135,21 @@ namespace librealsense {
         bool should_process(const rs2::frame& frame) override;
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
+        // Colorizes the region of interest; the rest of the image is left black
         template<typename T, typename F>
-        void make_rgb_data(const T* depth_data, uint8_t* rgb_data, int width, int height, F coloring_func)
+        void make_rgb_data(const T* depth_data, uint8_t* rgb_data, int width, int height, const pixel_roi& roi, F coloring_func)
         {
+            if (roi.width() != width || roi.height() != height)
+                memset(rgb_data, 0, size_t(width) * height * 3);
+
             auto cm = _maps[_map_index];
-            for (auto i = 0; i < width*height; ++i)
+            for (auto y = roi.min_y; y < roi.max_y; ++y)
             {
-                auto d = depth_data[i];
-                colorize_pixel(rgb_data, i, cm, d, coloring_func);
+                for (auto i = y * width + roi.min_x, row_end = y * width + roi.max_x; i < row_end; ++i)
+                {
+                    auto d = depth_data[i];
+                    colorize_pixel(rgb_data, i, cm, d, coloring_func);
+                }
             }
         }
 
@@ -169,5 +187,7 @@ namespace librealsense {
 
         float   _depth_units = 0.f;
         float   _d2d_convert_factor = 0.f;
+
+        roi_options _roi;
     };
 }
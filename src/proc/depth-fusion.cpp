@@ -0,0 +1,233 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "depth-fusion.h"
+#include <src/environment.h>
+#include <src/option.h>
+#include <src/stream.h>
+#include <src/points.h>
+
+#include <librealsense2/rs.hpp>
+
+#include <rsutils/concurrency/worker-pool.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+
+namespace librealsense
+{
+    depth_fusion::depth_fusion()
+        : generic_processing_block( "Depth Fusion" )
+    {
+        auto voxel_size = std::make_shared< ptr_option< float > >( 0.f, 1.f, 0.001f, 0.f, &_voxel_size,
+                                                                   "Voxel edge length in meters; 0 for no downsampling" );
+        register_option( RS2_OPTION_VOXEL_SIZE, voxel_size );
+    }
+
+    bool depth_fusion::should_process( const rs2::frame & frame )
+    {
+        if( ! frame )
+            return false;
+
+        if( auto set = frame.as< rs2::frameset >() )
+            return bool( set.first_or_default( RS2_STREAM_DEPTH, RS2_FORMAT_Z16 ) );
+
+        return frame.is< rs2::depth_frame >() && frame.get_profile().format() == RS2_FORMAT_Z16;
+    }
+
+    void depth_fusion::update_camera( camera & cam, const rs2::depth_frame & depth )
+    {
+        cam.depth = depth;
+        cam.stride = depth.get_stride_in_bytes();
+
+        auto profile = depth.get_profile();
+        if( profile.get() != cam.profile.get() || _reference_profile.get() != cam.reference.get() )
+        {
+            cam.profile = profile;
+            cam.reference = _reference_profile;
+            cam.intrinsics = profile.as< rs2::video_stream_profile >().get_intrinsics();
+            cam.has_extrinsics = false;
+            cam.frames_until_retry = 0;
+        }
+
+        if( ! cam.has_extrinsics )
+        {
+            if( cam.frames_until_retry > 0 )
+            {
+                --cam.frames_until_retry;
+                return;
+            }
+            cam.extrinsics = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0, 0, 0 } };
+            if( profile.unique_id() != _reference_id )
+            {
+                const rs2_stream_profile * from = profile;
+                const rs2_stream_profile * to = _reference_profile;
+                if( ! environment::get_instance().get_extrinsics_graph().try_fetch_extrinsics( *from->profile,
+                                                                                               *to->profile,
+                                                                                               &cam.extrinsics ) )
+                {
+                    if( ! cam.missing_extrinsics_logged )
+                        LOG_WARNING( "No extrinsics from " << profile.stream_name() << " #" << profile.unique_id()
+                                                           << " to the fusion reference; ignoring its depth" );
+                    cam.missing_extrinsics_logged = true;
+                    cam.frames_until_retry = extrinsics_retry_frames;
+                    return;
+                }
+            }
+            cam.has_extrinsics = true;
+            cam.missing_extrinsics_logged = false;
+        }
+
+        // The units can change from frame to frame; the rays are only rebuilt when they do
+        cam.rays.update( cam.intrinsics, depth.get_units(), cam.extrinsics );
+    }
+
+    void depth_fusion::forget_stale_cameras()
+    {
+        auto const limit = uint64_t( stale_frames ) * _cameras.size();
+        for( auto it = _cameras.begin(); it != _cameras.end(); )
+        {
+            if( _frame_count - it->second.last_frame <= limit )
+            {
+                ++it;
+                continue;
+            }
+            if( it->first == _reference_id )
+            {
+                _reference_id = -1;
+                _reference_profile = {};
+            }
+            it = _cameras.erase( it );
+        }
+    }
+
+    rs2::frame depth_fusion::process_frame( const rs2::frame_source & source, const rs2::frame & f )
+    {
+        std::vector< rs2::frame > depths;
+        if( auto set = f.as< rs2::frameset >() )
+        {
+            set.foreach_rs( [&]( const rs2::frame & frame ) {
+                if( frame.is< rs2::depth_frame >() && frame.get_profile().format() == RS2_FORMAT_Z16 )
+                    depths.push_back( frame );
+            } );
+        }
+        else
+            depths.push_back( f );
+
+        _frame_count += depths.size();
+        for( auto & depth : depths )
+            _cameras[depth.get_profile().unique_id()].last_frame = _frame_count;
+        forget_stale_cameras();
+
+        rs2::frame reference;
+        for( auto & depth : depths )
+        {
+            auto profile = depth.get_profile();
+            if( _reference_id < 0 )
+            {
+                _reference_id = profile.unique_id();
+                _reference_profile = profile;
+                _output_profile = profile.as< rs2::video_stream_profile >().clone( RS2_STREAM_DEPTH,
+                                                                                  profile.stream_index(),
+                                                                                  RS2_FORMAT_XYZ32F );
+            }
+            if( profile.unique_id() == _reference_id )
+                reference = depth;
+        }
+        // The reference first, since the others are transformed into it
+        if( reference )
+            update_camera( _cameras[_reference_id], reference );
+        for( auto & depth : depths )
+            if( depth.get() != reference.get() )
+                update_camera( _cameras[depth.get_profile().unique_id()], depth );
+
+        if( ! reference )
+            return {};
+        return fuse( reference );
+    }
+
+    rs2::frame depth_fusion::fuse( const rs2::frame & reference )
+    {
+        std::vector< camera * > cameras;
+        std::vector< size_t > first_rows;
+        size_t n_rows = 0;
+        for( auto & id_camera : _cameras )
+        {
+            auto & cam = id_camera.second;
+            if( ! cam.depth || ! cam.has_extrinsics )
+                continue;
+            cameras.push_back( &cam );
+            first_rows.push_back( n_rows );
+            n_rows += cam.rays.height();
+        }
+
+        // All rows of all cameras are processed as one range, so the work is balanced across the pool
+        auto for_each_row = [&]( std::function< void( camera &, const uint16_t *, size_t row_in_camera, size_t row ) > fn )
+        {
+            rsutils::concurrency::worker_pool::shared().parallel_for(
+                n_rows,
+                32,
+                [&]( size_t begin, size_t end )
+                {
+                    auto i = size_t( std::upper_bound( first_rows.begin(), first_rows.end(), begin ) - first_rows.begin() ) - 1;
+                    for( auto row = begin; row < end; ++row )
+                    {
+                        while( i + 1 < first_rows.size() && row >= first_rows[i + 1] )
+                            ++i;
+                        auto & cam = *cameras[i];
+                        auto const y = row - first_rows[i];
+                        auto depth = reinterpret_cast< const uint16_t * >(
+                            reinterpret_cast< const uint8_t * >( cam.depth.get_data() ) + y * cam.stride );
+                        fn( cam, depth, y, row );
+                    }
+                } );
+        };
+
+        // First count the valid pixels of each row, which gives every row its place in the output...
+        _row_offsets.resize( n_rows + 1 );
+        _row_offsets[0] = 0;
+        for_each_row( [&]( camera & cam, const uint16_t * depth, size_t, size_t row )
+        {
+            _row_offsets[row + 1] = cam.rays.width() - std::count( depth, depth + cam.rays.width(), uint16_t( 0 ) );
+        } );
+        std::partial_sum( _row_offsets.begin(), _row_offsets.end(), _row_offsets.begin() );
+        size_t const n_points = _row_offsets.back();
+
+        // ... then deproject and transform straight into it
+        auto fill = [&]( float3 * points )
+        {
+            for_each_row( [&]( camera & cam, const uint16_t * depth, size_t y, size_t row )
+            {
+                cam.rays.deproject_valid( points + _row_offsets[row], depth, int( y ), 0, cam.rays.width() );
+            } );
+        };
+
+        auto output_profile
+            = std::dynamic_pointer_cast< stream_profile_interface >( _output_profile.get()->profile->shared_from_this() );
+        auto original = (frame_interface *)reference.get();
+        float const voxel_size = _voxel_size;
+
+        frame_interface * output;
+        if( voxel_size > 0.f )
+        {
+            _merged.resize( n_points );
+            fill( _merged.data() );
+            _grid.reset( voxel_size );
+            _grid.add( _merged.data(), n_points );
+
+            output = _source_wrapper.allocate_points( output_profile, original, _grid.size() );
+            _grid.get_centroids( ( (points *)output )->get_vertices() );
+        }
+        else
+        {
+            output = _source_wrapper.allocate_points( output_profile, original, n_points );
+            fill( ( (points *)output )->get_vertices() );
+        }
+
+        auto pts = (points *)output;
+        std::memset( pts->get_texture_coordinates(), 0, pts->get_vertex_count() * sizeof( float2 ) );
+        return rs2::frame( (rs2_frame *)output );
+    }
+}
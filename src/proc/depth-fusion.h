@@ -0,0 +1,86 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "depth-rays.h"
+#include "voxel-grid.h"
+#include <src/float3.h>
+
+#include <map>
+
+
+namespace librealsense
+{
+    // Fuses the depth of several calibrated cameras into a single point cloud.
+    //
+    // Depth frames (or framesets containing them) from any number of devices are fed into the same block. The latest
+    // frame of each depth stream is kept, and whenever a frame of the reference stream arrives, the latest depth of
+    // every camera is deprojected directly into the coordinate system of the reference and emitted as one points
+    // frame. Frames of the other cameras are passed through unchanged. The reference is the first depth stream the
+    // block receives; the other cameras need a known extrinsic path to it in the extrinsics graph (e.g., from
+    // rs2_register_extrinsics). Cameras without one are left out until it becomes available.
+    //
+    // A stream that stops delivering (e.g., when the cameras are restarted, which gives their streams new profiles) is
+    // forgotten once the others have each delivered stale_frames frames without it. If it was the reference, the next
+    // depth stream to deliver becomes the reference.
+    //
+    // Deprojection and transformation are combined into one multiply-add per pixel using a per-camera table of rays
+    // (see depth_rays), already rotated into the reference. Invalid (zero) depth is skipped, so the output holds only valid points, without texture
+    // coordinates and without the image layout of a regular pointcloud.
+    //
+    // With a non-zero voxel size, the merged points are further reduced to one point (the centroid) per occupied voxel.
+    //
+    class depth_fusion : public generic_processing_block
+    {
+    public:
+        depth_fusion();
+
+    protected:
+        bool should_process( const rs2::frame & frame ) override;
+        rs2::frame process_frame( const rs2::frame_source & source, const rs2::frame & f ) override;
+
+    private:
+        // Frames each of the other streams deliver before a silent one is forgotten
+        static const int stale_frames = 30;
+
+        // Frames of a camera between attempts to find its (missing) extrinsics
+        static const int extrinsics_retry_frames = 30;
+
+        struct camera
+        {
+            rs2::frame depth;                 // latest frame
+            uint64_t last_frame = 0;          // _frame_count when it arrived
+            int stride = 0;
+
+            // What the rays were built from, fetched again only when the profile or the reference changes
+            rs2::stream_profile profile;
+            rs2::stream_profile reference;
+            rs2_intrinsics intrinsics{};
+            rs2_extrinsics extrinsics{};
+            depth_rays rays;                  // into the reference
+            bool has_extrinsics = false;
+            int frames_until_retry = 0;       // while the extrinsics are missing
+            bool missing_extrinsics_logged = false;
+        };
+
+        void update_camera( camera & cam, const rs2::depth_frame & depth );
+        void forget_stale_cameras();
+        rs2::frame fuse( const rs2::frame & reference );
+
+        float _voxel_size = 0.f;
+
+        std::map< int, camera > _cameras;     // by depth stream unique-id
+        uint64_t _frame_count = 0;            // depth frames received
+        int _reference_id = -1;
+        rs2::stream_profile _reference_profile;
+        rs2::stream_profile _output_profile;
+
+        // Kept between frames so a steady stream of frames does not allocate
+        std::vector< size_t > _row_offsets;
+        std::vector< float3 > _merged;
+        voxel_grid _grid;
+    };
+    MAP_EXTENSION( RS2_EXTENSION_DEPTH_FUSION, librealsense::depth_fusion );
+}
@@ -0,0 +1,51 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "depth-rays.h"
+#include "batch-projection.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace librealsense
+{
+    static const rs2_extrinsics identity = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0, 0, 0 } };
+
+    bool depth_rays::update( const rs2_intrinsics & intrin, float depth_units )
+    {
+        return update( intrin, depth_units, identity );
+    }
+
+    bool depth_rays::update( const rs2_intrinsics & intrin, float depth_units, const rs2_extrinsics & to_target )
+    {
+        if( ! _rays.empty() && _units == depth_units && ! std::memcmp( &_intrinsics, &intrin, sizeof( intrin ) )
+            && ! std::memcmp( &_extrinsics, &to_target, sizeof( to_target ) ) )
+            return false;
+
+        _intrinsics = intrin;
+        _extrinsics = to_target;
+        _units = depth_units;
+
+        size_t const n = size_t( intrin.width ) * intrin.height;
+        std::vector< float > pixels( n * 2 );
+        std::vector< float > ones( n, 1.f );
+        auto pixel = pixels.data();
+        for( int y = 0; y < intrin.height; ++y )
+            for( int x = 0; x < intrin.width; ++x )
+            {
+                *pixel++ = float( x );
+                *pixel++ = float( y );
+            }
+        _rays.resize( n );
+        deproject_pixels_to_points( &_rays[0].x, intrin, pixels.data(), ones.data(), n );
+
+        rs2_extrinsics rotation = to_target;
+        for( auto & r : rotation.rotation )
+            r *= depth_units;
+        std::fill( std::begin( rotation.translation ), std::end( rotation.translation ), 0.f );
+        transform_points_to_points( &_rays[0].x, rotation, &_rays[0].x, n );
+        _translation = { to_target.translation[0], to_target.translation[1], to_target.translation[2] };
+        return true;
+    }
+}
@@ -0,0 +1,68 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/h/rs_types.h>
+#include <librealsense2/h/rs_sensor.h>
+#include <src/float3.h>
+
+#include <cstdint>
+#include <vector>
+
+
+namespace librealsense
+{
+    // Deprojection table for a depth stream.
+    //
+    // Every deprojection model is linear in depth, so the point of pixel (x,y) with raw depth d is simply d * ray(x,y).
+    // With the depth units folded into the rays, and optionally an extrinsic rotation too, deprojecting and
+    // transforming a pixel costs one multiply-add per coordinate:
+    //     point = ray(x,y) * d + translation
+    // The table is only rebuilt when something it depends on changes.
+    //
+    class depth_rays
+    {
+    public:
+        // Returns true if the table had to be rebuilt
+        bool update( const rs2_intrinsics & intrin, float depth_units );
+        bool update( const rs2_intrinsics & intrin, float depth_units, const rs2_extrinsics & to_target );
+
+        int width() const { return _intrinsics.width; }
+        int height() const { return _intrinsics.height; }
+        const rs2_intrinsics & intrinsics() const { return _intrinsics; }
+        const float3 & translation() const { return _translation; }
+        const float3 * row( int y ) const { return _rays.data() + size_t( y ) * _intrinsics.width; }
+
+        float3 deproject( int x, int y, uint16_t d ) const
+        {
+            auto & r = row( y )[x];
+            float const z = d;
+            return { r.x * z + _translation.x, r.y * z + _translation.y, r.z * z + _translation.z };
+        }
+
+        // Deproject the valid (non-zero) pixels of row y in [x_begin,x_end), stepping by 'stride' pixels. Returns
+        // the end of the output.
+        float3 * deproject_valid( float3 * out, const uint16_t * depth_row, int y, int x_begin, int x_end,
+                                  int stride = 1 ) const
+        {
+            auto const ray = row( y );
+            auto const t = _translation;
+            for( int x = x_begin; x < x_end; x += stride )
+            {
+                if( ! depth_row[x] )
+                    continue;
+                float const d = depth_row[x];
+                *out++ = { ray[x].x * d + t.x, ray[x].y * d + t.y, ray[x].z * d + t.z };
+            }
+            return out;
+        }
+
+    private:
+        rs2_intrinsics _intrinsics{};
+        rs2_extrinsics _extrinsics{};
+        float _units = 0.f;
+        std::vector< float3 > _rays;
+        float3 _translation{ 0, 0, 0 };
+    };
+}
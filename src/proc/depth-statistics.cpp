@@ -0,0 +1,200 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "depth-statistics.h"
+#include <src/option.h>
+#include <src/frame.h>
+
+#include <librealsense2/rs.hpp>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace librealsense
+{
+    namespace
+    {
+        // Copies n pixels, counting them into the histogram and adding up the depth and number of the valid ones
+        void scan_pixels( const uint16_t * in, uint16_t * out, int n, uint32_t * histogram, uint64_t & sum,
+                          uint64_t & valid )
+        {
+            int i = 0;
+#ifdef __SSE2__
+            // Partial sums are flushed before they can overflow: each step adds two pixels to the 32-bit sum of a lane
+            int const flush_steps = 0x4000;
+            auto const zero = _mm_setzero_si128();
+            alignas( 16 ) uint16_t pixels[8];
+            alignas( 16 ) uint32_t sums[4];
+            alignas( 16 ) uint16_t zeros[8];
+            while( i + 8 <= n )
+            {
+                auto sum32 = zero;
+                auto zeros16 = zero;
+                int const begin = i;
+                for( int step = 0; step < flush_steps && i + 8 <= n; ++step, i += 8 )
+                {
+                    auto const v = _mm_loadu_si128( reinterpret_cast< const __m128i * >( in + i ) );
+                    _mm_storeu_si128( reinterpret_cast< __m128i * >( out + i ), v );
+                    sum32 = _mm_add_epi32( sum32, _mm_add_epi32( _mm_unpacklo_epi16( v, zero ),
+                                                                 _mm_unpackhi_epi16( v, zero ) ) );
+                    zeros16 = _mm_sub_epi16( zeros16, _mm_cmpeq_epi16( v, zero ) );  // +1 per invalid pixel
+
+                    _mm_store_si128( reinterpret_cast< __m128i * >( pixels ), v );
+                    for( auto d : pixels )
+                        ++histogram[d];
+                }
+                _mm_store_si128( reinterpret_cast< __m128i * >( sums ), sum32 );
+                _mm_store_si128( reinterpret_cast< __m128i * >( zeros ), zeros16 );
+                valid += i - begin;
+                for( auto s : sums )
+                    sum += s;
+                for( auto z : zeros )
+                    valid -= z;
+            }
+#endif
+            for( ; i < n; ++i )
+            {
+                auto const d = in[i];
+                out[i] = d;
+                ++histogram[d];
+                sum += d;
+                valid += d != 0;
+            }
+        }
+
+        // Depth, in depth units, at or below which 'rank' of the valid pixels are; 'cumulative' counts the pixels of
+        // each depth and below, starting from depth 1
+        uint16_t depth_at_rank( const std::vector< uint32_t > & cumulative, uint64_t rank )
+        {
+            auto it = std::lower_bound( cumulative.begin() + 1, cumulative.end(), std::max< uint64_t >( rank, 1 ) );
+            return uint16_t( std::min< ptrdiff_t >( it - cumulative.begin(), 0xffff ) );
+        }
+    }
+
+    void compute_depth_statistics( const uint16_t * depth, int width, int height, int stride, const pixel_roi & roi,
+                                   int grid_columns, int grid_rows, float units, uint16_t * copy,
+                                   std::vector< uint32_t > & histogram, frame_depth_statistics & statistics )
+    {
+        grid_columns = std::max( 1, std::min( grid_columns, std::max( 1, roi.width() ) ) );
+        grid_rows = std::max( 1, std::min( grid_rows, std::max( 1, roi.height() ) ) );
+        size_t const regions = size_t( grid_columns ) * grid_rows;
+        std::vector< uint64_t > sums( regions, 0 ), counts( regions, 0 );
+        histogram.assign( 0x10000, 0 );
+
+        // Regions split the rows the same way they split the columns
+        auto const row_bytes = size_t( width ) * sizeof( uint16_t );
+        int r = 0;
+        for( int y = 0; y < height; ++y )
+        {
+            auto in = reinterpret_cast< const uint16_t * >( reinterpret_cast< const uint8_t * >( depth ) + size_t( y ) * stride );
+            auto out = reinterpret_cast< uint16_t * >( reinterpret_cast< uint8_t * >( copy ) + size_t( y ) * stride );
+            if( roi.empty() || y < roi.min_y || y >= roi.max_y )
+            {
+                std::memcpy( out, in, row_bytes );
+                continue;
+            }
+
+            std::memcpy( out, in, roi.min_x * sizeof( uint16_t ) );
+            std::memcpy( out + roi.max_x, in + roi.max_x, ( width - roi.max_x ) * sizeof( uint16_t ) );
+            while( y >= roi.min_y + ( r + 1 ) * roi.height() / grid_rows )
+                ++r;
+            for( int c = 0; c < grid_columns; ++c )
+            {
+                int const x0 = roi.min_x + c * roi.width() / grid_columns;
+                int const x1 = roi.min_x + ( c + 1 ) * roi.width() / grid_columns;
+                auto const region = size_t( r ) * grid_columns + c;
+                scan_pixels( in + x0, out + x0, x1 - x0, histogram.data(), sums[region], counts[region] );
+            }
+        }
+
+        auto & summary = statistics.summary;
+        summary = {};
+        summary.grid_columns = grid_columns;
+        summary.grid_rows = grid_rows;
+        summary.total_pixels = roi.empty() ? 0 : roi.width() * roi.height();
+        statistics.region_means.assign( regions, 0.f );
+
+        uint64_t valid = 0, sum = 0;
+        for( size_t i = 0; i < regions; ++i )
+        {
+            valid += counts[i];
+            sum += sums[i];
+            if( counts[i] )
+                statistics.region_means[i] = float( double( sums[i] ) / counts[i] * units );
+        }
+        summary.valid_pixels = int( valid );
+        if( ! valid )
+            return;
+
+        summary.valid_fraction = float( double( valid ) / summary.total_pixels );
+        summary.mean = float( double( sum ) / valid * units );
+
+        // The histogram, from depth 1 up, becomes cumulative: the depth at a rank is then a binary search away
+        histogram[0] = 0;
+        for( size_t d = 1; d < histogram.size(); ++d )
+            histogram[d] += histogram[d - 1];
+        auto percentile = [&]( double p ) {
+            return depth_at_rank( histogram, uint64_t( std::ceil( p * valid ) ) ) * units;
+        };
+        summary.min = percentile( 0. );
+        summary.max = depth_at_rank( histogram, valid ) * units;
+        summary.percentile_5 = percentile( .05 );
+        summary.percentile_25 = percentile( .25 );
+        summary.median = percentile( .5 );
+        summary.percentile_75 = percentile( .75 );
+        summary.percentile_95 = percentile( .95 );
+    }
+
+    depth_statistics::depth_statistics()
+        : stream_filter_processing_block( "Depth Statistics" )
+    {
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+        _stream_filter.format = RS2_FORMAT_Z16;
+
+        auto columns = std::make_shared< ptr_option< int > >( 1, 64, 1, 1, &_grid_columns,
+                                                              "Columns of the grid of regions to compute the mean depth of" );
+        register_option( RS2_OPTION_STATISTICS_GRID_COLUMNS, columns );
+        auto rows = std::make_shared< ptr_option< int > >( 1, 64, 1, 1, &_grid_rows,
+                                                           "Rows of the grid of regions to compute the mean depth of" );
+        register_option( RS2_OPTION_STATISTICS_GRID_ROWS, rows );
+        _roi.register_to( *this );
+    }
+
+    rs2::frame depth_statistics::process_frame( const rs2::frame_source & source, const rs2::frame & f )
+    {
+        auto depth = f.as< rs2::depth_frame >();
+        if( ! depth )
+            return f;
+
+        if( f.get_profile().get() != _source_stream_profile.get() )
+        {
+            _source_stream_profile = f.get_profile();
+            _target_stream_profile = _source_stream_profile.clone( RS2_STREAM_DEPTH,
+                                                                   _source_stream_profile.stream_index(),
+                                                                   RS2_FORMAT_Z16 );
+        }
+
+        auto const width = depth.get_width(), height = depth.get_height();
+        auto const stride = depth.get_stride_in_bytes();
+        auto out = source.allocate_video_frame( _target_stream_profile, f, depth.get_bytes_per_pixel(), width, height,
+                                                stride, RS2_EXTENSION_DEPTH_FRAME );
+        auto fr = dynamic_cast< frame * >( (frame_interface *)out.get() );
+        if( ! fr )
+            return f;
+
+        auto statistics = std::make_shared< frame_depth_statistics >();
+        compute_depth_statistics( reinterpret_cast< const uint16_t * >( depth.get_data() ), width, height, stride,
+                                  _roi.get( f, width, height ), _grid_columns, _grid_rows, depth.get_units(),
+                                  reinterpret_cast< uint16_t * >( const_cast< void * >( out.get_data() ) ),
+                                  _histogram, *statistics );
+        fr->additional_data.depth_statistics = std::move( statistics );
+        _roi.apply( f, out );
+        return out;
+    }
+}
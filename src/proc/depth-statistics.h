@@ -0,0 +1,50 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "roi-options.h"
+
+#include <src/core/frame-additional-data.h>
+
+#include <vector>
+
+
+namespace librealsense
+{
+    // Computes the statistics of a Z16 image over a region, copying the whole image into 'copy' (of the same stride)
+    // on the way so it all takes a single pass over the pixels. The region is divided into a grid of regions, each
+    // with its mean depth. Depths are converted to meters with 'units'.
+    //
+    // 'histogram' is scratch space, kept by the caller so a stream of frames does not allocate.
+    //
+    void compute_depth_statistics( const uint16_t * depth, int width, int height, int stride, const pixel_roi & roi,
+                                   int grid_columns, int grid_rows, float units, uint16_t * copy,
+                                   std::vector< uint32_t > & histogram, frame_depth_statistics & statistics );
+
+
+    // Depth statistics for health monitoring: the fraction of valid pixels, the nearest, farthest and mean depth and
+    // its percentiles, and the mean depth of each region of a grid over the region of interest.
+    //
+    // The output is the depth frame with the statistics attached (see frame_depth_statistics), so consumers read them
+    // without going over the pixels again. Frames processed from it further down carry them too.
+    //
+    class depth_statistics : public stream_filter_processing_block
+    {
+    public:
+        depth_statistics();
+
+    protected:
+        rs2::frame process_frame( const rs2::frame_source & source, const rs2::frame & f ) override;
+
+    private:
+        int _grid_columns = 1;
+        int _grid_rows = 1;
+        roi_options _roi;
+        rs2::stream_profile _source_stream_profile;
+        rs2::stream_profile _target_stream_profile;
+        std::vector< uint32_t > _histogram;
+    };
+    MAP_EXTENSION( RS2_EXTENSION_DEPTH_STATISTICS, librealsense::depth_statistics );
+}
@@ -6,6 +6,11 @@
 #include <src/composite-frame.h>
 #include <src/core/frame-callback.h>
 
+#include <rsutils/string/from.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
 #include <ostream>
 
 namespace librealsense
@@ -16,11 +21,13 @@ void formats_converter::register_converter( const std::vector< stream_profile >
                                             std::function< std::shared_ptr< processing_block >( void ) > generate_func )
 {
     _pb_factories.push_back( std::make_shared< processing_block_factory >( source, target, generate_func ) );
+    _routes.clear();
 }
 
 void formats_converter::register_converter( const processing_block_factory & pbf )
 {
     _pb_factories.push_back( std::make_shared<processing_block_factory>( pbf ) );
+    _routes.clear();
 }
 
 void formats_converter::register_converters( const std::vector< processing_block_factory > & pbfs )
@@ -32,6 +39,7 @@ void formats_converter::register_converters( const std::vector< processing_block
 void formats_converter::clear_registered_converters()
 {
     _pb_factories.clear();
+    _routes.clear();
 }
 
 void formats_converter::drop_non_basic_formats()
@@ -67,6 +75,7 @@ void formats_converter::drop_non_basic_formats()
         _pb_factories.pop_back();
         --i; // Don't advance the counter because we reduce the vector size.
     }
+    _routes.clear();
 }
 
 std::ostream & operator<<( std::ostream & os, const std::shared_ptr< stream_profile_interface > & profile )
@@ -87,78 +96,148 @@ std::ostream & operator<<( std::ostream & os, const std::shared_ptr< stream_prof
     return os;
 }
 
-stream_profiles formats_converter::get_all_possible_profiles( const stream_profiles & raw_profiles )
+formats_converter::expansions formats_converter::expand( const std::vector< stream_profile > & raw_profiles,
+                                                         const std::vector< bool > & is_video ) const
 {
     // For each profile that can be used as input check all registered factories if they can create
     // a converter from the profile format (source). If so, create appropriate profiles for all possible target formats
     // that the converters support.
-    // Note - User profile type is stream_profile_interface, factories profile type is stream_profile.
-    stream_profiles to_profiles;
+    expansions result;
+    std::unordered_set< stream_profile > listed;
 
-    for( auto & raw_profile : raw_profiles )
+    for( size_t i = 0; i < raw_profiles.size(); ++i )
     {
-        LOG_DEBUG( "Raw profile: " << raw_profile );
-        for( auto & pbf : _pb_factories )
+        auto & raw_profile = raw_profiles[i];
+        for( size_t p = 0; p < _pb_factories.size(); ++p )
         {
-            const auto & sources = pbf->get_source_info();
+            const auto & sources = _pb_factories[p]->get_source_info();
             for( auto & source : sources )
             {
-                if( source.format == raw_profile->get_format() &&
-                   ( source.stream == raw_profile->get_stream_type() || source.stream == RS2_STREAM_ANY ) )
+                if( source.format == raw_profile.format &&
+                   ( source.stream == raw_profile.stream || source.stream == RS2_STREAM_ANY ) )
                 {
                     // targets are saved with format, type and sometimes index. Updating fps and resolution before using as key
-                    for( const auto & target : pbf->get_target_info() )
+                    for( const auto & target : _pb_factories[p]->get_target_info() )
                     {
                         // When interleaved streams are seperated to two distinct streams (e.g. sent as DDS streams),
                         // same converters are registered for both streams. We handle the relevant one based on index.
                         // Currently for infrared streams only.
-                        if( source.stream == RS2_STREAM_INFRARED && raw_profile->get_stream_index() != target.index )
+                        if( source.stream == RS2_STREAM_INFRARED && raw_profile.index != target.index )
                             continue;
 
-                        auto cloned_profile = clone_profile( raw_profile );
-                        cloned_profile->set_format( target.format );
-                        cloned_profile->set_stream_index( target.index );
-                        cloned_profile->set_stream_type( target.stream );
-
-                        auto cloned_vsp = As< video_stream_profile, stream_profile_interface >( cloned_profile );
-                        if( cloned_vsp )
-                        {
-                            // Conversion may involve changing the resolution (rotation, expansion, etc.)
-                            auto width = cloned_vsp->get_width();
-                            auto height = cloned_vsp->get_height();
-                            target.resolution_transform( width, height );
-                            cloned_vsp->set_dims( width, height );
-                        }
-                        LOG_DEBUG( "          -> " << cloned_profile );
-
-                        // Cache pbf supported profiles for efficiency in find_pbf_matching_most_profiles
-                        _pbf_supported_profiles[pbf.get()].push_back( cloned_profile );
-
-                        // Cache mapping of each target profile to profiles it is converting from.
-                        // Using map key type stream_profile and calling to_profile because stream_profile_interface is
-                        // abstract, can't use as key. shared_ptr< stream_profile_interface > saves pointer as key which
-                        // will result in bugs when mapping multiple raw profiles to the same converted profile.
-                        _target_profiles_to_raw_profiles[to_profile( cloned_profile.get() )].push_back( raw_profile );
-
-                        // TODO - Duplicates in the list happen when 2 raw_profiles have conversion to same target.
-                        // In this case it is faster to check if( _target_to_source_profiles_map[target].size() > 1 )
-                        // rather then if( is_profile_in_list( cloned_profile, to_profiles ) ), but L500 unit-tests
-                        // fail if we change. Need to understand difference
-                        if( is_profile_in_list( cloned_profile, to_profiles ) )
-                            continue;
+                        stream_profile converted( target.format,
+                                                  target.stream,
+                                                  target.index,
+                                                  raw_profile.width,
+                                                  raw_profile.height,
+                                                  raw_profile.fps );
+                        // Conversion may involve changing the resolution (rotation, expansion, etc.)
+                        if( is_video[i] )
+                            target.resolution_transform( converted.width, converted.height );
 
                         // Only injective cloning in many to one mapping.
                         // One to many is not affected.
-                        if( sources.size() > 1 && target.format != source.format )
-                            continue;
-
-                        to_profiles.push_back( cloned_profile );
+                        // Duplicates happen when 2 raw_profiles have conversion to same target; only the first is
+                        // returned.
+                        bool const injective = sources.size() <= 1 || target.format == source.format;
+                        result.push_back( { i, p, converted, injective && listed.insert( converted ).second } );
                     }
                 }
             }
         }
     }
 
+    return result;
+}
+
+std::shared_ptr< const formats_converter::expansions >
+formats_converter::get_expansions( const stream_profiles & raw_profiles ) const
+{
+    // Everything the expansion depends on, serialized
+    std::vector< stream_profile > raw_keys;
+    std::vector< bool > is_video;
+    std::vector< uint32_t > key;
+    raw_keys.reserve( raw_profiles.size() );
+    is_video.reserve( raw_profiles.size() );
+    key.reserve( raw_profiles.size() * 7 + _pb_factories.size() * 10 );
+    for( auto & raw_profile : raw_profiles )
+    {
+        auto p = to_profile( raw_profile.get() );
+        bool const video = dynamic_cast< const video_stream_profile * >( raw_profile.get() ) != nullptr;
+        raw_keys.push_back( p );
+        is_video.push_back( video );
+        key.insert( key.end(), { uint32_t( p.format ), uint32_t( p.stream ), uint32_t( p.index ), p.width, p.height, p.fps, uint32_t( video ) } );
+    }
+    for( auto & pbf : _pb_factories )
+    {
+        key.push_back( uint32_t( pbf->get_source_info().size() ) );
+        for( auto & source : pbf->get_source_info() )
+            key.insert( key.end(), { uint32_t( source.format ), uint32_t( source.stream ), uint32_t( source.index ) } );
+        key.push_back( uint32_t( pbf->get_target_info().size() ) );
+        for( auto & target : pbf->get_target_info() )
+        {
+            key.insert( key.end(), { uint32_t( target.format ), uint32_t( target.stream ), uint32_t( target.index ) } );
+            auto const transform = reinterpret_cast< uint64_t >( target.resolution_transform );
+            key.insert( key.end(), { uint32_t( transform ), uint32_t( transform >> 32 ) } );
+        }
+    }
+
+    // Process-wide: the same model (and firmware) produces the same key for every sensor of every device
+    static std::mutex mutex;
+    static std::map< std::vector< uint32_t >, std::shared_ptr< const expansions > > cache;
+
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        auto it = cache.find( key );
+        if( it != cache.end() )
+            return it->second;
+    }
+    auto result = std::make_shared< const expansions >( expand( raw_keys, is_video ) );
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        if( cache.size() >= 64 )
+            cache.clear();  // Just a bound: more than a handful of models/configurations is unusual
+        cache.emplace( std::move( key ), result );
+    }
+    return result;
+}
+
+stream_profiles formats_converter::get_all_possible_profiles( const stream_profiles & raw_profiles )
+{
+    // Note - User profile type is stream_profile_interface, factories profile type is stream_profile.
+    // The expansion itself is done on stream_profile (see get_expansions); here we only create the actual profiles.
+    auto const expansions = get_expansions( raw_profiles );
+    _routes.clear();  // The supported profiles may change
+
+    stream_profiles to_profiles;
+    to_profiles.reserve( expansions->size() );
+    for( auto & e : *expansions )
+    {
+        auto & raw_profile = raw_profiles[e.raw];
+
+        // Cache pbf supported profiles for efficiency in find_pbf_matching_most_profiles
+        _pbf_supported_profiles[_pb_factories[e.pbf].get()].insert( e.target );
+
+        // Cache mapping of each target profile to profiles it is converting from.
+        // Using map key type stream_profile because stream_profile_interface is abstract, can't use as key.
+        // shared_ptr< stream_profile_interface > saves pointer as key which will result in bugs when mapping multiple
+        // raw profiles to the same converted profile.
+        _target_profiles_to_raw_profiles[e.target].push_back( raw_profile );
+
+        if( ! e.listed )
+            continue;
+
+        auto cloned_profile = clone_profile( raw_profile );
+        cloned_profile->set_format( e.target.format );
+        cloned_profile->set_stream_index( e.target.index );
+        cloned_profile->set_stream_type( e.target.stream );
+        if( auto cloned_vsp = As< video_stream_profile, stream_profile_interface >( cloned_profile ) )
+            cloned_vsp->set_dims( e.target.width, e.target.height );
+        LOG_DEBUG( "Raw profile: " << raw_profile << " -> " << cloned_profile );
+
+        to_profiles.push_back( cloned_profile );
+    }
+
     return to_profiles;
 }
 
@@ -208,18 +287,6 @@ formats_converter::clone_profile( const std::shared_ptr< stream_profile_interfac
     return cloned;
 }
 
-bool formats_converter::is_profile_in_list( const std::shared_ptr< stream_profile_interface > & profile,
-                                            const stream_profiles & profiles ) const
-{
-    // Converting to stream_profile to avoid dynamic casting to video/motion_stream_profile
-    auto is_duplicate_predicate = [&profile]( const std::shared_ptr< stream_profile_interface > & spi ) {
-        return to_profile( spi.get() ) == to_profile( profile.get() );
-    };
-
-    return std::any_of( begin( profiles ), end( profiles ), is_duplicate_predicate );
-}
-
-// Not passing const & because we modify from_profiles, would otherwise need to create a copy
 void formats_converter::prepare_to_convert( stream_profiles from_profiles )
 {
     clear_active_cache();
@@ -230,20 +297,13 @@ void formats_converter::prepare_to_convert( stream_profiles from_profiles )
     // Caching from_profiles to set as processed frames profile before calling user callback
     cache_from_profiles( from_profiles );
 
-    while( ! from_profiles.empty() )
+    auto const route = get_route( from_profiles );
+    for( auto & step : *route )
     {
-        const auto & best_match = find_pbf_matching_most_profiles( from_profiles );
-        auto & factory_of_best_match = best_match.first;
-        auto & from_profiles_of_best_match = best_match.second;
-
-        // Mark matching profiles as handled
-        for( auto & profile : from_profiles_of_best_match )
-        {
-            const auto & matching_profiles_predicate = [&profile]( const std::shared_ptr<stream_profile_interface> & sp ) {
-                return to_profile( profile.get() ) == to_profile( sp.get() );
-            };
-            from_profiles.erase( std::remove_if( begin( from_profiles ), end( from_profiles ), matching_profiles_predicate ) );
-        }
+        auto & factory_of_best_match = _pb_factories[step.pbf];
+        stream_profiles from_profiles_of_best_match;
+        for( auto i : step.requests )
+            from_profiles_of_best_match.push_back( from_profiles[i] );
 
         // Retrieve source profile from cached map and generate the relevant processing block.
         std::unordered_set< std::shared_ptr< stream_profile_interface > > current_resolved_reqs;
@@ -268,6 +328,59 @@ void formats_converter::prepare_to_convert( stream_profiles from_profiles )
     }
 }
 
+std::shared_ptr< const formats_converter::route >
+formats_converter::get_route( const stream_profiles & from_profiles )
+{
+    std::vector< uint32_t > key;
+    key.reserve( from_profiles.size() * 6 );
+    for( auto & from_profile : from_profiles )
+    {
+        auto p = to_profile( from_profile.get() );
+        key.insert( key.end(), { uint32_t( p.format ), uint32_t( p.stream ), uint32_t( p.index ), p.width, p.height, p.fps } );
+    }
+
+    auto it = _routes.find( key );
+    if( it == _routes.end() )
+        it = _routes.emplace( std::move( key ), std::make_shared< const route >( find_route( from_profiles ) ) ).first;
+    return it->second;
+}
+
+// Not passing const & because we modify from_profiles, would otherwise need to create a copy
+formats_converter::route formats_converter::find_route( stream_profiles from_profiles )
+{
+    // The steps refer to the requests by their index
+    std::unordered_map< stream_profile_interface *, size_t > request_index;
+    for( size_t i = 0; i < from_profiles.size(); ++i )
+        request_index.emplace( from_profiles[i].get(), i );
+
+    route result;
+    while( ! from_profiles.empty() )
+    {
+        const auto & best_match = find_pbf_matching_most_profiles( from_profiles );
+        auto & factory_of_best_match = best_match.first;
+        auto & from_profiles_of_best_match = best_match.second;
+        if( ! factory_of_best_match || from_profiles_of_best_match.empty() )
+            throw invalid_value_exception( rsutils::string::from() << "no converter for " << from_profiles );
+
+        // Mark matching profiles as handled
+        for( auto & profile : from_profiles_of_best_match )
+        {
+            const auto & matching_profiles_predicate = [&profile]( const std::shared_ptr<stream_profile_interface> & sp ) {
+                return to_profile( profile.get() ) == to_profile( sp.get() );
+            };
+            from_profiles.erase( std::remove_if( begin( from_profiles ), end( from_profiles ), matching_profiles_predicate ) );
+        }
+
+        route_step step;
+        step.pbf = std::find( _pb_factories.begin(), _pb_factories.end(), factory_of_best_match ) - _pb_factories.begin();
+        for( auto & profile : from_profiles_of_best_match )
+            step.requests.push_back( request_index[profile.get()] );
+        result.push_back( std::move( step ) );
+    }
+
+    return result;
+}
+
 void formats_converter::update_target_profiles_data( const stream_profiles & from_profiles )
 {
     for( auto & from_profile : from_profiles )
@@ -323,6 +436,22 @@ stream_profiles formats_converter::get_active_source_profiles() const
     return active_source_profiles;
 }
 
+stream_profiles formats_converter::get_converted_only_source_profiles() const
+{
+    stream_profiles converted_only;
+
+    for( auto & iter : _raw_profile_to_converters )
+    {
+        auto & converters = iter.second;
+        if( std::all_of( converters.begin(),
+                         converters.end(),
+                         []( const std::shared_ptr< processing_block > & pb ) { return pb->outputs_new_frames(); } ) )
+            converted_only.push_back( iter.first );
+    }
+
+    return converted_only;
+}
+
 std::vector< std::shared_ptr< processing_block > > formats_converter::get_active_converters() const
 {
     std::vector< std::shared_ptr< processing_block > > active_converters;
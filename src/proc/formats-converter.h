@@ -5,6 +5,7 @@
 
 #include "processing-blocks-factory.h"
 
+#include <map>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -37,6 +38,8 @@ namespace librealsense
         void prepare_to_convert( stream_profiles to_profiles );
 
         stream_profiles get_active_source_profiles() const;
+        // Active source profiles whose frames are only converted into new frames, and never passed on as they are
+        stream_profiles get_converted_only_source_profiles() const;
         std::vector< std::shared_ptr< processing_block > > get_active_converters() const;
 
         void set_frames_callback( rs2_frame_callback_sptr callback );
@@ -44,12 +47,42 @@ namespace librealsense
         void convert_frame( frame_holder & f );
 
     protected:
+        // One converted profile, as found by get_all_possible_profiles: which raw profile and converter it comes
+        // from, and what it looks like
+        struct expansion
+        {
+            size_t raw;             // index into the raw profiles
+            size_t pbf;             // index into _pb_factories
+            stream_profile target;
+            bool listed;            // false for duplicates, which are not returned to the user
+        };
+        typedef std::vector< expansion > expansions;
+
+        // The expansion depends only on the raw profiles and the registered converters, which are the same for all
+        // sensors of the same model and firmware, so it is computed once and shared
+        std::shared_ptr< const expansions > get_expansions( const stream_profiles & raw_profiles ) const;
+        expansions expand( const std::vector< stream_profile > & raw_profiles, const std::vector< bool > & is_video ) const;
+
+        // The converters chosen for a request, in order: each a converter and the requested profiles (indices into
+        // the request) it converts
+        struct route_step
+        {
+            size_t pbf;  // index into _pb_factories
+            std::vector< size_t > requests;
+        };
+        typedef std::vector< route_step > route;
+
+        // Choosing the converters depends only on the requested profiles and on the profiles each converter supports,
+        // so a request made again (e.g., the same streams restarted) reuses the route found the first time. Routes are
+        // forgotten whenever the converters or the supported profiles change.
+        std::shared_ptr< const route > get_route( const stream_profiles & from_profiles );
+        route find_route( stream_profiles from_profiles );
+
         void clear_active_cache();
         void update_target_profiles_data( const stream_profiles & from_profiles );
         void cache_from_profiles( const stream_profiles & from_profiles );
 
         std::shared_ptr< stream_profile_interface > clone_profile( const std::shared_ptr< stream_profile_interface > & from_profile ) const;
-        bool is_profile_in_list( const std::shared_ptr< stream_profile_interface > & profile, const stream_profiles & profiles ) const;
 
         std::pair< std::shared_ptr< processing_block_factory >, stream_profiles >
             find_pbf_matching_most_profiles( const stream_profiles & profiles );
@@ -57,8 +90,9 @@ namespace librealsense
         std::shared_ptr< stream_profile_interface > find_cached_profile_for_frame( const frame_interface * f );
 
         std::vector< std::shared_ptr< processing_block_factory > > _pb_factories;
-        std::unordered_map< processing_block_factory *, stream_profiles > _pbf_supported_profiles;
+        std::unordered_map< processing_block_factory *, std::unordered_set< stream_profile > > _pbf_supported_profiles;
         std::unordered_map< stream_profile, stream_profiles > _target_profiles_to_raw_profiles;
+        std::map< std::vector< uint32_t >, std::shared_ptr< const route > > _routes;
 
         std::unordered_map< std::shared_ptr< stream_profile_interface >,
                             std::unordered_set< std::shared_ptr< processing_block > > > _raw_profile_to_converters;
@@ -58,19 +58,37 @@ namespace librealsense
         });
 
         register_option(RS2_OPTION_HOLES_FILL, hole_filling_mode);
+        _roi.register_to(*this);
     }
 
     rs2::frame hole_filling_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
     {
         update_configuration(f);
         auto tgt = prepare_target_frame(f, source);
+        _roi.apply(f, tgt);
+
+        // Outside the region of interest the target stays a copy of the input; inside, holes are filled in a
+        // contiguous copy of the region, as if it were the whole image
+        auto roi = _roi.get(f, int(_width), int(_height));
+        if (roi.width() < 3 || roi.height() < 3)
+            return tgt;
+        void* data = const_cast<void*>(tgt.get_data());
+        bool full_frame = (roi.width() == int(_width) && roi.height() == int(_height));
+        if (!full_frame)
+        {
+            _roi_data.resize(size_t(roi.width()) * roi.height() * _bpp);
+            copy_roi_out(data, int(_stride), roi, int(_bpp), _roi_data.data());
+            data = _roi_data.data();
+        }
 
         // Hole filling pass
         if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
-            apply_hole_filling<float>(const_cast<void*>(tgt.get_data()));
+            apply_hole_filling<float>(data, roi.width(), roi.height());
         else
-            apply_hole_filling<uint16_t>(const_cast<void*>(tgt.get_data()));
+            apply_hole_filling<uint16_t>(data, roi.width(), roi.height());
 
+        if (!full_frame)
+            copy_roi_in(_roi_data.data(), roi, int(_bpp), const_cast<void*>(tgt.get_data()), int(_stride));
         return tgt;
     }
 
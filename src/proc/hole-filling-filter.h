@@ -3,6 +3,8 @@
 // Enhancing the input video frame by filling missing data.
 #pragma once
 
+#include "roi-options.h"
+
 #include <rsutils/string/from.h>
 
 namespace librealsense
@@ -27,7 +29,7 @@ namespace librealsense
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
 
         template<typename T>
-        void apply_hole_filling(void * image_data)
+        void apply_hole_filling(void * image_data, size_t width, size_t height)
         {
             bool fp = (std::is_floating_point<T>::value);
             T* data = reinterpret_cast<T*>(image_data);
@@ -36,13 +38,13 @@ namespace librealsense
             switch (_hole_filling_mode)
             {
             case hf_fill_from_left:
-                holes_fill_left(data, _width, _height, _stride);
+                holes_fill_left(data, width, height, width * sizeof(T));
                 break;
             case hf_farest_from_around:
-                holes_fill_farest(data, _width, _height, _stride);
+                holes_fill_farest(data, width, height, width * sizeof(T));
                 break;
             case hf_nearest_from_around:
-                holes_fill_nearest(data, _width, _height, _stride);
+                holes_fill_nearest(data, width, height, width * sizeof(T));
                 break;
             default:
                 throw invalid_value_exception( rsutils::string::from() << "Unsupported hole filling mode: "
@@ -167,6 +169,8 @@ namespace librealsense
         rs2::stream_profile     _source_stream_profile;
         rs2::stream_profile     _target_stream_profile;
         uint8_t                 _hole_filling_mode;
+        roi_options             _roi;
+        std::vector<uint8_t>    _roi_data;                  // The region of interest, when not the whole frame
     };
     MAP_EXTENSION(RS2_EXTENSION_HOLE_FILLING_FILTER, librealsense::hole_filling_filter);
 }
@@ -6,13 +6,36 @@
 #include "proc/occlusion-filter.h"
 
 #include <rsutils/string/from.h>
+#include <rsutils/concurrency/worker-pool.h>
 
 #include <vector>
 #include <cmath>
+#include <algorithm>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
 
 
 namespace librealsense
 {
+    namespace
+    {
+        // Frames smaller than this (in pixels) are not worth waking up other threads for
+        const size_t parallel_threshold = 64 * 1024;
+
+        // Calls fn(begin,end) over [0,n) lines of 'line_size' pixels each, possibly in parallel
+        template< class Fn >
+        void for_each_band( size_t n, size_t line_size, Fn const & fn )
+        {
+            auto min_lines = std::max< size_t >( 1, parallel_threshold / 4 / std::max< size_t >( 1, line_size ) );
+            if( n * line_size < parallel_threshold )
+                fn( 0, n );
+            else
+                rsutils::concurrency::worker_pool::shared().parallel_for( n, min_lines, fn );
+        }
+    }
+
     occlusion_filter::occlusion_filter() : _occlusion_filter(occlusion_monotonic_scan) , _occlusion_scanning(horizontal)
     {
     }
@@ -20,10 +43,16 @@ namespace librealsense
     void occlusion_filter::set_texel_intrinsics(const rs2_intrinsics& in)
     {
         _texels_intrinsics = in;
+        std::lock_guard< std::mutex > lock( _texels_mutex );
         _texels_depth.resize(_texels_intrinsics.value().width*_texels_intrinsics.value().height);
     }
 
    void occlusion_filter::process(float3* points, float2* uv_map, const std::vector<float2> & pix_coord, const rs2::depth_frame& depth) const
+   {
+       process( points, uv_map, pix_coord, reinterpret_cast< const uint16_t * >( depth.get_data() ) );
+   }
+
+   void occlusion_filter::process(float3* points, float2* uv_map, const std::vector<float2> & pix_coord, const uint16_t* depth) const
     {
         switch (_occlusion_filter)
         {
@@ -63,49 +92,6 @@ namespace librealsense
            }
 
        return res;
-   }
-   template<size_t SIZE>
-   void rotate_image_optimized( uint8_t * dest[], const uint8_t * source, int width, int height)
-   {
-
-       auto width_out = height;
-       auto height_out = width;
-
-       auto out = dest[0];
-       auto buffer_size = maxDivisorRange(height, width, 1, ROTATION_BUFFER_SIZE); 
-
-       uint8_t ** buffer = new uint8_t * [buffer_size];
-       for (int i = 0; i < buffer_size; ++i)
-           buffer[i] = new uint8_t[buffer_size * SIZE];
-
-
-       for (int i = 0; i <= height - buffer_size; i = i + buffer_size)
-       {
-           for (int j = 0; j <= width - buffer_size; j = j + buffer_size)
-           {
-               for (int ii = 0; ii < buffer_size; ++ii)
-               {
-                   for (int jj = 0; jj < buffer_size; ++jj)
-                   {
-                       auto source_index = ((j + jj) + (width * (i + ii))) * SIZE;
-                       memcpy((void*)&(buffer[(buffer_size-1 - jj)][(buffer_size-1 - ii) * SIZE]), &source[source_index], SIZE);
-                   }
-               }
-
-               for (int ii = 0; ii < buffer_size; ++ii)
-               {
-                   auto out_index = (((height_out - buffer_size - j + 1) * width_out) - i - buffer_size + (ii)*width_out);
-                   memcpy(&out[(out_index)*SIZE], (buffer[ii]), buffer_size * SIZE);
-               }
-           }
-       }
-
-       for (int i = 0; i < buffer_size; ++i)
-       {
-           delete[] buffer[i];
-       }
-       delete[] buffer;
- 
    }
     // IMPORTANT! This implementation is based on the assumption that the RGB sensor is positioned strictly to the left of the depth sensor.
     // namely D415/D435. The implementation WILL NOT work properly for different setups
@@ -115,107 +101,111 @@ namespace librealsense
     // -  The occlusion is designated as U coordinate for a given pixel is less than the U coordinate of the predecessing pixel.
     // -  The UV mapping for the occluded pixel is reset to (0,0). Later on the (0,0) coordinate in the texture map is overwritten
     //    with a invalidation color such as black/magenta according to the purpose (production/debugging)
-   void occlusion_filter::monotonic_heuristic_invalidation(float3* points, float2* uv_map, const std::vector<float2>& pix_coord, const rs2::depth_frame& depth) const
+    // Lines are independent of each other, so bands of them are processed in parallel.
+   void occlusion_filter::monotonic_heuristic_invalidation(float3* points, float2* uv_map, const std::vector<float2>& pix_coord, const uint16_t* depth) const
    {
-       float occZTh = 0.1f; //meters
-       int occDilationSz = 1;
-       auto points_width = _depth_intrinsics->width;
-       auto points_height = _depth_intrinsics->height;
-       auto pixels_ptr = pix_coord.data();
-       auto points_ptr = points;
-       auto uv_map_ptr = uv_map;
-       float maxInLine = -1;
-       float maxZ = 0;
+       const float occZTh = 0.1f; //meters
+       const int occDilationSz = 1;
+       const int points_width = _depth_intrinsics->width;
+       const int points_height = _depth_intrinsics->height;
 
        if (_occlusion_scanning == horizontal)
        {
-           for( int y = 0; y < points_height; ++y )
+           for_each_band( points_height, points_width, [&]( size_t begin, size_t end )
            {
-               maxInLine = -1;
-               maxZ = 0;
-               int occDilationLeft = 0;
-
-               for(int x = 0; x < points_width; ++x )
+               for( int y = int( begin ); y < int( end ); ++y )
                {
-                   if( points_ptr->z )
+                   auto pixels_ptr = pix_coord.data() + y * points_width;
+                   auto points_ptr = points + y * points_width;
+                   float maxInLine = -1;
+                   float maxZ = 0;
+                   int occDilationLeft = 0;
+
+                   for( int x = 0; x < points_width; ++x )
                    {
-                       // Occlusion detection
-                       if( pixels_ptr->x < maxInLine
-                           || ( pixels_ptr->x == maxInLine && ( points_ptr->z - maxZ ) > occZTh ) )
-                       {
-                           *points_ptr = { 0, 0, 0 };
-                           occDilationLeft = occDilationSz;
-                       }
-                       else
+                       if( points_ptr->z )
                        {
-                           maxInLine = pixels_ptr->x;
-                           maxZ = points_ptr->z;
-                           if( occDilationLeft > 0 )
+                           // Occlusion detection
+                           if( pixels_ptr->x < maxInLine
+                               || ( pixels_ptr->x == maxInLine && ( points_ptr->z - maxZ ) > occZTh ) )
                            {
                                *points_ptr = { 0, 0, 0 };
-                               occDilationLeft--;
+                               occDilationLeft = occDilationSz;
+                           }
+                           else
+                           {
+                               maxInLine = pixels_ptr->x;
+                               maxZ = points_ptr->z;
+                               if( occDilationLeft > 0 )
+                               {
+                                   *points_ptr = { 0, 0, 0 };
+                                   occDilationLeft--;
+                               }
                            }
                        }
+                       ++points_ptr;
+                       ++pixels_ptr;
                    }
-                   ++points_ptr;
-                   ++uv_map_ptr;
-                   ++pixels_ptr;
                }
-           }
+           } );
        }
        else if (_occlusion_scanning == vertical)
        {
-           auto rotated_depth_width = _depth_intrinsics->height;
-           auto rotated_depth_height = _depth_intrinsics->width;
-           auto depth_ptr = (uint8_t *)(depth.get_data());
-           std::vector< uint8_t > alloc( depth.get_bytes_per_pixel() * points_width * points_height );
-           uint8_t * depth_planes[1];
-           depth_planes[0] = alloc.data();
-
-           rotate_image_optimized<2>(depth_planes, (const uint8_t *)(depth.get_data()), points_width, points_height);
+           // Occlusion is detected in the positive direction of Y: where there's a noticeable jump in depth between a
+           // pixel and the one above it, the pixels below whose V coordinate is lower than the one above are invalidated.
+           // Only the points of the pixel's own column are touched, so bands of columns are processed in parallel.
+           const float scaled_threshold = DEPTH_OCCLUSION_THRESHOLD / _depth_units;
+           const int scan_win_size = maxDivisorRange(points_width, points_height, 1, VERTICAL_SCAN_WINDOW_SIZE);
 
-           // scan depth frame after rotation: check if there is a noticed jump between adjacen pixels in Z-axis (depth), it means there could be occlusion.
-           // save suspected points and run occlusion-invalidation vertical scan only on them
-           // after rotation : height = points_width , width = points_height
-           for (int i = 0; i < rotated_depth_height; i++)
+           auto scan = [&]( int index )
            {
-               for (int j = 0; j < rotated_depth_width; j++)
+               float maxInLine = uv_map[index - points_width].y;
+               for( int y = 0; y <= scan_win_size; ++y, index += points_width )
                {
-                   // before depth frame rotation: occlusion detected in the positive direction of Y
-                   // after rotation : scan from right to left (positive direction of X) to detect occlusion
-                   // compare depth each pixel only with the pixel on its right (i,j+1)
-                   auto index = (j + (rotated_depth_width * i));
-                   auto uv_index = ((rotated_depth_height - i - 1) + (rotated_depth_width - j - 1) * rotated_depth_height);
-                   auto index_right = index + 1;
-                   uint16_t* diff_depth_ptr = (uint16_t*)depth_planes[0];
-                   uint16_t diff_right = std::abs( (uint16_t)( *( diff_depth_ptr + index ) )
-                                                   - (uint16_t)( *( diff_depth_ptr + index_right ) ) );
-                   float scaled_threshold = DEPTH_OCCLUSION_THRESHOLD / _depth_units;
-                   if (diff_right > scaled_threshold)
-                   {
-                       points_ptr = points + uv_index;
-                       uv_map_ptr = uv_map + uv_index;
-                       auto scan_win_size = maxDivisorRange(rotated_depth_height, rotated_depth_width, 1, VERTICAL_SCAN_WINDOW_SIZE);
-
-                       if (j >= scan_win_size) {
-                           maxInLine = (uv_map_ptr - 1 * points_width)->y;
-                           for (int y = 0; y <= scan_win_size; ++y)
-                           {
-                               if (((uv_map_ptr + y * points_width)->y < maxInLine))
-                               {
-                                   *(points_ptr + y * points_width) = { 0.f, 0.f };
-                               }
-                               else
-                               {
-                                   break;
-                               }
+                   if( uv_map[index].y < maxInLine )
+                       points[index] = { 0.f, 0.f, 0.f };
+                   else
+                       break;
+               }
+           };
 
-                           }
+#ifdef __SSSE3__
+           // Depth differences are whole numbers, so comparing with the floor of the threshold is the same
+           const __m128i threshold = _mm_set1_epi16( (short)(uint16_t)( scaled_threshold < 65535.f ? std::floor( scaled_threshold ) : 65535.f ) );
+           const __m128i zero = _mm_setzero_si128();
+#endif
 
-                       }
+           for_each_band( points_width, points_height, [&]( size_t begin, size_t end )
+           {
+               // The window must fit below the pixel; the first line has no pixel above it
+               for( int y = 1; y + scan_win_size < points_height; ++y )
+               {
+                   auto line = depth + y * points_width;
+                   auto line_above = line - points_width;
+                   int x = int( begin );
+#ifdef __SSSE3__
+                   for( ; x + 8 <= int( end ); x += 8 )
+                   {
+                       __m128i d = _mm_loadu_si128( (const __m128i *)( line + x ) );
+                       __m128i d_above = _mm_loadu_si128( (const __m128i *)( line_above + x ) );
+                       __m128i diff = _mm_or_si128( _mm_subs_epu16( d, d_above ), _mm_subs_epu16( d_above, d ) );
+                       // Two bits per pixel, set where the difference is not above the threshold
+                       int below = _mm_movemask_epi8( _mm_cmpeq_epi16( _mm_subs_epu16( diff, threshold ), zero ) );
+                       if( below == 0xffff )
+                           continue;
+                       for( int i = 0; i < 8; ++i )
+                           if( ! ( below & ( 1 << ( 2 * i ) ) ) )
+                               scan( y * points_width + x + i );
+                   }
+#endif
+                   for( ; x < int( end ); ++x )
+                   {
+                       uint16_t diff = std::abs( line[x] - line_above[x] );
+                       if( diff > scaled_threshold )
+                           scan( y * points_width + x );
                    }
                }
-           }
+           } );
        }
    }
     // Prepare texture map without occlusion that for every texture coordinate there no more than one depth point that is mapped to it
@@ -237,10 +227,13 @@ namespace librealsense
 
         static const float z_threshold = 0.05f; // Compensate for temporal noise when comparing Z values
 
+        std::lock_guard< std::mutex > lock( _texels_mutex );
+
         // Clear previous data
         memset((void*)(_texels_depth.data()), 0, _texels_depth.size() * sizeof(float));
 
-        // Pass1 -generate texels mapping with minimal depth for each texel involved
+        // Pass1 -generate texels mapping with minimal depth for each texel involved; sequential, as the depth that ends
+        // up in a texel depends on the order in which its pixels are visited
         for (size_t i = 0; i < points_height; i++)
         {
             for (size_t j = 0; j < points_width; j++)
@@ -262,31 +255,33 @@ namespace librealsense
             }
         }
 
-        mapped_pix = pix_coord.data();
-        depth_points = points;
-        auto uv_ptr = uv_map;
-
-        // Pass2 -invalidate depth texels with occlusion traits
-        for (size_t i = 0; i < points_height; i++)
+        // Pass2 -invalidate depth texels with occlusion traits; each line only reads the texels, so lines are independent
+        for_each_band( points_height, points_width, [&]( size_t begin, size_t end )
         {
-            for (size_t j = 0; j < points_width; j++)
+            auto mapped_pix = pix_coord.data() + begin * points_width;
+            auto depth_points = points + begin * points_width;
+            auto uv_ptr = uv_map + begin * points_width;
+            for (size_t i = begin; i < end; i++)
             {
-                if ((depth_points->z > 0.0001f) &&
-                    (mapped_pix->x > 0.f) && (mapped_pix->x < mapped_tex_width) &&
-                    (mapped_pix->y > 0.f) && (mapped_pix->y < mapped_tex_height))
+                for (size_t j = 0; j < points_width; j++)
                 {
-                    size_t texel_index = (size_t)(mapped_pix->y)*mapped_tex_width + (size_t)(mapped_pix->x);
-
-                    if ((_texels_depth[texel_index] > 0.0001f) && ((_texels_depth[texel_index] + z_threshold) < depth_points->z))
+                    if ((depth_points->z > 0.0001f) &&
+                        (mapped_pix->x > 0.f) && (mapped_pix->x < mapped_tex_width) &&
+                        (mapped_pix->y > 0.f) && (mapped_pix->y < mapped_tex_height))
                     {
-                        *uv_ptr = { 0.f, 0.f };
+                        size_t texel_index = (size_t)(mapped_pix->y)*mapped_tex_width + (size_t)(mapped_pix->x);
+
+                        if ((_texels_depth[texel_index] > 0.0001f) && ((_texels_depth[texel_index] + z_threshold) < depth_points->z))
+                        {
+                            *uv_ptr = { 0.f, 0.f };
+                        }
                     }
-                }
 
-                ++depth_points;
-                ++mapped_pix;
-                ++uv_ptr;
+                    ++depth_points;
+                    ++mapped_pix;
+                    ++uv_ptr;
+                }
             }
-        }
+        } );
     }
 }
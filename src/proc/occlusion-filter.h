@@ -6,7 +6,8 @@
 #include "rotation-transform.h"
 #include <src/pose.h>
 
-#define ROTATION_BUFFER_SIZE 32 // minimum limit that could be divided by all resolutions
+#include <mutex>
+
 #define VERTICAL_SCAN_WINDOW_SIZE 16
 #define DEPTH_OCCLUSION_THRESHOLD 0.5f //meters
 
@@ -34,12 +35,15 @@ namespace librealsense
         bool active(void) const { return (occlusion_none != _occlusion_filter); }
 
         void process(float3* points, float2* uv_map, const std::vector<float2> & pix_coord, const rs2::depth_frame& depth) const;
+        // Same, with the Z16 depth data of a frame matching the depth intrinsics
+        void process(float3* points, float2* uv_map, const std::vector<float2> & pix_coord, const uint16_t* depth) const;
 
         void set_mode(uint8_t filter_type) { _occlusion_filter = (occlusion_rect_type)filter_type; }
         void set_scanning(uint8_t scanning) { _occlusion_scanning = (occlusion_scanning_type)scanning; }
 
         void set_texel_intrinsics(const rs2_intrinsics& in);
         void set_depth_intrinsics(const rs2_intrinsics& in) { _depth_intrinsics = in; }
+        void set_depth_units(float units) { _depth_units = units; }
 
         occlusion_scanning_type find_scanning_direction(const rs2_extrinsics& extr)
         {
@@ -58,14 +62,15 @@ namespace librealsense
 
         friend class pointcloud;
 
-        void monotonic_heuristic_invalidation(float3* points, float2* uv_map, const std::vector<float2> & pix_coord, const rs2::depth_frame& depth) const;
+        void monotonic_heuristic_invalidation(float3* points, float2* uv_map, const std::vector<float2> & pix_coord, const uint16_t* depth) const;
         void comprehensive_invalidation(float3* points, float2* uv_map, const std::vector<float2> & pix_coord) const;
 
         optional_value<rs2_intrinsics>              _depth_intrinsics;
         optional_value<rs2_intrinsics>              _texels_intrinsics;
-        mutable std::vector<float>                  _texels_depth; // Temporal translation table of (mapped_x*mapped_y) holds the minimal depth value among all depth pixels mapped to that texel
+        mutable std::mutex                          _texels_mutex;
+        mutable std::vector<float>                  _texels_depth; // Temporal translation table of (mapped_x*mapped_y) holds the minimal depth value among all depth pixels mapped to that texel; guarded by _texels_mutex
         occlusion_rect_type                         _occlusion_filter;
         occlusion_scanning_type                     _occlusion_scanning;
-        float                                       _depth_units;
+        float                                       _depth_units = 0.001f;
     };
 }
@@ -0,0 +1,247 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "organized-mesh.h"
+
+#include <rsutils/concurrency/worker-pool.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+
+namespace librealsense
+{
+    namespace
+    {
+#ifdef __SSE2__
+        // Four consecutive vertices, as planes of x, y and z
+        struct vertices4
+        {
+            __m128 x, y, z;
+
+            explicit vertices4( const float3 * v )
+            {
+                auto const p = reinterpret_cast< const float * >( v );
+                auto const v0 = _mm_loadu_ps( p );      // x0 y0 z0 x1
+                auto const v1 = _mm_loadu_ps( p + 4 );  // y1 z1 x2 y2
+                auto const v2 = _mm_loadu_ps( p + 8 );  // z2 x3 y3 z3
+                x = _mm_shuffle_ps( v0, _mm_shuffle_ps( v1, v2, _MM_SHUFFLE( 1, 1, 2, 2 ) ), _MM_SHUFFLE( 2, 0, 3, 0 ) );
+                y = _mm_shuffle_ps( _mm_shuffle_ps( v0, v1, _MM_SHUFFLE( 0, 0, 1, 1 ) ),
+                                    _mm_shuffle_ps( v1, v2, _MM_SHUFFLE( 2, 2, 3, 3 ) ),
+                                    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+                z = _mm_shuffle_ps( _mm_shuffle_ps( v0, v1, _MM_SHUFFLE( 1, 1, 2, 2 ) ),
+                                    _mm_shuffle_ps( v2, v2, _MM_SHUFFLE( 3, 3, 0, 0 ) ),
+                                    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+            }
+
+            vertices4( __m128 x, __m128 y, __m128 z ) : x( x ), y( y ), z( z ) {}
+
+            vertices4 operator-( const vertices4 & o ) const
+            {
+                return { _mm_sub_ps( x, o.x ), _mm_sub_ps( y, o.y ), _mm_sub_ps( z, o.z ) };
+            }
+        };
+
+        // Exactly as cross_product() below, four at a time
+        vertices4 cross_product( const vertices4 & u, const vertices4 & v )
+        {
+            return { _mm_sub_ps( _mm_mul_ps( u.y, v.z ), _mm_mul_ps( u.z, v.y ) ),
+                     _mm_sub_ps( _mm_mul_ps( u.z, v.x ), _mm_mul_ps( u.x, v.z ) ),
+                     _mm_sub_ps( _mm_mul_ps( u.x, v.y ), _mm_mul_ps( u.y, v.x ) ) };
+        }
+
+        __m128 abs_ps( __m128 v ) { return _mm_andnot_ps( _mm_set1_ps( -0.f ), v ); }
+
+        // All-ones lanes where the four quad bytes are set
+        __m128 quad_mask( const uint8_t * quads )
+        {
+            int32_t q;
+            std::memcpy( &q, quads, sizeof( q ) );
+            auto const zero = _mm_setzero_si128();
+            auto const q32 = _mm_unpacklo_epi16( _mm_unpacklo_epi8( _mm_cvtsi32_si128( q ), zero ), zero );
+            return _mm_castsi128_ps( _mm_cmpgt_epi32( q32, zero ) );
+        }
+#endif
+
+        // As the PLY exporter computed it (cross() of float3 has its y negated, and is not used here)
+        float3 cross_product( const float3 & u, const float3 & v )
+        {
+            return { u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z, u.x * v.y - u.y * v.x };
+        }
+
+        // The normals of the two triangles, (a,d,b) and (d,a,c), of every quad of a row, as planes of x, y and z;
+        // (0,0,0) for quads that are not meshed
+        struct quad_normals_row
+        {
+            std::vector< float > n1[3], n2[3];
+
+            explicit quad_normals_row( int width )
+            {
+                for( auto & plane : n1 )
+                    plane.resize( width );
+                for( auto & plane : n2 )
+                    plane.resize( width );
+            }
+
+            float3 first( int x ) const { return { n1[0][x], n1[1][x], n1[2][x] }; }
+            float3 second( int x ) const { return { n2[0][x], n2[1][x], n2[2][x] }; }
+
+            void set( int x, const float3 & t1, const float3 & t2 )
+            {
+                n1[0][x] = t1.x, n1[1][x] = t1.y, n1[2][x] = t1.z;
+                n2[0][x] = t2.x, n2[1][x] = t2.y, n2[2][x] = t2.z;
+            }
+
+            void compute( const float3 * top, const float3 * bottom, const uint8_t * quads, int width )
+            {
+                int x = 0;
+#ifdef __SSE2__
+                // Vertices x+1 to x+4 of both rows are read
+                for( ; x + 4 < width; x += 4 )
+                {
+                    vertices4 const a( top + x ), b( top + x + 1 ), c( bottom + x ), d( bottom + x + 1 );
+                    auto const t1 = cross_product( d - a, b - a );
+                    auto const t2 = cross_product( c - a, d - a );
+                    auto const mask = quad_mask( quads + x );
+                    _mm_storeu_ps( &n1[0][x], _mm_and_ps( t1.x, mask ) );
+                    _mm_storeu_ps( &n1[1][x], _mm_and_ps( t1.y, mask ) );
+                    _mm_storeu_ps( &n1[2][x], _mm_and_ps( t1.z, mask ) );
+                    _mm_storeu_ps( &n2[0][x], _mm_and_ps( t2.x, mask ) );
+                    _mm_storeu_ps( &n2[1][x], _mm_and_ps( t2.y, mask ) );
+                    _mm_storeu_ps( &n2[2][x], _mm_and_ps( t2.z, mask ) );
+                }
+#endif
+                for( ; x < width - 1; ++x )
+                {
+                    if( ! quads[x] )
+                    {
+                        set( x, { 0, 0, 0 }, { 0, 0, 0 } );
+                        continue;
+                    }
+                    auto const & a = top[x];
+                    auto const & b = top[x + 1];
+                    auto const & c = bottom[x];
+                    auto const & d = bottom[x + 1];
+                    set( x, cross_product( d - a, b - a ), cross_product( c - a, d - a ) );
+                }
+            }
+        };
+    }
+
+    void compute_organized_mesh( uint8_t * quads, const float3 * vertices, int width, int height, float threshold )
+    {
+        rsutils::concurrency::worker_pool::shared().parallel_for(
+            height,
+            32,
+            [&]( size_t begin, size_t end )
+            {
+                for( int y = int( begin ); y < int( end ); ++y )
+                {
+                    auto out = quads + y * width;
+                    if( y == height - 1 )
+                    {
+                        std::fill( out, out + width, uint8_t( 0 ) );
+                        continue;
+                    }
+                    auto const top = vertices + y * width;
+                    auto const bottom = top + width;
+                    int x = 0;
+#ifdef __SSE2__
+                    // Vertices x+1 to x+4 of both rows are read
+                    auto const zero = _mm_setzero_ps();
+                    auto const t = _mm_set1_ps( threshold );
+                    for( ; x + 4 < width; x += 4 )
+                    {
+                        auto const a = vertices4( top + x ).z, b = vertices4( top + x + 1 ).z;
+                        auto const c = vertices4( bottom + x ).z, d = vertices4( bottom + x + 1 ).z;
+                        auto const valid = _mm_and_ps( _mm_and_ps( _mm_cmpneq_ps( a, zero ), _mm_cmpneq_ps( b, zero ) ),
+                                                       _mm_and_ps( _mm_cmpneq_ps( c, zero ), _mm_cmpneq_ps( d, zero ) ) );
+                        auto const close = _mm_and_ps( _mm_and_ps( _mm_cmplt_ps( abs_ps( _mm_sub_ps( a, b ) ), t ),
+                                                                   _mm_cmplt_ps( abs_ps( _mm_sub_ps( a, c ) ), t ) ),
+                                                       _mm_and_ps( _mm_cmplt_ps( abs_ps( _mm_sub_ps( b, d ) ), t ),
+                                                                   _mm_cmplt_ps( abs_ps( _mm_sub_ps( c, d ) ), t ) ) );
+                        int const meshed = _mm_movemask_ps( _mm_and_ps( valid, close ) );
+                        for( int i = 0; i < 4; ++i )
+                            out[x + i] = ( meshed >> i ) & 1;
+                    }
+#endif
+                    for( ; x < width - 1; ++x )
+                    {
+                        float const a = top[x].z, b = top[x + 1].z, c = bottom[x].z, d = bottom[x + 1].z;
+                        out[x] = a && b && c && d && std::abs( a - b ) < threshold && std::abs( a - c ) < threshold
+                              && std::abs( b - d ) < threshold && std::abs( c - d ) < threshold;
+                    }
+                    out[width - 1] = 0;
+                }
+            } );
+    }
+
+    void compute_vertex_normals( float3 * normals,
+                                 const float3 * vertices,
+                                 const uint8_t * quads,
+                                 int width,
+                                 int height )
+    {
+        rsutils::concurrency::worker_pool::shared().parallel_for(
+            height,
+            32,
+            [&]( size_t begin, size_t end )
+            {
+                // The triangle normals of each quad row are computed once, and used by the vertex rows above and
+                // below it
+                quad_normals_row above( width ), below( width );
+                if( begin > 0 )
+                    above.compute( vertices + ( begin - 1 ) * width, vertices + begin * width,
+                                   quads + ( begin - 1 ) * width, width );
+                for( int y = int( begin ); y < int( end ); ++y )
+                {
+                    if( y < height - 1 )
+                        below.compute( vertices + y * width, vertices + ( y + 1 ) * width, quads + y * width, width );
+                    auto const quads_above = quads + ( y - 1 ) * width;
+                    auto const quads_below = quads + y * width;
+                    for( int x = 0; x < width; ++x )
+                    {
+                        // A vertex is corner d of the quad up-left of it, b of the one to its left, c of the one
+                        // above it, and a of its own; they are summed in this order, the one the PLY exporter
+                        // always used
+                        float3 sum = { 0, 0, 0 };
+                        bool any = false;
+                        if( x > 0 && y > 0 && quads_above[x - 1] )
+                        {
+                            sum = sum + above.first( x - 1 ) + above.second( x - 1 );
+                            any = true;
+                        }
+                        if( x > 0 && y < height - 1 && quads_below[x - 1] )
+                        {
+                            sum = sum + below.first( x - 1 );
+                            any = true;
+                        }
+                        if( y > 0 && x < width - 1 && quads_above[x] )
+                        {
+                            sum = sum + above.second( x );
+                            any = true;
+                        }
+                        if( x < width - 1 && y < height - 1 && quads_below[x] )
+                        {
+                            sum = sum + below.first( x ) + below.second( x );
+                            any = true;
+                        }
+                        if( any )
+                        {
+                            float const len = std::sqrt( sum.x * sum.x + sum.y * sum.y + sum.z * sum.z );
+                            sum = { sum.x / len, sum.y / len, sum.z / len };
+                        }
+                        normals[y * width + x] = sum;
+                    }
+                    std::swap( above, below );
+                }
+            } );
+    }
+}
@@ -0,0 +1,32 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <src/float3.h>
+
+#include <cstdint>
+
+
+namespace librealsense
+{
+    // Triangulation of an organized point cloud (one vertex per pixel, (0,0,0) where invalid).
+    //
+    // Quad (x,y) has corners a=(x,y), b=(x+1,y), c=(x,y+1) and d=(x+1,y+1), and is meshed, as triangles (a,d,b) and
+    // (d,a,c), when all four corners are valid and the depth differences along its edges are all below 'threshold'.
+    // quads[y*width+x] is set to 1 for meshed quads and 0 otherwise (always 0 in the last row and column).
+    //
+    void compute_organized_mesh( uint8_t * quads,
+                                 const float3 * vertices,
+                                 int width,
+                                 int height,
+                                 float threshold );
+
+    // Per-vertex normals of a mesh from compute_organized_mesh(): the normalized sum of the (area-weighted) normals of
+    // the triangles sharing the vertex, or (0,0,0) for vertices that are not part of any.
+    void compute_vertex_normals( float3 * normals,
+                                 const float3 * vertices,
+                                 const uint8_t * quads,
+                                 int width,
+                                 int height );
+}
@@ -25,9 +25,13 @@
 
 namespace librealsense
 {
-    template<class MAP_DEPTH> void deproject_depth(float * points, const rs2_intrinsics & intrin, const uint16_t * depth, MAP_DEPTH map_depth)
+    // Deprojects rows [first_row,last_row) of the depth image into the same rows of the points
+    template<class MAP_DEPTH> void deproject_depth(float * points, const rs2_intrinsics & intrin, const uint16_t * depth,
+        int first_row, int last_row, MAP_DEPTH map_depth)
     {
-        for (int y = 0; y < intrin.height; ++y)
+        points += size_t(first_row) * intrin.width * 3;
+        depth += size_t(first_row) * intrin.width;
+        for (int y = first_row; y < last_row; ++y)
         {
             for (int x = 0; x < intrin.width; ++x)
             {
@@ -43,7 +47,8 @@ namespace librealsense
     {
         auto image = output.get_vertices();
         auto depth_scale = depth_frame.get_units();
-        deproject_depth((float*)image, depth_intrinsics, (const uint16_t*)depth_frame.get_data(), [depth_scale](uint16_t z) { return depth_scale * z; });
+        deproject_depth((float*)image, depth_intrinsics, (const uint16_t*)depth_frame.get_data(), _first_row, _last_row,
+            [depth_scale](uint16_t z) { return depth_scale * z; });
         return (float3*)image;
     }
 
@@ -212,9 +217,13 @@ namespace librealsense
         const rs2_extrinsics& extr,
         float2* pixels_ptr)
     {
-        auto tex_ptr = (float2*)output.get_texture_coordinates();
+        // Only rows [_first_row,_last_row) are mapped
+        auto const offset = size_t(_first_row) * width;
+        auto tex_ptr = (float2*)output.get_texture_coordinates() + offset;
+        points += offset;
+        pixels_ptr += offset;
 
-        for (unsigned int y = 0; y < height; ++y)
+        for (unsigned int y = _first_row; y < unsigned(_last_row); ++y)
         {
             for (unsigned int x = 0; x < width; ++x)
             {
@@ -245,13 +254,36 @@ namespace librealsense
         return source.allocate_points(_output_stream, depth);
     }
 
+    // Zeroes the pixels of an image outside the region of interest
+    template< class T >
+    static void zero_outside( T * data, const pixel_roi & roi, int width, int height )
+    {
+        std::fill( data, data + size_t( roi.min_y ) * width, T{} );
+        for( int y = roi.min_y; y < roi.max_y; ++y )
+        {
+            auto row = data + size_t( y ) * width;
+            std::fill( row, row + roi.min_x, T{} );
+            std::fill( row + roi.max_x, row + width, T{} );
+        }
+        std::fill( data + size_t( roi.max_y ) * width, data + size_t( width ) * height, T{} );
+    }
+
     rs2::frame pointcloud::process_depth_frame(const rs2::frame_source& source, const rs2::depth_frame& depth)
     {
         auto res = allocate_points(source, depth);
         auto pframe = (librealsense::points*)(res.get());
-        const float3* points = depth_to_points(res, *_depth_intrinsics, depth);
-
         auto vid_frame = depth.as<rs2::video_frame>();
+        _roi.apply(depth, res);
+
+        // Implementations process the rows of the region of interest; everything outside it is then zeroed
+        auto roi = _roi.get(depth, vid_frame.get_width(), vid_frame.get_height());
+        bool full_frame = (roi.width() == vid_frame.get_width() && roi.height() == vid_frame.get_height());
+        _first_row = roi.min_y;
+        _last_row = roi.max_y;
+
+        const float3* points = depth_to_points(res, *_depth_intrinsics, depth);
+        if (!full_frame)
+            zero_outside(pframe->get_vertices(), roi, vid_frame.get_width(), vid_frame.get_height());
 
         // Pixels calculated in the mapped texture. Used in post-processing filters
         float2* pixels_ptr = _pixels_map.data();
@@ -273,13 +305,18 @@ namespace librealsense
             auto width = vid_frame.get_width();
 
             get_texture_map(res, points, width, height, mapped_intr, extr, pixels_ptr);
+            if (!full_frame)
+            {
+                zero_outside(pframe->get_texture_coordinates(), roi, width, height);
+                zero_outside(pixels_ptr, roi, width, height);
+            }
 
             if (run__occlusion_filter(extr))
             {
                 if (_occlusion_filter->find_scanning_direction(extr) == vertical)
                 {
                     _occlusion_filter->set_scanning(static_cast<uint8_t>(vertical));
-                    _occlusion_filter->_depth_units = _depth_units;
+                    _occlusion_filter->set_depth_units(_depth_units);
                 }
                 _occlusion_filter->process(pframe->get_vertices(), pframe->get_texture_coordinates(), _pixels_map, depth);
             }
@@ -321,6 +358,7 @@ namespace librealsense
         occlusion_invalidation->set_description(1.f, "Off");
         occlusion_invalidation->set_description(2.f, "On");
         register_option(RS2_OPTION_FILTER_MAGNITUDE, occlusion_invalidation);
+        _roi.register_to(*this);
     }
 
     bool pointcloud::should_process(const rs2::frame& frame)
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "synthetic-stream.h"
+#include "roi-options.h"
 #include <src/float3.h>
 
 
@@ -57,6 +58,11 @@ namespace librealsense
         rs2::frame process_depth_frame(const rs2::frame_source& source, const rs2::depth_frame& depth);
         void set_extrinsics();
 
+        // Only the region of interest is deprojected; implementations need only process rows [_first_row,_last_row)
+        roi_options _roi;
+        int _first_row = 0;
+        int _last_row = 0;
+
         stream_filter _prev_stream_filter;
         std::shared_ptr< pointcloud > _registered_auto_calib_cb;
     };
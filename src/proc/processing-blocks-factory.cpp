@@ -57,17 +57,14 @@ namespace librealsense
         return false;
     }
 
-    stream_profiles processing_block_factory::find_satisfied_requests(const stream_profiles& requests, const stream_profiles& supported_profiles) const
+    stream_profiles processing_block_factory::find_satisfied_requests(const stream_profiles& requests, const std::unordered_set<stream_profile>& supported_profiles) const
     {
         // Return all requests which are related to this processing block factory.
 
         stream_profiles satisfied_req;
         for (auto&& req : requests)
         {
-            auto equal_profiles_predicate = [&req](const std::shared_ptr<stream_profile_interface>& sp) {
-                return to_profile(req.get()) == to_profile(sp.get());
-            };
-            if (std::any_of(begin(supported_profiles), end(supported_profiles), equal_profiles_predicate))
+            if (supported_profiles.count(to_profile(req.get())))
                 satisfied_req.push_back(req);
         }
         return satisfied_req;
@@ -6,6 +6,7 @@
 #include <src/core/stream-profile.h>
 #include <src/core/stream-profile-interface.h>
 
+#include <unordered_set>
 #include <vector>
 
 #include "../types.h"
@@ -59,7 +60,7 @@ namespace librealsense
                 } );
         }
 
-        stream_profiles find_satisfied_requests(const stream_profiles& sp, const stream_profiles& supported_profiles) const;
+        stream_profiles find_satisfied_requests(const stream_profiles& sp, const std::unordered_set<stream_profile>& supported_profiles) const;
         bool has_source(const std::shared_ptr<stream_profile_interface>& source) const;
 
     protected:
@@ -0,0 +1,249 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "quality-governor.h"
+#include "decimation-filter.h"
+#include "spatial-filter.h"
+#include "temporal-filter.h"
+#include "hole-filling-filter.h"
+#include <src/core/frame-callback.h>
+
+#include <rsutils/string/from.h>
+#include <rsutils/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+
+namespace librealsense
+{
+    constexpr float quality_governor::degrade_load;
+    constexpr float quality_governor::restore_load;
+    constexpr int quality_governor::settle_frames;
+    constexpr int quality_governor::max_restore_frames;
+
+    // Weight of the latest frame in the averages
+    static const float average_weight = 0.2f;
+
+    quality_governor::quality_governor()
+        : processing_block( "Quality Governor" )
+        , _output( std::make_shared< frame_holder >() )
+    {
+        auto on_frame = [this]( rs2::frame f, const rs2::frame_source & source )
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            auto out = process( f );
+            if( out )
+                source.frame_ready( out );
+        };
+
+        auto callback = new rs2::frame_processor_callback< decltype( on_frame ) >( on_frame );
+        processing_block::set_processing_callback( std::shared_ptr< rs2_frame_processor_callback >( callback ) );
+    }
+
+    void quality_governor::add_block( std::shared_ptr< processing_block_interface > block, int degrade_order )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+
+        stage s;
+        s.block = block;
+        s.degrade_order = degrade_order;
+        if( dynamic_cast< decimation_filter * >( block.get() ) )
+            s.kind = stage_kind::decimation;
+        else if( dynamic_cast< spatial_filter * >( block.get() ) )
+            s.kind = stage_kind::spatial;
+        else if( dynamic_cast< temporal_filter * >( block.get() ) )
+            s.kind = stage_kind::temporal;
+        else if( dynamic_cast< hole_filling_filter * >( block.get() ) )
+            s.kind = stage_kind::hole_filling;
+
+        // The block is run synchronously: its output is picked up right after invoking it. The holder is shared so a
+        // block that outlives us does not write into a dangling governor.
+        auto output = _output;
+        block->set_output_callback( make_frame_callback( [output]( frame_interface * f ) { *output = frame_holder( f ); } ) );
+        _stages.push_back( std::move( s ) );
+
+        _degrade_order.clear();
+        for( size_t i = 0; i < _stages.size(); ++i )
+            if( _stages[i].kind != stage_kind::other && _stages[i].degrade_order >= 0 )
+                _degrade_order.push_back( i );
+        std::stable_sort( _degrade_order.begin(), _degrade_order.end(),
+                          [this]( size_t a, size_t b ) { return _stages[a].degrade_order < _stages[b].degrade_order; } );
+    }
+
+    void quality_governor::set_notifications_callback( rs2_notifications_callback_sptr callback )
+    {
+        _notifications.set_callback( std::move( callback ) );
+    }
+
+    int quality_governor::get_level() const
+    {
+        return _level;
+    }
+
+    rs2::frame quality_governor::process( rs2::frame f )
+    {
+        auto const start = std::chrono::steady_clock::now();
+        auto current = f;
+        for( auto & s : _stages )
+        {
+            if( s.steps && s.kind == stage_kind::hole_filling )
+                continue;
+            if( s.steps && s.kind == stage_kind::temporal )
+            {
+                s.skipped = ! s.skipped;
+                if( s.skipped )
+                    continue;
+            }
+
+            auto const block_start = std::chrono::steady_clock::now();
+            s.block->invoke( frame_holder::acquire( (frame_interface *)current.get() ) );
+            // A block that outputs nothing passes its input on
+            if( *_output )
+            {
+                current = rs2::frame( (rs2_frame *)_output->frame );
+                _output->frame = nullptr;
+            }
+            double const ms
+                = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - block_start ).count();
+            s.average_ms += average_weight * ( float( ms ) - s.average_ms );
+        }
+
+        double const chain_ms
+            = std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now() - start ).count();
+        auto const fps = f.get_profile().fps();
+        if( fps > 0 && ! _degrade_order.empty() )
+            govern( chain_ms, 1000. / fps );
+        return current;
+    }
+
+    void quality_governor::govern( double chain_ms, double interval_ms )
+    {
+        // The average starts over after a change: the cost of the chain is not what it was
+        auto const load = float( chain_ms / interval_ms );
+        _load = _frames_since_change ? _load + average_weight * ( load - _load ) : load;
+        if( ++_frames_since_change < settle_frames )
+            return;
+
+        if( _load > degrade_load )
+        {
+            for( auto i : _degrade_order )
+            {
+                auto & s = _stages[i];
+                if( ! can_degrade( s ) )
+                    continue;
+                if( _last_change_was_restore && _frames_since_change < _restore_frames )
+                    _restore_frames = std::min( 2 * _restore_frames, max_restore_frames );
+                if( ! s.steps && ( s.kind == stage_kind::decimation || s.kind == stage_kind::spatial ) )
+                    s.base_value = s.block->get_option( RS2_OPTION_FILTER_MAGNITUDE ).query();
+                ++s.steps;
+                ++_level;
+                apply( s );
+                notify( s, true );
+                _frames_since_change = 0;
+                _last_change_was_restore = false;
+                return;
+            }
+        }
+        else if( _load < restore_load && _level && _frames_since_change >= _restore_frames )
+        {
+            for( auto it = _degrade_order.rbegin(); it != _degrade_order.rend(); ++it )
+            {
+                auto & s = _stages[*it];
+                if( ! s.steps )
+                    continue;
+                --s.steps;
+                --_level;
+                apply( s );
+                notify( s, false );
+                _frames_since_change = 0;
+                _last_change_was_restore = true;
+                return;
+            }
+        }
+    }
+
+    bool quality_governor::can_degrade( const stage & s ) const
+    {
+        switch( s.kind )
+        {
+        case stage_kind::decimation:
+        {
+            auto & magnitude = s.block->get_option( RS2_OPTION_FILTER_MAGNITUDE );
+            auto range = magnitude.get_range();
+            return magnitude.query() + range.step <= range.max;
+        }
+        case stage_kind::spatial:
+        {
+            auto & iterations = s.block->get_option( RS2_OPTION_FILTER_MAGNITUDE );
+            auto range = iterations.get_range();
+            return iterations.query() - range.step >= range.min;
+        }
+        case stage_kind::temporal:
+        case stage_kind::hole_filling:
+            return ! s.steps;
+        default:
+            return false;
+        }
+    }
+
+    void quality_governor::apply( stage & s )
+    {
+        switch( s.kind )
+        {
+        case stage_kind::decimation:
+        {
+            auto & magnitude = s.block->get_option( RS2_OPTION_FILTER_MAGNITUDE );
+            magnitude.set( s.base_value + s.steps * magnitude.get_range().step );
+            break;
+        }
+        case stage_kind::spatial:
+        {
+            auto & iterations = s.block->get_option( RS2_OPTION_FILTER_MAGNITUDE );
+            iterations.set( s.base_value - s.steps * iterations.get_range().step );
+            break;
+        }
+        case stage_kind::temporal:
+            s.skipped = false;
+            break;
+        default:
+            break;
+        }
+    }
+
+    void quality_governor::notify( const stage & s, bool degraded )
+    {
+        auto & name = s.block->get_info( RS2_CAMERA_INFO_NAME );
+        rsutils::string::from description;
+        description << ( degraded ? "Processing over budget" : "Processing within budget" ) << " (load "
+                    << std::fixed << std::setprecision( 2 ) << _load << "): " << name;
+        switch( s.kind )
+        {
+        case stage_kind::decimation:
+        case stage_kind::spatial:
+            description << ( s.kind == stage_kind::decimation ? " magnitude " : " iterations " )
+                        << s.block->get_option( RS2_OPTION_FILTER_MAGNITUDE ).query();
+            break;
+        case stage_kind::temporal:
+            description << ( s.steps ? " on alternate frames" : " on every frame" );
+            break;
+        default:
+            description << ( s.steps ? " skipped" : " restored" );
+            break;
+        }
+        description << std::setprecision( 1 ) << " [";
+        for( size_t i = 0; i < _stages.size(); ++i )
+            description << ( i ? ", " : "" ) << _stages[i].block->get_info( RS2_CAMERA_INFO_NAME ) << ' '
+                        << _stages[i].average_ms << " ms";
+        description << ']';
+
+        notification n( RS2_NOTIFICATION_CATEGORY_PROCESSING_QUALITY,
+                        _level,
+                        degraded ? RS2_LOG_SEVERITY_WARN : RS2_LOG_SEVERITY_INFO,
+                        description );
+        n.serialized_data = rsutils::json{ { "level", _level.load() }, { "load", _load }, { "block", name } }.dump();
+        LOG_DEBUG( n.description );
+        _notifications.raise_notification( n );
+    }
+}
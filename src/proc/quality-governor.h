@@ -0,0 +1,83 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include <src/core/notification.h>
+
+#include <atomic>
+#include <vector>
+
+
+namespace librealsense
+{
+    // Runs a chain of processing blocks and keeps it within the frame interval of the stream it processes.
+    //
+    // The time each block takes is measured on every frame. When the whole chain takes longer than the interval
+    // between frames (from the stream's fps), quality is lowered one step at a time, and restored again one step at a
+    // time once there is enough headroom. The blocks are degraded in their degrade order, and restored in reverse:
+    //     - a decimation filter gets a higher magnitude, up to its maximum;
+    //     - a spatial filter gets fewer iterations, down to one;
+    //     - a temporal filter is run on every other frame only;
+    //     - a hole-filling filter is skipped.
+    // Other blocks, and blocks added with a negative degrade order, are never degraded.
+    //
+    // Every change is reported as an RS2_NOTIFICATION_CATEGORY_PROCESSING_QUALITY notification.
+    //
+    // The blocks added are driven by the governor from then on: their output goes to the next block in the chain.
+    //
+    class quality_governor : public processing_block
+    {
+    public:
+        // The load is the time the chain takes over the frame interval, averaged over recent frames
+        static constexpr float degrade_load = 0.9f;
+        static constexpr float restore_load = 0.6f;
+        // Frames to wait after a change before deciding on another; doubled for restoring every time a restore is
+        // undone right away, so a chain on the edge does not keep flipping
+        static constexpr int settle_frames = 15;
+        static constexpr int max_restore_frames = 16 * settle_frames;
+
+        quality_governor();
+
+        void add_block( std::shared_ptr< processing_block_interface > block, int degrade_order );
+        void set_notifications_callback( rs2_notifications_callback_sptr callback );
+
+        // Number of degradation steps currently in effect
+        int get_level() const;
+
+    private:
+        enum class stage_kind { other, decimation, spatial, temporal, hole_filling };
+
+        struct stage
+        {
+            std::shared_ptr< processing_block_interface > block;
+            stage_kind kind = stage_kind::other;
+            int degrade_order = -1;
+            float average_ms = 0.f;
+            int steps = 0;           // degradation steps taken
+            float base_value = 0.f;  // of the option, before the first step
+            bool skipped = false;    // on alternate frames: the last one was skipped
+        };
+
+        rs2::frame process( rs2::frame f );
+        void govern( double chain_ms, double interval_ms );
+
+        bool can_degrade( const stage & s ) const;
+        void apply( stage & s );
+        void notify( const stage & s, bool degraded );
+
+        std::vector< stage > _stages;             // in chain order
+        std::vector< size_t > _degrade_order;     // of the stages that can be degraded
+        std::shared_ptr< frame_holder > _output;  // of the block being run; shared with the blocks' callbacks
+
+        float _load = 0.f;
+        std::atomic< int > _level{ 0 };
+        int _frames_since_change = 0;
+        int _restore_frames = 2 * settle_frames;
+        bool _last_change_was_restore = false;
+
+        notifications_processor _notifications;
+    };
+    MAP_EXTENSION( RS2_EXTENSION_QUALITY_GOVERNOR, librealsense::quality_governor );
+}
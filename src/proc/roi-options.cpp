@@ -0,0 +1,87 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "roi-options.h"
+#include <src/option.h>
+#include <src/frame.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace librealsense
+{
+    void roi_options::register_to( options_container & block )
+    {
+        block.register_option( RS2_OPTION_ROI_MIN_X,
+                               std::make_shared< ptr_option< float > >( 0.f, 1.f, 0.01f, 0.f, &_roi.min_x,
+                                                                        "Left edge of the region of interest, as a fraction of the width" ) );
+        block.register_option( RS2_OPTION_ROI_MIN_Y,
+                               std::make_shared< ptr_option< float > >( 0.f, 1.f, 0.01f, 0.f, &_roi.min_y,
+                                                                        "Top edge of the region of interest, as a fraction of the height" ) );
+        block.register_option( RS2_OPTION_ROI_MAX_X,
+                               std::make_shared< ptr_option< float > >( 0.f, 1.f, 0.01f, 1.f, &_roi.max_x,
+                                                                        "Right edge of the region of interest, as a fraction of the width" ) );
+        block.register_option( RS2_OPTION_ROI_MAX_Y,
+                               std::make_shared< ptr_option< float > >( 0.f, 1.f, 0.01f, 1.f, &_roi.max_y,
+                                                                        "Bottom edge of the region of interest, as a fraction of the height" ) );
+    }
+
+    static pixel_roi to_pixels( const frame_roi & fraction, int width, int height )
+    {
+        // Edges are rounded outwards, so any pixel touched by the region is in it
+        pixel_roi roi;
+        roi.min_x = std::max( 0, int( std::floor( fraction.min_x * width ) ) );
+        roi.min_y = std::max( 0, int( std::floor( fraction.min_y * height ) ) );
+        roi.max_x = std::min( width, int( std::ceil( fraction.max_x * width ) ) );
+        roi.max_y = std::min( height, int( std::ceil( fraction.max_y * height ) ) );
+        // Edges set in the wrong order leave nothing
+        roi.max_x = std::max( roi.max_x, roi.min_x );
+        roi.max_y = std::max( roi.max_y, roi.min_y );
+        return roi;
+    }
+
+    pixel_roi roi_options::get( int width, int height ) const
+    {
+        return to_pixels( _roi, width, height );
+    }
+
+    frame_roi const & roi_options::resolve( const rs2::frame & f ) const
+    {
+        if( ! _roi.is_full_frame() )
+            return _roi;
+        if( auto fr = dynamic_cast< frame * >( (frame_interface *)f.get() ) )
+            return fr->additional_data.roi;
+        return _roi;
+    }
+
+    pixel_roi roi_options::get( const rs2::frame & f, int width, int height ) const
+    {
+        return to_pixels( resolve( f ), width, height );
+    }
+
+    void roi_options::apply( const rs2::frame & input, const rs2::frame & output ) const
+    {
+        if( auto fr = dynamic_cast< frame * >( (frame_interface *)output.get() ) )
+            fr->additional_data.roi = resolve( input );
+    }
+
+    void copy_roi_out( const void * image, int image_stride, const pixel_roi & roi, int bpp, void * out )
+    {
+        auto const row_size = size_t( roi.width() ) * bpp;
+        auto src = static_cast< const uint8_t * >( image ) + size_t( roi.min_y ) * image_stride + size_t( roi.min_x ) * bpp;
+        auto dst = static_cast< uint8_t * >( out );
+        for( int y = roi.min_y; y < roi.max_y; ++y, src += image_stride, dst += row_size )
+            std::memcpy( dst, src, row_size );
+    }
+
+    void copy_roi_in( const void * in, const pixel_roi & roi, int bpp, void * image, int image_stride )
+    {
+        auto const row_size = size_t( roi.width() ) * bpp;
+        auto src = static_cast< const uint8_t * >( in );
+        auto dst = static_cast< uint8_t * >( image ) + size_t( roi.min_y ) * image_stride + size_t( roi.min_x ) * bpp;
+        for( int y = roi.min_y; y < roi.max_y; ++y, src += row_size, dst += image_stride )
+            std::memcpy( dst, src, row_size );
+    }
+}
@@ -0,0 +1,60 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <src/core/options-container.h>
+#include <src/core/frame-additional-data.h>
+
+#include <librealsense2/hpp/rs_frame.hpp>
+
+
+namespace librealsense
+{
+    // Pixels [min_x,max_x) x [min_y,max_y) of an image
+    struct pixel_roi
+    {
+        int min_x, min_y, max_x, max_y;
+
+        int width() const { return max_x - min_x; }
+        int height() const { return max_y - min_y; }
+        bool empty() const { return max_x <= min_x || max_y <= min_y; }
+    };
+
+
+    // The region of interest of a processing block, exposed through the RS2_OPTION_ROI_* options.
+    //
+    // The edges are fractions of the image width and height, so the same region applies to any resolution (e.g.,
+    // before and after decimation); by default it covers the whole image.
+    //
+    // A block processing only its region records it on its output (see frame_roi); a block left with the whole
+    // image processes its input in the region recorded on it, so setting the region on the first block of a chain of
+    // region-aware blocks is enough. Other blocks (align, decimation, etc.) output whole frames, with no region.
+    //
+    class roi_options
+    {
+    public:
+        void register_to( options_container & block );
+
+        // The region in pixels, for an image of the given size
+        pixel_roi get( int width, int height ) const;
+
+        // The region in pixels to process a frame in: ours if set, otherwise the one recorded on the frame
+        pixel_roi get( const rs2::frame & f, int width, int height ) const;
+
+        // Records the region a frame was processed in -- ours if set, otherwise that of its input -- on the output
+        void apply( const rs2::frame & input, const rs2::frame & output ) const;
+
+        bool is_full_frame() const { return _roi.is_full_frame(); }
+
+    private:
+        frame_roi const & resolve( const rs2::frame & f ) const;
+
+        frame_roi _roi;
+    };
+
+
+    // The region of an image copied to / from a contiguous buffer, for algorithms written for whole images
+    void copy_roi_out( const void * image, int image_stride, const pixel_roi & roi, int bpp, void * out );
+    void copy_roi_in( const void * in, const pixel_roi & roi, int bpp, void * image, int image_stride );
+}
@@ -0,0 +1,98 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "sequence-demux.h"
+#include <src/core/frame-interface.h>
+
+#include <librealsense2/rs.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace librealsense
+{
+    constexpr int sequence_demux::max_sequence_size;
+
+    sequence_demux::sequence_demux()
+        : stream_filter_processing_block( "Sequence Demultiplexer" )
+    {
+        // Only the captured stream is split; the logical streams we output (index 1 and up) go through untouched
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+        _stream_filter.index = 0;
+        _demuxed.reserve( 4 );
+    }
+
+    bool sequence_demux::should_process( const rs2::frame & frame )
+    {
+        if( ! stream_filter_processing_block::should_process( frame ) )
+            return false;
+
+        // Straight to the metadata parsers, without the error-handling of the public API for each field
+        auto fi = (frame_interface *)frame.get();
+        rs2_metadata_type sequence_size = 0, sequence_id = 0;
+        if( ! fi->find_metadata( RS2_FRAME_METADATA_SEQUENCE_SIZE, &sequence_size ) || sequence_size <= 0 )
+            return false;
+        if( ! fi->find_metadata( RS2_FRAME_METADATA_SEQUENCE_ID, &sequence_id ) )
+            return false;
+        if( sequence_id < 0 || sequence_id >= std::min< rs2_metadata_type >( sequence_size, max_sequence_size ) )
+            return false;
+
+        _sequence_id = int( sequence_id );
+        return true;
+    }
+
+    rs2::stream_profile const & sequence_demux::get_target_profile( const rs2::frame & f, int sequence_id )
+    {
+        auto & slot = _slots[sequence_id];
+        auto profile = f.get_profile();
+        if( profile.get() != slot.source_profile.get() )
+        {
+            auto vp = profile.as< rs2::video_stream_profile >();
+            slot.target_profile = vp.clone( vp.stream_type(), vp.stream_index() + sequence_id + 1, vp.format(),
+                                            vp.width(), vp.height(), vp.get_intrinsics() );
+            slot.source_profile = profile;
+        }
+        return slot.target_profile;
+    }
+
+    rs2::frame sequence_demux::process_frame( const rs2::frame_source & source, const rs2::frame & f )
+    {
+        auto vf = f.as< rs2::video_frame >();
+        if( ! vf )
+            return f;
+
+        auto & target_profile = get_target_profile( f, _sequence_id );
+        auto const ext = f.is< rs2::disparity_frame >() ? RS2_EXTENSION_DISPARITY_FRAME
+                       : f.is< rs2::depth_frame >()     ? RS2_EXTENSION_DEPTH_FRAME
+                                                        : RS2_EXTENSION_VIDEO_FRAME;
+        auto out = source.allocate_video_frame( target_profile, f, vf.get_bytes_per_pixel(), vf.get_width(),
+                                                vf.get_height(), vf.get_stride_in_bytes(), ext );
+        if( ! out )
+            return f;
+        std::memcpy( const_cast< void * >( out.get_data() ), vf.get_data(),
+                     size_t( vf.get_stride_in_bytes() ) * vf.get_height() );
+
+        _demuxed.push_back( f.get() );
+        return out;
+    }
+
+    rs2::frame sequence_demux::prepare_output( const rs2::frame_source & source, rs2::frame input,
+                                               std::vector< rs2::frame > results )
+    {
+        // A demuxed frame has a different stream index than its input, so the generic heuristic would keep both in the
+        // output frameset: the input frames we replaced are left out here instead
+        auto composite = input.as< rs2::frameset >();
+        if( ! composite || results.empty() )
+        {
+            _demuxed.clear();
+            return results.empty() ? input : results[0];
+        }
+
+        for( auto f : composite )
+            if( std::find( _demuxed.begin(), _demuxed.end(), f.get() ) == _demuxed.end() )
+                results.push_back( f );
+        _demuxed.clear();
+        return source.allocate_composite_frame( results );
+    }
+}
@@ -0,0 +1,48 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+#include <array>
+
+
+namespace librealsense
+{
+    // Splits a depth stream captured with a sequence of exposures (HDR or a subpreset) into one logical stream per
+    // sequence id: a depth frame with RS2_FRAME_METADATA_SEQUENCE_ID n comes out with its own stream profile of
+    // stream index n + 1, so downstream filters (one per index), syncers and queues see a regular depth stream per
+    // exposure and need no matching logic of their own.
+    //
+    // Frames without sequence metadata, or outside a sequence (SEQUENCE_SIZE 0), pass through unchanged. The state
+    // is a fixed slot per sequence id, up to max_sequence_size.
+    //
+    class sequence_demux : public stream_filter_processing_block
+    {
+    public:
+        static constexpr int max_sequence_size = 8;
+
+        sequence_demux();
+
+    protected:
+        bool should_process( const rs2::frame & frame ) override;
+        rs2::frame process_frame( const rs2::frame_source & source, const rs2::frame & f ) override;
+        rs2::frame prepare_output( const rs2::frame_source & source, rs2::frame input,
+                                   std::vector< rs2::frame > results ) override;
+
+    private:
+        struct sequence_slot
+        {
+            rs2::stream_profile source_profile;
+            rs2::stream_profile target_profile;
+        };
+
+        rs2::stream_profile const & get_target_profile( const rs2::frame & f, int sequence_id );
+
+        std::array< sequence_slot, max_sequence_size > _slots;
+        int _sequence_id = 0;  // of the frame accepted by should_process()
+        std::vector< rs2_frame * > _demuxed;  // input frames replaced by process_frame(), for prepare_output()
+    };
+    MAP_EXTENSION( RS2_EXTENSION_SEQUENCE_DEMUX, librealsense::sequence_demux );
+}
@@ -0,0 +1,91 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "sparse-pointcloud.h"
+#include <src/option.h>
+#include <src/points.h>
+
+#include <librealsense2/rs.hpp>
+
+#include <rsutils/concurrency/worker-pool.h>
+
+#include <cstring>
+
+
+namespace librealsense
+{
+    sparse_pointcloud::sparse_pointcloud()
+        : stream_filter_processing_block( "Sparse Pointcloud" )
+    {
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+        _stream_filter.format = RS2_FORMAT_Z16;
+
+        auto stride = std::make_shared< ptr_option< int > >( 1, 8, 1, 2, &_stride, "Deproject every Nth pixel" );
+        register_option( RS2_OPTION_FILTER_MAGNITUDE, stride );
+        _roi.register_to( *this );
+    }
+
+    void sparse_pointcloud::update_output_profile( const rs2::frame & f, const pixel_roi & roi )
+    {
+        if( f.get_profile().get() == _source_stream_profile.get() && _target_stride == _stride
+            && ! std::memcmp( &roi, &_target_roi, sizeof( roi ) ) )
+            return;
+
+        _source_stream_profile = f.get_profile();
+        _target_roi = roi;
+        _target_stride = _stride;
+        _target_width = ( roi.width() + _stride - 1 ) / _stride;
+        _target_height = ( roi.height() + _stride - 1 ) / _stride;
+
+        // Output pixel (i,j) is input pixel (min_x + i*stride, min_y + j*stride)
+        auto vp = _source_stream_profile.as< rs2::video_stream_profile >();
+        auto intrin = vp.get_intrinsics();
+        intrin.width = _target_width;
+        intrin.height = _target_height;
+        intrin.ppx = ( intrin.ppx - roi.min_x ) / _stride;
+        intrin.ppy = ( intrin.ppy - roi.min_y ) / _stride;
+        intrin.fx /= _stride;
+        intrin.fy /= _stride;
+        _target_stream_profile = vp.clone( RS2_STREAM_DEPTH, vp.stream_index(), RS2_FORMAT_XYZ32F,
+                                           _target_width, _target_height, intrin );
+    }
+
+    rs2::frame sparse_pointcloud::process_frame( const rs2::frame_source & source, const rs2::frame & f )
+    {
+        auto depth = f.as< rs2::depth_frame >();
+        if( ! depth )
+            return f;
+
+        _rays.update( depth.get_profile().as< rs2::video_stream_profile >().get_intrinsics(), depth.get_units() );
+        auto const roi = _roi.get( f, _rays.width(), _rays.height() );
+        if( roi.empty() )
+            return f;
+        update_output_profile( f, roi );
+
+        rs2::points output = source.allocate_points( _target_stream_profile, f );
+        auto pts = (points *)output.get();
+        auto vertices = pts->get_vertices();
+        std::memset( pts->get_texture_coordinates(), 0, pts->get_vertex_count() * sizeof( float2 ) );
+
+        auto const data = reinterpret_cast< const uint8_t * >( depth.get_data() );
+        auto const depth_stride = depth.get_stride_in_bytes();
+        int const stride = _target_stride;
+        int const out_width = _target_width;
+        rsutils::concurrency::worker_pool::shared().parallel_for(
+            _target_height,
+            16,
+            [&]( size_t begin, size_t end )
+            {
+                for( auto j = begin; j < end; ++j )
+                {
+                    int const y = roi.min_y + int( j ) * stride;
+                    auto const row = reinterpret_cast< const uint16_t * >( data + y * depth_stride );
+                    auto out = vertices + j * out_width;
+                    for( int x = roi.min_x; x < roi.max_x; x += stride )
+                        *out++ = row[x] ? _rays.deproject( x, y, row[x] ) : float3{ 0, 0, 0 };
+                }
+            } );
+
+        return output;
+    }
+}
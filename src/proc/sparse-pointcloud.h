@@ -0,0 +1,43 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "depth-rays.h"
+#include "roi-options.h"
+
+
+namespace librealsense
+{
+    // Pointcloud of a subsampled range image: only every Nth pixel, in each direction, of the region of interest of a
+    // depth frame is deprojected, so the full-resolution cloud is never produced.
+    //
+    // The output stays organized like an image, (ROI width / N) x (ROI height / N), with invalid depth as (0,0,0) and
+    // without texture coordinates; its stream profile carries matching intrinsics. The stride is set with
+    // RS2_OPTION_FILTER_MAGNITUDE and the region with the RS2_OPTION_ROI_* options.
+    //
+    class sparse_pointcloud : public stream_filter_processing_block
+    {
+    public:
+        sparse_pointcloud();
+
+    protected:
+        rs2::frame process_frame( const rs2::frame_source & source, const rs2::frame & f ) override;
+
+    private:
+        void update_output_profile( const rs2::frame & f, const pixel_roi & roi );
+
+        int _stride = 2;
+        roi_options _roi;
+        depth_rays _rays;
+
+        rs2::stream_profile _source_stream_profile;
+        rs2::stream_profile _target_stream_profile;
+        pixel_roi _target_roi{};
+        int _target_stride = 0;
+        int _target_width = 0;
+        int _target_height = 0;
+    };
+    MAP_EXTENSION( RS2_EXTENSION_SPARSE_POINTCLOUD, librealsense::sparse_pointcloud );
+}
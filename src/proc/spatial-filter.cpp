@@ -157,6 +157,7 @@ namespace librealsense
         register_option(RS2_OPTION_FILTER_SMOOTH_DELTA, spatial_filter_delta);
         register_option(RS2_OPTION_FILTER_MAGNITUDE, spatial_filter_iterations);
         register_option(RS2_OPTION_HOLES_FILL, holes_filling_mode);
+        _roi.register_to(*this);
     }
 
     rs2::frame spatial_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
@@ -165,16 +166,46 @@ namespace librealsense
 
         update_configuration(f);
         tgt = prepare_target_frame(f, source);
+        _roi.apply(f, tgt);
+
+        // Outside the region of interest the target stays a copy of the input; inside, the filter runs on a
+        // contiguous copy of the region, as if it were the whole image
+        auto roi = _roi.get(f, int(_width), int(_height));
+        if (roi.width() < 3 || roi.height() < 3)
+            return tgt;
+        void* data = const_cast<void*>(tgt.get_data());
+        bool full_frame = (roi.width() == int(_width) && roi.height() == int(_height));
+        if (!full_frame)
+        {
+            _roi_data.resize(size_t(roi.width()) * roi.height() * _bpp);
+            copy_roi_out(data, int(_stride), roi, int(_bpp), _roi_data.data());
+            set_image_size(roi.width(), roi.height());
+            data = _roi_data.data();
+        }
 
         // Spatial domain transform edge-preserving filter
         if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
-            dxf_smooth<float>(const_cast<void*>(tgt.get_data()), _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+            dxf_smooth<float>(data, _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
         else
-            dxf_smooth<uint16_t>(const_cast<void*>(tgt.get_data()), _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+            dxf_smooth<uint16_t>(data, _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
 
+        if (!full_frame)
+        {
+            auto vp = _target_stream_profile.as<rs2::video_stream_profile>();
+            set_image_size(vp.width(), vp.height());
+            copy_roi_in(_roi_data.data(), roi, int(_bpp), const_cast<void*>(tgt.get_data()), int(_stride));
+        }
         return tgt;
     }
 
+    void spatial_filter::set_image_size(int width, int height)
+    {
+        _width = width;
+        _height = height;
+        _stride = _width * _bpp;
+        _current_frm_size_pixels = _width * _height;
+    }
+
     void  spatial_filter::update_configuration(const rs2::frame& f)
     {
         if (f.get_profile().get() != _source_stream_profile.get())
@@ -186,10 +217,7 @@ namespace librealsense
             _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
             auto vp = _target_stream_profile.as<rs2::video_stream_profile>();
             _focal_lenght_mm = vp.get_intrinsics().fx;
-            _width = vp.width();
-            _height = vp.height();
-            _stride = _width * _bpp;
-            _current_frm_size_pixels = _width * _height;
+            set_image_size(vp.width(), vp.height());
 
             // Check if the new frame originated from stereo-based depth sensor
             // retrieve the stereo baseline parameter
@@ -12,6 +12,7 @@
 
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
+#include "roi-options.h"
 
 namespace librealsense
 {
@@ -22,6 +23,7 @@ namespace librealsense
 
     protected:
         void    update_configuration(const rs2::frame& f);
+        void    set_image_size(int width, int height);
 
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
@@ -280,6 +282,8 @@ namespace librealsense
         float                   _stereo_baseline_mm;
         uint8_t                 _holes_filling_mode;
         uint8_t                 _holes_filling_radius;
+        roi_options             _roi;
+        std::vector<uint8_t>    _roi_data;                  // The region of interest, when not the whole frame
     };
     MAP_EXTENSION(RS2_EXTENSION_SPATIAL_FILTER, librealsense::spatial_filter);
 }
@@ -12,9 +12,10 @@
 #include "environment.h"
 #include "stream.h"
 
-using namespace librealsense;
+#include <algorithm>
+#include <cstring>
 
-template<int N> struct bytes { uint8_t b[N]; };
+using namespace librealsense;
 
 bool is_special_resolution(const rs2_intrinsics& depth, const rs2_intrinsics& to)
 {
@@ -59,7 +60,9 @@ inline void distorte_x_y<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(const __m128& x,
 }
 
 
-template<rs2_distortion dist>
+// Projects depth pixels onto the other image, into the pixels they fall in (rounded), or their position there (where
+// pixels with no depth get -1)
+template<rs2_distortion dist, bool round_to_pixels = true>
 inline void get_texture_map_sse(const uint16_t * depth,
     float depth_scale,
     const unsigned int size,
@@ -103,7 +106,9 @@ inline void get_texture_map_sse(const uint16_t * depth,
     auto ppx = _mm_set_ps1(to.ppx);
     auto ppy = _mm_set_ps1(to.ppy);
 
-    for (unsigned int i = 0; i < size; i += 8)
+    // Whole groups of 8 pixels; a partial last group is done below
+    const unsigned int whole_groups = size & ~7u;
+    for (unsigned int i = 0; i < whole_groups; i += 8)
     {
         auto x0 = _mm_load_ps(mapx + i);
         auto x1 = _mm_load_ps(mapx + i + 4);
@@ -156,6 +161,25 @@ inline void get_texture_map_sse(const uint16_t * depth,
         p_x1 = _mm_add_ps(_mm_mul_ps(p_x1, fx), ppx);
         p_y1 = _mm_add_ps(_mm_mul_ps(p_y1, fy), ppy);
 
+        if (!round_to_pixels)
+        {
+            auto none = _mm_set_ps1(-1);
+
+            cmp = _mm_cmpneq_ps(depth0, zero);
+            auto u0 = _mm_or_ps(_mm_and_ps(cmp, p_x0), _mm_andnot_ps(cmp, none));
+            auto v0 = _mm_or_ps(_mm_and_ps(cmp, p_y0), _mm_andnot_ps(cmp, none));
+            _mm_stream_si128(&res[0], _mm_castps_si128(_mm_unpacklo_ps(u0, v0)));
+            _mm_stream_si128(&res[1], _mm_castps_si128(_mm_unpackhi_ps(u0, v0)));
+
+            cmp = _mm_cmpneq_ps(depth1, zero);
+            auto u1 = _mm_or_ps(_mm_and_ps(cmp, p_x1), _mm_andnot_ps(cmp, none));
+            auto v1 = _mm_or_ps(_mm_and_ps(cmp, p_y1), _mm_andnot_ps(cmp, none));
+            _mm_stream_si128(&res[2], _mm_castps_si128(_mm_unpacklo_ps(u1, v1)));
+            _mm_stream_si128(&res[3], _mm_castps_si128(_mm_unpackhi_ps(u1, v1)));
+            res += 4;
+            continue;
+        }
+
         cmp = _mm_cmpneq_ps(depth0, zero);
         auto half = _mm_set_ps1(0.5);
         auto u_round0 = _mm_and_ps(_mm_add_ps(p_x0, half), cmp);
@@ -191,6 +215,20 @@ inline void get_texture_map_sse(const uint16_t * depth,
         _mm_stream_si128(&res[1], res2_int1);
         res += 2;
     }
+
+    // The rest is mapped through zero-padded copies, so nothing past the end is read or written and the results are
+    // exactly those of a whole group
+    if (const unsigned int rest = size - whole_groups)
+    {
+        alignas(16) uint16_t rest_depth[8] = {};
+        alignas(16) float rest_x[8] = {}, rest_y[8] = {};
+        alignas(16) uint8_t rest_pixels[8 * 8];
+        std::copy(depth + whole_groups, depth + size, rest_depth);
+        std::copy(pre_compute_x + whole_groups, pre_compute_x + size, rest_x);
+        std::copy(pre_compute_y + whole_groups, pre_compute_y + size, rest_y);
+        get_texture_map_sse<dist, round_to_pixels>(rest_depth, depth_scale, 8, rest_x, rest_y, rest_pixels, to, from_to_other);
+        std::memcpy(pixels_ptr_int + whole_groups * 8, rest_pixels, rest * 8);
+    }
 }
 
 image_transform::image_transform(const rs2_intrinsics& from, float depth_scale)
@@ -239,16 +277,33 @@ void image_transform::pre_compute_x_y_map(std::vector<float>& pre_compute_map_x,
     }
 }
 
+// Calls map_pixels(begin, count) for all the depth pixels, or only for the blocks of them that changed (the last of
+// which may be partial)
+template<class MAP_PIXELS>
+inline void map_changed_pixels(int size, bool whole, const std::vector<uint32_t>& changed_blocks, MAP_PIXELS map_pixels)
+{
+    if (whole)
+    {
+        map_pixels(0, size);
+        return;
+    }
+    for (auto block : changed_blocks)
+    {
+        int begin = int(block * depth_change_tracker::block_size);
+        map_pixels(begin, std::min(int(depth_change_tracker::block_size), size - begin));
+    }
+}
+
 void image_transform::align_depth_to_other(const uint16_t* z_pixels, uint16_t* dest, int bpp, const rs2_intrinsics& depth, const rs2_intrinsics& to,
-    const rs2_extrinsics& from_to_other)
+    const rs2_extrinsics& from_to_other, depth_to_other_map& map, bool whole)
 {
     switch (to.model)
     {
     case RS2_DISTORTION_MODIFIED_BROWN_CONRADY:
-        align_depth_to_other_sse<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, dest, depth, to, from_to_other);
+        align_depth_to_other_sse<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, dest, depth, to, from_to_other, map, whole);
         break;
     default:
-        align_depth_to_other_sse(z_pixels, dest, depth, to, from_to_other);
+        align_depth_to_other_sse(z_pixels, dest, depth, to, from_to_other, map, whole);
         break;
     }
 }
@@ -281,17 +336,17 @@ inline void image_transform::move_depth_to_other(const uint16_t* z_pixels, uint1
     }
 }
 
-void image_transform::align_other_to_depth(const uint16_t* z_pixels, const uint8_t * source, uint8_t * dest, int bpp, const rs2_intrinsics& to,
-    const rs2_extrinsics& from_to_other)
+void image_transform::map_other_to_depth(const uint16_t* z_pixels, const rs2_intrinsics& to,
+    const rs2_extrinsics& from_to_other, other_to_depth_map& map, bool whole)
 {
     switch (to.model)
     {
     case RS2_DISTORTION_MODIFIED_BROWN_CONRADY:
     case RS2_DISTORTION_INVERSE_BROWN_CONRADY:
-        align_other_to_depth_sse<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, source, dest, bpp, to, from_to_other);
+        map_other_to_depth_sse<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, to, from_to_other, map, whole);
         break;
     default:
-        align_other_to_depth_sse(z_pixels, source, dest, bpp, to, from_to_other);
+        map_other_to_depth_sse(z_pixels, to, from_to_other, map, whole);
         break;
     }
 }
@@ -299,11 +354,8 @@ void image_transform::align_other_to_depth(const uint16_t* z_pixels, const uint8
 
 template<rs2_distortion dist>
 inline void image_transform::align_depth_to_other_sse(const uint16_t * z_pixels, uint16_t * dest, const rs2_intrinsics& depth, const rs2_intrinsics& to,
-    const rs2_extrinsics& from_to_other)
+    const rs2_extrinsics& from_to_other, depth_to_other_map& map, bool whole)
 {
-    get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
-        _pre_compute_map_y_top_left.data(), (uint8_t *)_pixel_top_left_int.data(), to, from_to_other);
-
     float fov[2];
     rs2_fov(&depth, fov);
     float2 pixels_per_angle_depth = { (float)depth.width / fov[0], (float)depth.height / fov[1] };
@@ -311,89 +363,58 @@ inline void image_transform::align_depth_to_other_sse(const uint16_t * z_pixels,
     rs2_fov(&to, fov);
     float2 pixels_per_angle_target = { (float)to.width / fov[0], (float)to.height / fov[1] };
 
-    if (pixels_per_angle_depth.x < pixels_per_angle_target.x || pixels_per_angle_depth.y < pixels_per_angle_target.y || is_special_resolution(depth, to))
-    {
-        get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
-            _pre_compute_map_y_bottom_right.data(), (uint8_t *)_pixel_bottom_right_int.data(), to, from_to_other);
+    bool corners = pixels_per_angle_depth.x < pixels_per_angle_target.x || pixels_per_angle_depth.y < pixels_per_angle_target.y || is_special_resolution(depth, to);
 
-        move_depth_to_other(z_pixels, dest, to, _pixel_top_left_int, _pixel_bottom_right_int);
-    }
-    else
+    map_changed_pixels(_depth.height*_depth.width, whole, map.changed_blocks(), [&](int begin, int count)
     {
-        move_depth_to_other(z_pixels, dest, to, _pixel_top_left_int, _pixel_top_left_int);
-    }
+        get_texture_map_sse<dist>(z_pixels + begin, _depth_scale, count, _pre_compute_map_x_top_left.data() + begin,
+            _pre_compute_map_y_top_left.data() + begin, (uint8_t *)(map.top_left.data() + begin), to, from_to_other);
+
+        if (corners)
+            get_texture_map_sse<dist>(z_pixels + begin, _depth_scale, count, _pre_compute_map_x_bottom_right.data() + begin,
+                _pre_compute_map_y_bottom_right.data() + begin, (uint8_t *)(map.bottom_right.data() + begin), to, from_to_other);
+    });
 
+    move_depth_to_other(z_pixels, dest, to, map.top_left, corners ? map.bottom_right : map.top_left);
 }
 
 template<rs2_distortion dist>
-inline void image_transform::align_other_to_depth_sse(const uint16_t * z_pixels, const uint8_t * source, uint8_t * dest, int bpp, const rs2_intrinsics& to,
-    const rs2_extrinsics& from_to_other)
+inline void image_transform::map_other_to_depth_sse(const uint16_t * z_pixels, const rs2_intrinsics& to,
+    const rs2_extrinsics& from_to_other, other_to_depth_map& map, bool whole)
 {
-    get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
-        _pre_compute_map_y_top_left.data(), (uint8_t *)_pixel_top_left_int.data(), to, from_to_other);
-
-    std::vector<int2>& bottom_right = _pixel_top_left_int;
-    if (to.height < _depth.height && to.width < _depth.width)
+    auto size = _depth.height*_depth.width;
+    if (map.interpolation() == align_bilinear)
     {
-        get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
-            _pre_compute_map_y_bottom_right.data(), (uint8_t *)_pixel_bottom_right_int.data(), to, from_to_other);
+        if (_pre_compute_map_x_center.empty())
+            pre_compute_x_y_map(_pre_compute_map_x_center, _pre_compute_map_y_center);
 
-        bottom_right = _pixel_bottom_right_int;
+        map_changed_pixels(size, whole, map.changed_blocks(), [&](int begin, int count)
+        {
+            get_texture_map_sse<dist, false>(z_pixels + begin, _depth_scale, count, _pre_compute_map_x_center.data() + begin,
+                _pre_compute_map_y_center.data() + begin, (uint8_t *)(map.position.data() + begin), to, from_to_other);
+        });
+        return;
     }
 
-    switch (bpp)
+    bool corners = to.height < _depth.height && to.width < _depth.width;
+    auto& bottom_right = corners ? _pixel_bottom_right_int : _pixel_top_left_int;
+    map_changed_pixels(size, whole, map.changed_blocks(), [&](int begin, int count)
     {
-    case 1:
-        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<1>*>(source), reinterpret_cast<bytes<1>*>(dest), to,
-            _pixel_top_left_int, bottom_right);
-        break;
-    case 2:
-        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<2>*>(source), reinterpret_cast<bytes<2>*>(dest), to,
-            _pixel_top_left_int, bottom_right);
-        break;
-    case 3:
-        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<3>*>(source), reinterpret_cast<bytes<3>*>(dest), to,
-            _pixel_top_left_int, bottom_right);
-        break;
-    case 4:
-        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<4>*>(source), reinterpret_cast<bytes<4>*>(dest), to,
-            _pixel_top_left_int, bottom_right);
-        break;
-    default:
-        break;
-    }
-}
+        get_texture_map_sse<dist>(z_pixels + begin, _depth_scale, count, _pre_compute_map_x_top_left.data() + begin,
+            _pre_compute_map_y_top_left.data() + begin, (uint8_t *)(_pixel_top_left_int.data() + begin), to, from_to_other);
 
-template<class T >
-void image_transform::move_other_to_depth(const uint16_t* z_pixels,
-    const T* source,
-    T* dest, const rs2_intrinsics& to,
-    const std::vector<librealsense::int2>& pixel_top_left_int,
-    const std::vector<librealsense::int2>& pixel_bottom_right_int)
-{
-    // Iterate over the pixels of the depth image
-    for (int y = 0; y < _depth.height; ++y)
-    {
-        for (int x = 0; x < _depth.width; ++x)
-        {
-            auto depth_pixel_index = y * _depth.width + x;
-            // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
-            if (z_pixels[depth_pixel_index])
-            {
-                for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
-                {
-                    for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
-                    {
-                        if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
-                            continue;
-                        auto other_ind = other_y * to.width + other_x;
+        if (corners)
+            get_texture_map_sse<dist>(z_pixels + begin, _depth_scale, count, _pre_compute_map_x_bottom_right.data() + begin,
+                _pre_compute_map_y_bottom_right.data() + begin, (uint8_t *)(_pixel_bottom_right_int.data() + begin), to, from_to_other);
 
-                        dest[depth_pixel_index] = source[other_ind];
-                    }
-                }
-            }
+        // Of the other pixels covered by the depth pixel, the last one
+        for (int i = begin; i < begin + count; ++i)
+        {
+            int x0 = std::max(_pixel_top_left_int[i].x, 0), x1 = std::min(bottom_right[i].x, to.width - 1);
+            int y0 = std::max(_pixel_top_left_int[i].y, 0), y1 = std::min(bottom_right[i].y, to.height - 1);
+            map.index[i] = (z_pixels[i] && x0 <= x1 && y0 <= y1) ? y1 * to.width + x1 : -1;
         }
-    }
+    });
 }
 
 void align_sse::reset_cache(rs2_stream from, rs2_stream to)
@@ -419,15 +440,18 @@ void align_sse::align_z_to_other(rs2::video_frame& aligned, const rs2::video_fra
     {
         _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale);
         _stream_transform->pre_compute_x_y_map_corners();
+        _depth_to_other_map.invalidate();
     }
-    _stream_transform->align_depth_to_other(z_pixels, reinterpret_cast<uint16_t*>(aligned_data), 2, z_intrin, other_intrin, z_to_other);
+
+    // The pixels covered by each depth pixel are only mapped again where depth changed
+    bool whole = _depth_to_other_map.update(z_pixels, size_t(z_intrin.width) * z_intrin.height, z_scale, _depth_change_threshold);
+    _stream_transform->align_depth_to_other(z_pixels, reinterpret_cast<uint16_t*>(aligned_data), 2, z_intrin, other_intrin, z_to_other,
+        _depth_to_other_map, whole);
 }
 
 void align_sse::align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale)
 {
     uint8_t * aligned_data = reinterpret_cast<uint8_t *>(const_cast<void*>(aligned.get_data()));
-    auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
-    memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
 
     auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
     auto other_profile = other.get_profile().as<rs2::video_stream_profile>();
@@ -445,6 +469,11 @@ void align_sse::align_other_to_z(rs2::video_frame& aligned, const rs2::video_fra
         _stream_transform->pre_compute_x_y_map_corners();
     }
 
-    _stream_transform->align_other_to_depth(z_pixels, other_pixels, aligned_data, other.get_bytes_per_pixel(), other_intrin, z_to_other);
+    // The map is only computed again where depth changed; remapping fills every pixel
+    auto& map = _other_maps[other_profile.get()->profile];
+    bool whole = map.update(z_pixels, size_t(z_intrin.width) * z_intrin.height, z_scale, align_interpolation(_interpolation),
+        other_profile.format(), _depth_change_threshold);
+    _stream_transform->map_other_to_depth(z_pixels, other_intrin, z_to_other, map, whole);
+    map.remap(other_pixels, other_intrin.width, other_intrin.height, other.get_bytes_per_pixel(), aligned_data);
 }
 #endif
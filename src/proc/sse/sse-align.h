@@ -15,16 +15,20 @@ namespace librealsense
         image_transform(const rs2_intrinsics& from,
             float depth_scale);
 
+        // Only the pixels of the changed blocks of the map are computed again, unless whole
         inline void align_depth_to_other(const uint16_t* z_pixels,
             uint16_t* dest, int bpp,
             const rs2_intrinsics& depth,
             const rs2_intrinsics& to,
-            const rs2_extrinsics& from_to_other);
+            const rs2_extrinsics& from_to_other,
+            depth_to_other_map& map,
+            bool whole);
 
-        inline void align_other_to_depth(const uint16_t* z_pixels,
-            const uint8_t * source,
-            uint8_t* dest, int bpp, const rs2_intrinsics& to,
-            const rs2_extrinsics& from_to_other);
+        void map_other_to_depth(const uint16_t* z_pixels,
+            const rs2_intrinsics& to,
+            const rs2_extrinsics& from_to_other,
+            other_to_depth_map& map,
+            bool whole);
 
         void pre_compute_x_y_map_corners();
 
@@ -37,6 +41,8 @@ namespace librealsense
         std::vector<float> _pre_compute_map_y_top_left;
         std::vector<float> _pre_compute_map_x_bottom_right;
         std::vector<float> _pre_compute_map_y_bottom_right;
+        std::vector<float> _pre_compute_map_x_center;
+        std::vector<float> _pre_compute_map_y_center;
 
         std::vector<int2> _pixel_top_left_int;
         std::vector<int2> _pixel_bottom_right_int;
@@ -49,26 +55,22 @@ namespace librealsense
         inline void align_depth_to_other_sse(const uint16_t* z_pixels,
             uint16_t* dest, const rs2_intrinsics& depth,
             const rs2_intrinsics& to,
-            const rs2_extrinsics& from_to_other);
+            const rs2_extrinsics& from_to_other,
+            depth_to_other_map& map,
+            bool whole);
 
         template<rs2_distortion dist = RS2_DISTORTION_NONE>
-        inline void align_other_to_depth_sse(const uint16_t* z_pixels,
-            const uint8_t * source,
-            uint8_t* dest, int bpp, const rs2_intrinsics& to,
-            const rs2_extrinsics& from_to_other);
+        inline void map_other_to_depth_sse(const uint16_t* z_pixels,
+            const rs2_intrinsics& to,
+            const rs2_extrinsics& from_to_other,
+            other_to_depth_map& map,
+            bool whole);
 
         inline void move_depth_to_other(const uint16_t* z_pixels,
             uint16_t* dest, const rs2_intrinsics& to,
             const std::vector<int2>& pixel_top_left_int,
             const std::vector<int2>& pixel_bottom_right_int);
 
-        template<class T >
-        inline void move_other_to_depth(const uint16_t* z_pixels,
-            const T* source,
-            T* dest, const rs2_intrinsics& to,
-            const std::vector<int2>& pixel_top_left_int,
-            const std::vector<int2>& pixel_bottom_right_int);
-
     };
 
     class align_sse : public align
@@ -9,6 +9,7 @@
 #include "sse-pointcloud.h"
 #include "../../option.h"
 
+#include <algorithm>
 #include <iostream>
 
 #ifdef __SSSE3__
@@ -63,9 +64,11 @@ namespace librealsense
         float* pre_compute_x = _pre_compute_map_x.data();
         float* pre_compute_y = _pre_compute_map_y.data();
 
-        uint32_t size = depth_intrinsics.height * depth_intrinsics.width;
+        // Only rows [_first_row,_last_row)
+        uint32_t begin = _first_row * depth_intrinsics.width;
+        uint32_t end = _last_row * depth_intrinsics.width;
 
-        auto point = (float*)output.get_vertices();
+        auto point = (float*)output.get_vertices() + begin * 3;
 
         //mask for shuffle
         const __m128i mask0 = _mm_set_epi8((char)0xff, (char)0xff, (char)7, (char)6, (char)0xff, (char)0xff, (char)5, (char)4,
@@ -73,12 +76,30 @@ namespace librealsense
         const __m128i mask1 = _mm_set_epi8((char)0xff, (char)0xff, (char)15, (char)14, (char)0xff, (char)0xff, (char)13, (char)12,
             (char)0xff, (char)0xff, (char)11, (char)10, (char)0xff, (char)0xff, (char)9, (char)8);
 
-        auto scale = _mm_set_ps1(depth_frame.get_units());
+        float const units = depth_frame.get_units();
+        auto scale = _mm_set_ps1(units);
 
         auto mapx = pre_compute_x;
         auto mapy = pre_compute_y;
 
-        for (unsigned int i = 0; i < size; i += 8)
+        // The aligned loads and streaming stores need whole groups of 8 pixels from a multiple of 8 (the start of the
+        // region of interest may not be, and the region need not end on one): the pixels before and after them are
+        // deprojected one at a time, the same way
+        auto deproject = [&]( unsigned int i )
+        {
+            float const z = depth_image[i] * units;
+            point[0] = z * mapx[i];
+            point[1] = z * mapy[i];
+            point[2] = z;
+            point += 3;
+        };
+        uint32_t const aligned_begin = std::min( ( begin + 7 ) & ~7u, end );
+        uint32_t const aligned_end = std::max( aligned_begin, end & ~7u );
+
+        unsigned int i = begin;
+        for( ; i < aligned_begin; ++i )
+            deproject( i );
+        for (; i < aligned_end; i += 8)
         {
             auto x0 = _mm_load_ps(mapx + i);
             auto x1 = _mm_load_ps(mapx + i + 4);
@@ -131,6 +152,8 @@ namespace librealsense
             _mm_stream_ps(&point[20], xyz13);
             point += 24;
         }
+        for( ; i < end; ++i )
+            deproject( i );
 #endif
         return (float3*)output.get_vertices();
     }
@@ -274,12 +297,14 @@ namespace librealsense
                                           float2 * pixels_ptr )
     {
 
-        get_texture_map_sse( (float2 *)output.get_texture_coordinates(),
-                         points,
+        // Only rows [_first_row,_last_row)
+        auto const offset = size_t( _first_row ) * width;
+        get_texture_map_sse( (float2 *)output.get_texture_coordinates() + offset,
+                         points + offset,
                          width,
-                         height,
+                         _last_row - _first_row,
                          other_intrinsics,
                          extr,
-                         pixels_ptr );
+                         pixels_ptr + offset );
     }
     }
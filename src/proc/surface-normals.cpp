@@ -0,0 +1,114 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "surface-normals.h"
+#include <src/option.h>
+#include <src/points.h>
+
+#include <librealsense2/rs.hpp>
+
+#include <rsutils/concurrency/worker-pool.h>
+
+#include <cmath>
+
+
+namespace librealsense
+{
+    surface_normals::surface_normals()
+        : stream_filter_processing_block( "Surface Normals" )
+    {
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+
+        auto threshold = std::make_shared< ptr_option< float > >( 0.f, 1.f, 0.001f, 0.05f, &_threshold,
+                                                                  "Max depth difference, in meters, along a mesh edge" );
+        register_option( RS2_OPTION_FILTER_SMOOTH_DELTA, threshold );
+    }
+
+    bool surface_normals::should_process( const rs2::frame & frame )
+    {
+        if( ! frame || frame.is< rs2::frameset >() )
+            return false;
+        if( frame.is< rs2::points >() )
+            return true;
+        return frame.is< rs2::depth_frame >() && frame.get_profile().format() == RS2_FORMAT_Z16;
+    }
+
+    void surface_normals::update_output_profiles( const rs2::frame & f, int width, int height )
+    {
+        if( f.get_profile().get() == _source_stream_profile.get() )
+            return;
+
+        _source_stream_profile = f.get_profile();
+        auto vp = _source_stream_profile.as< rs2::video_stream_profile >();
+        auto intrin = vp.get_intrinsics();
+        _normals_stream_profile = vp.clone( RS2_STREAM_DEPTH, vp.stream_index(), RS2_FORMAT_XYZ32F, width, height, intrin );
+        _mesh_stream_profile = vp.clone( RS2_STREAM_DEPTH, vp.stream_index(), RS2_FORMAT_Y8, width, height, intrin );
+    }
+
+    rs2::frame surface_normals::process_frame( const rs2::frame_source & source, const rs2::frame & f )
+    {
+        auto vp = f.get_profile().as< rs2::video_stream_profile >();
+        if( ! vp )
+            return f;
+        int const width = vp.width();
+        int const height = vp.height();
+
+        const float3 * vertices;
+        if( auto pts = f.as< rs2::points >() )
+        {
+            // Only organized clouds can be meshed
+            if( pts.size() != size_t( width ) * height )
+                return f;
+            vertices = reinterpret_cast< const float3 * >( pts.get_vertices() );
+        }
+        else
+        {
+            auto depth = f.as< rs2::depth_frame >();
+            _rays.update( vp.get_intrinsics(), depth.get_units() );
+            _points.resize( size_t( width ) * height );
+            auto const data = reinterpret_cast< const uint8_t * >( depth.get_data() );
+            auto const stride = depth.get_stride_in_bytes();
+            rsutils::concurrency::worker_pool::shared().parallel_for(
+                height,
+                32,
+                [&]( size_t begin, size_t end )
+                {
+                    for( auto y = begin; y < end; ++y )
+                    {
+                        auto row = reinterpret_cast< const uint16_t * >( data + y * stride );
+                        auto out = _points.data() + y * width;
+                        for( int x = 0; x < width; ++x )
+                            out[x] = row[x] ? _rays.deproject( x, int( y ), row[x] ) : float3{ 0, 0, 0 };
+                    }
+                } );
+            vertices = _points.data();
+        }
+
+        update_output_profiles( f, width, height );
+        auto normals = source.allocate_video_frame( _normals_stream_profile, f, sizeof( float3 ), width, height,
+                                                    width * sizeof( float3 ) );
+        auto mesh = source.allocate_video_frame( _mesh_stream_profile, f, 1, width, height, width );
+        auto quads = (uint8_t *)mesh.get_data();
+        compute_organized_mesh( quads, vertices, width, height, _threshold );
+        compute_vertex_normals( (float3 *)normals.get_data(), vertices, quads, width, height );
+
+        return source.allocate_composite_frame( { normals, mesh } );
+    }
+
+    rs2::frame surface_normals::prepare_output( const rs2::frame_source & source,
+                                                rs2::frame input,
+                                                std::vector< rs2::frame > results )
+    {
+        // Normals and mesh go along with the points (or depth) they were computed from, which is not what the default
+        // does since they share the stream type and may share the format
+        if( results.empty() )
+            return input;
+        std::vector< rs2::frame > frames;
+        if( auto set = input.as< rs2::frameset >() )
+            set.foreach_rs( [&]( const rs2::frame & f ) { frames.push_back( f ); } );
+        else
+            frames.push_back( input );
+        frames.insert( frames.end(), results.begin(), results.end() );
+        return source.allocate_composite_frame( frames );
+    }
+}
@@ -0,0 +1,46 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "depth-rays.h"
+#include "organized-mesh.h"
+
+#include <vector>
+
+
+namespace librealsense
+{
+    // Computes the organized mesh and vertex normals of organized points (or of depth, which is deprojected first),
+    // and adds them to the output as two more frames of the same resolution:
+    //     - normals: a video frame of RS2_FORMAT_XYZ32F, one normal per pixel
+    //     - mesh: a video frame of RS2_FORMAT_Y8, one byte per quad as in compute_organized_mesh()
+    // The input points (or depth) are passed along with them. RS2_OPTION_FILTER_SMOOTH_DELTA sets the meshing
+    // threshold, in meters.
+    //
+    class surface_normals : public stream_filter_processing_block
+    {
+    public:
+        surface_normals();
+
+    protected:
+        bool should_process( const rs2::frame & frame ) override;
+        rs2::frame process_frame( const rs2::frame_source & source, const rs2::frame & f ) override;
+        rs2::frame prepare_output( const rs2::frame_source & source,
+                                   rs2::frame input,
+                                   std::vector< rs2::frame > results ) override;
+
+    private:
+        void update_output_profiles( const rs2::frame & f, int width, int height );
+
+        float _threshold = 0.05f;
+        depth_rays _rays;
+        std::vector< float3 > _points;  // when working from depth
+
+        rs2::stream_profile _source_stream_profile;
+        rs2::stream_profile _normals_stream_profile;
+        rs2::stream_profile _mesh_stream_profile;
+    };
+    MAP_EXTENSION( RS2_EXTENSION_SURFACE_NORMALS, librealsense::surface_normals );
+}
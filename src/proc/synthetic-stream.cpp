@@ -345,28 +345,31 @@ namespace librealsense
     {
         auto vid_stream = dynamic_cast<video_stream_profile_interface*>(stream.get());
         if (vid_stream)
-        {
-            frame_additional_data data{};
-            data.frame_number = original->get_frame_number();
-            data.timestamp = original->get_frame_timestamp();
-            data.timestamp_domain = original->get_frame_timestamp_domain();
-            data.metadata_size = 0;
-            data.system_time = time_service::get_time();
-            data.is_blocking = original->is_blocking();
-
-            auto res = _actual_source.alloc_frame(
-                { vid_stream->get_stream_type(), vid_stream->get_stream_index(), frame_type },
-                vid_stream->get_width() * vid_stream->get_height() * sizeof( float ) * 5,
-                std::move( data ),
-                true );
-            if (!res) throw wrong_api_call_sequence_exception("Out of frame resources!");
-            res->set_sensor(original->get_sensor());
-            res->set_stream(stream);
-            return res;
-        }
+            return allocate_points(stream, original, size_t(vid_stream->get_width()) * vid_stream->get_height(), frame_type);
         return nullptr;
     }
 
+    frame_interface* synthetic_source::allocate_points(std::shared_ptr<stream_profile_interface> stream, frame_interface* original, size_t vertex_count, rs2_extension frame_type)
+    {
+        frame_additional_data data{};
+        data.frame_number = original->get_frame_number();
+        data.timestamp = original->get_frame_timestamp();
+        data.timestamp_domain = original->get_frame_timestamp_domain();
+        data.metadata_size = 0;
+        data.system_time = time_service::get_time();
+        data.is_blocking = original->is_blocking();
+
+        auto res = _actual_source.alloc_frame(
+            { stream->get_stream_type(), stream->get_stream_index(), frame_type },
+            vertex_count * sizeof( float ) * 5,
+            std::move( data ),
+            true );
+        if (!res) throw wrong_api_call_sequence_exception("Out of frame resources!");
+        res->set_sensor(original->get_sensor());
+        res->set_stream(stream);
+        return res;
+    }
+
 
     frame_interface* synthetic_source::allocate_video_frame(std::shared_ptr<stream_profile_interface> stream,
         frame_interface* original,
@@ -422,6 +425,9 @@ namespace librealsense
             throw std::runtime_error("Can not cast frame interface to frame");
 
         frame_additional_data data = of->additional_data;
+        // The region the original was processed in says nothing of what the new frame will hold: a block that
+        // processes its output in a region records it (see roi_options::apply)
+        data.roi = frame_roi();
         auto res = _actual_source.alloc_frame( { stream->get_stream_type(), stream->get_stream_index(), frame_type },
                                                stride * height,
                                                std::move( data ),
@@ -41,6 +41,11 @@ namespace librealsense
         frame_interface* allocate_points(std::shared_ptr<stream_profile_interface> stream, 
             frame_interface* original, rs2_extension frame_type = RS2_EXTENSION_POINTS) override;
 
+        // Points frame with any number of vertices, for clouds that are not laid out like the stream's image (e.g.,
+        // merged or downsampled clouds); the stream need not be a video stream
+        frame_interface* allocate_points(std::shared_ptr<stream_profile_interface> stream,
+            frame_interface* original, size_t vertex_count, rs2_extension frame_type = RS2_EXTENSION_POINTS);
+
         void frame_ready(frame_holder result) override;
 
         rs2_source* get_rs2_source() const { return _c_wrapper.get(); }
@@ -60,6 +65,10 @@ namespace librealsense
         void invoke(frame_holder frames) override;
         synthetic_source_interface& get_source() override { return _source_wrapper; }
 
+        // Whether every frame output is a new frame that keeps no reference to the input, so the input is released by
+        // the time invoke() returns
+        virtual bool outputs_new_frames() const { return false; }
+
         virtual ~processing_block() { _source.flush(); }
     protected:
         frame_source _source;
@@ -149,6 +158,9 @@ namespace librealsense
     public:
         functional_processing_block(const char* name, rs2_format target_format, rs2_stream target_stream = RS2_STREAM_ANY, rs2_extension extension_type = RS2_EXTENSION_VIDEO_FRAME);
 
+        // Depth frames keep their original frame
+        bool outputs_new_frames() const override { return _extension_type != RS2_EXTENSION_DEPTH_FRAME; }
+
     protected:
         virtual void init_profiles_info(const rs2::frame* f);
         rs2::frame process_frame(const rs2::frame_source & source, const rs2::frame & f) override;
@@ -178,6 +190,11 @@ namespace librealsense
             rs2_extension right_extension_type,
             int right_idx);
 
+        bool outputs_new_frames() const override
+        {
+            return _left_extension_type != RS2_EXTENSION_DEPTH_FRAME && _right_extension_type != RS2_EXTENSION_DEPTH_FRAME;
+        }
+
     protected:
         virtual void process_function(uint8_t * const dest[], const uint8_t * source, int width, int height, int actual_size, int input_size) = 0;
         void configure_processing_callback();
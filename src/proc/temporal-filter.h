@@ -3,6 +3,7 @@
 
 #pragma once
 #include "types.h"
+#include "roi-options.h"
 
 namespace librealsense
 {
@@ -20,7 +21,7 @@ namespace librealsense
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
 
         template<typename T>
-        void temp_jw_smooth(void* frame_data, void * _last_frame_data, uint8_t *history)
+        void temp_jw_smooth(void* frame_data, void * _last_frame_data, uint8_t *history, const pixel_roi& roi)
         {
             static_assert((std::is_arithmetic<T>::value), "temporal filter assumes numeric types");
 
@@ -33,50 +34,53 @@ namespace librealsense
 
             unsigned char mask = 1 << _cur_frame_index;
 
-            // pass one -- go through image and update all
-            for (size_t i = 0; i < _current_frm_size_pixels; i++)
+            // pass one -- go through the region of interest and update all; the rest is left as is
+            for (size_t y = roi.min_y; y < size_t(roi.max_y); y++)
             {
-                T cur_val = frame[i];
-                T prev_val = _last_frame[i];
-
-                if (cur_val)
+                for (size_t i = y * _width + roi.min_x, row_end = y * _width + roi.max_x; i < row_end; i++)
                 {
-                    if (!prev_val)
+                    T cur_val = frame[i];
+                    T prev_val = _last_frame[i];
+
+                    if (cur_val)
                     {
-                        _last_frame[i] = cur_val;
-                        history[i] = mask;
-                    }
-                    else
-                    {  // old and new val
-                        T diff = static_cast<T>(fabs(cur_val - prev_val));
-
-                        if (diff < delta_z)
-                        {  // old and new val agree
-                            history[i] |= mask;
-                            float filtered = _alpha_param * cur_val + _one_minus_alpha * prev_val;
-                            T result = static_cast<T>(filtered);
-                            frame[i] = result;
-                            _last_frame[i] = result;
-                        }
-                        else
+                        if (!prev_val)
                         {
                             _last_frame[i] = cur_val;
                             history[i] = mask;
                         }
+                        else
+                        {  // old and new val
+                            T diff = static_cast<T>(fabs(cur_val - prev_val));
+
+                            if (diff < delta_z)
+                            {  // old and new val agree
+                                history[i] |= mask;
+                                float filtered = _alpha_param * cur_val + _one_minus_alpha * prev_val;
+                                T result = static_cast<T>(filtered);
+                                frame[i] = result;
+                                _last_frame[i] = result;
+                            }
+                            else
+                            {
+                                _last_frame[i] = cur_val;
+                                history[i] = mask;
+                            }
+                        }
                     }
-                }
-                else
-                {  // no cur_val
-                    if (prev_val)
-                    { // only case we can help
-                        unsigned char hist = history[i];
-                        unsigned char classification = _persistence_map[hist];
-                        if (classification & mask)
-                        { // we have had enough samples lately
-                            frame[i] = prev_val;
+                    else
+                    {  // no cur_val
+                        if (prev_val)
+                        { // only case we can help
+                            unsigned char hist = history[i];
+                            unsigned char classification = _persistence_map[hist];
+                            if (classification & mask)
+                            { // we have had enough samples lately
+                                frame[i] = prev_val;
+                            }
                         }
+                        history[i] &= ~mask;
                     }
-                    history[i] &= ~mask;
                 }
             }
 
@@ -105,6 +109,7 @@ namespace librealsense
         uint8_t                 _cur_frame_index;
         // encodes whether a particular 8 bit history is good enough for all 8 phases of storage
         std::array<uint8_t, PRESISTENCY_LUT_SIZE> _persistence_map;
+        roi_options             _roi;
     };
     MAP_EXTENSION(RS2_EXTENSION_TEMPORAL_FILTER, librealsense::temporal_filter);
 }
@@ -0,0 +1,89 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "voxel-filter.h"
+#include <src/option.h>
+#include <src/stream.h>
+#include <src/points.h>
+
+#include <librealsense2/rs.hpp>
+
+#include <rsutils/concurrency/worker-pool.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+
+namespace librealsense
+{
+    voxel_filter::voxel_filter()
+        : stream_filter_processing_block( "Voxel Grid Filter" )
+    {
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+        _stream_filter.format = RS2_FORMAT_Z16;
+
+        auto voxel_size = std::make_shared< ptr_option< float > >( 0.001f, 1.f, 0.001f, 0.01f, &_voxel_size,
+                                                                   "Voxel edge length in meters" );
+        register_option( RS2_OPTION_VOXEL_SIZE, voxel_size );
+        _roi.register_to( *this );
+    }
+
+    rs2::frame voxel_filter::process_frame( const rs2::frame_source & source, const rs2::frame & f )
+    {
+        auto depth = f.as< rs2::depth_frame >();
+        if( ! depth )
+            return f;
+
+        if( f.get_profile().get() != _source_stream_profile.get() )
+        {
+            _source_stream_profile = f.get_profile();
+            _target_stream_profile = _source_stream_profile.clone( RS2_STREAM_DEPTH,
+                                                                   _source_stream_profile.stream_index(),
+                                                                   RS2_FORMAT_XYZ32F );
+        }
+
+        _rays.update( depth.get_profile().as< rs2::video_stream_profile >().get_intrinsics(), depth.get_units() );
+        auto const roi = _roi.get( f, _rays.width(), _rays.height() );
+
+        auto const data = reinterpret_cast< const uint8_t * >( depth.get_data() );
+        auto const depth_stride = depth.get_stride_in_bytes();
+        auto const row_of = [&]( size_t j ) {
+            return reinterpret_cast< const uint16_t * >( data + ( roi.min_y + j ) * depth_stride );
+        };
+        auto & pool = rsutils::concurrency::worker_pool::shared();
+
+        // Count the valid pixels of each row, so that rows can then be deprojected in parallel, each straight into its
+        // place
+        size_t const n_rows = roi.height();
+        _row_offsets.resize( n_rows + 1 );
+        _row_offsets[0] = 0;
+        pool.parallel_for( n_rows, 32, [&]( size_t begin, size_t end )
+        {
+            for( auto j = begin; j < end; ++j )
+            {
+                auto row = row_of( j );
+                _row_offsets[j + 1] = roi.width() - std::count( row + roi.min_x, row + roi.max_x, uint16_t( 0 ) );
+            }
+        } );
+        std::partial_sum( _row_offsets.begin(), _row_offsets.end(), _row_offsets.begin() );
+
+        _points.resize( _row_offsets.back() );
+        pool.parallel_for( n_rows, 32, [&]( size_t begin, size_t end )
+        {
+            for( auto j = begin; j < end; ++j )
+                _rays.deproject_valid( _points.data() + _row_offsets[j], row_of( j ), int( roi.min_y + j ),
+                                       roi.min_x, roi.max_x );
+        } );
+
+        _grid.reset( _voxel_size );
+        _grid.add( _points.data(), _points.size() );
+
+        auto profile = std::dynamic_pointer_cast< stream_profile_interface >(
+            _target_stream_profile.get()->profile->shared_from_this() );
+        auto output = (points *)_source_wrapper.allocate_points( profile, (frame_interface *)f.get(), _grid.size() );
+        _grid.get_centroids( output->get_vertices() );
+        std::memset( output->get_texture_coordinates(), 0, output->get_vertex_count() * sizeof( float2 ) );
+        return rs2::frame( (rs2_frame *)output );
+    }
+}
@@ -0,0 +1,42 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "depth-rays.h"
+#include "roi-options.h"
+#include "voxel-grid.h"
+
+
+namespace librealsense
+{
+    // Voxel-grid downsampled pointcloud, straight from depth: the valid pixels in the region of interest of a depth
+    // frame are deprojected and binned into cubic voxels of RS2_OPTION_VOXEL_SIZE meters, and the centroid of each
+    // occupied voxel is output. The full-resolution cloud is never materialized as a frame.
+    //
+    // The output is a points frame with one vertex per occupied voxel (so it is not organized like an image), without
+    // texture coordinates.
+    //
+    class voxel_filter : public stream_filter_processing_block
+    {
+    public:
+        voxel_filter();
+
+    protected:
+        rs2::frame process_frame( const rs2::frame_source & source, const rs2::frame & f ) override;
+
+    private:
+        float _voxel_size = 0.01f;
+        roi_options _roi;
+        depth_rays _rays;
+        rs2::stream_profile _source_stream_profile;
+        rs2::stream_profile _target_stream_profile;
+
+        // Kept between frames so a steady stream of frames does not allocate
+        std::vector< size_t > _row_offsets;
+        std::vector< float3 > _points;
+        voxel_grid _grid;
+    };
+    MAP_EXTENSION( RS2_EXTENSION_VOXEL_FILTER, librealsense::voxel_filter );
+}
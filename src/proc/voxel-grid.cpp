@@ -0,0 +1,97 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "voxel-grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace librealsense
+{
+    static constexpr uint64_t empty_key = ~uint64_t( 0 );
+    static constexpr int32_t coordinate_limit = ( 1 << 20 ) - 1;
+
+    static uint64_t pack( float v )
+    {
+        auto i = (int32_t)std::max( -float( coordinate_limit ), std::min( std::floor( v ), float( coordinate_limit ) ) );
+        return uint64_t( i + coordinate_limit + 1 );  // [0, 2^21)
+    }
+
+    static size_t hash_of( uint64_t key )
+    {
+        return size_t( ( key * 0x9E3779B97F4A7C15ull ) >> 21 );
+    }
+
+    uint64_t voxel_grid::key_of( const float3 & p ) const
+    {
+        return pack( p.x * _inv_size ) | ( pack( p.y * _inv_size ) << 21 ) | ( pack( p.z * _inv_size ) << 42 );
+    }
+
+    void voxel_grid::reset( float voxel_size )
+    {
+        _inv_size = voxel_size > 0.f ? 1.f / voxel_size : 0.f;
+        _cells.clear();
+        std::fill( _keys.begin(), _keys.end(), empty_key );
+    }
+
+    void voxel_grid::grow()
+    {
+        size_t const new_size = std::max< size_t >( 1024, _keys.size() * 2 );
+        _keys.assign( new_size, empty_key );
+        _slot_cells.resize( new_size );
+        _mask = new_size - 1;
+
+        // Cells are kept in insertion order, so the table can be rebuilt from them
+        for( uint32_t i = 0; i < _cells.size(); ++i )
+        {
+            auto const key = _cells[i].key;
+            auto slot = hash_of( key ) & _mask;
+            while( _keys[slot] != empty_key )
+                slot = ( slot + 1 ) & _mask;
+            _keys[slot] = key;
+            _slot_cells[slot] = i;
+        }
+    }
+
+    void voxel_grid::add( const float3 & p )
+    {
+        // Keep the load factor under 1/2
+        if( ( _cells.size() + 1 ) * 2 > _keys.size() )
+            grow();
+
+        auto const key = key_of( p );
+        auto slot = hash_of( key ) & _mask;
+        while( true )
+        {
+            auto const k = _keys[slot];
+            if( k == key )
+            {
+                auto & c = _cells[_slot_cells[slot]];
+                c.sum = c.sum + p;
+                ++c.count;
+                return;
+            }
+            if( k == empty_key )
+            {
+                _keys[slot] = key;
+                _slot_cells[slot] = uint32_t( _cells.size() );
+                _cells.push_back( { key, p, 1 } );
+                return;
+            }
+            slot = ( slot + 1 ) & _mask;
+        }
+    }
+
+    void voxel_grid::add( const float3 * points, size_t count )
+    {
+        for( size_t i = 0; i < count; ++i )
+            add( points[i] );
+    }
+
+    void voxel_grid::get_centroids( float3 * out ) const
+    {
+        for( auto & c : _cells )
+            *out++ = c.sum / float( c.count );
+    }
+}
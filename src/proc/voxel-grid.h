@@ -0,0 +1,58 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <src/float3.h>
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+
+namespace librealsense
+{
+    // Bins points into a grid of cubic voxels and produces one point per occupied voxel: the centroid of the points
+    // that fell into it.
+    //
+    // Occupied voxels are kept in an open-addressing hash table keyed by the voxel coordinates, so memory is
+    // proportional to the number of occupied voxels rather than the volume covered. The storage is kept between
+    // uses: once warmed up, binning a frame does not allocate.
+    //
+    // Voxel coordinates are limited to 21 bits each, i.e. +/-2^20 voxels from the origin in each direction; points
+    // beyond that are clamped into the outermost voxels.
+    //
+    class voxel_grid
+    {
+    public:
+        // Remove all points and set the voxel edge length for the points to come
+        void reset( float voxel_size );
+
+        void add( const float3 & point );
+        void add( const float3 * points, size_t count );
+
+        // Number of occupied voxels
+        size_t size() const { return _cells.size(); }
+
+        // Write the centroid of each occupied voxel, in the order the voxels were first hit; 'out' must have room for
+        // size() points
+        void get_centroids( float3 * out ) const;
+
+    private:
+        struct cell
+        {
+            uint64_t key;
+            float3 sum;
+            uint32_t count;
+        };
+
+        uint64_t key_of( const float3 & point ) const;
+        void grow();
+
+        float _inv_size = 0.f;
+        std::vector< uint64_t > _keys;        // hash table; empty slots hold empty_key
+        std::vector< uint32_t > _slot_cells;  // index into _cells, per table slot
+        std::vector< cell > _cells;
+        size_t _mask = 0;
+    };
+}
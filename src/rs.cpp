@@ -25,6 +25,7 @@
 #include "proc/colorizer.h"
 #include "proc/pointcloud.h"
 #include "proc/align.h"
+#include "proc/batch-projection.h"
 #include "proc/threshold.h"
 #include "proc/units-transform.h"
 #include "proc/disparity-transform.h"
@@ -37,6 +38,14 @@
 #include "proc/rates-printer.h"
 #include "proc/hdr-merge.h"
 #include "proc/sequence-id-filter.h"
+#include "proc/depth-fusion.h"
+#include "proc/voxel-filter.h"
+#include "proc/sparse-pointcloud.h"
+#include "proc/surface-normals.h"
+#include "proc/sequence-demux.h"
+#include "proc/quality-governor.h"
+#include "proc/aligned-pointcloud.h"
+#include "proc/depth-statistics.h"
 #include "media/playback/playback_device.h"
 #include "stream.h"
 #include <librealsense2/h/rs_types.h>
@@ -55,6 +64,7 @@
 #include "debug-stream-sensor.h"
 #include "max-usable-range-sensor.h"
 #include "fw-update/fw-update-device-interface.h"
+#include "fw-update/fw-update-orchestrator.h"
 #include "core/frame-callback.h"
 #include "color-sensor.h"
 #include "composite-frame.h"
@@ -62,6 +72,7 @@
 
 #include <src/core/time-service.h>
 #include <rsutils/string/from.h>
+#include <rsutils/concurrency/lock-free-queue.h>
 
 ////////////////////////
 // API implementation //
@@ -194,14 +205,40 @@ struct rs2_pipeline_profile
 
 struct rs2_frame_queue
 {
-    explicit rs2_frame_queue(int cap)
-        : queue( cap, [cap]( librealsense::frame_holder const & fh ) {
+    explicit rs2_frame_queue( int cap, bool lock_free = false )
+    {
+        auto on_drop = [cap]( librealsense::frame_holder const & fh ) {
             LOG_DEBUG( "DROPPED queue (capacity= " << cap << ") frame " << fh );
-        } )
+        };
+        if( lock_free )
+            lock_free_queue.reset( new lock_free_frame_queue( cap, on_drop ) );
+        else
+            queue.reset( new locked_frame_queue( cap, on_drop ) );
+    }
+
+    bool enqueue( librealsense::frame_holder && fh )
+    {
+        return queue ? queue->enqueue( std::move( fh ) ) : lock_free_queue->enqueue( std::move( fh ) );
+    }
+    bool dequeue( librealsense::frame_holder * fh, unsigned int timeout_ms )
+    {
+        return queue ? queue->dequeue( fh, timeout_ms ) : lock_free_queue->dequeue( fh, timeout_ms );
+    }
+    bool try_dequeue( librealsense::frame_holder * fh )
     {
+        return queue ? queue->try_dequeue( fh ) : lock_free_queue->try_dequeue( fh );
     }
+    void clear() { queue ? queue->clear() : lock_free_queue->clear(); }
+    size_t size() const { return queue ? queue->size() : lock_free_queue->size(); }
 
-    single_consumer_frame_queue<librealsense::frame_holder> queue;
+    typedef single_consumer_frame_queue< librealsense::frame_holder > locked_frame_queue;
+    typedef single_consumer_frame_queue< librealsense::frame_holder,
+                                         rsutils::concurrency::lock_free_queue< librealsense::frame_holder > >
+        lock_free_frame_queue;
+
+    // Only one of them
+    std::unique_ptr< locked_frame_queue > queue;
+    std::unique_ptr< lock_free_frame_queue > lock_free_queue;
 };
 
 struct rs2_sensor_list
@@ -1475,6 +1512,12 @@ rs2_frame_queue* rs2_create_frame_queue(int capacity, rs2_error** error) BEGIN_A
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, capacity)
 
+rs2_frame_queue* rs2_create_lock_free_frame_queue(int capacity, rs2_error** error) BEGIN_API_CALL
+{
+    return new rs2_frame_queue(capacity, true);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, capacity)
+
 void rs2_delete_frame_queue(rs2_frame_queue* queue) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
@@ -1486,7 +1529,7 @@ rs2_frame* rs2_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, r
 {
     VALIDATE_NOT_NULL(queue);
     librealsense::frame_holder fh;
-    if (!queue->queue.dequeue(&fh, timeout_ms))
+    if (!queue->dequeue(&fh, timeout_ms))
     {
         throw std::runtime_error("Frame did not arrive in time!");
     }
@@ -1502,7 +1545,7 @@ int rs2_poll_for_frame(rs2_frame_queue* queue, rs2_frame** output_frame, rs2_err
     VALIDATE_NOT_NULL(queue);
     VALIDATE_NOT_NULL(output_frame);
     librealsense::frame_holder fh;
-    if (queue->queue.try_dequeue(&fh))
+    if (queue->try_dequeue(&fh))
     {
         frame_interface* result = nullptr;
         std::swap(result, fh.frame);
@@ -1519,7 +1562,7 @@ int rs2_try_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, rs2_
     VALIDATE_NOT_NULL(queue);
     VALIDATE_NOT_NULL(output_frame);
     librealsense::frame_holder fh;
-    if (!queue->queue.dequeue(&fh, timeout_ms))
+    if (!queue->dequeue(&fh, timeout_ms))
     {
         return false;
     }
@@ -1538,21 +1581,21 @@ void rs2_enqueue_frame(rs2_frame* frame, void* queue) BEGIN_API_CALL
     auto q = reinterpret_cast<rs2_frame_queue*>(queue);
     librealsense::frame_holder fh;
     fh.frame = (frame_interface*)frame;
-    q->queue.enqueue(std::move(fh));
+    q->enqueue(std::move(fh));
 }
 NOEXCEPT_RETURN(, frame, queue)
 
 void rs2_flush_queue(rs2_frame_queue* queue, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
-    queue->queue.clear();
+    queue->clear();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, queue)
 
 int rs2_frame_queue_size(rs2_frame_queue* queue, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
-    return int(queue->queue.size());
+    return int(queue->size());
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, queue)
 
@@ -1885,6 +1928,14 @@ int rs2_is_processing_block_extendable_to(const rs2_processing_block* f, rs2_ext
     case RS2_EXTENSION_DEPTH_HUFFMAN_DECODER: throw not_implemented_exception( "deprecated" );
     case RS2_EXTENSION_HDR_MERGE: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::hdr_merge) != nullptr;
     case RS2_EXTENSION_SEQUENCE_ID_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::sequence_id_filter) != nullptr;
+    case RS2_EXTENSION_DEPTH_FUSION: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::depth_fusion) != nullptr;
+    case RS2_EXTENSION_VOXEL_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::voxel_filter) != nullptr;
+    case RS2_EXTENSION_SPARSE_POINTCLOUD: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::sparse_pointcloud) != nullptr;
+    case RS2_EXTENSION_SURFACE_NORMALS: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::surface_normals) != nullptr;
+    case RS2_EXTENSION_SEQUENCE_DEMUX: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::sequence_demux) != nullptr;
+    case RS2_EXTENSION_QUALITY_GOVERNOR: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::quality_governor) != nullptr;
+    case RS2_EXTENSION_ALIGNED_POINTCLOUD: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::aligned_pointcloud) != nullptr;
+    case RS2_EXTENSION_DEPTH_STATISTICS: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::depth_statistics) != nullptr;
   
     default:
         return false;
@@ -2770,6 +2821,119 @@ rs2_processing_block* rs2_create_sequence_id_filter(rs2_error** error) BEGIN_API
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_depth_fusion_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::depth_fusion>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_voxel_filter_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::voxel_filter>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_sparse_pointcloud_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::sparse_pointcloud>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_surface_normals_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::surface_normals>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_sequence_demux_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::sequence_demux>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_quality_governor_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::quality_governor>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+void rs2_quality_governor_add_block(rs2_processing_block* governor, rs2_processing_block* block, int degrade_order, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(governor);
+    VALIDATE_NOT_NULL(block);
+    auto gov = VALIDATE_INTERFACE((processing_block_interface*)(governor->block.get()), librealsense::quality_governor);
+    if (block->block == governor->block)
+        throw invalid_value_exception("a quality governor cannot run itself");
+    gov->add_block(block->block, degrade_order);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, governor, block, degrade_order)
+
+void rs2_set_quality_governor_notifications_callback(rs2_processing_block* governor, rs2_notification_callback_ptr on_notification, void* user, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(governor);
+    VALIDATE_NOT_NULL(on_notification);
+    auto gov = VALIDATE_INTERFACE((processing_block_interface*)(governor->block.get()), librealsense::quality_governor);
+    rs2_notifications_callback_sptr callback(
+        new notifications_callback(on_notification, user),
+        [](rs2_notifications_callback* p) { delete p; });
+    gov->set_notifications_callback(std::move(callback));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, governor, on_notification, user)
+
+void rs2_set_quality_governor_notifications_callback_cpp(rs2_processing_block* governor, rs2_notifications_callback* callback, rs2_error** error) BEGIN_API_CALL
+{
+    // Take ownership of the callback ASAP or else memory leaks could result if we throw!
+    VALIDATE_NOT_NULL( callback );
+    rs2_notifications_callback_sptr callback_ptr{ callback,
+                                                  []( rs2_notifications_callback * p )
+                                                  {
+                                                      p->release();
+                                                  } };
+
+    VALIDATE_NOT_NULL(governor);
+    auto gov = VALIDATE_INTERFACE((processing_block_interface*)(governor->block.get()), librealsense::quality_governor);
+    gov->set_notifications_callback( callback_ptr );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, governor, callback)
+
+int rs2_get_quality_governor_level(const rs2_processing_block* governor, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(governor);
+    auto gov = VALIDATE_INTERFACE((processing_block_interface*)(governor->block.get()), librealsense::quality_governor);
+    return gov->get_level();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, governor)
+
+rs2_processing_block* rs2_create_aligned_pointcloud(rs2_stream texture_stream, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_ENUM(texture_stream);
+
+    auto block = std::make_shared<librealsense::aligned_pointcloud>(texture_stream);
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, texture_stream)
+
+rs2_processing_block* rs2_create_depth_statistics_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::depth_statistics>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
 float rs2_get_depth_scale(rs2_sensor* sensor, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -2822,6 +2986,32 @@ float rs2_depth_frame_get_units( const rs2_frame* frame_ref, rs2_error** error )
 }
 HANDLE_EXCEPTIONS_AND_RETURN( 0, frame_ref )
 
+int rs2_depth_frame_get_statistics( const rs2_frame* frame_ref, rs2_depth_statistics* statistics, rs2_error** error ) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL( frame_ref );
+    VALIDATE_NOT_NULL( statistics );
+    auto f = dynamic_cast< librealsense::frame * >( ( frame_interface * ) frame_ref );
+    if( ! f || ! f->additional_data.depth_statistics )
+        return 0;
+    *statistics = f->additional_data.depth_statistics->summary;
+    return 1;
+}
+HANDLE_EXCEPTIONS_AND_RETURN( 0, frame_ref, statistics )
+
+int rs2_depth_frame_get_region_means( const rs2_frame* frame_ref, float* means, int count, rs2_error** error ) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL( frame_ref );
+    if( count > 0 )
+        VALIDATE_NOT_NULL( means );
+    auto f = dynamic_cast< librealsense::frame * >( ( frame_interface * ) frame_ref );
+    if( ! f || ! f->additional_data.depth_statistics )
+        return 0;
+    auto const & region_means = f->additional_data.depth_statistics->region_means;
+    std::copy_n( region_means.begin(), std::min( size_t( std::max( count, 0 ) ), region_means.size() ), means );
+    return int( region_means.size() );
+}
+HANDLE_EXCEPTIONS_AND_RETURN( 0, frame_ref, means, count )
+
 float rs2_depth_stereo_frame_get_baseline(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
@@ -3415,6 +3605,39 @@ void rs2_update_firmware(const rs2_device* device, const void* fw_image, int fw_
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, device, fw_image)
 
+int rs2_update_firmware_devices_cpp(const rs2_device* const* devices, int count, const void* fw_image, int fw_image_size, int max_concurrent, rs2_devices_update_callback* callback, rs2_error** error) BEGIN_API_CALL
+{
+    // Take ownership of the callback ASAP or else memory leaks could result if we throw! (the caller usually does a
+    // 'new' when calling us)
+    rs2_devices_update_callback_sptr callback_ptr;
+    if( callback )
+        callback_ptr.reset( callback, []( rs2_devices_update_callback * p ) { p->release(); } );
+
+    VALIDATE_NOT_NULL(devices);
+    VALIDATE_RANGE(count, 1, std::numeric_limits<int>::max());
+    VALIDATE_NOT_NULL(fw_image);
+    VALIDATE_RANGE(max_concurrent, 0, std::numeric_limits<int>::max());
+
+    std::vector< const librealsense::update_device_interface * > fwus;
+    for( int i = 0; i < count; ++i )
+    {
+        VALIDATE_NOT_NULL(devices[i]);
+        VALIDATE_NOT_NULL(devices[i]->device);
+        fwus.push_back( VALIDATE_INTERFACE(devices[i]->device, librealsense::update_device_interface) );
+    }
+
+    librealsense::fw_update_orchestrator orchestrator( std::move( fwus ), max_concurrent );
+    if( ! callback_ptr )
+        return int( orchestrator.update( fw_image, fw_image_size ) );
+    return int( orchestrator.update(
+        fw_image,
+        fw_image_size,
+        [&]( size_t i, float progress ) { callback_ptr->on_update_progress( int( i ), progress ); },
+        [&]( size_t i, std::string const & error )
+        { callback_ptr->on_update_done( int( i ), error.empty() ? nullptr : error.c_str() ); } ) );
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, devices, count, fw_image, max_concurrent)
+
 const rs2_raw_data_buffer* rs2_create_flash_backup_cpp(const rs2_device* device, rs2_update_progress_callback* callback, rs2_error** error) BEGIN_API_CALL
 {
     // Take ownership of the callback ASAP or else memory leaks could result if we throw! (the caller usually does a
@@ -4081,6 +4304,37 @@ void rs2_transform_point_to_point(float to_point[3], const struct rs2_extrinsics
 }
 NOEXCEPT_RETURN(, to_point)
 
+void rs2_project_points_to_pixels(float* pixels, const struct rs2_intrinsics* intrin, const float* points, int count) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(pixels);
+    VALIDATE_NOT_NULL(intrin);
+    VALIDATE_NOT_NULL(points);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    librealsense::project_points_to_pixels(pixels, *intrin, points, count);
+}
+NOEXCEPT_RETURN(, pixels)
+
+void rs2_deproject_pixels_to_points(float* points, const struct rs2_intrinsics* intrin, const float* pixels, const float* depths, int count) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(points);
+    VALIDATE_NOT_NULL(intrin);
+    VALIDATE_NOT_NULL(pixels);
+    VALIDATE_NOT_NULL(depths);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    librealsense::deproject_pixels_to_points(points, *intrin, pixels, depths, count);
+}
+NOEXCEPT_RETURN(, points)
+
+void rs2_transform_points_to_points(float* to_points, const struct rs2_extrinsics* extrin, const float* from_points, int count) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(to_points);
+    VALIDATE_NOT_NULL(extrin);
+    VALIDATE_NOT_NULL(from_points);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    librealsense::transform_points_to_points(to_points, *extrin, from_points, count);
+}
+NOEXCEPT_RETURN(, to_points)
+
 void rs2_fov(const struct rs2_intrinsics* intrin, float to_fov[2]) BEGIN_API_CALL
 {
     to_fov[0] = (atan2f(intrin->ppx + 0.5f, intrin->fx) + atan2f(intrin->width - (intrin->ppx + 0.5f), intrin->fx)) * 57.2957795f;
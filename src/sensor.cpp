@@ -267,20 +267,16 @@ void log_callback_end( uint32_t fps,
         return *_owner;
     }
 
-    // TODO - make this method more efficient, using parralel computation, with SSE or CUDA, when available
-    std::vector<uint8_t> sensor_base::align_width_to_64(int width, int height, int bpp, uint8_t * pix) const
+    void sensor_base::copy_width_aligned_to_64(int width, int height, int bpp, const uint8_t * pix, uint8_t * dst) const
     {
-        int factor = bpp >> 3;
-        int bytes_in_width = width * factor;
-        int actual_input_bytes_in_width = (((bytes_in_width / 64 ) + 1) * 64);
-        std::vector<uint8_t> pixels;
+        auto const bytes_in_width = size_t(width * bpp >> 3);
+        auto const stride = size_t(compute_stride_aligned_to_64(width, bpp));
         for (int j = 0; j < height; ++j)
         {
-            int start_index = j * actual_input_bytes_in_width;
-            int end_index = (width * factor) + (j * actual_input_bytes_in_width);
-            pixels.insert(pixels.end(), pix + start_index, pix + end_index);
+            memcpy(dst, pix, bytes_in_width);
+            dst += bytes_in_width;
+            pix += stride;
         }
-        return pixels;
     }
 
     std::shared_ptr< frame >
@@ -596,6 +592,10 @@ void log_callback_end( uint32_t fps,
         for( auto & pb : active_pbs )
             register_processing_block_options( *pb );
 
+        // Raw frames that only go through converters can be read in place by them
+        if( auto uvc = std::dynamic_pointer_cast< uvc_sensor >( _raw_sensor ) )
+            uvc->set_converted_only_profiles( _formats_converter.get_converted_only_source_profiles() );
+
         _raw_sensor->set_source_owner(this);
         try
         {
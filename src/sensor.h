@@ -132,7 +132,14 @@ namespace librealsense
             return width * height * bpp >> 3;
         }
 
-        std::vector<uint8_t> align_width_to_64(int width, int height, int bpp, uint8_t * pix) const;
+        // Stride of MIPI buffers, whose rows are aligned to 64 bytes
+        inline int compute_stride_aligned_to_64(int width, int bpp) const
+        {
+            return ((width * bpp >> 3) + 63) / 64 * 64;
+        }
+
+        // Copies an image out of a buffer of rows aligned to 64 bytes, leaving the padding out
+        void copy_width_aligned_to_64(int width, int height, int bpp, const uint8_t * pix, uint8_t * dst) const;
 
         std::atomic<bool> _is_streaming;
         std::atomic<bool> _is_opened;
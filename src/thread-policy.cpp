@@ -0,0 +1,170 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include "thread-policy.h"
+
+#include <src/librealsense-exception.h>
+
+#include <rsutils/os/thread.h>
+#include <rsutils/easylogging/easyloggingpp.h>
+#include <rsutils/json.h>
+
+#include <stdexcept>
+
+
+namespace librealsense {
+
+
+static thread_policy::rule parse_rule( rsutils::json_ref j, std::string const & where )
+{
+    if( ! j.is_object() )
+        throw invalid_value_exception( "thread policy: '" + where + "' must be an object" );
+
+    thread_policy::rule r;
+    if( auto cpus = j.nested( "cpus" ) )
+    {
+        if( cpus.is_string() )
+        {
+            try
+            {
+                r.cpus = rsutils::os::parse_cpu_list( cpus.string_ref() );
+            }
+            catch( std::invalid_argument const & e )
+            {
+                throw invalid_value_exception( "thread policy: '" + where + "': " + e.what() );
+            }
+        }
+        else if( cpus.is_array() )
+        {
+            for( auto & cpu : cpus )
+            {
+                if( ! cpu.is_number_unsigned() )
+                    throw invalid_value_exception( "thread policy: '" + where + "' cpus must be non-negative integers" );
+                r.cpus.push_back( cpu.get< int >() );
+            }
+        }
+        else
+            throw invalid_value_exception( "thread policy: '" + where + "' cpus must be a list or a string" );
+    }
+    r.priority = j.nested( "priority" ).default_value( 0 );
+    if( r.priority < 0 || r.priority > 99 )
+        throw invalid_value_exception( "thread policy: '" + where + "' priority must be in [0,99]" );
+    return r;
+}
+
+
+/*static*/ thread_policy & thread_policy::instance()
+{
+    static thread_policy the_policy;
+    return the_policy;
+}
+
+
+/*static*/ void thread_policy::configure( rsutils::json const & settings )
+{
+    rsutils::json_ref j( settings );
+    bool const clear = ! j.exists() || j.is_null();
+    if( ! clear && ! j.is_object() )
+        throw invalid_value_exception( "thread policy: 'threads' must be an object" );
+
+    rule default_rule;
+    std::map< std::string, rule > by_role;
+    std::map< std::string, device_rules > by_device;
+
+    for( auto it = j.begin(); ! clear && it != j.end(); ++it )
+    {
+        if( it.key() == "default" )
+            default_rule = parse_rule( it.value(), it.key() );
+        else if( it.key() == "devices" )
+        {
+            rsutils::json_ref devices( it.value() );
+            if( ! devices.is_object() )
+                throw invalid_value_exception( "thread policy: 'devices' must be an object" );
+            for( auto dit = devices.begin(); dit != devices.end(); ++dit )
+            {
+                auto & dev = by_device[dit.key()];
+                rsutils::json_ref dj( dit.value() );
+                dev.all_roles = parse_rule( dj, dit.key() );
+                dev.has_all_roles = dj.nested( "cpus" ) || dj.nested( "priority" );
+                for( auto rit = dj.begin(); rit != dj.end(); ++rit )
+                    if( rit.value().is_object() )
+                        dev.by_role[rit.key()] = parse_rule( rit.value(), dit.key() + "/" + rit.key() );
+            }
+        }
+        else
+            by_role[it.key()] = parse_rule( it.value(), it.key() );
+    }
+
+    auto & policy = instance();
+    std::lock_guard< std::mutex > lock( policy._mutex );
+    policy._default = std::move( default_rule );
+    policy._by_role = std::move( by_role );
+    policy._by_device = std::move( by_device );
+    ++policy._generation;  // threads will re-apply on their next apply()
+}
+
+
+/*static*/ thread_policy::rule thread_policy::find_rule( char const * role, std::string const & device_id )
+{
+    auto & policy = instance();
+    std::lock_guard< std::mutex > lock( policy._mutex );
+    if( ! device_id.empty() )
+    {
+        auto dev = policy._by_device.find( device_id );
+        if( dev != policy._by_device.end() )
+        {
+            auto r = dev->second.by_role.find( role );
+            if( r != dev->second.by_role.end() )
+                return r->second;
+            if( dev->second.has_all_roles )
+                return dev->second.all_roles;
+        }
+    }
+    auto r = policy._by_role.find( role );
+    if( r != policy._by_role.end() )
+        return r->second;
+    return policy._default;
+}
+
+
+/*static*/ bool thread_policy::apply( char const * role, std::string const & device_id )
+{
+    // Remember what was applied to this thread so loops calling us repeatedly pay almost nothing
+    thread_local unsigned applied_generation = 0;
+    thread_local char const * applied_role = nullptr;
+    thread_local std::string applied_device_id;
+    thread_local bool pinned = false;
+    thread_local bool prioritized = false;
+
+    auto const generation = instance()._generation.load();
+    if( applied_generation == generation && applied_role == role && applied_device_id == device_id )
+        return false;
+    applied_generation = generation;
+    applied_role = role;
+    applied_device_id = device_id;
+
+    rsutils::os::set_current_thread_name( std::string( "rs-" ) + role );
+
+    // Whatever a previous rule changed and the current one does not is undone
+    auto r = find_rule( role, device_id );
+    if( ! r.cpus.empty() || pinned )
+    {
+        bool ok = r.cpus.empty() ? rsutils::os::reset_current_thread_affinity()
+                                 : rsutils::os::set_current_thread_affinity( r.cpus );
+        if( ! ok )
+            LOG_WARNING( "failed to set CPU affinity of '" << role << "' thread" );
+        pinned = ! r.cpus.empty();
+    }
+    if( r.priority || prioritized )
+    {
+        bool ok = r.priority ? rsutils::os::set_current_thread_realtime_priority( r.priority )
+                             : rsutils::os::reset_current_thread_priority();
+        if( ! ok )
+            LOG_WARNING( "failed to set real-time priority " << r.priority << " of '" << role << "' thread" );
+        prioritized = r.priority != 0;
+    }
+    return true;
+}
+
+
+}  // namespace librealsense
@@ -0,0 +1,91 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+#pragma once
+
+#include <rsutils/json-fwd.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <map>
+
+
+namespace librealsense
+{
+    // The roles internal threads can identify themselves with, used both for naming ("rs-<role>") and as keys in the
+    // policy settings
+    namespace thread_role
+    {
+        constexpr char const * capture = "capture";                    // v4l2 poll loop, uvc_streamer publisher
+        constexpr char const * hid = "hid";                            // HID/IIO readers and interrupt handlers
+        constexpr char const * device_watcher = "device-watcher";      // udev/polling device watchers
+        constexpr char const * time_diff_keeper = "time-diff-keeper";  // global timestamp polling
+        constexpr char const * options_watcher = "options-watcher";    // option value change polling
+        constexpr char const * playback = "playback";                  // playback reader and per-stream dispatchers
+        constexpr char const * record = "record";                      // recorder writer
+    }
+
+
+    // Process-wide policy for naming, pinning, and prioritizing the internal threads librealsense spawns.
+    //
+    // It is configured from the "threads" section of the context settings (see rs2_create_context_ex), e.g.:
+    //     "threads": {
+    //         "default": { "cpus": "0-7" },
+    //         "capture": { "cpus": "8-9", "priority": 50 },
+    //         "hid": { "cpus": [10] },
+    //         "devices": {
+    //             "2-3-1": { "cpus": "12-15", "capture": { "cpus": "12", "priority": 60 } }
+    //         }
+    //     }
+    // For each thread, the most specific rule wins: device+role, device, role, then default. "cpus" can be a list of
+    // CPU numbers or a kernel-style CPU-list string; "priority" is a SCHED_FIFO priority [1,99], where 0 (the default)
+    // leaves the scheduling policy alone.
+    //
+    // Devices are keyed by their backend unique-id (USB port path on Linux), which all the nodes of a camera share.
+    // Currently only the V4L2 capture threads identify the device they serve.
+    //
+    // Frame buffers are allocated by whatever thread first writes to them; with the capture threads pinned to the CPUs
+    // of one NUMA node, the kernel's first-touch policy keeps the frame memory local to that node.
+    //
+    // Since backend threads are not aware of contexts, the policy is global: the last context created with "threads"
+    // in its settings wins. Contexts without it leave the policy alone; "threads": null clears it (threads pinned or
+    // prioritized by the previous policy are reset).
+    //
+    class thread_policy
+    {
+    public:
+        struct rule
+        {
+            std::vector< int > cpus;  // empty = no affinity change
+            int priority = 0;         // 0 = no scheduling change
+        };
+
+        // Replace the current policy with the given settings (the contents of "threads"); null or missing settings
+        // clear it. Throws invalid_value_exception on bad settings
+        static void configure( rsutils::json const & settings );
+
+        // Name the calling thread and apply whatever rule matches the role & device to it.
+        // Cheap to call repeatedly from the same thread (e.g., from inside a dispatcher loop): only the first call (or
+        // the first after a policy change, or with another role or device) does any work, and returns true.
+        static bool apply( char const * role, std::string const & device_id = std::string() );
+
+        // Find the rule for the given role & device; exposed mostly for testing
+        static rule find_rule( char const * role, std::string const & device_id );
+
+    private:
+        struct device_rules
+        {
+            rule all_roles;
+            bool has_all_roles = false;
+            std::map< std::string, rule > by_role;
+        };
+
+        static thread_policy & instance();
+
+        std::mutex _mutex;
+        std::atomic< unsigned > _generation{ 1 };
+        rule _default;
+        std::map< std::string, rule > _by_role;
+        std::map< std::string, device_rules > _by_device;
+    };
+}
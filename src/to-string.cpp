@@ -313,6 +313,14 @@ const char * get_string( rs2_extension value )
     CASE( MAX_USABLE_RANGE_SENSOR )
     CASE( DEBUG_STREAM_SENSOR )
     CASE( CALIBRATION_CHANGE_DEVICE )
+    CASE( DEPTH_FUSION )
+    CASE( VOXEL_FILTER )
+    CASE( SPARSE_POINTCLOUD )
+    CASE( SURFACE_NORMALS )
+    CASE( SEQUENCE_DEMUX )
+    CASE( QUALITY_GOVERNOR )
+    CASE( ALIGNED_POINTCLOUD )
+    CASE( DEPTH_STATISTICS )
     default:
         assert( ! is_valid( value ) );
         return UNKNOWN_VALUE;
@@ -459,6 +467,15 @@ std::string const & get_string_( rs2_option value )
         CASE( OHM_TEMPERATURE )
         CASE( SOC_PVT_TEMPERATURE )
         CASE( GYRO_SENSITIVITY )
+        CASE( VOXEL_SIZE )
+        CASE( ROI_MIN_X )
+        CASE( ROI_MIN_Y )
+        CASE( ROI_MAX_X )
+        CASE( ROI_MAX_Y )
+        CASE( ALIGN_INTERPOLATION )
+        CASE( ALIGN_DEPTH_CHANGE_THRESHOLD )
+        CASE( STATISTICS_GRID_COLUMNS )
+        CASE( STATISTICS_GRID_ROWS )
 #undef CASE
         return arr;
     }();
@@ -694,6 +711,7 @@ const char * get_string( rs2_notification_category value )
     CASE( UNKNOWN_ERROR )
     CASE( FIRMWARE_UPDATE_RECOMMENDED )
     CASE( POSE_RELOCALIZATION )
+    CASE( PROCESSING_QUALITY )
     default:
         assert( ! is_valid( value ) );
         return UNKNOWN_VALUE;
@@ -16,6 +16,27 @@
 namespace librealsense {
 
 
+// A backend buffer read in place by a raw frame: it is given back to the backend only once both the frame callback
+// returned and the frame was released
+class buffer_loan
+{
+    std::function< void() > _continuation;
+    std::atomic< int > _holders{ 2 };
+
+public:
+    explicit buffer_loan( std::function< void() > && continuation )
+        : _continuation( std::move( continuation ) )
+    {
+    }
+
+    void release()
+    {
+        if( --_holders == 0 )
+            _continuation();
+    }
+};
+
+
 // in sensor.cpp
 void log_callback_end( uint32_t fps,
                        rs2_time_t callback_start_time,
@@ -111,13 +132,16 @@ void uvc_sensor::open( const stream_profiles & requests )
     for( auto && req_profile : requests )
     {
         auto && req_profile_base = std::dynamic_pointer_cast< stream_profile_base >( req_profile );
+        bool const converted_only
+            = std::find( _converted_only_profiles.begin(), _converted_only_profiles.end(), req_profile )
+           != _converted_only_profiles.end();
         try
         {
             unsigned long long last_frame_number = 0;
             rs2_time_t last_timestamp = 0;
             _device->probe_and_commit(
                 req_profile_base->get_backend_profile(),
-                [this, req_profile_base, req_profile, last_frame_number, last_timestamp](
+                [this, req_profile_base, req_profile, converted_only, last_frame_number, last_timestamp](
                     platform::stream_profile p,
                     platform::frame_object f,
                     std::function< void() > continuation ) mutable
@@ -182,26 +206,41 @@ void uvc_sensor::open( const stream_profiles & requests )
                     if( val_in_range( req_profile_base->get_format(), { RS2_FORMAT_MJPEG, RS2_FORMAT_Z16H } ) )
                         expected_size = static_cast< int >( f.frame_size );
 
+                    // method should be limited to use of MIPI - not for USB
+                    // the aim is to grab the data from a bigger buffer, which is aligned to 64 bytes,
+                    // when the resolution's width is not aligned to 64
+                    auto const row_bytes = size_t( width * bpp >> 3 );
+                    auto const aligned_stride = size_t( compute_stride_aligned_to_64( width, bpp ) );
+                    bool const aligned_to_64 = row_bytes % 64 != 0 && f.frame_size > expected_size
+                                            && f.frame_size >= aligned_stride * ( height - 1 ) + row_bytes;
+
+                    // When only converters read the frame, they read it straight from the backend buffer and write
+                    // into their own target frames: no copy
+                    bool const in_place = converted_only && vsp && ! aligned_to_64 && f.frame_size >= expected_size;
+
                     auto extension = frame_source::stream_to_frame_types( req_profile_base->get_stream_type() );
                     frame_holder fh = _source.alloc_frame(
                         { req_profile_base->get_stream_type(), req_profile_base->get_stream_index(), extension },
                         expected_size,
                         std::move( fr->additional_data ),
-                        true );
+                        ! in_place );
                     auto diff = time_service::get_time() - system_time;
                     if( diff > 10 )
                         LOG_DEBUG( "!! Frame allocation took " << diff << " msec" );
 
+                    std::shared_ptr< buffer_loan > loan;
                     if( fh.frame )
                     {
-                        // method should be limited to use of MIPI - not for USB
-                        // the aim is to grab the data from a bigger buffer, which is aligned to 64 bytes,
-                        // when the resolution's width is not aligned to 64
-                        if( ( width * bpp >> 3 ) % 64 != 0 && f.frame_size > expected_size )
+                        if( in_place )
                         {
-                            std::vector< uint8_t > pixels = align_width_to_64( width, height, bpp, (uint8_t *)f.pixels );
-                            assert( expected_size == sizeof( uint8_t ) * pixels.size() );
-                            memcpy( (void *)fh->get_frame_data(), pixels.data(), expected_size );
+                            loan = std::make_shared< buffer_loan >( std::move( continuation ) );
+                            fh->attach_continuation( frame_continuation( [loan]() { loan->release(); }, f.pixels ) );
+                        }
+                        else if( aligned_to_64 )
+                        {
+                            // the rows are copied straight into the frame, so the padding costs no extra copy
+                            copy_width_aligned_to_64( width, height, bpp, (const uint8_t *)f.pixels,
+                                                      (uint8_t *)fh->get_frame_data() );
                         }
                         else
                         {
@@ -233,7 +272,8 @@ void uvc_sensor::open( const stream_profiles & requests )
 
                     // calling the continuation method, and releasing the backend frame buffer
                     // since the content of the OS frame buffer has been copied, it can released ASAP
-                    continuation();
+                    if( ! loan )
+                        continuation();
 
                     if (!fh.frame)
                     {
@@ -256,6 +296,11 @@ void uvc_sensor::open( const stream_profiles & requests )
                         // Log callback ended
                         log_callback_end( fps, callback_start_time, time_service::get_time(), stream_type, frame_number );
                     }
+
+                    // The converters are done with a frame read in place by now; the buffer goes back to the backend
+                    // as soon as the frame is released, too
+                    if( loan )
+                        loan->release();
                 } );
         }
         catch( ... )
@@ -270,6 +315,7 @@ void uvc_sensor::open( const stream_profiles & requests )
     }
 
     _internal_config = commited;
+    _converted_only_profiles.clear();
 
     if( _on_open )
         _on_open( _internal_config );
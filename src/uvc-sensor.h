@@ -31,6 +31,10 @@ public:
     virtual void prepare_for_bulk_operation() override;
     virtual void finished_bulk_operation() override;
 
+    // Profiles of the next open() whose frames are only read by converters that output new frames, and are released by
+    // the time the frame callback returns: these frames refer to the backend buffer instead of a copy of it
+    void set_converted_only_profiles( stream_profiles profiles ) { _converted_only_profiles = std::move( profiles ); }
+
     std::vector< platform::stream_profile > get_configuration() const { return _internal_config; }
     std::shared_ptr< platform::uvc_device > get_uvc_device() { return _device; }
     platform::usb_spec get_usb_specification() const { return _device->get_usb_specification(); }
@@ -90,6 +94,7 @@ private:
     std::vector< platform::extension_unit > _xus;
     std::unique_ptr< power > _power;
     std::unique_ptr< frame_timestamp_reader > _timestamp_reader;
+    stream_profiles _converted_only_profiles;
 };
 
 
@@ -5,6 +5,8 @@
 #include "uvc-types.h"
 #include "uvc-device.h"
 
+#include <rsutils/concurrency/inline-dispatcher.h>
+
 #include "stdio.h"
 #include "stdlib.h"
 #include <cstring>
@@ -53,7 +55,8 @@ namespace librealsense
             int64_t _watchdog_timeout;
             uvc_streamer_context _context;
 
-            dispatcher _action_dispatcher;
+            // Invoked for every USB request completed: must not allocate
+            rsutils::concurrency::inline_dispatcher _action_dispatcher;
 
             std::shared_ptr<watchdog> _watchdog;
             uint32_t _read_buff_length;
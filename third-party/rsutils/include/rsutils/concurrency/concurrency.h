@@ -194,14 +194,16 @@ public:
 };
 
 // A single_consumer_queue meant to hold frame_holder objects
-template<class T>
+// The underlying queue may be replaced by any with the same interface, e.g. rsutils::concurrency::lock_free_queue (which
+// has no peek())
+template< class T, class Queue = single_consumer_queue< T > >
 class single_consumer_frame_queue
 {
-    single_consumer_queue<T> _queue;
+    Queue _queue;
 
 public:
-    single_consumer_frame_queue< T >( unsigned int cap = QUEUE_MAX_SIZE,
-                                      std::function< void( T const & ) > on_drop_callback = nullptr )
+    single_consumer_frame_queue( unsigned int cap = QUEUE_MAX_SIZE,
+                                 std::function< void( T const & ) > on_drop_callback = nullptr )
         : _queue( cap, on_drop_callback )
     {
     }
@@ -278,14 +280,25 @@ public:
     //
     class cancellable_timer
     {
-        dispatcher* _owner;
-    
+        std::atomic< bool > const * _was_stopped;
+        std::mutex * _was_stopped_mutex;
+        std::condition_variable * _was_stopped_cv;
+
     public:
         cancellable_timer(dispatcher* owner)
-            : _owner(owner)
+            : cancellable_timer( owner->_was_stopped, owner->_was_stopped_mutex, owner->_was_stopped_cv )
+        {}
+
+        // For other dispatchers (see inline_dispatcher), from their own stop state
+        cancellable_timer( std::atomic< bool > const & was_stopped,
+                           std::mutex & was_stopped_mutex,
+                           std::condition_variable & was_stopped_cv )
+            : _was_stopped( &was_stopped )
+            , _was_stopped_mutex( &was_stopped_mutex )
+            , _was_stopped_cv( &was_stopped_cv )
         {}
 
-        bool was_stopped() const { return _owner->_was_stopped.load(); }
+        bool was_stopped() const { return _was_stopped->load(); }
 
         // Replacement for sleep() -- try to sleep for a time, but stop if the
         // dispatcher is stopped
@@ -297,13 +310,13 @@ public:
         {
             using namespace std::chrono;
 
-            std::unique_lock<std::mutex> lock(_owner->_was_stopped_mutex);
+            std::unique_lock<std::mutex> lock(*_was_stopped_mutex);
             if( was_stopped() )
                 return false;
             // wait_for() returns "false if the predicate pred still evaluates to false after the
             // rel_time timeout expired, otherwise true"
             return ! (
-                _owner->_was_stopped_cv.wait_for( lock, sleep_time, [&]() { return was_stopped(); } ) );
+                _was_stopped_cv->wait_for( lock, sleep_time, [&]() { return was_stopped(); } ) );
         }
     };
 
@@ -0,0 +1,230 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "concurrency.h"
+#include "lock-free-queue.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace rsutils {
+namespace concurrency {
+
+
+// A dispatcher action held by value: a closure of up to inline_size bytes (that can be moved without throwing) is
+// stored inside the object itself, so making one allocates nothing. Anything bigger goes on the heap, as with
+// std::function.
+//
+class inline_action
+{
+public:
+    static constexpr size_t inline_size = 64;
+
+    inline_action() = default;
+
+    template< class F,
+              class = typename std::enable_if< ! std::is_same< typename std::decay< F >::type, inline_action >::value >::type >
+    inline_action( F && f )
+    {
+        typedef typename std::decay< F >::type closure;
+        emplace< closure >( std::forward< F >( f ), std::integral_constant< bool, fits< closure >::value >() );
+    }
+
+    inline_action( inline_action && other ) noexcept { move_from( other ); }
+
+    inline_action & operator=( inline_action && other ) noexcept
+    {
+        if( this != &other )
+        {
+            reset();
+            move_from( other );
+        }
+        return *this;
+    }
+
+    inline_action( inline_action const & ) = delete;
+    inline_action & operator=( inline_action const & ) = delete;
+
+    ~inline_action() { reset(); }
+
+    explicit operator bool() const { return _ops != nullptr; }
+
+    // Whether the closure was too big to be held inline
+    bool on_heap() const { return _ops && _ops->on_heap; }
+
+    void operator()( dispatcher::cancellable_timer timer ) { _ops->invoke( &_storage, timer ); }
+
+    void reset()
+    {
+        if( _ops )
+            _ops->destroy( &_storage );
+        _ops = nullptr;
+    }
+
+private:
+    template< class F >
+    struct fits
+        : std::integral_constant< bool,
+                                  sizeof( F ) <= inline_size && alignof( F ) <= alignof( std::max_align_t )
+                                      && std::is_nothrow_move_constructible< F >::value >
+    {
+    };
+
+    struct ops
+    {
+        void ( *invoke )( void *, dispatcher::cancellable_timer & );
+        void ( *move )( void * to, void * from );  // and destroy the source
+        void ( *destroy )( void * );
+        bool on_heap;
+    };
+
+    template< class F >
+    struct inline_ops
+    {
+        static void invoke( void * p, dispatcher::cancellable_timer & t ) { ( *static_cast< F * >( p ) )( t ); }
+        static void move( void * to, void * from )
+        {
+            new( to ) F( std::move( *static_cast< F * >( from ) ) );
+            static_cast< F * >( from )->~F();
+        }
+        static void destroy( void * p ) { static_cast< F * >( p )->~F(); }
+        static ops const table;
+    };
+
+    template< class F >
+    struct heap_ops
+    {
+        static void invoke( void * p, dispatcher::cancellable_timer & t ) { ( **static_cast< F ** >( p ) )( t ); }
+        static void move( void * to, void * from ) { *static_cast< F ** >( to ) = *static_cast< F ** >( from ); }
+        static void destroy( void * p ) { delete *static_cast< F ** >( p ); }
+        static ops const table;
+    };
+
+    template< class F, class Arg >
+    void emplace( Arg && f, std::true_type /*fits*/ )
+    {
+        new( &_storage ) F( std::forward< Arg >( f ) );
+        _ops = &inline_ops< F >::table;
+    }
+
+    template< class F, class Arg >
+    void emplace( Arg && f, std::false_type /*fits*/ )
+    {
+        *reinterpret_cast< F ** >( &_storage ) = new F( std::forward< Arg >( f ) );
+        _ops = &heap_ops< F >::table;
+    }
+
+    void move_from( inline_action & other ) noexcept
+    {
+        if( ! other._ops )
+            return;
+        other._ops->move( &_storage, &other._storage );
+        _ops = other._ops;
+        other._ops = nullptr;
+    }
+
+    typename std::aligned_storage< inline_size, alignof( std::max_align_t ) >::type _storage;
+    ops const * _ops = nullptr;
+};
+
+
+template< class F >
+inline_action::ops const inline_action::inline_ops< F >::table
+    = { &inline_action::inline_ops< F >::invoke, &inline_action::inline_ops< F >::move,
+        &inline_action::inline_ops< F >::destroy, false };
+
+template< class F >
+inline_action::ops const inline_action::heap_ops< F >::table
+    = { &inline_action::heap_ops< F >::invoke, &inline_action::heap_ops< F >::move,
+        &inline_action::heap_ops< F >::destroy, true };
+
+
+// A drop-in for dispatcher, for hot paths: actions are held in a ring of inline_action cells allocated up-front, and
+// handed over through a lock_free_queue, so invoking a (small) action neither allocates nor takes a lock, and the
+// dispatching thread spins briefly before blocking so it wakes up quickly when actions come in bursts.
+//
+// Unlike dispatcher, the capacity must be bounded: it is all allocated on construction.
+//
+class inline_dispatcher
+{
+public:
+    typedef dispatcher::cancellable_timer cancellable_timer;
+    typedef inline_action action;
+
+    inline_dispatcher( unsigned int queue_capacity, std::function< void( action const & ) > on_drop_callback = nullptr );
+    ~inline_dispatcher();
+
+    inline_dispatcher( inline_dispatcher const & ) = delete;
+    inline_dispatcher & operator=( inline_dispatcher const & ) = delete;
+
+    bool empty() const { return _queue.empty(); }
+
+    // See dispatcher::invoke
+    template< class T >
+    void invoke( T && item, bool is_blocking = false )
+    {
+        if( ! _was_stopped )
+        {
+            if( is_blocking )
+                _queue.blocking_enqueue( action( std::forward< T >( item ) ) );
+            else
+                _queue.enqueue( action( std::forward< T >( item ) ) );
+        }
+    }
+
+    // See dispatcher::invoke_and_wait
+    template< class T >
+    void invoke_and_wait( T item, std::function< bool() > exit_condition, bool is_blocking = false )
+    {
+        bool done = false;
+
+        invoke(
+            [&, func = std::move( item )]( cancellable_timer c )
+            {
+                std::lock_guard< std::mutex > lk( _blocking_invoke_mutex );
+                func( c );
+
+                done = true;
+                _blocking_invoke_cv.notify_one();
+            },
+            is_blocking );
+
+        std::unique_lock< std::mutex > lk( _blocking_invoke_mutex );
+        _blocking_invoke_cv.wait( lk, [&]() { return done || exit_condition(); } );
+    }
+
+    // See dispatcher::stop
+    void stop();
+
+    // See dispatcher::start
+    void start();
+
+    // See dispatcher::flush
+    bool flush( std::chrono::steady_clock::duration timeout = std::chrono::seconds( 10 ) );
+
+private:
+    bool _wait_for_start( int timeout_ms );
+
+    lock_free_queue< action > _queue;
+    std::thread _thread;
+
+    std::atomic< bool > _was_stopped;
+    std::condition_variable _was_stopped_cv;
+    std::mutex _was_stopped_mutex;
+
+    std::mutex _dispatch_mutex;
+
+    std::condition_variable _blocking_invoke_cv;
+    std::mutex _blocking_invoke_mutex;
+
+    std::atomic< bool > _is_alive;
+};
+
+
+}  // namespace concurrency
+}  // namespace rsutils
@@ -0,0 +1,346 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined( __i386__ ) || defined( __x86_64__ ) || defined( _M_IX86 ) || defined( _M_X64 )
+#include <immintrin.h>
+#endif
+
+
+namespace rsutils {
+namespace concurrency {
+
+
+// A bounded queue for handing items between threads without taking a lock, with the interface and semantics of
+// single_consumer_queue: when full, enqueue() drops the oldest item (through the on-drop callback) while
+// blocking_enqueue() waits for room; stop() empties it and rejects anything enqueued until start().
+//
+// The items live in a ring of cells, each with a sequence number saying whether it is ready to be written or read
+// (Vyukov's bounded MPMC queue), so any number of threads may enqueue. Dropping the oldest item is done by the
+// producer taking it off the front, the same way the consumer does. So, unlike single_consumer_queue, there is no
+// peek(): a producer may take the front item away while it is being looked at.
+//
+// Waiting, for an item or for room, spins and then yields before blocking on a condition variable. Whoever makes an
+// item or room available signals only when it knows someone is blocked, so a busy queue makes no system calls. The
+// spinning adapts: it gets longer while waits end while yielding, and shorter when they end up blocking anyway.
+//
+template< class T >
+class lock_free_queue
+{
+    struct cell
+    {
+        std::atomic< size_t > sequence;
+        T item;
+    };
+
+    // Spin iterations before yielding, adapted within [min_spins,max_spins]; then yields before blocking
+    static constexpr unsigned min_spins = 16;
+    static constexpr unsigned max_spins = 1024;
+    static constexpr unsigned yields = 16;
+
+    size_t const _cap;
+    std::unique_ptr< cell[] > _cells;
+    std::function< void( T const & ) > const _on_drop_callback;
+
+    // Producers and consumer each update their own position: keep them on separate cache lines
+    char _pad0[64];
+    std::atomic< size_t > _enqueue_pos;
+    char _pad1[64];
+    std::atomic< size_t > _dequeue_pos;
+    char _pad2[64];
+
+    std::atomic< bool > _accepting;
+
+    std::mutex _mutex;                // only for blocking
+    std::condition_variable _deq_cv;  // not empty signal
+    std::condition_variable _enq_cv;  // not full signal
+    std::atomic< int > _deq_waiters;
+    std::atomic< int > _enq_waiters;
+    std::atomic< unsigned > _deq_spins;
+    std::atomic< unsigned > _enq_spins;
+    bool const _can_spin;  // with a single core, whoever we wait for cannot run while we spin
+
+public:
+    explicit lock_free_queue( unsigned int cap = 10, std::function< void( T const & ) > on_drop_callback = nullptr )
+        : _cap( std::max( cap, 1u ) )
+        , _cells( new cell[_cap] )
+        , _on_drop_callback( on_drop_callback )
+        , _enqueue_pos( 0 )
+        , _dequeue_pos( 0 )
+        , _accepting( true )
+        , _deq_waiters( 0 )
+        , _enq_waiters( 0 )
+        , _deq_spins( min_spins )
+        , _enq_spins( min_spins )
+        , _can_spin( std::thread::hardware_concurrency() > 1 )
+    {
+        for( size_t i = 0; i < _cap; ++i )
+            _cells[i].sequence.store( i, std::memory_order_relaxed );
+    }
+
+    lock_free_queue( lock_free_queue const & ) = delete;
+    lock_free_queue & operator=( lock_free_queue const & ) = delete;
+
+    // Enqueue an item onto the queue.
+    // If the queue is full, the front will be removed, losing whatever was there!
+    bool enqueue( T && item )
+    {
+        if( ! _accepting.load( std::memory_order_acquire ) )
+        {
+            if( _on_drop_callback )
+                _on_drop_callback( item );
+            return false;
+        }
+
+        while( ! try_push( item ) )
+        {
+            T oldest;
+            if( try_pop( &oldest ) && _on_drop_callback )
+                _on_drop_callback( oldest );
+        }
+
+        // We pushed something -- let the consumer know, if it's blocked
+        notify( _deq_waiters, _deq_cv );
+        return true;
+    }
+
+    // Enqueue an item, but wait for room if there isn't any
+    // Returns true if the enqueue succeeded
+    bool blocking_enqueue( T && item )
+    {
+        unsigned attempt = 0;
+        auto const forever = std::chrono::steady_clock::time_point::max();
+        while( true )
+        {
+            if( ! _accepting.load( std::memory_order_acquire ) )
+            {
+                // We shouldn't be adding anything to the queue when we're stopping
+                if( _on_drop_callback )
+                    _on_drop_callback( item );
+                return false;
+            }
+            if( try_push( item ) )
+                break;
+            wait( attempt, _enq_spins, _enq_waiters, _enq_cv, forever, [this]() { return ! _accepting || ! full(); } );
+        }
+
+        spun( attempt, _enq_spins );
+        notify( _deq_waiters, _deq_cv );
+        return true;
+    }
+
+    // Remove one item; if unavailable, wait for it
+    // Return true if an item was removed -- otherwise, false
+    bool dequeue( T * item, unsigned int timeout_ms )
+    {
+        unsigned attempt = 0;
+        auto const deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds( timeout_ms );
+        while( ! try_pop( item ) )
+        {
+            if( ! _accepting.load( std::memory_order_acquire ) )
+                return false;
+            if( ! wait( attempt, _deq_spins, _deq_waiters, _deq_cv, deadline, [this]() { return ! _accepting || ! empty(); } ) )
+                return false;
+        }
+
+        spun( attempt, _deq_spins );
+        // We've made room -- let whoever is blocked waiting for room know about it
+        notify( _enq_waiters, _enq_cv );
+        return true;
+    }
+
+    // Remove one item if available; do not wait for one
+    // Return true if an item was removed -- otherwise, false
+    bool try_dequeue( T * item )
+    {
+        if( ! try_pop( item ) )
+            return false;
+        notify( _enq_waiters, _enq_cv );
+        return true;
+    }
+
+    void stop()
+    {
+        // We no longer accept any more items!
+        _accepting = false;
+        clear();
+    }
+
+    void clear()
+    {
+        T item;
+        while( try_pop( &item ) )
+            item = T();
+
+        // Wake up anyone who is waiting for room to enqueue, or waiting for something to dequeue -- there's nothing now
+        std::lock_guard< std::mutex > lock( _mutex );
+        _enq_cv.notify_all();
+        _deq_cv.notify_all();
+    }
+
+    void start() { _accepting = true; }
+
+    bool started() const { return _accepting; }
+    bool stopped() const { return ! started(); }
+
+    // Items being enqueued count as soon as they are given a cell
+    size_t size() const
+    {
+        auto const dequeue_pos = _dequeue_pos.load( std::memory_order_acquire );
+        auto const enqueue_pos = _enqueue_pos.load( std::memory_order_acquire );
+        return enqueue_pos > dequeue_pos ? std::min( enqueue_pos - dequeue_pos, _cap ) : 0;
+    }
+
+    bool empty() const
+    {
+        auto const pos = _dequeue_pos.load( std::memory_order_acquire );
+        return _cells[pos % _cap].sequence.load( std::memory_order_acquire ) != pos + 1;
+    }
+
+private:
+    bool full() const
+    {
+        auto const pos = _enqueue_pos.load( std::memory_order_acquire );
+        return _cells[pos % _cap].sequence.load( std::memory_order_acquire ) != pos;
+    }
+
+    // Moves the item in only if there is room
+    bool try_push( T & item )
+    {
+        auto pos = _enqueue_pos.load( std::memory_order_relaxed );
+        while( true )
+        {
+            auto & c = _cells[pos % _cap];
+            auto const seq = c.sequence.load( std::memory_order_acquire );
+            auto const diff = intptr_t( seq ) - intptr_t( pos );
+            if( diff == 0 )
+            {
+                if( _enqueue_pos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                {
+                    c.item = std::move( item );
+                    c.sequence.store( pos + 1, std::memory_order_release );
+                    return true;
+                }
+            }
+            else if( diff < 0 )
+                return false;  // full: the cell still holds an item from the previous lap
+            else
+                pos = _enqueue_pos.load( std::memory_order_relaxed );
+        }
+    }
+
+    bool try_pop( T * item )
+    {
+        auto pos = _dequeue_pos.load( std::memory_order_relaxed );
+        while( true )
+        {
+            auto & c = _cells[pos % _cap];
+            auto const seq = c.sequence.load( std::memory_order_acquire );
+            auto const diff = intptr_t( seq ) - intptr_t( pos + 1 );
+            if( diff == 0 )
+            {
+                if( _dequeue_pos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                {
+                    *item = std::move( c.item );
+                    c.sequence.store( pos + _cap, std::memory_order_release );
+                    return true;
+                }
+            }
+            else if( diff < 0 )
+                return false;  // empty, or the item is still being written
+            else
+                pos = _dequeue_pos.load( std::memory_order_relaxed );
+        }
+    }
+
+    static void cpu_relax()
+    {
+#if defined( __i386__ ) || defined( __x86_64__ ) || defined( _M_IX86 ) || defined( _M_X64 )
+        _mm_pause();
+#elif defined( __aarch64__ ) || defined( __arm__ )
+        asm volatile( "yield" );
+#endif
+    }
+
+    // One step of waiting: spin, then yield, then block until ready() or the deadline.
+    // Returns false once the deadline has passed without ready().
+    template< class Ready >
+    bool wait( unsigned & attempt,
+               std::atomic< unsigned > & spins,
+               std::atomic< int > & waiters,
+               std::condition_variable & cv,
+               std::chrono::steady_clock::time_point deadline,
+               Ready ready )
+    {
+        auto const spin_limit = _can_spin ? spins.load( std::memory_order_relaxed ) : 0;
+        if( attempt < spin_limit )
+        {
+            ++attempt;
+            cpu_relax();
+            return true;
+        }
+        if( attempt < spin_limit + yields )
+        {
+            ++attempt;
+            std::this_thread::yield();
+            return true;
+        }
+
+        // Spinning was wasted: halve it
+        spins.store( std::max( min_spins, spin_limit / 2 ), std::memory_order_relaxed );
+        std::unique_lock< std::mutex > lock( _mutex );
+        waiters.fetch_add( 1 );
+        // Pairs with the fence in notify(): either they see us waiting, or we see what they did
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        bool is_ready = true;
+        if( deadline == std::chrono::steady_clock::time_point::max() )
+            cv.wait( lock, ready );
+        else
+            is_ready = cv.wait_until( lock, deadline, ready );
+        waiters.fetch_sub( 1 );
+        return is_ready;
+    }
+
+    // After a wait that ended without blocking: spin a little longer, to avoid yielding next time
+    void spun( unsigned attempt, std::atomic< unsigned > & spins ) const
+    {
+        if( ! _can_spin )
+            return;
+        auto const spin_limit = spins.load( std::memory_order_relaxed );
+        if( attempt > spin_limit && attempt <= spin_limit + yields && spin_limit < max_spins )
+            spins.store( std::min( max_spins, spin_limit + spin_limit / 8 + 1 ), std::memory_order_relaxed );
+    }
+
+    void notify( std::atomic< int > & waiters, std::condition_variable & cv )
+    {
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+        if( ! waiters.load( std::memory_order_relaxed ) )
+            return;
+        // Taking the lock makes sure the waiter is either blocked already or has yet to check ready()
+        std::lock_guard< std::mutex > lock( _mutex );
+        cv.notify_all();
+    }
+};
+
+
+template< class T >
+constexpr unsigned lock_free_queue< T >::min_spins;
+template< class T >
+constexpr unsigned lock_free_queue< T >::max_spins;
+template< class T >
+constexpr unsigned lock_free_queue< T >::yields;
+
+
+}  // namespace concurrency
+}  // namespace rsutils
@@ -0,0 +1,57 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <deque>
+#include <vector>
+
+
+namespace rsutils {
+namespace concurrency {
+
+
+// A fixed set of worker threads for data-parallel work, e.g. splitting an image into row bands.
+//
+// Work is submitted through parallel_for(), which blocks until all of it is done. The calling thread participates, so
+// a pool with no workers simply runs everything inline, and nested parallel_for() calls (from within a worker) cannot
+// deadlock.
+//
+class worker_pool
+{
+public:
+    // The number of worker threads does not include the calling thread
+    explicit worker_pool( unsigned n_workers );
+    ~worker_pool();
+
+    worker_pool( worker_pool const & ) = delete;
+    worker_pool & operator=( worker_pool const & ) = delete;
+
+    // Number of threads that may run work concurrently, including the caller
+    size_t concurrency() const { return _workers.size() + 1; }
+
+    // Split [0,n) into contiguous ranges of at least 'min_chunk' elements and call fn(begin,end) on each, in parallel.
+    // Returns when all ranges are done. If any of the calls throws, the first exception is rethrown here.
+    void parallel_for( size_t n, size_t min_chunk, std::function< void( size_t begin, size_t end ) > const & fn );
+
+    // A process-wide pool, created on first use, with a worker per hardware thread (less the caller)
+    static worker_pool & shared();
+
+private:
+    bool run_one( std::unique_lock< std::mutex > & lock );
+
+    std::vector< std::thread > _workers;
+    std::deque< std::function< void() > > _tasks;
+    std::mutex _mutex;
+    std::condition_variable _task_cv;
+    std::condition_variable _done_cv;
+    bool _stopping = false;
+};
+
+
+}  // namespace concurrency
+}  // namespace rsutils
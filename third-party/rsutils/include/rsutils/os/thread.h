@@ -0,0 +1,45 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+
+namespace rsutils {
+namespace os {
+
+
+// Sets the name of the calling thread, as seen by debuggers, 'top -H', 'ps -L', etc.
+// On Linux the name is truncated to 15 characters.
+// Returns false if not supported or failed.
+bool set_current_thread_name( std::string const & name );
+
+// Restricts the calling thread to the given set of logical CPUs.
+// An empty set is a no-op (and returns true).
+// Returns false if not supported or failed.
+bool set_current_thread_affinity( std::vector< int > const & cpus );
+
+// Lets the calling thread run on any CPU again, undoing set_current_thread_affinity().
+// Returns false if not supported or failed.
+bool reset_current_thread_affinity();
+
+// Switches the calling thread to a real-time (SCHED_FIFO) scheduling policy with the given priority, in the range
+// [1,99]. A priority of 0 is a no-op (and returns true).
+// This usually requires CAP_SYS_NICE or an appropriate RLIMIT_RTPRIO.
+// Returns false if not supported or failed.
+bool set_current_thread_realtime_priority( int priority );
+
+// Switches the calling thread back to the default (SCHED_OTHER) scheduling policy.
+// Returns false if not supported or failed.
+bool reset_current_thread_priority();
+
+// Parses a CPU list in the format used by the Linux kernel (cpuset, taskset -c, etc.): comma-separated CPU numbers
+// or inclusive ranges, e.g. "0-3,8,10-11".
+// Throws std::invalid_argument on bad syntax, or on CPUs above 1023 (more than any affinity can hold).
+std::vector< int > parse_cpu_list( std::string const & );
+
+
+}  // namespace os
+}  // namespace rsutils
@@ -0,0 +1,127 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <rsutils/concurrency/inline-dispatcher.h>
+#include <rsutils/easylogging/easyloggingpp.h>
+#include <rsutils/time/waiting-on.h>
+
+
+namespace rsutils {
+namespace concurrency {
+
+
+constexpr size_t inline_action::inline_size;
+
+
+inline_dispatcher::inline_dispatcher( unsigned int cap, std::function< void( action const & ) > on_drop_callback )
+    : _queue( cap, on_drop_callback )
+    , _was_stopped( true )
+    , _is_alive( true )
+{
+    // We keep a running thread that takes stuff off our queue and dispatches them
+    _thread = std::thread( [&]()
+    {
+        int timeout_ms = 5000;
+        action item;
+        while( _is_alive )
+        {
+            if( _wait_for_start( timeout_ms ) )
+            {
+                if( _queue.dequeue( &item, timeout_ms ) )
+                {
+                    cancellable_timer time( _was_stopped, _was_stopped_mutex, _was_stopped_cv );
+
+                    try
+                    {
+                        // While we're dispatching the item, we cannot stop!
+                        std::lock_guard< std::mutex > lock( _dispatch_mutex );
+                        item( time );
+                    }
+                    catch( const std::exception & e )
+                    {
+                        LOG_ERROR( "Dispatcher [" << this << "] exception caught: " << e.what() );
+                    }
+                    catch( ... )
+                    {
+                        LOG_ERROR( "Dispatcher [" << this << "] unknown exception caught!" );
+                    }
+                    // Release whatever the action captured now, rather than when the next one comes in
+                    item.reset();
+                }
+            }
+        }
+    } );
+}
+
+
+inline_dispatcher::~inline_dispatcher()
+{
+    // Don't get into any more dispatches
+    _is_alive = false;
+
+    // Stop whatever's in-progress, if any
+    stop();
+
+    // Wait until our worker thread quits
+    if( _thread.joinable() )
+        _thread.join();
+}
+
+
+void inline_dispatcher::start()
+{
+    {
+        std::lock_guard< std::mutex > lock( _was_stopped_mutex );
+        _was_stopped = false;
+    }
+    _queue.start();
+    // Wake up all threads that wait for the dispatcher to start
+    _was_stopped_cv.notify_all();
+}
+
+
+void inline_dispatcher::stop()
+{
+    // Don't accept any more incoming stuff, and get rid of anything pending
+    _queue.stop();
+
+    // Wait until any dispatched is done...
+    {
+        std::lock_guard< std::mutex > lock( _dispatch_mutex );
+    }
+    // Signal we've stopped so any sleeping dispatched will wake up immediately
+    {
+        std::lock_guard< std::mutex > lock( _was_stopped_mutex );
+        _was_stopped = true;
+    }
+    _was_stopped_cv.notify_all();
+}
+
+
+bool inline_dispatcher::flush( std::chrono::steady_clock::duration timeout )
+{
+    if( _was_stopped )
+        return true;  // Nothing to do - so success (no timeout)
+
+    rsutils::time::waiting_on< bool > invoked( _was_stopped_cv, _was_stopped_mutex, false );
+    auto invoked_in_thread = invoked.in_thread();
+    invoke( [invoked_in_thread]( cancellable_timer ) { invoked_in_thread.signal( true ); }, true );
+    invoked.wait_until( timeout, [&]() { return invoked || _was_stopped; } );
+    return invoked;
+}
+
+
+bool inline_dispatcher::_wait_for_start( int timeout_ms )
+{
+    // If the dispatcher is not started wait for a start event, if not such event within given timeout do nothing.
+    // If during the wait the thread destructor is called (_is_alive = false) do nothing as well.
+    std::unique_lock< std::mutex > lock( _was_stopped_mutex );
+    return _was_stopped_cv.wait_for( lock,
+                                     std::chrono::milliseconds( timeout_ms ),
+                                     [this]() { return ! _was_stopped.load() || ! _is_alive; } )
+        && _is_alive;
+}
+
+
+}  // namespace concurrency
+}  // namespace rsutils
@@ -0,0 +1,141 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <rsutils/os/thread.h>
+
+#include <stdexcept>
+#include <cstdlib>
+
+#if defined( __linux__ ) && ! defined( __ANDROID__ )
+#include <pthread.h>
+#include <sched.h>
+#define RSUTILS_LINUX_THREADS
+#elif defined( __APPLE__ )
+#include <pthread.h>
+#endif
+
+
+namespace rsutils {
+namespace os {
+
+
+// The highest CPU number a cpu_set_t can hold (CPU_SETSIZE on Linux); no affinity can name a higher one
+static long const max_cpu = 1023;
+
+
+bool set_current_thread_name( std::string const & name )
+{
+#if defined( RSUTILS_LINUX_THREADS )
+    // Linux limits the name to 16 bytes, including the terminator
+    return 0 == pthread_setname_np( pthread_self(), name.substr( 0, 15 ).c_str() );
+#elif defined( __APPLE__ )
+    return 0 == pthread_setname_np( name.c_str() );
+#else
+    return false;
+#endif
+}
+
+
+bool set_current_thread_affinity( std::vector< int > const & cpus )
+{
+    if( cpus.empty() )
+        return true;
+#if defined( RSUTILS_LINUX_THREADS )
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    for( int cpu : cpus )
+    {
+        if( cpu < 0 || cpu >= CPU_SETSIZE )
+            return false;
+        CPU_SET( cpu, &set );
+    }
+    return 0 == pthread_setaffinity_np( pthread_self(), sizeof( set ), &set );
+#else
+    return false;
+#endif
+}
+
+
+bool reset_current_thread_affinity()
+{
+#if defined( RSUTILS_LINUX_THREADS )
+    // CPUs that do not exist (or that the process may not use) are ignored by the kernel
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    for( int cpu = 0; cpu < CPU_SETSIZE; ++cpu )
+        CPU_SET( cpu, &set );
+    return 0 == pthread_setaffinity_np( pthread_self(), sizeof( set ), &set );
+#else
+    return false;
+#endif
+}
+
+
+bool set_current_thread_realtime_priority( int priority )
+{
+    if( ! priority )
+        return true;
+#if defined( RSUTILS_LINUX_THREADS )
+    sched_param param = {};
+    param.sched_priority = priority;
+    return 0 == pthread_setschedparam( pthread_self(), SCHED_FIFO, &param );
+#else
+    return false;
+#endif
+}
+
+
+bool reset_current_thread_priority()
+{
+#if defined( RSUTILS_LINUX_THREADS )
+    sched_param param = {};
+    return 0 == pthread_setschedparam( pthread_self(), SCHED_OTHER, &param );
+#else
+    return false;
+#endif
+}
+
+
+std::vector< int > parse_cpu_list( std::string const & str )
+{
+    std::vector< int > cpus;
+    char const * p = str.c_str();
+    auto parse_number = [&]() -> int
+    {
+        char * end;
+        auto n = std::strtol( p, &end, 10 );
+        if( end == p || n < 0 )
+            throw std::invalid_argument( "invalid CPU list '" + str + "'" );
+        if( n > max_cpu )  // including strtol overflow
+            throw std::invalid_argument( "CPU out of range in '" + str + "'" );
+        p = end;
+        return int( n );
+    };
+    while( *p )
+    {
+        int first = parse_number();
+        int last = first;
+        if( *p == '-' )
+        {
+            ++p;
+            last = parse_number();
+            if( last < first )
+                throw std::invalid_argument( "invalid CPU range in '" + str + "'" );
+        }
+        for( int cpu = first; cpu <= last; ++cpu )
+            cpus.push_back( cpu );
+        if( *p == ',' )
+        {
+            ++p;
+            if( ! *p )
+                throw std::invalid_argument( "invalid CPU list '" + str + "'" );
+        }
+        else if( *p )
+            throw std::invalid_argument( "invalid CPU list '" + str + "'" );
+    }
+    return cpus;
+}
+
+
+}  // namespace os
+}  // namespace rsutils
@@ -0,0 +1,122 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+#include <rsutils/concurrency/worker-pool.h>
+
+#include <algorithm>
+#include <exception>
+
+
+namespace rsutils {
+namespace concurrency {
+
+
+worker_pool::worker_pool( unsigned n_workers )
+{
+    _workers.reserve( n_workers );
+    for( unsigned i = 0; i < n_workers; ++i )
+        _workers.emplace_back(
+            [this]()
+            {
+                std::unique_lock< std::mutex > lock( _mutex );
+                while( true )
+                {
+                    _task_cv.wait( lock, [this]() { return _stopping || ! _tasks.empty(); } );
+                    if( _stopping )
+                        break;
+                    run_one( lock );
+                }
+            } );
+}
+
+
+worker_pool::~worker_pool()
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _stopping = true;
+    }
+    _task_cv.notify_all();
+    for( auto & worker : _workers )
+        worker.join();
+}
+
+
+// Run the next pending task, if any; the lock is released while it runs
+//
+bool worker_pool::run_one( std::unique_lock< std::mutex > & lock )
+{
+    if( _tasks.empty() )
+        return false;
+    auto task = std::move( _tasks.front() );
+    _tasks.pop_front();
+    lock.unlock();
+    task();
+    lock.lock();
+    return true;
+}
+
+
+void worker_pool::parallel_for( size_t n, size_t min_chunk, std::function< void( size_t, size_t ) > const & fn )
+{
+    if( ! n )
+        return;
+    min_chunk = std::max< size_t >( min_chunk, 1 );
+    size_t n_chunks = std::min( concurrency(), ( n + min_chunk - 1 ) / min_chunk );
+    if( n_chunks <= 1 )
+    {
+        fn( 0, n );
+        return;
+    }
+
+    size_t const chunk = ( n + n_chunks - 1 ) / n_chunks;
+    n_chunks = ( n + chunk - 1 ) / chunk;
+
+    // All tasks of this call share the completion state, which lives on our stack; we don't return until it's unused
+    size_t remaining = n_chunks;
+    std::exception_ptr error;
+    auto run_chunk = [&]( size_t begin )
+    {
+        std::exception_ptr e;
+        try
+        {
+            fn( begin, std::min( begin + chunk, n ) );
+        }
+        catch( ... )
+        {
+            e = std::current_exception();
+        }
+        std::lock_guard< std::mutex > lock( _mutex );
+        if( e && ! error )
+            error = e;
+        if( ! --remaining )
+            _done_cv.notify_all();
+    };
+
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        for( size_t i = 1; i < n_chunks; ++i )
+            _tasks.emplace_back( [&run_chunk, i, chunk]() { run_chunk( i * chunk ); } );
+    }
+    _task_cv.notify_all();
+
+    // The caller does the first chunk, then helps with whatever is still pending rather than just wait
+    run_chunk( 0 );
+    std::unique_lock< std::mutex > lock( _mutex );
+    while( remaining )
+        if( ! run_one( lock ) )
+            _done_cv.wait( lock, [&]() { return ! remaining || ! _tasks.empty(); } );
+    if( error )
+        std::rethrow_exception( error );
+}
+
+
+/*static*/ worker_pool & worker_pool::shared()
+{
+    static worker_pool the_pool( std::max( 1u, std::thread::hardware_concurrency() ) - 1 );
+    return the_pool;
+}
+
+
+}  // namespace concurrency
+}  // namespace rsutils
@@ -6,6 +6,7 @@
 #include <rsutils/json.h>
 #include <vector>
 #include <map>
+#include <set>
 #include <string>
 #include <cstring>
 #include <iostream>
@@ -224,6 +225,133 @@ bool is_mipi_device( const rs2::device & dev )
     return d457_device && usb_type.compare( "unknown" ) == 0;
 }
 
+// Updates all connected devices, including those in recovery mode, at the same time: no more than 'jobs' at once (0 for
+// all of them)
+int update_all( rs2::context & ctx, const std::vector< uint8_t > & fw_image, int jobs, bool only_sw_devs )
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::map< std::string, rs2::update_device > update_devices;  // by update serial number
+    std::set< std::string > expected;
+
+    ctx.set_devices_changed_callback( [&]( rs2::event_information & info )
+    {
+        std::lock_guard< std::mutex > lk( mutex );
+        for( auto && d : info.get_new_devices() )
+            if( d.is< rs2::update_device >() && d.supports( RS2_CAMERA_INFO_FIRMWARE_UPDATE_ID ) )
+                update_devices[d.get_info( RS2_CAMERA_INFO_FIRMWARE_UPDATE_ID )] = d;
+        cv.notify_one();
+    } );
+
+    for( auto && d : query_devices( ctx, only_sw_devs ) )
+    {
+        if( ! d.supports( RS2_CAMERA_INFO_FIRMWARE_UPDATE_ID ) )
+            continue;
+        std::string sn = d.get_info( RS2_CAMERA_INFO_FIRMWARE_UPDATE_ID );
+        if( d.is< rs2::updatable >() )
+        {
+            if( is_mipi_device( d ) )
+            {
+                std::cout << std::endl << "Skipping MIPI device " << sn << ": update it on its own" << std::endl;
+                continue;
+            }
+            if( ! d.as< rs2::updatable >().check_firmware_compatibility( fw_image ) )
+            {
+                std::cout << std::endl << "Skipping " << sn << ": this firmware version is not compatible with "
+                          << d.get_info( RS2_CAMERA_INFO_NAME ) << std::endl;
+                continue;
+            }
+            std::cout << std::endl << "Updating device FW: " << std::endl;
+            print_device_info( d );
+            d.as< rs2::updatable >().enter_update_state();
+        }
+        else if( ! d.is< rs2::update_device >() )
+            continue;
+        else
+        {
+            std::cout << std::endl << "Recovering device: " << std::endl;
+            print_device_info( d );
+        }
+
+        std::lock_guard< std::mutex > lk( mutex );
+        // Some devices may immediately get in an update state
+        if( d.is< rs2::update_device >() )
+            update_devices[sn] = d;
+        expected.insert( sn );
+    }
+
+    if( expected.empty() )
+    {
+        std::cout << std::endl << "No devices to update were found" << std::endl << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector< rs2::update_device > devices;
+    std::vector< std::string > serials;
+    {
+        std::unique_lock< std::mutex > lk( mutex );
+        auto all_found = [&]
+        {
+            for( auto & sn : expected )
+                if( ! update_devices.count( sn ) )
+                    return false;
+            return true;
+        };
+        if( ! cv.wait_for( lk, std::chrono::seconds( WAIT_FOR_DEVICE_TIMEOUT ), all_found ) )
+            std::cout << std::endl << "Failed to locate some devices in FW update mode" << std::endl;
+        for( auto & sn : expected )
+        {
+            auto it = update_devices.find( sn );
+            if( it == update_devices.end() )
+                std::cout << "    " << sn << ": not found" << std::endl;
+            else
+            {
+                devices.push_back( it->second );
+                serials.push_back( sn );
+            }
+        }
+    }
+
+    std::cout << std::endl << "Firmware update of " << devices.size() << " devices started";
+    if( jobs > 0 )
+        std::cout << ", " << jobs << " at a time";
+    std::cout << ". Please don't disconnect them!" << std::endl << std::endl;
+
+    bool const show_progress = ISATTY( FILENO( stdout ) );
+    std::vector< int > percents( devices.size(), 0 );
+    auto errors = rs2::update_firmware(
+        devices,
+        fw_image,
+        [&]( int i, float progress )
+        {
+            int percent = int( progress * 100 );
+            if( ! show_progress || percent == percents[i] )
+                return;
+            percents[i] = percent;
+            std::cout << "\r";
+            for( size_t j = 0; j < percents.size(); ++j )
+                std::cout << serials[j] << ": " << percents[j] << "[%]  ";
+            std::cout << std::flush;
+        },
+        jobs );
+
+    std::cout << std::endl << std::endl;
+    size_t failures = expected.size() - devices.size();
+    for( size_t i = 0; i < devices.size(); ++i )
+    {
+        if( errors[i].empty() )
+            std::cout << "Device " << serials[i] << ": firmware update done" << std::endl;
+        else
+        {
+            std::cout << "Device " << serials[i] << ": firmware update failed: " << errors[i] << std::endl;
+            ++failures;
+        }
+    }
+
+    ctx.set_devices_changed_callback( []( rs2::event_information & ) {} );
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
 int main( int argc, char ** argv )
 try
 {
@@ -246,6 +374,8 @@ try
     ValueArg<std::string> file_arg("f", "file", "Path of the firmware image file", false, "", "string");
     ValueArg<std::string> serial_number_arg("s", "serial_number", "The serial number of the device to be update, this is mandetory if more than one device is connected", false, "", "string");
     SwitchArg only_sw_arg( "", "sw-only", "Show only software devices (playback, DDS, etc. -- but not USB/HID/etc.)" );
+    SwitchArg all_arg( "a", "all", "Update all connected devices, including those in recovery mode, at the same time (signed firmware only)" );
+    ValueArg< int > jobs_arg( "j", "jobs", "With --all, the maximum number of devices to update at once (default: all of them)", false, 0, "int" );
 
     cmd.add(debug_arg);
     cmd.add(list_devices_arg);
@@ -255,6 +385,8 @@ try
     cmd.add(serial_number_arg);
     cmd.add(backup_arg);
     cmd.add(only_sw_arg);
+    cmd.add(all_arg);
+    cmd.add(jobs_arg);
 #ifdef BUILD_WITH_DDS
     ValueArg< int > domain_arg( "", "dds-domain", "Set the DDS domain ID (default to 0)", false, 0, "0-232" );
     cmd.add( domain_arg );
@@ -309,6 +441,19 @@ try
 
     std::string update_serial_number;
 
+    // Update (or recover) all devices at once
+    if( all_arg.isSet() )
+    {
+        if( unsigned_arg.isSet() || backup_arg.isSet() || serial_number_arg.isSet() )
+        {
+            std::cout << std::endl << "--all cannot be combined with -u, -b, or -s" << std::endl << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::vector< uint8_t > fw_image = read_firmware_data( file_arg.isSet(), file_arg.getValue() );
+        std::cout << std::endl << "Update to FW: " << file_arg.getValue() << std::endl;
+        return update_all( ctx, fw_image, jobs_arg.getValue(), only_sw_arg.getValue() );
+    }
+
     // Recovery
     if (recover_arg.isSet() )
     {
@@ -0,0 +1,189 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#cmake:add-file ../../../src/proc/align-remap.cpp
+//#cmake:add-file ../../../src/proc/align-remap-avx.cpp
+
+#include "../algo-common.h"
+#include <src/proc/align-remap.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+int const W = 37, H = 23;  // odd sizes, so no row is a multiple of the SIMD width
+
+
+std::vector< uint8_t > make_image( int bpp )
+{
+    std::vector< uint8_t > image( W * H * bpp );
+    for( size_t i = 0; i < image.size(); ++i )
+        image[i] = uint8_t( i * 7 + i / 5 );
+    return image;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "remap nearest", "[align]" )
+{
+    // Include the first and last pixels, which SIMD reads cannot run past
+    std::vector< int32_t > index;
+    for( int i = 0; i < 101; ++i )
+        index.push_back( i % 9 == 4 ? -1 : ( i * 131 ) % ( W * H ) );
+    index.push_back( 0 );
+    index.push_back( W * H - 1 );
+
+    for( int bpp = 1; bpp <= 6; ++bpp )
+    {
+        auto const image = make_image( bpp );
+        std::vector< uint8_t > out( index.size() * bpp, 0xcd );
+        remap_nearest( image.data(), image.size(), bpp, index.data(), out.data(), index.size() );
+
+        for( size_t i = 0; i < index.size(); ++i )
+            for( int b = 0; b < bpp; ++b )
+            {
+                auto const expected = index[i] < 0 ? 0 : image[index[i] * bpp + b];
+                CHECK( out[i * bpp + b] == expected );
+            }
+    }
+}
+
+
+TEST_CASE( "remap bilinear", "[align]" )
+{
+    // A linear gradient interpolates to the value at the position
+    auto value = []( float u, float v, int c ) { return 10.f + 2.f * u + 3.f * v + 20.f * c; };
+    std::vector< float2 > position;
+    for( int i = 0; i < 50; ++i )
+        position.push_back( { ( i * 0.73f ) - 0.5f + 0.01f, float( i % H ) * 0.9f } );
+    position.push_back( { W - 1.f, H - 1.f } );
+    position.push_back( { -1.f, 2.f } );        // outside
+    position.push_back( { 2.f, H - 0.4f } );    // outside
+
+    for( int channels = 1; channels <= 4; ++channels )
+    {
+        std::vector< uint8_t > image( W * H * channels );
+        for( int y = 0; y < H; ++y )
+            for( int x = 0; x < W; ++x )
+                for( int c = 0; c < channels; ++c )
+                    image[( y * W + x ) * channels + c] = uint8_t( value( float( x ), float( y ), c ) + 0.5f );
+
+        std::vector< uint8_t > out( position.size() * channels, 0xcd );
+        remap_bilinear( image.data(), W, H, channels, 8, position.data(), out.data(), position.size() );
+
+        for( size_t i = 0; i < position.size(); ++i )
+        {
+            auto const & p = position[i];
+            bool const inside = p.x >= -0.5f && p.x < W - 0.5f && p.y >= -0.5f && p.y < H - 0.5f;
+            for( int c = 0; c < channels; ++c )
+            {
+                float const expected = inside ? value( std::max( p.x, 0.f ), std::max( p.y, 0.f ), c ) : 0.f;
+                CHECK( std::abs( out[i * channels + c] - expected ) <= 1.f );
+            }
+        }
+    }
+
+    // 16-bit channels
+    std::vector< uint16_t > wide( W * H );
+    for( int y = 0; y < H; ++y )
+        for( int x = 0; x < W; ++x )
+            wide[y * W + x] = uint16_t( 1000 + 300 * x + 500 * y );
+    std::vector< uint16_t > out( position.size() );
+    remap_bilinear( reinterpret_cast< const uint8_t * >( wide.data() ), W, H, 2, 16, position.data(),
+                    reinterpret_cast< uint8_t * >( out.data() ), position.size() );
+    for( size_t i = 0; i + 3 < position.size(); ++i )
+    {
+        auto const & p = position[i];
+        float const expected = 1000 + 300 * std::max( p.x, 0.f ) + 500 * std::max( p.y, 0.f );
+        CHECK( std::abs( out[i] - expected ) <= 1.f );
+    }
+    CHECK( out[position.size() - 1] == 0 );
+}
+
+
+TEST_CASE( "other to depth map is kept while depth does not change", "[align]" )
+{
+    std::vector< uint16_t > depth( 64, 1000 );
+    other_to_depth_map map;
+    CHECK( map.update( depth.data(), depth.size(), 0.001f, align_nearest, RS2_FORMAT_RGB8 ) );
+    CHECK( map.index.size() == depth.size() );
+    CHECK_FALSE( map.update( depth.data(), depth.size(), 0.001f, align_nearest, RS2_FORMAT_RGB8 ) );
+    CHECK( map.changed_blocks().empty() );
+
+    // Only the blocks where depth changed are computed again
+    depth[17] = 1001;
+    CHECK_FALSE( map.update( depth.data(), depth.size(), 0.001f, align_nearest, RS2_FORMAT_RGB8 ) );
+    CHECK( map.changed_blocks() == std::vector< uint32_t >{ 2 } );
+    CHECK_FALSE( map.update( depth.data(), depth.size(), 0.001f, align_nearest, RS2_FORMAT_RGB8 ) );
+    CHECK( map.changed_blocks().empty() );
+
+    // A change of depth units or interpolation needs the whole map, but interpolation only for formats that can be
+    // interpolated
+    CHECK( map.update( depth.data(), depth.size(), 0.0001f, align_nearest, RS2_FORMAT_RGB8 ) );
+    CHECK( map.update( depth.data(), depth.size(), 0.001f, align_nearest, RS2_FORMAT_RGB8 ) );
+    CHECK_FALSE( map.update( depth.data(), depth.size(), 0.001f, align_bilinear, RS2_FORMAT_YUYV ) );
+    CHECK( map.interpolation() == align_nearest );
+    CHECK( map.update( depth.data(), depth.size(), 0.001f, align_bilinear, RS2_FORMAT_RGB8 ) );
+    CHECK( map.interpolation() == align_bilinear );
+    CHECK( map.position.size() == depth.size() );
+
+    map.invalidate();
+    CHECK( map.update( depth.data(), depth.size(), 0.001f, align_bilinear, RS2_FORMAT_RGB8 ) );
+}
+
+
+TEST_CASE( "depth change tracker", "[align]" )
+{
+    size_t const N = 8 * 20 + 3;  // a partial block at the end
+    std::vector< uint16_t > depth( N, 1000 );
+    depth_change_tracker tracker;
+    CHECK( tracker.update( depth.data(), N, 5 ) );  // the first frame is computed whole
+    CHECK_FALSE( tracker.update( depth.data(), N, 5 ) );
+    CHECK( tracker.changed_blocks().empty() );
+
+    // Changes up to the threshold are ignored, but accumulate against the reference
+    depth[10] = 1005;
+    CHECK_FALSE( tracker.update( depth.data(), N, 5 ) );
+    CHECK( tracker.changed_blocks().empty() );
+    depth[10] = 1006;
+    CHECK_FALSE( tracker.update( depth.data(), N, 5 ) );
+    CHECK( tracker.changed_blocks() == std::vector< uint32_t >{ 1 } );
+    depth[10] = 1003;  // now compared to 1006
+    CHECK_FALSE( tracker.update( depth.data(), N, 5 ) );
+    CHECK( tracker.changed_blocks().empty() );
+
+    // Gaining or losing depth always counts, as do changes in the last, partial block
+    depth[17] = 0;
+    depth[40] = 994;
+    depth[N - 1] = 2000;
+    CHECK_FALSE( tracker.update( depth.data(), N, 5 ) );
+    CHECK( tracker.changed_blocks() == std::vector< uint32_t >{ 2, 5, 20 } );
+    depth[17] = 1;
+    CHECK_FALSE( tracker.update( depth.data(), N, 5 ) );
+    CHECK( tracker.changed_blocks() == std::vector< uint32_t >{ 2 } );
+
+    // With a threshold of 0, any change counts: so does the pixel left 3 away from its reference
+    depth[100] += 1;
+    CHECK_FALSE( tracker.update( depth.data(), N, 0 ) );
+    CHECK( tracker.changed_blocks() == std::vector< uint32_t >{ 1, 12 } );
+
+    // When most blocks change, everything is computed again
+    for( size_t i = 0; i < N; i += 2 )
+        depth[i] += 100;
+    CHECK( tracker.update( depth.data(), N, 5 ) );
+    CHECK_FALSE( tracker.update( depth.data(), N, 5 ) );
+    CHECK( tracker.changed_blocks().empty() );
+
+    // As when the size changes
+    CHECK( tracker.update( depth.data(), N - 1, 5 ) );
+}
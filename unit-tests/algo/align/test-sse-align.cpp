@@ -0,0 +1,60 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#cmake:add-file ../../../src/proc/align-remap.cpp
+//#cmake:add-file ../../../src/proc/align-remap-avx.cpp
+
+// The SSE aligner maps depth pixels 8 at a time: mapping only the blocks where depth changed must give the same map as
+// mapping the whole image, including the last block when the image is not a multiple of 8 pixels.
+
+#include "../algo-common.h"
+#include <src/proc/sse/sse-align.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace librealsense;
+
+
+#ifdef __SSSE3__
+
+TEST_CASE( "SSE align maps only changed blocks", "[align]" )
+{
+    int const W = 61, H = 47;  // 2867 pixels: the last block has 3
+    rs2_intrinsics const depth_intrin = { W, H, 30.f, 23.f, 50, 50, RS2_DISTORTION_NONE, { 0 } };
+    rs2_intrinsics const other_intrin = { 80, 60, 41.f, 29.f, 70, 70, RS2_DISTORTION_MODIFIED_BROWN_CONRADY, { 0.05f, 0, 0, 0, 0 } };
+    rs2_extrinsics const extrin = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0.015f, 0.f, 0.001f } };
+
+    std::vector< uint16_t > depth( W * H );
+    for( int y = 0; y < H; ++y )
+        for( int x = 0; x < W; ++x )
+            depth[y * W + x] = ( x % 7 && y % 5 ) ? uint16_t( 1000 + 4 * x + 2 * y ) : 0;
+
+    image_transform transform( depth_intrin, 0.001f );
+    transform.pre_compute_x_y_map_corners();
+    for( auto interpolation : { align_nearest, align_bilinear } )
+    {
+        other_to_depth_map map, full;
+        REQUIRE( map.update( depth.data(), depth.size(), 0.001f, interpolation, RS2_FORMAT_RGB8 ) );
+        transform.map_other_to_depth( depth.data(), other_intrin, extrin, map, true );
+
+        // Some blocks change, the last one among them
+        auto changed = depth;
+        for( int k = 0; k < 50; ++k )
+            changed[( k * 97 ) % changed.size()] += 300;
+        changed.back() += 300;
+        REQUIRE_FALSE( map.update( changed.data(), changed.size(), 0.001f, interpolation, RS2_FORMAT_RGB8 ) );
+        REQUIRE( map.changed_blocks().back() == changed.size() / depth_change_tracker::block_size );
+        transform.map_other_to_depth( changed.data(), other_intrin, extrin, map, false );
+
+        full.update( changed.data(), changed.size(), 0.001f, interpolation, RS2_FORMAT_RGB8 );
+        transform.map_other_to_depth( changed.data(), other_intrin, extrin, full, true );
+        if( interpolation == align_bilinear )
+            CHECK( std::memcmp( map.position.data(), full.position.data(), changed.size() * sizeof( map.position[0] ) ) == 0 );
+        else
+            CHECK( map.index == full.index );
+    }
+}
+
+#endif
@@ -0,0 +1,154 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#cmake:add-file ../../../src/proc/color-formats-converter.cpp
+
+// Large YUY2, UYVY and M420 frames are converted in bands of rows on a worker pool: the result must not depend on how
+// many threads the bands run on. The benchmark (tagged [benchmark], not run by default) compares resolutions and
+// thread counts.
+
+#include "../algo-common.h"
+#include <src/proc/color-formats-converter.h>
+#include <rsutils/concurrency/worker-pool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace librealsense;
+using rsutils::concurrency::worker_pool;
+
+
+namespace {
+
+
+typedef std::function< void( uint8_t * const d[], const uint8_t * s, int w, int h, worker_pool * ) > converter;
+
+
+struct source_format
+{
+    const char * name;
+    int bytes_per_2_lines;  // per pixel of width
+    converter convert;
+};
+
+
+source_format yuy2( rs2_format target )
+{
+    return { "YUY2", 4, [target]( uint8_t * const d[], const uint8_t * s, int w, int h, worker_pool * pool ) {
+                unpack_yuy2( target, RS2_STREAM_COLOR, d, s, w, h, w * h * 2, pool );
+            } };
+}
+
+source_format uyvy( rs2_format target )
+{
+    return { "UYVY", 4, [target]( uint8_t * const d[], const uint8_t * s, int w, int h, worker_pool * pool ) {
+                unpack_uyvyc( target, RS2_STREAM_COLOR, d, s, w, h, w * h * 2, pool );
+            } };
+}
+
+source_format m420( rs2_format target )
+{
+    return { "M420", 3, [target]( uint8_t * const d[], const uint8_t * s, int w, int h, worker_pool * pool ) {
+                unpack_m420( target, RS2_STREAM_COLOR, d, s, w, h, w * h * 3 / 2, pool );
+            } };
+}
+
+
+int bytes_per_pixel( rs2_format format )
+{
+    switch( format )
+    {
+    case RS2_FORMAT_Y8: return 1;
+    case RS2_FORMAT_Y16: return 2;
+    case RS2_FORMAT_RGB8:
+    case RS2_FORMAT_BGR8: return 3;
+    default: return 4;
+    }
+}
+
+
+std::vector< uint8_t > convert( source_format const & from, int bpp, std::vector< uint8_t > const & source, int w,
+                                int h, worker_pool & pool )
+{
+    // Sentinel bytes past the end catch bands that write beyond their rows
+    std::vector< uint8_t > out( w * h * bpp + 64, 0xcd );
+    uint8_t * const dest[] = { out.data() };
+    from.convert( dest, source.data(), w, h, &pool );
+    return out;
+}
+
+
+// The SIMD loads of M420 UV lines are aligned
+std::vector< uint8_t > make_source( source_format const & from, int w, int h )
+{
+    std::vector< uint8_t > source( w * h / 2 * from.bytes_per_2_lines + 64 );
+    for( size_t i = 0; i < source.size(); ++i )
+        source[i] = uint8_t( i * 13 + i / 7 );
+    return source;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "color bands match single-threaded conversion", "[color]" )
+{
+    worker_pool single( 0 );
+    worker_pool several( 3 );
+
+    // 848 pixels wide is not a multiple of 32, so bands are pairs of lines; 424x240 is converted in one piece
+    for( auto const & size : { std::make_pair( 1280, 720 ), std::make_pair( 848, 480 ), std::make_pair( 640, 480 ),
+                               std::make_pair( 424, 240 ) } )
+    {
+        int const w = size.first, h = size.second;
+        for( auto target : { RS2_FORMAT_Y8, RS2_FORMAT_Y16, RS2_FORMAT_RGB8, RS2_FORMAT_BGRA8 } )
+            for( auto const & from : { yuy2( target ), uyvy( target ), m420( target ) } )
+            {
+                if( std::string( from.name ) == "UYVY" && bytes_per_pixel( target ) < 3 )
+                    continue;  // UYVY converts to color only
+                CAPTURE( from.name, w, h, target );
+                auto const source = make_source( from, w, h );
+                auto const expected = convert( from, bytes_per_pixel( target ), source, w, h, single );
+                auto const actual = convert( from, bytes_per_pixel( target ), source, w, h, several );
+                CHECK( expected == actual );
+            }
+    }
+}
+
+
+TEST_CASE( "color bands benchmark", "[.][benchmark]" )
+{
+    unsigned const cores = std::max( 1u, std::thread::hardware_concurrency() );
+    std::vector< unsigned > thread_counts{ 1, 2, 4, cores };
+    std::sort( thread_counts.begin(), thread_counts.end() );
+    thread_counts.erase( std::unique( thread_counts.begin(), thread_counts.end() ), thread_counts.end() );
+
+    for( auto const & size : { std::make_pair( 640, 480 ), std::make_pair( 1280, 720 ), std::make_pair( 1920, 1080 ) } )
+    {
+        int const w = size.first, h = size.second;
+        for( auto const & from : { yuy2( RS2_FORMAT_RGB8 ), uyvy( RS2_FORMAT_RGB8 ), m420( RS2_FORMAT_RGB8 ) } )
+        {
+            auto const source = make_source( from, w, h );
+            std::cout << from.name << " to RGB8 " << w << "x" << h << ":";
+            for( auto threads : thread_counts )
+            {
+                worker_pool pool( threads - 1 );
+                std::vector< uint8_t > out( w * h * 3 );
+                uint8_t * const dest[] = { out.data() };
+                int const frames = 100;
+                auto const start = std::chrono::steady_clock::now();
+                for( int i = 0; i < frames; ++i )
+                    from.convert( dest, source.data(), w, h, &pool );
+                auto const usec = std::chrono::duration< double, std::micro >( std::chrono::steady_clock::now() - start ).count();
+                std::cout << "  " << threads << " thread(s) " << usec / frames << " usec";
+            }
+            std::cout << std::endl;
+        }
+    }
+}
@@ -0,0 +1,121 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#cmake:add-file ../../../src/proc/depth-statistics.cpp
+
+#include "../algo-common.h"
+#include <src/proc/depth-statistics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+float const UNITS = 0.001f;
+
+
+// The statistics of the pixels in [x0,x1) x [y0,y1), the slow way
+struct reference
+{
+    std::vector< uint16_t > valid;
+    double sum = 0;
+
+    reference( const std::vector< uint16_t > & depth, int stride, int x0, int y0, int x1, int y1 )
+    {
+        for( int y = y0; y < y1; ++y )
+            for( int x = x0; x < x1; ++x )
+                if( auto d = depth[y * stride + x] )
+                {
+                    valid.push_back( d );
+                    sum += d;
+                }
+        std::sort( valid.begin(), valid.end() );
+    }
+
+    float percentile( double p ) const
+    {
+        auto rank = std::max< size_t >( 1, size_t( std::ceil( p * valid.size() ) ) );
+        return valid[rank - 1] * UNITS;
+    }
+
+    float mean() const { return valid.empty() ? 0.f : float( sum / valid.size() * UNITS ); }
+};
+
+
+}  // namespace
+
+
+TEST_CASE( "depth statistics", "[depth-statistics]" )
+{
+    // Odd sizes and a padded stride, so the SIMD remainders and the pixels outside the region are exercised
+    int const W = 101, H = 37, STRIDE = 104;
+    std::vector< uint16_t > depth( STRIDE * H );
+    for( int y = 0; y < H; ++y )
+        for( int x = 0; x < STRIDE; ++x )
+            depth[y * STRIDE + x] = ( x * 7 + y * 3 ) % 11 ? uint16_t( 500 + ( x * 37 + y * 91 ) % 4000 ) : 0;
+    depth[5 * STRIDE + 30] = 0xffff;
+
+    std::vector< uint32_t > histogram;
+    for( auto const & roi : { pixel_roi{ 0, 0, W, H }, pixel_roi{ 13, 4, 90, 33 } } )
+    {
+        std::vector< uint16_t > copy( depth.size(), 0 );
+        frame_depth_statistics statistics;
+        compute_depth_statistics( depth.data(), W, H, STRIDE * 2, roi, 3, 2, UNITS, copy.data(), histogram,
+                                  statistics );
+
+        // The whole image is copied, region or not
+        for( int y = 0; y < H; ++y )
+            CHECK( std::equal( depth.begin() + y * STRIDE, depth.begin() + y * STRIDE + W, copy.begin() + y * STRIDE ) );
+
+        reference all( depth, STRIDE, roi.min_x, roi.min_y, roi.max_x, roi.max_y );
+        auto const & s = statistics.summary;
+        CHECK( s.total_pixels == roi.width() * roi.height() );
+        CHECK( s.valid_pixels == int( all.valid.size() ) );
+        CHECK( s.valid_fraction == approx( float( all.valid.size() ) / s.total_pixels ) );
+        CHECK( s.min == all.valid.front() * UNITS );
+        CHECK( s.max == all.valid.back() * UNITS );
+        CHECK( s.mean == approx( all.mean() ) );
+        CHECK( s.percentile_5 == all.percentile( .05 ) );
+        CHECK( s.percentile_25 == all.percentile( .25 ) );
+        CHECK( s.median == all.percentile( .5 ) );
+        CHECK( s.percentile_75 == all.percentile( .75 ) );
+        CHECK( s.percentile_95 == all.percentile( .95 ) );
+
+        REQUIRE( s.grid_columns == 3 );
+        REQUIRE( s.grid_rows == 2 );
+        REQUIRE( statistics.region_means.size() == 6 );
+        for( int r = 0; r < 2; ++r )
+            for( int c = 0; c < 3; ++c )
+            {
+                reference region( depth, STRIDE, roi.min_x + c * roi.width() / 3, roi.min_y + r * roi.height() / 2,
+                                  roi.min_x + ( c + 1 ) * roi.width() / 3, roi.min_y + ( r + 1 ) * roi.height() / 2 );
+                CHECK( statistics.region_means[r * 3 + c] == approx( region.mean() ) );
+            }
+    }
+}
+
+
+TEST_CASE( "depth statistics without depth", "[depth-statistics]" )
+{
+    std::vector< uint16_t > depth( 64 * 8, 0 ), copy( depth.size() );
+    std::vector< uint32_t > histogram;
+    frame_depth_statistics statistics;
+
+    // More grid cells than pixels are limited to one per pixel
+    compute_depth_statistics( depth.data(), 64, 8, 128, pixel_roi{ 10, 2, 14, 3 }, 8, 8, UNITS, copy.data(),
+                              histogram, statistics );
+    auto const & s = statistics.summary;
+    CHECK( s.total_pixels == 4 );
+    CHECK( s.valid_pixels == 0 );
+    CHECK( s.valid_fraction == 0.f );
+    CHECK( s.median == 0.f );
+    CHECK( s.grid_columns == 4 );
+    CHECK( s.grid_rows == 1 );
+    CHECK( statistics.region_means == std::vector< float >( 4, 0.f ) );
+}
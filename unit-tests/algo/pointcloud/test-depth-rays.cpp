@@ -0,0 +1,71 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#cmake:add-file ../../../src/proc/batch-projection.cpp
+//#cmake:add-file ../../../src/proc/depth-rays.cpp
+
+#include "../algo-common.h"
+#include <librealsense2/rsutil.h>
+#include <src/proc/depth-rays.h>
+
+using librealsense::float3;
+
+
+static rs2_intrinsics make_intrin()
+{
+    return { 640,
+             480,
+             321.86f,
+             238.91f,
+             452.08f,
+             452.58f,
+             RS2_DISTORTION_BROWN_CONRADY,
+             { 0.180086836f, -0.534179211f, -0.00139013783f, 0.000118769123f, 0.470662683f } };
+}
+
+// A ray-table deprojection must match deprojecting, then transforming, each pixel on its own
+TEST_CASE( "rays match deproject + transform", "[depth-rays]" )
+{
+    auto const intrin = make_intrin();
+    float const units = 0.001f;
+    rs2_extrinsics const ex = { { 0.99f, 0.141067f, 0.f, -0.141067f, 0.99f, 0.f, 0.f, 0.f, 1.f }, { 0.05f, -0.1f, 0.2f } };
+
+    librealsense::depth_rays rays;
+    REQUIRE( rays.update( intrin, units, ex ) );
+    REQUIRE_FALSE( rays.update( intrin, units, ex ) );  // nothing changed
+
+    for( int y = 0; y < intrin.height; y += 7 )
+        for( int x = 0; x < intrin.width; x += 5 )
+        {
+            uint16_t const d = uint16_t( 300 + x + y );
+            float const pixel[] = { float( x ), float( y ) };
+            float point[3], expected[3];
+            rs2_deproject_pixel_to_point( point, &intrin, pixel, d * units );
+            rs2_transform_point_to_point( expected, &ex, point );
+
+            auto actual = rays.deproject( x, y, d );
+            CAPTURE( x, y );
+            REQUIRE( std::abs( actual.x - expected[0] ) < 1e-5f );
+            REQUIRE( std::abs( actual.y - expected[1] ) < 1e-5f );
+            REQUIRE( std::abs( actual.z - expected[2] ) < 1e-5f );
+        }
+}
+
+TEST_CASE( "deproject_valid skips zero depth", "[depth-rays]" )
+{
+    auto const intrin = make_intrin();
+    librealsense::depth_rays rays;
+    rays.update( intrin, 0.001f );
+
+    uint16_t row[16] = { 0, 1000, 0, 0, 2000, 0, 3000, 0, 0, 0, 0, 0, 0, 0, 0, 4000 };
+    float3 out[16];
+    auto end = rays.deproject_valid( out, row, 10, 0, 16 );
+    REQUIRE( end - out == 4 );
+    CHECK( out[0].z == approx( 1.f ) );
+    CHECK( out[3].z == approx( 4.f ) );
+
+    end = rays.deproject_valid( out, row, 10, 1, 16, 3 );  // 1, 4, 7, 10, 13
+    REQUIRE( end - out == 2 );
+    CHECK( out[1].z == approx( 2.f ) );
+}
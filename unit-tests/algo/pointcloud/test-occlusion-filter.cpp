@@ -0,0 +1,209 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#cmake:add-file ../../../src/proc/occlusion-filter.cpp
+
+#include "../algo-common.h"
+#include <src/proc/occlusion-filter.h>
+
+#include <vector>
+#include <random>
+#include <cstring>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+// The original, scalar, implementation of the heuristic: the filter must produce exactly the same output
+
+int reference_gcd( int a, int b )
+{
+    return b ? reference_gcd( b, a % b ) : a;
+}
+
+int reference_max_divisor( int a, int b, int lo, int hi )
+{
+    int g = reference_gcd( a, b );
+    for( int i = lo; i * i <= g && i <= hi; i++ )
+        if( ( g % i == 0 ) && ( g / i ) <= hi )
+            return g / i;
+    return g;
+}
+
+void reference_rotate( uint8_t * out, const uint8_t * source, int width, int height )
+{
+    const int SIZE = 2;
+    auto width_out = height;
+    auto height_out = width;
+    auto buffer_size = reference_max_divisor( height, width, 1, 32 );
+    std::vector< std::vector< uint8_t > > buffer( buffer_size, std::vector< uint8_t >( buffer_size * SIZE ) );
+    for( int i = 0; i <= height - buffer_size; i = i + buffer_size )
+        for( int j = 0; j <= width - buffer_size; j = j + buffer_size )
+        {
+            for( int ii = 0; ii < buffer_size; ++ii )
+                for( int jj = 0; jj < buffer_size; ++jj )
+                {
+                    auto source_index = ( ( j + jj ) + ( width * ( i + ii ) ) ) * SIZE;
+                    memcpy( &buffer[buffer_size - 1 - jj][( buffer_size - 1 - ii ) * SIZE], &source[source_index], SIZE );
+                }
+            for( int ii = 0; ii < buffer_size; ++ii )
+            {
+                auto out_index = ( ( ( height_out - buffer_size - j + 1 ) * width_out ) - i - buffer_size + ( ii ) * width_out );
+                memcpy( &out[out_index * SIZE], buffer[ii].data(), buffer_size * SIZE );
+            }
+        }
+}
+
+void reference_horizontal( float3 * points, const std::vector< float2 > & pix_coord, int width, int height )
+{
+    auto pixels_ptr = pix_coord.data();
+    for( int y = 0; y < height; ++y )
+    {
+        float maxInLine = -1;
+        float maxZ = 0;
+        int occDilationLeft = 0;
+        for( int x = 0; x < width; ++x, ++points, ++pixels_ptr )
+        {
+            if( ! points->z )
+                continue;
+            if( pixels_ptr->x < maxInLine || ( pixels_ptr->x == maxInLine && ( points->z - maxZ ) > 0.1f ) )
+            {
+                *points = { 0, 0, 0 };
+                occDilationLeft = 1;
+            }
+            else
+            {
+                maxInLine = pixels_ptr->x;
+                maxZ = points->z;
+                if( occDilationLeft > 0 )
+                {
+                    *points = { 0, 0, 0 };
+                    occDilationLeft--;
+                }
+            }
+        }
+    }
+}
+
+void reference_vertical( float3 * points, const float2 * uv_map, const uint16_t * depth, int width, int height, float depth_units )
+{
+    auto rotated_width = height;
+    auto rotated_height = width;
+    std::vector< uint16_t > rotated( width * height + 1 );  // the last pixel is compared with the one past the end
+    reference_rotate( (uint8_t *)rotated.data(), (const uint8_t *)depth, width, height );
+    for( int i = 0; i < rotated_height; i++ )
+        for( int j = 0; j < rotated_width; j++ )
+        {
+            auto index = ( j + ( rotated_width * i ) );
+            auto uv_index = ( ( rotated_height - i - 1 ) + ( rotated_width - j - 1 ) * rotated_height );
+            uint16_t diff_right = std::abs( rotated[index] - rotated[index + 1] );
+            if( diff_right > DEPTH_OCCLUSION_THRESHOLD / depth_units )
+            {
+                auto scan_win_size = reference_max_divisor( rotated_height, rotated_width, 1, VERTICAL_SCAN_WINDOW_SIZE );
+                // The first line has no line above it: the original read before the start of the texture coordinates
+                if( j >= scan_win_size && uv_index >= width )
+                {
+                    float maxInLine = uv_map[uv_index - width].y;
+                    for( int y = 0; y <= scan_win_size; ++y )
+                    {
+                        if( uv_map[uv_index + y * width].y < maxInLine )
+                            points[uv_index + y * width] = { 0.f, 0.f, 0.f };
+                        else
+                            break;
+                    }
+                }
+            }
+        }
+}
+
+
+// A scene with a closer object in front of a background, so there are depth jumps and non-monotonic texture coordinates
+struct scene
+{
+    int width, height;
+    std::vector< uint16_t > depth;
+    std::vector< float3 > points;
+    std::vector< float2 > pixels;
+    std::vector< float2 > uvs;
+
+    scene( int w, int h )
+        : width( w )
+        , height( h )
+        , depth( w * h )
+        , points( w * h )
+        , pixels( w * h )
+        , uvs( w * h )
+    {
+        std::mt19937 gen( 42 );
+        std::uniform_int_distribution< int > noise( -20, 20 );
+        std::uniform_int_distribution< int > holes( 0, 30 );
+        for( int y = 0; y < h; ++y )
+            for( int x = 0; x < w; ++x )
+            {
+                auto i = y * w + x;
+                bool object = x > w / 3 && x < w / 2 && y > h / 3 && y < 2 * h / 3;
+                int d = object ? 800 : 2000;
+                d += noise( gen );
+                if( ! holes( gen ) )
+                    d = 0;
+                depth[i] = uint16_t( d );
+                float z = d * 0.001f;
+                points[i] = { float( x ), float( y ), z };
+                // The texture shifts more for closer points, so both directions see occlusions
+                float shift = z ? 40.f / z : 0.f;
+                pixels[i] = { x + shift, y + shift };
+                uvs[i] = { pixels[i].x / w, pixels[i].y / h };
+            }
+    }
+};
+
+
+void check_same( std::vector< float3 > const & expected, std::vector< float3 > const & actual )
+{
+    REQUIRE( expected.size() == actual.size() );
+    size_t mismatches = 0, invalidated = 0;
+    for( size_t i = 0; i < expected.size(); ++i )
+    {
+        if( std::memcmp( &expected[i], &actual[i], sizeof( float3 ) ) )
+            ++mismatches;
+        if( ! expected[i].z )
+            ++invalidated;
+    }
+    CHECK( mismatches == 0 );
+    CHECK( invalidated > 0 );
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "occlusion filter matches the original", "[occlusion]" )
+{
+    // Small frames run in one band; large ones in parallel
+    for( auto & res : std::vector< std::pair< int, int > >{ { 64, 48 }, { 424, 240 }, { 848, 480 }, { 1280, 720 } } )
+    {
+        scene s( res.first, res.second );
+        rs2_intrinsics intr = { s.width, s.height, s.width / 2.f, s.height / 2.f, 500, 500, RS2_DISTORTION_NONE, { 0 } };
+
+        occlusion_filter filter;
+        filter.set_depth_intrinsics( intr );
+        filter.set_depth_units( 0.001f );
+
+        auto expected = s.points;
+        reference_horizontal( expected.data(), s.pixels, s.width, s.height );
+        auto actual = s.points;
+        filter.set_scanning( horizontal );
+        filter.process( actual.data(), s.uvs.data(), s.pixels, s.depth.data() );
+        check_same( expected, actual );
+
+        expected = s.points;
+        reference_vertical( expected.data(), s.uvs.data(), s.depth.data(), s.width, s.height, 0.001f );
+        actual = s.points;
+        filter.set_scanning( vertical );
+        filter.process( actual.data(), s.uvs.data(), s.pixels, s.depth.data() );
+        check_same( expected, actual );
+    }
+}
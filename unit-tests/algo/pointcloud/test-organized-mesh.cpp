@@ -0,0 +1,147 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#cmake:add-file ../../../src/proc/organized-mesh.cpp
+
+#include "../algo-common.h"
+#include <src/proc/organized-mesh.h>
+
+#include <vector>
+#include <map>
+#include <cmath>
+#include <utility>
+
+using librealsense::float3;
+
+
+// The PLY exporter's cross product (not float3's, whose y is negated)
+static float3 exporter_cross( float3 const & a, float3 const & b )
+{
+    return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+// A slanted plane with a hole and a depth step, big enough to be split over threads
+static std::vector< float3 > make_cloud( int width, int height )
+{
+    std::vector< float3 > cloud( width * height );
+    for( int y = 0; y < height; ++y )
+        for( int x = 0; x < width; ++x )
+        {
+            float z = 1.f + 0.001f * x + 0.0005f * y;
+            if( x > width / 2 )
+                z += 0.2f;  // step: not meshed across
+            if( x > 10 && x < 20 && y > 10 && y < 15 )
+                z = 0;      // hole
+            cloud[y * width + x] = z ? float3{ ( x - width / 2 ) * 0.002f * z, ( y - height / 2 ) * 0.002f * z, z }
+                                     : float3{ 0, 0, 0 };
+        }
+    return cloud;
+}
+
+static void check_mesh_and_normals( int const width, int const height )
+{
+    CAPTURE( width, height );
+    float const threshold = 0.05f;
+    auto const cloud = make_cloud( width, height );
+
+    std::vector< uint8_t > quads( width * height );
+    std::vector< float3 > normals( width * height );
+    librealsense::compute_organized_mesh( quads.data(), cloud.data(), width, height, threshold );
+    librealsense::compute_vertex_normals( normals.data(), cloud.data(), quads.data(), width, height );
+
+    std::map< int, float3 > expected_normals;
+    for( int x = 0; x < width - 1; ++x )
+        for( int y = 0; y < height - 1; ++y )
+        {
+            auto a = y * width + x, b = y * width + x + 1, c = ( y + 1 ) * width + x, d = ( y + 1 ) * width + x + 1;
+            auto & va = cloud[a], & vb = cloud[b], & vc = cloud[c], & vd = cloud[d];
+            bool meshed = va.z && vb.z && vc.z && vd.z && std::abs( va.z - vb.z ) < threshold
+                        && std::abs( va.z - vc.z ) < threshold && std::abs( vb.z - vd.z ) < threshold
+                        && std::abs( vc.z - vd.z ) < threshold;
+            CAPTURE( x, y );
+            REQUIRE( bool( quads[a] ) == meshed );
+            if( ! meshed )
+                continue;
+            auto n1 = exporter_cross( vd - va, vb - va );
+            auto n2 = exporter_cross( vc - va, vd - va );
+            for( auto i : { a, a, b, c, d, d } )
+                expected_normals.emplace( i, float3{ 0, 0, 0 } );
+            expected_normals[a] = expected_normals[a] + n1 + n2;
+            expected_normals[b] = expected_normals[b] + n1;
+            expected_normals[c] = expected_normals[c] + n2;
+            expected_normals[d] = expected_normals[d] + n1 + n2;
+        }
+    for( int y = 0; y < height; ++y )
+        CHECK( ! quads[y * width + width - 1] );
+    for( int x = 0; x < width; ++x )
+        CHECK( ! quads[( height - 1 ) * width + x] );
+
+    for( int i = 0; i < width * height; ++i )
+    {
+        CAPTURE( i );
+        auto it = expected_normals.find( i );
+        if( it == expected_normals.end() )
+        {
+            REQUIRE( normals[i] == float3{ 0, 0, 0 } );
+            continue;
+        }
+        auto e = it->second;
+        e = e / std::sqrt( e * e );
+        REQUIRE( std::abs( normals[i].x - e.x ) < 1e-5f );
+        REQUIRE( std::abs( normals[i].y - e.y ) < 1e-5f );
+        REQUIRE( std::abs( normals[i].z - e.z ) < 1e-5f );
+    }
+}
+
+// What the PLY exporter used to do: mesh quads, accumulating triangle normals per vertex. Widths that are not a
+// multiple of the SIMD width leave quads to the scalar code.
+TEST_CASE( "mesh and normals match the exporter's", "[organized-mesh]" )
+{
+    for( auto size : { std::make_pair( 64, 48 ), std::make_pair( 61, 70 ), std::make_pair( 6, 5 ) } )
+        check_mesh_and_normals( size.first, size.second );
+}
+
+
+// Z = 1 + 0.3 X - 0.2 Y, with a hole and a step (of the same slope) that is not meshed across: every meshed vertex has
+// the normal of the plane, (0.3,-0.2,-1) normalized, facing the camera
+TEST_CASE( "normals of a tilted plane", "[organized-mesh]" )
+{
+    int const width = 45, height = 30;
+    float const p = 0.3f, q = -0.2f;
+    std::vector< float3 > cloud( width * height );
+    for( int y = 0; y < height; ++y )
+        for( int x = 0; x < width; ++x )
+        {
+            float const X = ( x - width / 2 ) * 0.01f, Y = ( y - height / 2 ) * 0.01f;
+            float const Z = 1.f + p * X + q * Y + ( x > 30 ? 0.2f : 0.f );
+            bool const hole = x > 5 && x < 9 && y > 5 && y < 9;
+            cloud[y * width + x] = hole ? float3{ 0, 0, 0 } : float3{ X, Y, Z };
+        }
+
+    std::vector< uint8_t > quads( width * height );
+    std::vector< float3 > normals( width * height );
+    librealsense::compute_organized_mesh( quads.data(), cloud.data(), width, height, 0.05f );
+    librealsense::compute_vertex_normals( normals.data(), cloud.data(), quads.data(), width, height );
+
+    float const len = std::sqrt( p * p + q * q + 1 );
+    float3 const expected = { p / len, q / len, -1 / len };
+    int meshed = 0;
+    for( int y = 0; y < height; ++y )
+        for( int x = 0; x < width; ++x )
+        {
+            CAPTURE( x, y );
+            auto const & n = normals[y * width + x];
+            if( ! cloud[y * width + x].z )
+            {
+                // A hole
+                CHECK( n == float3{ 0, 0, 0 } );
+                continue;
+            }
+            ++meshed;
+            CHECK( std::abs( n.x - expected.x ) < 1e-4f );
+            CHECK( std::abs( n.y - expected.y ) < 1e-4f );
+            CHECK( std::abs( n.z - expected.z ) < 1e-4f );
+        }
+    CHECK( meshed > width * height / 2 );
+}
@@ -0,0 +1,55 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#cmake:add-file ../../../src/proc/voxel-grid.cpp
+
+#include "../algo-common.h"
+#include <src/proc/voxel-grid.h>
+
+#include <vector>
+
+using librealsense::float3;
+using librealsense::voxel_grid;
+
+
+TEST_CASE( "voxel centroids", "[voxel-grid]" )
+{
+    voxel_grid grid;
+    grid.reset( 0.1f );
+    grid.add( { 0.01f, 0.01f, 0.01f } );
+    grid.add( { 0.03f, 0.05f, 0.09f } );
+    grid.add( { -0.01f, 0.01f, 0.01f } );  // negative coordinates are a separate voxel
+    grid.add( { 0.21f, 0.f, 1.f } );
+    REQUIRE( grid.size() == 3 );
+
+    std::vector< float3 > centroids( grid.size() );
+    grid.get_centroids( centroids.data() );
+    CHECK( centroids[0].x == approx( 0.02f ) );
+    CHECK( centroids[0].y == approx( 0.03f ) );
+    CHECK( centroids[0].z == approx( 0.05f ) );
+    CHECK( centroids[1].x == approx( -0.01f ) );
+    CHECK( centroids[2].z == approx( 1.f ) );
+}
+
+TEST_CASE( "voxel grid reuse", "[voxel-grid]" )
+{
+    // Enough points to grow the table several times
+    voxel_grid grid;
+    std::vector< float3 > points;
+    for( int x = 0; x < 100; ++x )
+        for( int y = 0; y < 100; ++y )
+            points.push_back( { x * 0.01f + 0.001f, y * 0.01f + 0.001f, 2.f } );
+
+    grid.reset( 0.02f );
+    grid.add( points.data(), points.size() );
+    CHECK( grid.size() == 50 * 50 );
+
+    grid.reset( 0.5f );
+    grid.add( points.data(), points.size() );
+    CHECK( grid.size() == 2 * 2 );
+    std::vector< float3 > centroids( grid.size() );
+    grid.get_centroids( centroids.data() );
+    for( auto & c : centroids )
+        CHECK( c.z == approx( 2.f ) );
+}
@@ -0,0 +1,121 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+//#cmake:add-file ../../../src/proc/batch-projection.cpp
+
+#include "../algo-common.h"
+#include <librealsense2/rsutil.h>
+#include <src/proc/batch-projection.h>
+
+#include <vector>
+
+// Same intrinsics as test-distortion.cpp, with the model replaced per test
+static rs2_intrinsics make_intrin( rs2_distortion model )
+{
+    return { 1280,
+             720,
+             643.720581f,
+             357.821259f,
+             904.170471f,
+             905.155090f,
+             model,
+             { 0.180086836f, -0.534179211f, -0.00139013783f, 0.000118769123f, 0.470662683f } };
+}
+
+// A grid over the whole image, with an odd count so the SIMD remainder gets exercised, and large enough that the
+// batch gets split over multiple threads
+static void make_pixels( std::vector< float > & pixels, std::vector< float > & depths )
+{
+    for( int y = 0; y < 720; y += 3 )
+        for( int x = 0; x < 1280; x += 3 )
+        {
+            pixels.push_back( x + 0.25f );
+            pixels.push_back( y + 0.75f );
+            depths.push_back( 0.3f + ( x + y ) * 0.001f );
+        }
+    pixels.push_back( 1 );
+    pixels.push_back( 1 );
+    depths.push_back( 10.5f );
+}
+
+static void compare( std::vector< float > const & expected, std::vector< float > const & actual, float epsilon )
+{
+    REQUIRE( expected.size() == actual.size() );
+    for( size_t i = 0; i < expected.size(); ++i )
+    {
+        CAPTURE( i );
+        REQUIRE( std::abs( expected[i] - actual[i] ) <= epsilon );
+    }
+}
+
+static void check_model( rs2_distortion model )
+{
+    auto intrin = make_intrin( model );
+    std::vector< float > pixels, depths;
+    make_pixels( pixels, depths );
+    auto const count = depths.size();
+
+    std::vector< float > points( 3 * count ), batch_points( 3 * count );
+    for( size_t i = 0; i < count; ++i )
+        rs2_deproject_pixel_to_point( &points[3 * i], &intrin, &pixels[2 * i], depths[i] );
+    librealsense::deproject_pixels_to_points( batch_points.data(), intrin, pixels.data(), depths.data(), count );
+    compare( points, batch_points, 0.0001f );
+
+    std::vector< float > projected( 2 * count ), batch_projected( 2 * count );
+    for( size_t i = 0; i < count; ++i )
+        rs2_project_point_to_pixel( &projected[2 * i], &intrin, &points[3 * i] );
+    librealsense::project_points_to_pixels( batch_projected.data(), intrin, points.data(), count );
+    compare( projected, batch_projected, 0.001f );
+}
+
+TEST_CASE( "batch none" )
+{
+    check_model( RS2_DISTORTION_NONE );
+}
+
+TEST_CASE( "batch inverse_brown_conrady" )
+{
+    check_model( RS2_DISTORTION_INVERSE_BROWN_CONRADY );
+}
+
+TEST_CASE( "batch brown_conrady" )
+{
+    check_model( RS2_DISTORTION_BROWN_CONRADY );
+}
+
+TEST_CASE( "batch kannala_brandt4" )
+{
+    check_model( RS2_DISTORTION_KANNALA_BRANDT4 );
+}
+
+TEST_CASE( "batch project modified_brown_conrady" )
+{
+    auto intrin = make_intrin( RS2_DISTORTION_MODIFIED_BROWN_CONRADY );
+    std::vector< float > points = { 0.1f, 0.2f, 1.f, -0.3f, 0.05f, 2.5f, 0.f, 0.f, 0.7f };
+    std::vector< float > projected( 6 ), batch_projected( 6 );
+    for( size_t i = 0; i < 3; ++i )
+        rs2_project_point_to_pixel( &projected[2 * i], &intrin, &points[3 * i] );
+    rs2_project_points_to_pixels( batch_projected.data(), &intrin, points.data(), 3 );
+    compare( projected, batch_projected, 0.001f );
+}
+
+TEST_CASE( "batch transform" )
+{
+    rs2_extrinsics extrin = { { 0.999f, 0.01f, 0.02f, -0.01f, 0.999f, 0.03f, -0.02f, -0.03f, 0.999f },
+                              { 0.05f, 0.001f, 0.002f } };
+    std::vector< float > from;
+    for( int i = 0; i < 1001; ++i )
+    {
+        from.push_back( i * 0.01f );
+        from.push_back( -i * 0.02f );
+        from.push_back( 1 + i * 0.003f );
+    }
+    std::vector< float > to( from.size() );
+    for( size_t i = 0; i < from.size(); i += 3 )
+        rs2_transform_point_to_point( &to[i], &extrin, &from[i] );
+
+    // In-place transformation is allowed
+    rs2_transform_points_to_points( from.data(), &extrin, from.data(), int( from.size() / 3 ) );
+    compare( to, from, 0.00001f );
+}
@@ -0,0 +1,122 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// The formats converter remembers the expansion of raw profiles (shared by all sensors of the same model) and the
+// converters it picked for a request (reused when the same streams are started again): the same input must reuse
+// them, and anything else must not.
+
+#include <src/proc/formats-converter.h>
+#include <src/stream.h>
+
+#include "../catch.h"
+
+#include <algorithm>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+class test_converter : public formats_converter
+{
+public:
+    test_converter()
+    {
+        register_converter( processing_block_factory::create_id_pbf( RS2_FORMAT_Z16, RS2_STREAM_DEPTH ) );
+        register_converter( processing_block_factory::create_id_pbf( RS2_FORMAT_YUYV, RS2_STREAM_COLOR ) );
+        register_converter( { { RS2_FORMAT_YUYV } },
+                            { { RS2_FORMAT_RGB8, RS2_STREAM_COLOR } },
+                            []() { return std::make_shared< identity_processing_block >(); } );
+    }
+
+    using formats_converter::get_expansions;
+    using formats_converter::get_route;
+
+    size_t routes() const { return _routes.size(); }
+};
+
+
+std::shared_ptr< stream_profile_interface > raw( rs2_format format, rs2_stream stream, uint32_t width )
+{
+    auto p = std::make_shared< video_stream_profile >();
+    p->set_format( format );
+    p->set_stream_type( stream );
+    p->set_dims( width, width * 3 / 4 );
+    p->set_framerate( 30 );
+    return p;
+}
+
+
+std::shared_ptr< stream_profile_interface > find( stream_profiles const & profiles, rs2_format format )
+{
+    for( auto & p : profiles )
+        if( p->get_format() == format )
+            return p;
+    return {};
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "formats converter reuses the expansion of the same raw profiles", "[formats-converter]" )
+{
+    stream_profiles const raw_profiles = { raw( RS2_FORMAT_Z16, RS2_STREAM_DEPTH, 640 ),
+                                           raw( RS2_FORMAT_YUYV, RS2_STREAM_COLOR, 640 ) };
+
+    // Another sensor of the same model gets the same expansion
+    test_converter a, b;
+    auto expansion = a.get_expansions( raw_profiles );
+    CHECK( a.get_expansions( raw_profiles ) == expansion );
+    CHECK( b.get_expansions( raw_profiles ) == expansion );
+    CHECK( a.get_all_possible_profiles( raw_profiles ).size() == 3 );
+
+    // Different profiles, or different converters, do not
+    CHECK( a.get_expansions( { raw( RS2_FORMAT_YUYV, RS2_STREAM_COLOR, 1280 ) } ) != expansion );
+    b.drop_non_basic_formats();
+    CHECK( b.get_expansions( raw_profiles ) != expansion );
+}
+
+
+TEST_CASE( "formats converter reuses the route of the same request", "[formats-converter]" )
+{
+    stream_profiles const raw_profiles = { raw( RS2_FORMAT_Z16, RS2_STREAM_DEPTH, 640 ),
+                                           raw( RS2_FORMAT_YUYV, RS2_STREAM_COLOR, 640 ) };
+    test_converter converter;
+    auto const profiles = converter.get_all_possible_profiles( raw_profiles );
+    auto const depth = find( profiles, RS2_FORMAT_Z16 ), rgb = find( profiles, RS2_FORMAT_RGB8 ),
+               yuyv = find( profiles, RS2_FORMAT_YUYV );
+    REQUIRE( depth );
+    REQUIRE( rgb );
+    REQUIRE( yuyv );
+
+    converter.prepare_to_convert( { depth, rgb } );
+    CHECK( converter.routes() == 1 );
+    auto const route = converter.get_route( { depth, rgb } );
+    REQUIRE( route->size() == 2 );
+    auto const converters = converter.get_active_converters();
+    CHECK( converters.size() == 2 );
+
+    // Started again: same route, but new converters (they have state of their own)
+    converter.prepare_to_convert( { depth, rgb } );
+    CHECK( converter.routes() == 1 );
+    CHECK( converter.get_route( { depth, rgb } ) == route );
+    auto const again = converter.get_active_converters();
+    CHECK( again.size() == 2 );
+    for( auto & pb : again )
+        CHECK( std::find( converters.begin(), converters.end(), pb ) == converters.end() );
+
+    // A different request finds its own route
+    converter.prepare_to_convert( { depth, yuyv } );
+    CHECK( converter.routes() == 2 );
+    CHECK( converter.get_route( { depth, yuyv } ) != route );
+    CHECK( converter.get_route( { depth, rgb } ) == route );
+
+    // New supported profiles forget all routes
+    converter.get_all_possible_profiles( raw_profiles );
+    CHECK( converter.routes() == 0 );
+    CHECK( converter.get_route( { depth, rgb } ) != route );
+}
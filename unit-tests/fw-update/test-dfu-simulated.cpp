@@ -0,0 +1,341 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Signed firmware update (DFU) of one and of many devices, end-to-end against simulated DFU devices
+
+#include <src/fw-update/fw-update-device.h>
+#include <src/fw-update/fw-update-orchestrator.h>
+#include <src/usb/usb-messenger.h>
+
+#include "../catch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+using namespace librealsense;
+using namespace librealsense::platform;
+
+
+namespace {
+
+
+// Tracks how many of the simulated devices are downloading at any time
+struct fleet
+{
+    std::atomic< int > active{ 0 };
+    std::atomic< int > max_active{ 0 };
+};
+
+
+// The DFU state machine, as far as the update uses it: each DFU_DNLOAD block moves to DNLOAD-SYNC, and is acknowledged
+// by the following DFU_GETSTATUS, possibly after some polls that find it still busy
+class dfu_simulator : public usb_messenger
+{
+public:
+    std::mutex mutex;
+    rs2_dfu_state state = RS2_DFU_STATE_DFU_IDLE;
+    std::vector< uint8_t > received;
+    uint16_t transfer_size;
+    int busy_polls = 0;       // how many status requests find each block still being written
+    int fail_at_block = -1;
+    int n_blocks = 0;
+    int n_status = 0;
+
+    dfu_simulator( uint16_t transfer_size_, fleet & f )
+        : transfer_size( transfer_size_ )
+        , _fleet( f )
+    {
+    }
+
+    usb_status control_transfer( int request_type, int request, int value, int index, uint8_t * buffer,
+                                 uint32_t length, uint32_t & transferred, uint32_t timeout_ms ) override
+    {
+        std::lock_guard< std::mutex > lock( mutex );
+        transferred = 0;
+        switch( request )
+        {
+        case RS2_DFU_DETACH:
+            state = RS2_DFU_STATE_DFU_IDLE;
+            return RS2_USB_STATUS_SUCCESS;
+
+        case RS2_DFU_GET_STATE:
+            buffer[0] = uint8_t( state );
+            transferred = 1;
+            return RS2_USB_STATUS_SUCCESS;
+
+        case RS2_DFU_UPLOAD:
+        {
+            dfu_fw_status_payload payload = {};
+            std::memcpy( buffer, &payload, std::min< size_t >( length, sizeof( payload ) ) );
+            transferred = length;
+            return RS2_USB_STATUS_SUCCESS;
+        }
+
+        case RS2_DFU_DOWNLOAD:
+            if( ! length )
+            {
+                if( state != RS2_DFU_STATE_DFU_DOWNLOAD_IDLE )
+                    return RS2_USB_STATUS_PIPE;
+                state = RS2_DFU_STATE_DFU_MANIFEST_SYNC;
+                return RS2_USB_STATUS_SUCCESS;
+            }
+            if( state != RS2_DFU_STATE_DFU_IDLE && state != RS2_DFU_STATE_DFU_DOWNLOAD_IDLE )
+                return RS2_USB_STATUS_PIPE;
+            if( value != n_blocks || length > transfer_size || value == fail_at_block )
+            {
+                state = RS2_DFU_STATE_DFU_ERROR;
+                return RS2_USB_STATUS_SUCCESS;
+            }
+            if( ! n_blocks )
+                started();
+            ++n_blocks;
+            received.insert( received.end(), buffer, buffer + length );
+            _busy = busy_polls;
+            state = RS2_DFU_STATE_DFU_DOWNLOAD_SYNC;
+            // Writing takes time; it's what other devices' updates can overlap
+            std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+            transferred = length;
+            return RS2_USB_STATUS_SUCCESS;
+
+        case RS2_DFU_GET_STATUS:
+        {
+            ++n_status;
+            switch( state )
+            {
+            case RS2_DFU_STATE_DFU_DOWNLOAD_SYNC:
+            case RS2_DFU_STATE_DFU_DOWNLOAD_BUSY:
+                state = _busy-- > 0 ? RS2_DFU_STATE_DFU_DOWNLOAD_BUSY : RS2_DFU_STATE_DFU_DOWNLOAD_IDLE;
+                break;
+            case RS2_DFU_STATE_DFU_MANIFEST_SYNC:
+                state = RS2_DFU_STATE_DFU_MANIFEST;
+                break;
+            case RS2_DFU_STATE_DFU_MANIFEST:
+                state = RS2_DFU_STATE_DFU_MANIFEST_WAIT_RESET;
+                --_fleet.active;
+                break;
+            default:
+                break;
+            }
+            dfu_status_payload status;
+            status.bStatus = state == RS2_DFU_STATE_DFU_ERROR ? RS2_DFU_STATUS_PROG : RS2_DFU_STATUS_OK;
+            status.bState = uint8_t( state );
+            std::memcpy( buffer, &status, std::min< size_t >( length, sizeof( status ) ) );
+            transferred = length;
+            return RS2_USB_STATUS_SUCCESS;
+        }
+
+        default:
+            return RS2_USB_STATUS_NOT_SUPPORTED;
+        }
+    }
+
+    usb_status bulk_transfer( const rs_usb_endpoint &, uint8_t *, uint32_t, uint32_t &, uint32_t ) override { return RS2_USB_STATUS_NOT_SUPPORTED; }
+    usb_status reset_endpoint( const rs_usb_endpoint &, uint32_t ) override { return RS2_USB_STATUS_NOT_SUPPORTED; }
+    usb_status submit_request( const rs_usb_request & ) override { return RS2_USB_STATUS_NOT_SUPPORTED; }
+    usb_status cancel_request( const rs_usb_request & ) override { return RS2_USB_STATUS_NOT_SUPPORTED; }
+    rs_usb_request create_request( rs_usb_endpoint ) override { return nullptr; }
+
+private:
+    void started()
+    {
+        auto active = ++_fleet.active;
+        auto max_active = _fleet.max_active.load();
+        while( active > max_active && ! _fleet.max_active.compare_exchange_weak( max_active, active ) )
+            ;
+    }
+
+    fleet & _fleet;
+    int _busy = 0;
+};
+
+
+class simulated_usb_device : public usb_device_mock
+{
+public:
+    std::shared_ptr< dfu_simulator > dfu;
+    bool advertise_transfer_size = true;
+
+    simulated_usb_device( uint16_t transfer_size, fleet & f )
+        : dfu( std::make_shared< dfu_simulator >( transfer_size, f ) )
+    {
+    }
+
+    const usb_device_info get_info() const override
+    {
+        usb_device_info info = {};
+        info.id = "simulated";
+        info.pid = 0x0adb;
+        return info;
+    }
+
+    const rs_usb_messenger open( uint8_t ) override { return dfu; }
+
+    const std::vector< usb_descriptor > get_descriptors() const override
+    {
+        std::vector< usb_descriptor > descriptors;
+        if( advertise_transfer_size )
+        {
+            dfu_functional_descriptor desc = { sizeof( desc ), 0x21, 0x0b, 0, dfu->transfer_size, 0x0110 };
+            usb_descriptor ud = { desc.bLength, desc.bDescriptorType, std::vector< uint8_t >( sizeof( desc ) ) };
+            std::memcpy( ud.data.data(), &desc, sizeof( desc ) );
+            descriptors.push_back( ud );
+        }
+        return descriptors;
+    }
+};
+
+
+class simulated_update_device : public update_device
+{
+public:
+    simulated_update_device( std::shared_ptr< simulated_usb_device > const & usb )
+        : update_device( nullptr, usb, "D400" )
+    {
+    }
+
+    bool check_fw_compatibility( const std::vector< uint8_t > & ) const override { return true; }
+};
+
+
+std::vector< uint8_t > make_image( size_t size )
+{
+    std::vector< uint8_t > image( size );
+    for( size_t i = 0; i < size; ++i )
+        image[i] = uint8_t( i * 31 + i / 7 );
+    return image;
+}
+
+
+class progress_recorder : public rs2_update_progress_callback
+{
+public:
+    std::vector< float > values;
+    void on_update_progress( const float progress ) override { values.push_back( progress ); }
+    void release() override {}
+};
+
+
+}  // namespace
+
+
+TEST_CASE( "DFU uses the device's transfer size", "[fw-update]" )
+{
+    fleet f;
+    auto usb = std::make_shared< simulated_usb_device >( 4096, f );
+    auto image = make_image( 100000 );
+    auto progress = std::make_shared< progress_recorder >();
+
+    SECTION( "advertised" )
+    {
+        simulated_update_device dev( usb );
+        dev.update( image.data(), int( image.size() ), progress );
+        CHECK( usb->dfu->received == image );
+        CHECK( usb->dfu->n_blocks == 25 );  // ceil( 100000 / 4096 )
+        CHECK( usb->dfu->state == RS2_DFU_STATE_DFU_MANIFEST_WAIT_RESET );
+        // One status request per block, then the manifest phase
+        CHECK( usb->dfu->n_status <= 25 + 2 );
+        REQUIRE( progress->values.size() == 25 );
+        CHECK( std::is_sorted( progress->values.begin(), progress->values.end() ) );
+        CHECK( progress->values.back() == 1.f );
+    }
+    SECTION( "advertised below the default" )
+    {
+        auto small = std::make_shared< simulated_usb_device >( 512, f );
+        simulated_update_device dev( small );
+        dev.update( image.data(), int( image.size() ), progress );
+        CHECK( small->dfu->received == image );
+        CHECK( small->dfu->n_blocks == 196 );  // ceil( 100000 / 512 )
+        CHECK( progress->values.back() == 1.f );
+    }
+    SECTION( "not advertised" )
+    {
+        usb->advertise_transfer_size = false;
+        simulated_update_device dev( usb );
+        dev.update( image.data(), int( image.size() ), progress );
+        CHECK( usb->dfu->received == image );
+        CHECK( usb->dfu->n_blocks == 98 );  // 1024 bytes each
+        CHECK( progress->values.back() == 1.f );
+    }
+    SECTION( "busy device" )
+    {
+        usb->dfu->busy_polls = 2;
+        simulated_update_device dev( usb );
+        auto start = std::chrono::steady_clock::now();
+        dev.update( image.data(), int( image.size() ), progress );
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        CHECK( usb->dfu->received == image );
+        CHECK( usb->dfu->n_status <= 25 * 3 + 2 );
+        // A short wait is not rounded up to a full polling interval
+        CHECK( elapsed < std::chrono::milliseconds( 25 * 100 ) );
+    }
+}
+
+
+TEST_CASE( "orchestrator updates many devices at once", "[fw-update]" )
+{
+    size_t const N_DEVICES = 8;
+    size_t const MAX_CONCURRENT = 3;
+    fleet f;
+    std::vector< std::shared_ptr< simulated_usb_device > > usbs;
+    std::vector< std::shared_ptr< simulated_update_device > > devs;
+    std::vector< update_device_interface const * > fwus;
+    for( size_t i = 0; i < N_DEVICES; ++i )
+    {
+        usbs.push_back( std::make_shared< simulated_usb_device >( 2048, f ) );
+        devs.push_back( std::make_shared< simulated_update_device >( usbs.back() ) );
+        fwus.push_back( devs.back().get() );
+    }
+    auto image = make_image( 64 * 1024 );
+
+    std::vector< float > progress( N_DEVICES, 0.f );
+    std::vector< std::string > errors( N_DEVICES, "not done" );
+    auto on_progress = [&]( size_t i, float p )
+    {
+        CHECK( p >= progress[i] );
+        progress[i] = p;
+    };
+    auto on_done = [&]( size_t i, std::string const & error ) { errors[i] = error; };
+
+    SECTION( "all succeed" )
+    {
+        fw_update_orchestrator orchestrator( fwus, MAX_CONCURRENT );
+        CHECK( orchestrator.update( image.data(), int( image.size() ), on_progress, on_done ) == 0 );
+        for( size_t i = 0; i < N_DEVICES; ++i )
+        {
+            CHECK( usbs[i]->dfu->received == image );
+            CHECK( progress[i] == 1.f );
+            CHECK( errors[i].empty() );
+        }
+        CHECK( f.max_active <= int( MAX_CONCURRENT ) );
+        CHECK( f.max_active > 1 );
+    }
+    SECTION( "one fails" )
+    {
+        usbs[2]->dfu->fail_at_block = 5;
+        fw_update_orchestrator orchestrator( fwus );
+        CHECK( orchestrator.update( image.data(), int( image.size() ), on_progress, on_done ) == 1 );
+        for( size_t i = 0; i < N_DEVICES; ++i )
+        {
+            if( i == 2 )
+            {
+                CHECK( ! errors[i].empty() );
+                CHECK( progress[i] < 1.f );
+            }
+            else
+            {
+                CHECK( errors[i].empty() );
+                CHECK( usbs[i]->dfu->received == image );
+            }
+        }
+    }
+    SECTION( "a device cannot be listed twice" )
+    {
+        fwus.push_back( fwus.front() );
+        CHECK_THROWS( fw_update_orchestrator( fwus, 0 ) );
+    }
+}
@@ -0,0 +1,160 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <src/hw-monitor.h>
+#include <src/hw-monitor-cache.h>
+
+#include <rsutils/os/special-folder.h>
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include "../catch.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace librealsense;
+
+
+namespace {
+
+uint8_t const READ = 0x15;   // cacheable
+uint8_t const WRITE = 0x16;  // invalidating
+uint8_t const OTHER = 0x2A;  // neither
+
+
+// Answers every command with its opcode followed by its first parameter, and counts them
+class counting_transfer : public platform::command_transfer
+{
+public:
+    int count = 0;
+    uint32_t value = 0;  // added to the answer, to tell a stale response from a fresh one
+
+    std::vector< uint8_t > send_receive( uint8_t const * pb, size_t cb, int, bool ) override
+    {
+        ++count;
+        uint32_t opcode, param1;
+        std::memcpy( &opcode, pb + 4, sizeof( opcode ) );
+        std::memcpy( &param1, pb + 8, sizeof( param1 ) );
+        param1 += value;
+        std::vector< uint8_t > response( 8 );
+        std::memcpy( response.data(), &opcode, sizeof( opcode ) );
+        std::memcpy( response.data() + 4, &param1, sizeof( param1 ) );
+        return response;
+    }
+};
+
+
+uint32_t read( hw_monitor const & hwm, uint8_t opcode, uint32_t param1 )
+{
+    auto data = hwm.send( command( opcode, param1 ) );
+    REQUIRE( data.size() == 4 );
+    uint32_t value;
+    std::memcpy( &value, data.data(), sizeof( value ) );
+    return value;
+}
+
+
+std::shared_ptr< hw_monitor_cache > make_cache()
+{
+    return std::make_shared< hw_monitor_cache >(
+        rsutils::os::get_special_folder( rsutils::os::special_folder::temp_folder ),
+        std::set< uint8_t >{ READ },
+        std::set< uint8_t >{ WRITE } );
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "cached responses skip the device", "[hw-monitor-cache]" )
+{
+    auto device = std::make_shared< counting_transfer >();
+    auto transfer = std::make_shared< locked_transfer >( device, nullptr );
+    hw_monitor hwm( transfer );
+
+    auto cache = make_cache();
+    std::remove( cache->get_filename( "test-serial", "1.2.3.4" ).c_str() );
+    transfer->set_cache( cache );
+
+    // Nothing is served before the device identity is known
+    CHECK( read( hwm, READ, 1 ) == 1 );
+    CHECK( read( hwm, READ, 1 ) == 1 );
+    CHECK( device->count == 2 );
+
+    cache->bind( "test-serial", "1.2.3.4", "calibration-1" );
+    CHECK( read( hwm, READ, 1 ) == 1 );
+    CHECK( read( hwm, READ, 1 ) == 1 );
+    CHECK( read( hwm, READ, 2 ) == 2 );  // different parameters are a different entry
+    CHECK( read( hwm, READ, 2 ) == 2 );
+    CHECK( device->count == 4 );
+
+    // Other commands always go to the device
+    CHECK( read( hwm, OTHER, 1 ) == 1 );
+    CHECK( read( hwm, OTHER, 1 ) == 1 );
+    CHECK( device->count == 6 );
+
+    SECTION( "a new session with the same device reads the cache from disk" )
+    {
+        auto device2 = std::make_shared< counting_transfer >();
+        auto transfer2 = std::make_shared< locked_transfer >( device2, nullptr );
+        hw_monitor hwm2( transfer2 );
+        auto cache2 = make_cache();
+        transfer2->set_cache( cache2 );
+        device2->value = 100;
+
+        cache2->bind( "test-serial", "1.2.3.4", "calibration-1" );
+        CHECK( read( hwm2, READ, 1 ) == 1 );
+        CHECK( read( hwm2, READ, 2 ) == 2 );
+        CHECK( device2->count == 0 );
+
+        // Another firmware version does not share the entry
+        cache2->bind( "test-serial", "1.2.3.5", "calibration-1" );
+        CHECK( read( hwm2, READ, 1 ) == 101 );
+        CHECK( device2->count == 1 );
+        std::remove( cache2->get_filename( "test-serial", "1.2.3.5" ).c_str() );
+    }
+    SECTION( "a changed validation token drops the entry" )
+    {
+        // E.g., the calibration was changed by another host
+        auto device2 = std::make_shared< counting_transfer >();
+        auto transfer2 = std::make_shared< locked_transfer >( device2, nullptr );
+        hw_monitor hwm2( transfer2 );
+        auto cache2 = make_cache();
+        transfer2->set_cache( cache2 );
+        device2->value = 100;
+
+        cache2->bind( "test-serial", "1.2.3.4", "calibration-2" );
+        CHECK( read( hwm2, READ, 1 ) == 101 );
+        CHECK( read( hwm2, READ, 1 ) == 101 );
+        CHECK( device2->count == 1 );
+
+        // The entry on disk now holds the new responses, under the new token
+        auto cache3 = make_cache();
+        cache3->bind( "test-serial", "1.2.3.4", "calibration-2" );
+        std::vector< uint8_t > response;
+        auto request = hw_monitor::build_command( READ, 1 );
+        CHECK( cache3->lookup( request.data(), request.size(), response ) );
+        request = hw_monitor::build_command( READ, 2 );
+        CHECK( ! cache3->lookup( request.data(), request.size(), response ) );
+    }
+    SECTION( "writes invalidate" )
+    {
+        device->value = 100;
+        hwm.send( command( WRITE, 1 ) );
+        CHECK( device->count == 7 );
+        CHECK( read( hwm, READ, 1 ) == 101 );
+        CHECK( read( hwm, READ, 1 ) == 101 );
+        CHECK( device->count == 8 );
+
+        // And on disk, too
+        auto cache2 = make_cache();
+        cache2->bind( "test-serial", "1.2.3.4", "calibration-1" );
+        std::vector< uint8_t > response;
+        auto request = hw_monitor::build_command( READ, 2 );
+        CHECK( ! cache2->lookup( request.data(), request.size(), response ) );
+    }
+
+    std::remove( cache->get_filename( "test-serial", "1.2.3.4" ).c_str() );
+}
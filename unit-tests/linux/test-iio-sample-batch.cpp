@@ -0,0 +1,267 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// IIO IMU samples are read from the character device as many at a time as the watermark lets the kernel buffer, and
+// handed over in a single callback, each with its own backend time. A FIFO stands in for the IIO device here, fed at
+// the sampling frequency, so the CPU time spent per sample can be compared with reading a sample at a time.
+
+#include "../catch.h"
+
+#ifdef RS2_USE_V4L2_BACKEND
+
+#include <src/linux/iio-sample-batch.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/select.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+
+namespace {
+std::atomic< bool > counting_allocations{ false };
+std::atomic< int > allocations{ 0 };
+}
+
+void * operator new( std::size_t size )
+{
+    if( counting_allocations )
+        ++allocations;
+    if( void * p = std::malloc( size ? size : 1 ) )
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete( void * p ) noexcept
+{
+    std::free( p );
+}
+
+
+using namespace librealsense;
+using namespace librealsense::platform;
+
+
+namespace {
+
+
+// x, y, z then the metadata: an 8-byte HW timestamp, in nsec
+uint32_t const CHANNEL_SIZE = 24;
+uint32_t const METADATA_SIZE = 8;
+uint32_t const BUFFER_LENGTH = 128;
+
+
+void make_scan( uint8_t * scan, uint32_t index, uint64_t ts_ns )
+{
+    int32_t xyz[3] = { int32_t( index ), -int32_t( index ), 1000 };
+    std::memcpy( scan, xyz, sizeof( xyz ) );
+    std::memset( scan + 12, 0, 4 );
+    std::memcpy( scan + 16, &ts_ns, sizeof( ts_ns ) );
+}
+
+
+double thread_cpu_ms()
+{
+    timespec ts;
+    clock_gettime( CLOCK_THREAD_CPUTIME_ID, &ts );
+    return ts.tv_sec * 1000. + ts.tv_nsec / 1e6;
+}
+
+
+struct capture_stats
+{
+    uint32_t samples = 0;
+    uint32_t callbacks = 0;
+    double cpu_ms = 0;
+    bool in_order = true;
+};
+
+
+// Feeds a FIFO the way the kernel fills the IIO buffer -- a watermark's worth of samples at a time, at the sampling
+// frequency -- and reads it the way the capture thread does
+capture_stats capture( uint32_t frequency, uint32_t watermark, uint32_t total )
+{
+    std::string path = "/tmp/rs-iio-fifo-" + std::to_string( getpid() );
+    ::unlink( path.c_str() );
+    REQUIRE( mkfifo( path.c_str(), 0600 ) == 0 );
+    int fd = open( path.c_str(), O_RDONLY | O_NONBLOCK );
+    REQUIRE( fd > 0 );
+    // Without a writer, the FIFO would read as EOF until the feeder opens it
+    int keep_open = open( path.c_str(), O_WRONLY | O_NONBLOCK );
+    REQUIRE( keep_open > 0 );
+
+    std::thread feeder( [&]()
+    {
+        int out = open( path.c_str(), O_WRONLY );
+        std::vector< uint8_t > chunk( CHANNEL_SIZE * watermark );
+        auto const period = std::chrono::nanoseconds( 1000000000 / frequency );
+        auto next = std::chrono::steady_clock::now();
+        for( uint32_t i = 0; i < total; i += watermark )
+        {
+            uint32_t const n = std::min( watermark, total - i );
+            for( uint32_t j = 0; j < n; ++j )
+                make_scan( chunk.data() + CHANNEL_SIZE * j, i + j, uint64_t( i + j ) * period.count() );
+            next += n * period;
+            std::this_thread::sleep_until( next );
+            if( write( out, chunk.data(), CHANNEL_SIZE * n ) != ssize_t( CHANNEL_SIZE * n ) )
+                break;
+        }
+        close( out );
+    } );
+
+    capture_stats stats;
+    iio_sample_batch batch( CHANNEL_SIZE, METADATA_SIZE, frequency, BUFFER_LENGTH );
+    rs2_time_t last_backend_time = 0;
+    uint64_t last_ts = 0;
+    auto const cpu_start = thread_cpu_ms();
+    while( stats.samples < total )
+    {
+        fd_set fds;
+        FD_ZERO( &fds );
+        FD_SET( fd, &fds );
+        struct timeval tv = { 5, 0 };
+        REQUIRE( select( fd + 1, &fds, nullptr, nullptr, &tv ) > 0 );
+        auto read_size = read( fd, batch.data(), batch.size() );
+        if( read_size <= 0 )
+            continue;
+
+        auto now = std::chrono::duration< double, std::milli >( std::chrono::system_clock::now().time_since_epoch() ).count();
+        counting_allocations = true;
+        auto const n = batch.parse( read_size, now );
+        counting_allocations = false;
+
+        // The callback
+        ++stats.callbacks;
+        for( size_t i = 0; i < n; ++i )
+        {
+            auto & fo = batch.samples()[i];
+            auto md = reinterpret_cast< const metadata_hid_raw * >( fo.metadata );
+            int32_t x;
+            std::memcpy( &x, fo.pixels, sizeof( x ) );
+            stats.in_order = stats.in_order && x == int32_t( stats.samples ) && fo.frame_size == CHANNEL_SIZE - METADATA_SIZE
+                          && fo.backend_time >= last_backend_time && ( ! stats.samples || md->header.timestamp > last_ts );
+            last_backend_time = fo.backend_time;
+            last_ts = md->header.timestamp;
+            ++stats.samples;
+        }
+    }
+    stats.cpu_ms = thread_cpu_ms() - cpu_start;
+
+    feeder.join();
+    close( keep_open );
+    close( fd );
+    ::unlink( path.c_str() );
+    return stats;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "iio watermark", "[hid]" )
+{
+    CHECK( iio_sample_batch::watermark( 100, BUFFER_LENGTH ) == 1 );
+    CHECK( iio_sample_batch::watermark( 200, BUFFER_LENGTH ) == 1 );
+    CHECK( iio_sample_batch::watermark( 400, BUFFER_LENGTH ) == 2 );
+    CHECK( iio_sample_batch::watermark( 1000, BUFFER_LENGTH ) == 5 );
+    CHECK( iio_sample_batch::watermark( 100000, BUFFER_LENGTH ) == BUFFER_LENGTH / 2 );
+}
+
+
+TEST_CASE( "iio sample batch", "[hid]" )
+{
+    uint32_t const frequency = 1000;
+    iio_sample_batch batch( CHANNEL_SIZE, METADATA_SIZE, frequency, BUFFER_LENGTH );
+    REQUIRE( batch.size() == CHANNEL_SIZE * BUFFER_LENGTH );
+
+    SECTION( "backend times follow the HW timestamps" )
+    {
+        // 1.5 ms apart, not at the sampling frequency
+        for( uint32_t i = 0; i < 4; ++i )
+            make_scan( batch.data() + CHANNEL_SIZE * i, i, 5000000000ull + i * 1500000ull );
+        // A trailing partial scan is not a sample
+        REQUIRE( batch.parse( CHANNEL_SIZE * 4 + 3, 100. ) == 4 );
+        for( uint32_t i = 0; i < 4; ++i )
+        {
+            auto & fo = batch.samples()[i];
+            CHECK( fo.pixels == batch.data() + CHANNEL_SIZE * i );
+            CHECK( fo.frame_size == CHANNEL_SIZE - METADATA_SIZE );
+            CHECK( fo.backend_time == Catch::Approx( 100. - ( 3 - i ) * 1.5 ) );
+            auto md = reinterpret_cast< const metadata_hid_raw * >( fo.metadata );
+            CHECK( fo.metadata_size == md->header.length );
+            CHECK( md->header.timestamp == 5000000ull + i * 1500ull );  // usec
+        }
+    }
+    SECTION( "without metadata, backend times follow the sampling frequency" )
+    {
+        iio_sample_batch no_md( CHANNEL_SIZE - METADATA_SIZE, 0, frequency, BUFFER_LENGTH );
+        REQUIRE( no_md.parse( ( CHANNEL_SIZE - METADATA_SIZE ) * 3, 100. ) == 3 );
+        for( uint32_t i = 0; i < 3; ++i )
+        {
+            CHECK( no_md.samples()[i].metadata == nullptr );
+            CHECK( no_md.samples()[i].backend_time == Catch::Approx( 100. - ( 2 - i ) ) );
+        }
+    }
+    SECTION( "HW timestamps out of order" )
+    {
+        make_scan( batch.data(), 0, 9000000ull );
+        make_scan( batch.data() + CHANNEL_SIZE, 1, 1000000ull );
+        REQUIRE( batch.parse( CHANNEL_SIZE * 2, 200. ) == 2 );
+        CHECK( batch.samples()[0].backend_time == Catch::Approx( 199. ) );
+        CHECK( batch.samples()[1].backend_time == Catch::Approx( 200. ) );
+    }
+    SECTION( "a batch read late" )
+    {
+        make_scan( batch.data(), 0, 0 );
+        REQUIRE( batch.parse( CHANNEL_SIZE, 100. ) == 1 );
+        // Read 0.5 ms later, but the first of these was sampled 1 ms before the last
+        make_scan( batch.data(), 1, 1000000ull );
+        make_scan( batch.data() + CHANNEL_SIZE, 2, 2000000ull );
+        REQUIRE( batch.parse( CHANNEL_SIZE * 2, 100.5 ) == 2 );
+        CHECK( batch.samples()[0].backend_time == Catch::Approx( 100. ) );
+        CHECK( batch.samples()[1].backend_time == Catch::Approx( 100.5 ) );
+    }
+    SECTION( "less than a scan" )
+    {
+        CHECK( batch.parse( CHANNEL_SIZE - 1, 100. ) == 0 );
+    }
+}
+
+
+TEST_CASE( "iio capture from a fifo", "[hid]" )
+{
+    allocations = 0;
+    for( uint32_t frequency : { 400u, 1000u } )
+    {
+        auto const total = frequency / 2;  // half a second
+        auto const watermark = iio_sample_batch::watermark( frequency, BUFFER_LENGTH );
+        auto single = capture( frequency, 1, total );
+        auto batched = capture( frequency, watermark, total );
+
+        CHECK( single.samples == total );
+        CHECK( single.in_order );
+        CHECK( batched.samples == total );
+        CHECK( batched.in_order );
+        // One callback per wake-up, however many samples it brought
+        CHECK( batched.callbacks <= ( total + watermark - 1 ) / watermark );
+
+        std::cout << frequency << " Hz: " << single.cpu_ms * 1000. / total << " usec CPU/sample a sample at a time, "
+                  << batched.cpu_ms * 1000. / total << " usec CPU/sample with a watermark of " << watermark << " ("
+                  << batched.callbacks << " callbacks)" << std::endl;
+    }
+    CHECK( allocations == 0 );
+}
+
+#endif  // RS2_USE_V4L2_BACKEND
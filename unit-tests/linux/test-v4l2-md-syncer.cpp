@@ -0,0 +1,254 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// The V4L2 backend dequeues video and metadata buffers from separate nodes; the syncer pairs them by sequence, and must
+// give back to the kernel every buffer it cannot pair -- without allocating anything while streaming.
+
+#include "../catch.h"
+
+#ifdef RS2_USE_V4L2_BACKEND
+
+#include <src/linux/v4l2-md-syncer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <set>
+#include <vector>
+
+
+namespace {
+std::atomic< bool > counting_allocations{ false };
+std::atomic< int > allocations{ 0 };
+}
+
+void * operator new( std::size_t size )
+{
+    if( counting_allocations )
+        ++allocations;
+    if( void * p = std::malloc( size ? size : 1 ) )
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete( void * p ) noexcept
+{
+    std::free( p );
+}
+
+
+using namespace librealsense::platform;
+
+
+namespace {
+
+
+int const VIDEO_FD = 10;
+int const MD_FD = 20;
+
+
+// Drives a syncer the way the capture loop does, and keeps track of every buffer
+class capture
+{
+public:
+    std::vector< std::pair< int, uint32_t > > enqueued;  // fd and sequence of every buffer given back
+    std::vector< uint32_t > pulled;
+    v4l2_video_md_syncer syncer;
+
+    capture()
+        : syncer( [this]( int fd, v4l2_buffer & buf ) { enqueued.emplace_back( fd, buf.sequence ); } )
+    {
+        enqueued.reserve( 10000 );
+        pulled.reserve( 10000 );
+        syncer.start();
+    }
+
+    static v4l2_buffer make_buffer( uint32_t sequence )
+    {
+        v4l2_buffer buf = {};
+        buf.sequence = sequence;
+        buf.index = sequence % 4;
+        buf.bytesused = 100 + sequence;
+        return buf;
+    }
+
+    // Both push and pull, as the capture loop does for every dequeued buffer
+    bool video( uint32_t sequence ) { return push( true, sequence ); }
+    bool md( uint32_t sequence ) { return push( false, sequence ); }
+
+    bool push( bool video, uint32_t sequence )
+    {
+        counting_allocations = true;
+        if( video )
+            syncer.push_video( make_buffer( sequence ), VIDEO_FD );
+        else
+            syncer.push_metadata( make_buffer( sequence ), MD_FD );
+        v4l2_buffer v, m;
+        int vfd = -1, mfd = -1;
+        bool const synced = syncer.pull_video_with_metadata( v, m, vfd, mfd );
+        counting_allocations = false;
+        if( synced )
+        {
+            CHECK( v.sequence == m.sequence );
+            CHECK( v.bytesused == 100 + v.sequence );
+            CHECK( v.index == v.sequence % 4 );
+            CHECK( vfd == VIDEO_FD );
+            CHECK( mfd == MD_FD );
+            pulled.push_back( v.sequence );
+        }
+        return synced;
+    }
+
+    size_t enqueued_from( int fd ) const
+    {
+        size_t n = 0;
+        for( auto & e : enqueued )
+            if( e.first == fd )
+                ++n;
+        return n;
+    }
+};
+
+
+}  // namespace
+
+
+TEST_CASE( "v4l2 video/metadata syncer", "[v4l2]" )
+{
+    allocations = 0;
+
+    SECTION( "in order" )
+    {
+        capture c;
+        for( uint32_t seq = 1; seq <= 100; ++seq )
+        {
+            CHECK_FALSE( c.video( seq ) );
+            CHECK( c.md( seq ) );
+        }
+        CHECK( c.pulled.size() == 100 );
+        CHECK( c.enqueued.empty() );
+        CHECK( c.syncer.dropped() == 0 );
+    }
+    SECTION( "metadata first" )
+    {
+        capture c;
+        for( uint32_t seq = 1; seq <= 100; ++seq )
+        {
+            CHECK_FALSE( c.md( seq ) );
+            CHECK( c.video( seq ) );
+        }
+        CHECK( c.pulled.size() == 100 );
+        CHECK( c.enqueued.empty() );
+    }
+    SECTION( "video burst ahead of metadata" )
+    {
+        capture c;
+        CHECK_FALSE( c.video( 1 ) );
+        CHECK_FALSE( c.video( 2 ) );
+        CHECK_FALSE( c.video( 3 ) );  // only the last two are kept
+        REQUIRE( c.enqueued.size() == 1 );
+        CHECK( c.enqueued[0] == std::make_pair( VIDEO_FD, 1u ) );
+        CHECK_FALSE( c.md( 1 ) );     // its video is gone
+        CHECK( c.enqueued.size() == 2 );
+        CHECK( c.md( 2 ) );
+        CHECK( c.md( 3 ) );
+        CHECK( c.pulled == std::vector< uint32_t >{ 2, 3 } );
+    }
+    SECTION( "kernel dropped a metadata buffer" )
+    {
+        capture c;
+        CHECK_FALSE( c.video( 1 ) );
+        CHECK( c.md( 1 ) );
+        CHECK_FALSE( c.video( 2 ) );
+        CHECK_FALSE( c.video( 3 ) );
+        CHECK( c.md( 3 ) );           // video 2 can no longer be paired
+        CHECK( c.enqueued == std::vector< std::pair< int, uint32_t > >{ { VIDEO_FD, 2 } } );
+        CHECK( c.pulled == std::vector< uint32_t >{ 1, 3 } );
+    }
+    SECTION( "kernel dropped a video buffer" )
+    {
+        capture c;
+        CHECK_FALSE( c.md( 1 ) );
+        CHECK_FALSE( c.md( 2 ) );
+        CHECK( c.video( 2 ) );
+        CHECK( c.enqueued == std::vector< std::pair< int, uint32_t > >{ { MD_FD, 1 } } );
+        CHECK( c.pulled == std::vector< uint32_t >{ 2 } );
+    }
+    SECTION( "repeated metadata sequence" )
+    {
+        capture c;
+        CHECK_FALSE( c.md( 0 ) );
+        CHECK_FALSE( c.md( 0 ) );     // replaces the first
+        CHECK( c.enqueued == std::vector< std::pair< int, uint32_t > >{ { MD_FD, 0 } } );
+        CHECK( c.video( 0 ) );
+        CHECK( c.pulled == std::vector< uint32_t >{ 0 } );
+    }
+    SECTION( "stopped" )
+    {
+        capture c;
+        CHECK_FALSE( c.video( 1 ) );
+        c.syncer.stop();
+        CHECK_FALSE( c.md( 1 ) );
+        c.syncer.start();
+        CHECK_FALSE( c.md( 1 ) );     // video 1 was flushed when stopping
+        CHECK( c.video( 2 ) == false );
+        CHECK( c.enqueued.size() == 1 );
+        CHECK( c.pulled.empty() );
+    }
+    SECTION( "random drops and interleaving" )
+    {
+        std::mt19937 gen( 5 );
+        for( int round = 0; round < 20; ++round )
+        {
+            capture c;
+            std::bernoulli_distribution drop( 0.1 ), video_first( 0.5 );
+            std::vector< uint32_t > videos, mds;
+            for( uint32_t seq = 0; seq < 500; ++seq )
+            {
+                if( ! drop( gen ) )
+                    videos.push_back( seq );
+                if( ! drop( gen ) )
+                    mds.push_back( seq );
+            }
+            // Each node dequeues in order; between them, either can be first, but never more than a frame ahead
+            size_t v = 0, m = 0;
+            while( v < videos.size() || m < mds.size() )
+            {
+                bool take_video;
+                if( v == videos.size() )
+                    take_video = false;
+                else if( m == mds.size() )
+                    take_video = true;
+                else if( videos[v] != mds[m] )
+                    take_video = videos[v] < mds[m];
+                else
+                    take_video = video_first( gen );
+                if( take_video )
+                    c.video( videos[v++] );
+                else
+                    c.md( mds[m++] );
+            }
+
+            std::set< uint32_t > both;
+            for( auto seq : videos )
+                if( std::binary_search( mds.begin(), mds.end(), seq ) )
+                    both.insert( seq );
+            CHECK( std::set< uint32_t >( c.pulled.begin(), c.pulled.end() ) == both );
+            CHECK( std::is_sorted( c.pulled.begin(), c.pulled.end() ) );
+            // Every buffer is either pulled, given back, or (at most two of each) still pending
+            auto pending_video = videos.size() - c.pulled.size() - c.enqueued_from( VIDEO_FD );
+            auto pending_md = mds.size() - c.pulled.size() - c.enqueued_from( MD_FD );
+            CHECK( pending_video <= v4l2_video_md_syncer::max_pending );
+            CHECK( pending_md <= v4l2_video_md_syncer::max_pending );
+            CHECK( c.syncer.dropped() == c.enqueued.size() );
+        }
+    }
+
+    CHECK( allocations == 0 );
+}
+
+#endif  // RS2_USE_V4L2_BACKEND
@@ -0,0 +1,294 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// The metadata tables must decode exactly what the per-attribute parsers, as the DS devices used to register them,
+// decode: blobs in the UVC layout the depth and color sensors capture are fed to both, and every attribute compared.
+// Each struct is decoded once per frame, by the first of its parsers to be asked, for all of them.
+
+#include <src/metadata-tables.h>
+
+#include "../catch.h"
+
+#include <random>
+#include <vector>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+typedef std::vector< std::pair< rs2_frame_metadata_value, std::shared_ptr< md_attribute_parser_base > > > parsers;
+
+
+// The parsers as d400_device::register_metadata() registered them
+parsers reference_depth_parsers()
+{
+    parsers p;
+    auto offset = metadata_raw_mode_offset + offsetof( md_depth_mode, depth_y_mode ) + offsetof( md_depth_y_normal_mode, intel_capture_timing );
+    p.emplace_back( RS2_FRAME_METADATA_FRAME_COUNTER, make_attribute_parser( &md_capture_timing::frame_counter, md_capture_timing_attributes::frame_counter_attribute, offset ) );
+
+    offset = metadata_raw_mode_offset + offsetof( md_depth_mode, depth_y_mode ) + offsetof( md_depth_y_normal_mode, intel_capture_stats );
+    p.emplace_back( RS2_FRAME_METADATA_WHITE_BALANCE, make_attribute_parser( &md_capture_stats::white_balance, md_capture_stat_attributes::white_balance_attribute, offset ) );
+
+    offset = metadata_raw_mode_offset + offsetof( md_depth_mode, depth_y_mode ) + offsetof( md_depth_y_normal_mode, intel_depth_control );
+    p.emplace_back( RS2_FRAME_METADATA_GAIN_LEVEL, make_attribute_parser( &md_depth_control::manual_gain, md_depth_control_attributes::gain_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_ACTUAL_EXPOSURE, make_attribute_parser( &md_depth_control::manual_exposure, md_depth_control_attributes::exposure_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_AUTO_EXPOSURE, make_attribute_parser( &md_depth_control::auto_exposure_mode, md_depth_control_attributes::ae_mode_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_FRAME_LASER_POWER, make_attribute_parser( &md_depth_control::laser_power, md_depth_control_attributes::laser_pwr_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_FRAME_LASER_POWER_MODE, make_attribute_parser( &md_depth_control::emitterMode, md_depth_control_attributes::emitter_mode_attribute, offset,
+        []( const rs2_metadata_type & param ) { return param == 1 ? 1 : 0; } ) );
+    p.emplace_back( RS2_FRAME_METADATA_EXPOSURE_PRIORITY, make_attribute_parser( &md_depth_control::exposure_priority, md_depth_control_attributes::exposure_priority_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_EXPOSURE_ROI_LEFT, make_attribute_parser( &md_depth_control::exposure_roi_left, md_depth_control_attributes::roi_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_EXPOSURE_ROI_RIGHT, make_attribute_parser( &md_depth_control::exposure_roi_right, md_depth_control_attributes::roi_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_EXPOSURE_ROI_TOP, make_attribute_parser( &md_depth_control::exposure_roi_top, md_depth_control_attributes::roi_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_EXPOSURE_ROI_BOTTOM, make_attribute_parser( &md_depth_control::exposure_roi_bottom, md_depth_control_attributes::roi_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_FRAME_EMITTER_MODE, make_attribute_parser( &md_depth_control::emitterMode, md_depth_control_attributes::emitter_mode_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_FRAME_LED_POWER, make_attribute_parser( &md_depth_control::ledPower, md_depth_control_attributes::led_power_attribute, offset ) );
+
+    offset = metadata_raw_mode_offset + offsetof( md_depth_mode, depth_y_mode ) + offsetof( md_depth_y_normal_mode, intel_configuration );
+    p.emplace_back( (rs2_frame_metadata_value)RS2_FRAME_METADATA_HW_TYPE, make_attribute_parser( &md_configuration::hw_type, md_configuration_attributes::hw_type_attribute, offset ) );
+    p.emplace_back( (rs2_frame_metadata_value)RS2_FRAME_METADATA_SKU_ID, make_attribute_parser( &md_configuration::sku_id, md_configuration_attributes::sku_id_attribute, offset ) );
+    p.emplace_back( (rs2_frame_metadata_value)RS2_FRAME_METADATA_FORMAT, make_attribute_parser( &md_configuration::format, md_configuration_attributes::format_attribute, offset ) );
+    p.emplace_back( (rs2_frame_metadata_value)RS2_FRAME_METADATA_WIDTH, make_attribute_parser( &md_configuration::width, md_configuration_attributes::width_attribute, offset ) );
+    p.emplace_back( (rs2_frame_metadata_value)RS2_FRAME_METADATA_HEIGHT, make_attribute_parser( &md_configuration::height, md_configuration_attributes::height_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_GPIO_INPUT_DATA, make_attribute_parser( &md_configuration::gpioInputData, md_configuration_attributes::gpio_input_data_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_SEQUENCE_SIZE, make_attribute_parser( &md_configuration::sub_preset_info, md_configuration_attributes::sub_preset_info_attribute, offset,
+        []( const rs2_metadata_type & param ) {
+            return ( param & md_configuration::SUB_PRESET_BIT_MASK_SEQUENCE_SIZE ) >> md_configuration::SUB_PRESET_BIT_OFFSET_SEQUENCE_SIZE;
+        } ) );
+    p.emplace_back( RS2_FRAME_METADATA_SEQUENCE_ID, make_attribute_parser( &md_configuration::sub_preset_info, md_configuration_attributes::sub_preset_info_attribute, offset,
+        []( const rs2_metadata_type & param ) {
+            return ( param & md_configuration::SUB_PRESET_BIT_MASK_SEQUENCE_ID ) >> md_configuration::SUB_PRESET_BIT_OFFSET_SEQUENCE_ID;
+        } ) );
+    p.emplace_back( RS2_FRAME_METADATA_SEQUENCE_NAME, make_attribute_parser( &md_configuration::sub_preset_info, md_configuration_attributes::sub_preset_info_attribute, offset,
+        []( const rs2_metadata_type & param ) {
+            return ( param & md_configuration::SUB_PRESET_BIT_MASK_ID ) >> md_configuration::SUB_PRESET_BIT_OFFSET_ID;
+        } ) );
+    return p;
+}
+
+
+// The parsers as ds_color_common::register_metadata() registered them
+parsers reference_color_parsers()
+{
+    parsers p;
+    auto offset = metadata_raw_mode_offset + offsetof( md_rgb_mode, rgb_mode ) + offsetof( md_rgb_normal_mode, intel_capture_timing );
+    p.emplace_back( RS2_FRAME_METADATA_FRAME_COUNTER, make_attribute_parser( &md_capture_timing::frame_counter, md_capture_timing_attributes::frame_counter_attribute, offset ) );
+
+    offset = metadata_raw_mode_offset + offsetof( md_rgb_mode, rgb_mode ) + offsetof( md_rgb_normal_mode, intel_capture_stats );
+    p.emplace_back( RS2_FRAME_METADATA_WHITE_BALANCE, make_attribute_parser( &md_capture_stats::white_balance, md_capture_stat_attributes::white_balance_attribute, offset ) );
+
+    auto as_short = []( const rs2_metadata_type & param ) { return rs2_metadata_type( *(short *)&( param ) ); };
+    offset = metadata_raw_mode_offset + offsetof( md_rgb_mode, rgb_mode ) + offsetof( md_rgb_normal_mode, intel_rgb_control );
+    p.emplace_back( RS2_FRAME_METADATA_GAIN_LEVEL, make_attribute_parser( &md_rgb_control::gain, md_rgb_control_attributes::gain_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_ACTUAL_EXPOSURE, make_attribute_parser( &md_rgb_control::manual_exp, md_rgb_control_attributes::manual_exp_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_BRIGHTNESS, make_attribute_parser( &md_rgb_control::brightness, md_rgb_control_attributes::brightness_attribute, offset, as_short ) );
+    p.emplace_back( RS2_FRAME_METADATA_CONTRAST, make_attribute_parser( &md_rgb_control::contrast, md_rgb_control_attributes::contrast_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_SATURATION, make_attribute_parser( &md_rgb_control::saturation, md_rgb_control_attributes::saturation_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_SHARPNESS, make_attribute_parser( &md_rgb_control::sharpness, md_rgb_control_attributes::sharpness_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_AUTO_WHITE_BALANCE_TEMPERATURE, make_attribute_parser( &md_rgb_control::awb_temp, md_rgb_control_attributes::awb_temp_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_BACKLIGHT_COMPENSATION, make_attribute_parser( &md_rgb_control::backlight_comp, md_rgb_control_attributes::backlight_comp_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_GAMMA, make_attribute_parser( &md_rgb_control::gamma, md_rgb_control_attributes::gamma_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_HUE, make_attribute_parser( &md_rgb_control::hue, md_rgb_control_attributes::hue_attribute, offset, as_short ) );
+    p.emplace_back( RS2_FRAME_METADATA_MANUAL_WHITE_BALANCE, make_attribute_parser( &md_rgb_control::manual_wb, md_rgb_control_attributes::manual_wb_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_POWER_LINE_FREQUENCY, make_attribute_parser( &md_rgb_control::power_line_frequency, md_rgb_control_attributes::power_line_frequency_attribute, offset ) );
+    p.emplace_back( RS2_FRAME_METADATA_LOW_LIGHT_COMPENSATION, make_attribute_parser( &md_rgb_control::low_light_comp, md_rgb_control_attributes::low_light_comp_attribute, offset ) );
+    return p;
+}
+
+
+// What the sensor would register from the tables
+class recorder
+{
+public:
+    mutable parsers registered;
+
+    void register_metadata( rs2_frame_metadata_value key, std::shared_ptr< md_attribute_parser_base > parser ) const
+    {
+        registered.emplace_back( key, parser );
+    }
+};
+
+
+template< class S >
+void fill( S & s, std::mt19937 & gen )
+{
+    auto bytes = reinterpret_cast< uint8_t * >( &s );
+    for( size_t i = 0; i < sizeof( S ); ++i )
+        bytes[i] = uint8_t( gen() );
+    s.header.md_type_id = md_type_trait< S >::type;
+    s.header.md_size = sizeof( S );
+    // Some attributes on, some off
+    s.flags = gen();
+}
+
+
+// A blob as a depth sensor captures it
+metadata_raw depth_blob( std::mt19937 & gen )
+{
+    metadata_raw md = {};
+    md.header.length = sizeof( md );
+    md.header.timestamp = gen();
+    auto & mode = md.mode.depth_mode.depth_y_mode;
+    fill( mode.intel_capture_timing, gen );
+    fill( mode.intel_capture_stats, gen );
+    fill( mode.intel_depth_control, gen );
+    fill( mode.intel_configuration, gen );
+    return md;
+}
+
+
+metadata_raw color_blob( std::mt19937 & gen )
+{
+    metadata_raw md = {};
+    md.header.length = sizeof( md );
+    md.header.timestamp = gen();
+    auto & mode = md.mode.rgb_mode.rgb_mode;
+    fill( mode.intel_capture_timing, gen );
+    fill( mode.intel_capture_stats, gen );
+    fill( mode.intel_rgb_control, gen );
+    fill( mode.intel_configuration, gen );
+    return md;
+}
+
+
+void set_blob( frame & f, metadata_raw const & md )
+{
+    f.additional_data.metadata_size = sizeof( md );
+    f.additional_data.metadata_blob = {};
+    std::memcpy( f.additional_data.metadata_blob.data(), &md, sizeof( md ) );
+}
+
+
+// Every attribute the reference parsers know must be found (or not) with the same value by the registered table parsers
+void compare( frame const & f, parsers const & reference, parsers const & tables )
+{
+    REQUIRE( tables.size() == reference.size() );
+    for( size_t i = 0; i < reference.size(); ++i )
+    {
+        auto key = reference[i].first;
+        REQUIRE( tables[i].first == key );
+        rs2_metadata_type expected = -1, actual = -1;
+        bool const found = reference[i].second->find( f, &expected );
+        CAPTURE( key );
+        CHECK( tables[i].second->find( f, &actual ) == found );
+        if( found )
+            CHECK( actual == expected );
+    }
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "metadata tables decode like the attribute parsers", "[metadata]" )
+{
+    std::mt19937 gen( 1234 );
+
+    SECTION( "depth" )
+    {
+        auto reference = reference_depth_parsers();
+        recorder sensor;
+        auto base = metadata_raw_mode_offset + offsetof( md_depth_mode, depth_y_mode );
+        register_md_layout< md_capture_timing >( sensor, base + offsetof( md_depth_y_normal_mode, intel_capture_timing ) );
+        register_md_layout< md_capture_stats >( sensor, base + offsetof( md_depth_y_normal_mode, intel_capture_stats ) );
+        register_md_layout< md_depth_control >( sensor, base + offsetof( md_depth_y_normal_mode, intel_depth_control ) );
+        register_md_layout< md_configuration >( sensor, base + offsetof( md_depth_y_normal_mode, intel_configuration ) );
+
+        for( int i = 0; i < 1000; ++i )
+        {
+            auto md = depth_blob( gen );
+            if( i % 10 == 9 )
+                md.mode.depth_mode.depth_y_mode.intel_depth_control.header.md_size -= 1;  // too short
+            if( i % 10 == 8 )
+                md.mode.depth_mode.depth_y_mode.intel_configuration.header.md_type_id = md_type::META_DATA_INTEL_STAT_ID;
+            frame f;
+            set_blob( f, md );
+
+            compare( f, reference, sensor.registered );
+        }
+    }
+    SECTION( "color" )
+    {
+        auto reference = reference_color_parsers();
+        recorder sensor;
+        auto base = metadata_raw_mode_offset + offsetof( md_rgb_mode, rgb_mode );
+        register_md_layout< md_capture_timing >( sensor, base + offsetof( md_rgb_normal_mode, intel_capture_timing ) );
+        register_md_layout< md_capture_stats >( sensor, base + offsetof( md_rgb_normal_mode, intel_capture_stats ) );
+        register_md_layout< md_rgb_control >( sensor, base + offsetof( md_rgb_normal_mode, intel_rgb_control ) );
+
+        for( int i = 0; i < 1000; ++i )
+        {
+            auto md = color_blob( gen );
+            if( i % 10 == 9 )
+                md.mode.rgb_mode.rgb_mode.intel_rgb_control.header.md_type_id = md_type::META_DATA_INTEL_DEPTH_CONTROL_ID;
+            frame f;
+            set_blob( f, md );
+
+            compare( f, reference, sensor.registered );
+        }
+    }
+    SECTION( "no metadata" )
+    {
+        frame f;
+        recorder sensor;
+        register_md_layout< md_depth_control >( sensor, metadata_raw_mode_offset );
+        for( auto & parser : sensor.registered )
+            CHECK_FALSE( parser.second->find( f, nullptr ) );
+    }
+}
+
+
+TEST_CASE( "metadata structs are decoded once per frame", "[metadata]" )
+{
+    std::mt19937 gen( 5678 );
+    recorder sensor;
+    auto offset = metadata_raw_mode_offset + offsetof( md_depth_mode, depth_y_mode )
+                + offsetof( md_depth_y_normal_mode, intel_depth_control );
+    register_md_layout< md_depth_control >( sensor, offset );
+    auto & gain = sensor.registered[0].second;
+    auto & exposure = sensor.registered[1].second;
+
+    auto md = depth_blob( gen );
+    auto & control = md.mode.depth_mode.depth_y_mode.intel_depth_control;
+    control.flags = uint32_t( md_depth_control_attributes::gain_attribute )
+                  | uint32_t( md_depth_control_attributes::exposure_attribute );
+    control.manual_gain = 10;
+    control.manual_exposure = 20;
+    frame f;
+    set_blob( f, md );
+
+    // The first parser decodes the struct; from then on, all its parsers read what was decoded (so changing the blob,
+    // which is never done to a published frame, goes unnoticed)
+    rs2_metadata_type value;
+    REQUIRE( gain->find( f, &value ) );
+    CHECK( value == 10 );
+    auto & blob_control = *reinterpret_cast< md_depth_control * >( f.additional_data.metadata_blob.data() + offset );
+    blob_control.manual_gain = 11;
+    blob_control.manual_exposure = 21;
+    REQUIRE( gain->find( f, &value ) );
+    CHECK( value == 10 );
+    REQUIRE( exposure->find( f, &value ) );
+    CHECK( value == 20 );
+
+    // Other metadata, as given to a new frame (or to this one, when recycled), is decoded again
+    frame g;
+    g.additional_data = f.additional_data;
+    REQUIRE( exposure->find( g, &value ) );
+    CHECK( value == 21 );
+    f.additional_data = g.additional_data;
+    REQUIRE( gain->find( f, &value ) );
+    CHECK( value == 11 );
+
+    // A struct that is not there is not looked for again either
+    frame h;
+    control.header.md_type_id = md_type::META_DATA_INTEL_STAT_ID;
+    set_blob( h, md );
+    CHECK_FALSE( gain->find( h, &value ) );
+    control.header.md_type_id = md_type::META_DATA_INTEL_DEPTH_CONTROL_ID;
+    std::memcpy( h.additional_data.metadata_blob.data(), &md, sizeof( md ) );
+    CHECK_FALSE( exposure->find( h, &value ) );
+}
@@ -0,0 +1,206 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:dependencies rsutils
+
+// The inline dispatcher behaves like dispatcher, but holds its actions inline in a ring allocated up-front, so invoking
+// a small action allocates nothing. The benchmark (tagged [benchmark], not run by default) compares the time from
+// invoke() until the action runs with that of dispatcher.
+
+#include <unit-tests/test.h>
+#include <rsutils/time/timer.h>
+#include <rsutils/concurrency/concurrency.h>
+#include <rsutils/concurrency/inline-dispatcher.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <vector>
+
+
+namespace {
+std::atomic< bool > counting_allocations{ false };
+std::atomic< int > allocations{ 0 };
+}
+
+void * operator new( std::size_t size )
+{
+    if( counting_allocations )
+        ++allocations;
+    if( void * p = std::malloc( size ? size : 1 ) )
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete( void * p ) noexcept
+{
+    std::free( p );
+}
+
+
+using namespace rsutils::time;
+using rsutils::concurrency::inline_action;
+using rsutils::concurrency::inline_dispatcher;
+
+
+TEST_CASE( "inline action" )
+{
+    int runs = 0;
+    inline_action small( [&runs]( dispatcher::cancellable_timer ) { ++runs; } );
+    CHECK( small );
+    CHECK_FALSE( small.on_heap() );
+
+    char big_buffer[inline_action::inline_size + 1] = { 1 };
+    inline_action big( [&runs, big_buffer]( dispatcher::cancellable_timer ) { runs += big_buffer[0]; } );
+    CHECK( big.on_heap() );
+
+    // Move-only closures are fine
+    std::unique_ptr< int > p( new int( 10 ) );
+    inline_action move_only( [&runs, p = std::move( p )]( dispatcher::cancellable_timer ) { runs += *p; } );
+    CHECK_FALSE( move_only.on_heap() );
+
+    std::atomic< bool > stopped( false );
+    std::mutex m;
+    std::condition_variable cv;
+    dispatcher::cancellable_timer t( stopped, m, cv );
+    inline_action moved( std::move( small ) );
+    CHECK_FALSE( small );
+    moved( t );
+    big( t );
+    move_only( t );
+    CHECK( runs == 12 );
+
+    moved.reset();
+    CHECK_FALSE( moved );
+}
+
+
+TEST_CASE( "inline dispatcher main flow" )
+{
+    inline_dispatcher d( 3 );
+    std::atomic_bool run = { false };
+    auto func = [&]( dispatcher::cancellable_timer c )
+    {
+        c.try_sleep( std::chrono::milliseconds( 200 ) );
+        run = true;
+    };
+
+    d.start();
+    REQUIRE( d.empty() );
+    d.invoke( func );
+    d.invoke( func );
+    REQUIRE_FALSE( d.empty() );
+    REQUIRE( d.flush() );
+    REQUIRE( run );
+    d.stop();
+}
+
+
+TEST_CASE( "inline dispatcher invoke and wait" )
+{
+    inline_dispatcher d( 2 );
+    std::atomic_bool run = { false };
+    d.start();
+    stopwatch sw;
+    d.invoke_and_wait(
+        [&]( dispatcher::cancellable_timer )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+            run = true;
+        },
+        []() { return false; },
+        true );
+    CHECK( sw.get_elapsed() >= std::chrono::milliseconds( 200 ) );
+    CHECK( run );
+    d.stop();
+}
+
+
+TEST_CASE( "inline dispatcher stop clears what is pending" )
+{
+    std::atomic< int > dropped( 0 );
+    inline_dispatcher d( 10, [&]( inline_action const & ) { ++dropped; } );
+    std::atomic< int > runs( 0 );
+    d.start();
+    d.invoke( [&]( dispatcher::cancellable_timer t ) {
+        t.try_sleep( std::chrono::milliseconds( 200 ) );
+        ++runs;
+    } );
+    d.invoke( [&]( dispatcher::cancellable_timer ) { ++runs; } );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+
+    // Like dispatcher, stop waits for the action being dispatched
+    d.stop();
+    CHECK( runs == 1 );
+
+    // Nothing is dispatched once stopped
+    d.invoke( [&]( dispatcher::cancellable_timer ) { ++runs; } );
+    CHECK( d.flush() );
+    CHECK( runs == 1 );
+    CHECK( dropped == 0 );  // cleared, not dropped, as with dispatcher
+}
+
+
+TEST_CASE( "inline dispatcher does not allocate" )
+{
+    inline_dispatcher d( 16 );
+    std::atomic< int > runs( 0 );
+    d.start();
+    REQUIRE( d.flush() );  // the dispatching thread is up and waiting
+
+    allocations = 0;
+    counting_allocations = true;
+    for( int i = 0; i < 1000; ++i )
+        d.invoke( [&runs, i]( dispatcher::cancellable_timer ) { runs += i % 2; }, true );
+    counting_allocations = false;
+    CHECK( allocations == 0 );
+
+    REQUIRE( d.flush() );
+    CHECK( runs == 500 );
+    d.stop();
+}
+
+
+namespace {
+
+
+// Median time, in usec, from invoke() until the action starts running
+template< class Dispatcher >
+double wakeup_usec()
+{
+    int const actions = 5000;
+    Dispatcher d( 16 );
+    d.start();
+    std::vector< double > usec;
+    usec.reserve( actions );
+    std::atomic< bool > ran( false );
+    for( int n = 0; n < actions; ++n )
+    {
+        ran = false;
+        auto const start = std::chrono::steady_clock::now();
+        d.invoke( [&usec, &ran, start]( dispatcher::cancellable_timer ) {
+            usec.push_back( std::chrono::duration< double, std::micro >( std::chrono::steady_clock::now() - start ).count() );
+            ran = true;
+        } );
+        while( ! ran )
+            std::this_thread::yield();
+    }
+    d.stop();
+    std::nth_element( usec.begin(), usec.begin() + usec.size() / 2, usec.end() );
+    return usec[usec.size() / 2];
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "inline dispatcher benchmark", "[.][benchmark]" )
+{
+    auto const plain = wakeup_usec< dispatcher >();
+    auto const inlined = wakeup_usec< inline_dispatcher >();
+    std::cout << "invoke to run: " << plain << " usec dispatcher, " << inlined << " usec inline" << std::endl;
+}
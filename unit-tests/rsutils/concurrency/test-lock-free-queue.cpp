@@ -0,0 +1,220 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:dependencies rsutils
+
+// The lock-free queue behaves like single_consumer_queue: dropping the oldest item when full, waiting for room in a
+// blocking enqueue, and not waiting once stopped. The benchmarks (tagged [benchmark], not run by default) compare the
+// two for throughput and latency.
+
+#include <unit-tests/test.h>
+#include <rsutils/time/timer.h>
+#include <rsutils/concurrency/concurrency.h>
+#include <rsutils/concurrency/lock-free-queue.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace rsutils::time;
+using rsutils::concurrency::lock_free_queue;
+
+
+TEST_CASE( "lock-free queue drops the oldest" )
+{
+    std::vector< int > dropped;
+    lock_free_queue< int > q( 3, [&]( int const & i ) { dropped.push_back( i ); } );
+    for( int i = 0; i < 5; ++i )
+        REQUIRE( q.enqueue( int( i ) ) );
+    CHECK( q.size() == 3 );
+    CHECK( dropped == std::vector< int >{ 0, 1 } );
+
+    int i = -1;
+    for( int expected = 2; expected < 5; ++expected )
+    {
+        REQUIRE( q.try_dequeue( &i ) );
+        CHECK( i == expected );
+    }
+    CHECK( q.empty() );
+    CHECK_FALSE( q.try_dequeue( &i ) );
+}
+
+
+TEST_CASE( "lock-free queue holds move-only items" )
+{
+    lock_free_queue< std::unique_ptr< int > > q( 2 );
+    q.enqueue( std::unique_ptr< int >( new int( 1 ) ) );
+    q.enqueue( std::unique_ptr< int >( new int( 2 ) ) );
+    q.enqueue( std::unique_ptr< int >( new int( 3 ) ) );
+    std::unique_ptr< int > p;
+    REQUIRE( q.dequeue( &p, 0 ) );
+    CHECK( *p == 2 );
+    REQUIRE( q.dequeue( &p, 0 ) );
+    CHECK( *p == 3 );
+}
+
+
+TEST_CASE( "lock-free queue dequeue waits, but not after stop" )
+{
+    lock_free_queue< int > q;
+    int i;
+    timer t( std::chrono::milliseconds( 90 ) );
+    t.start();
+    CHECK_FALSE( q.dequeue( &i, 100 ) );
+    CHECK( t.has_expired() );
+
+    std::thread producer( [&]() {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+        q.enqueue( 7 );
+    } );
+    REQUIRE( q.dequeue( &i, 2000 ) );
+    CHECK( i == 7 );
+    producer.join();
+
+    q.enqueue( 8 );
+    q.stop();
+    CHECK( q.stopped() );
+    CHECK( q.empty() );
+    CHECK_FALSE( q.enqueue( 9 ) );
+    timer t2( std::chrono::seconds( 1 ) );
+    t2.start();
+    CHECK_FALSE( q.dequeue( &i, 2000 ) );
+    CHECK_FALSE( t2.has_expired() );
+
+    q.start();
+    CHECK( q.enqueue( 10 ) );
+    REQUIRE( q.dequeue( &i, 0 ) );
+    CHECK( i == 10 );
+}
+
+
+TEST_CASE( "lock-free queue blocking enqueue waits for room" )
+{
+    lock_free_queue< int > q( 2 );
+    REQUIRE( q.blocking_enqueue( 0 ) );
+    REQUIRE( q.blocking_enqueue( 1 ) );
+
+    std::atomic< bool > enqueued( false );
+    std::thread producer( [&]() {
+        q.blocking_enqueue( 2 );
+        enqueued = true;
+    } );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    CHECK_FALSE( enqueued );
+    int i;
+    REQUIRE( q.dequeue( &i, 0 ) );
+    CHECK( i == 0 );
+    producer.join();
+    CHECK( enqueued );
+    CHECK( q.size() == 2 );
+
+    // Stopping releases a blocked producer
+    std::thread blocked( [&]() { q.blocking_enqueue( 3 ); q.blocking_enqueue( 4 ); } );
+    std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+    q.stop();
+    blocked.join();
+}
+
+
+TEST_CASE( "lock-free queue with several producers" )
+{
+    int const producers = 4;
+    int const per_producer = 100000;
+    lock_free_queue< int > q( 64 );
+    std::vector< std::thread > threads;
+    for( int p = 0; p < producers; ++p )
+        threads.emplace_back( [&q, p]() {
+            for( int i = 0; i < per_producer; ++i )
+                q.blocking_enqueue( p * per_producer + i );
+        } );
+
+    // Nothing is lost, and each producer's items arrive in order
+    std::vector< int > last( producers, -1 );
+    for( int n = 0; n < producers * per_producer; ++n )
+    {
+        int i;
+        REQUIRE( q.dequeue( &i, 5000 ) );
+        auto const p = i / per_producer;
+        REQUIRE( i % per_producer == last[p] + 1 );
+        last[p] = i % per_producer;
+    }
+    for( auto & t : threads )
+        t.join();
+    CHECK( q.empty() );
+}
+
+
+namespace {
+
+
+// Items per second through the queue, from 'producers' threads to one consumer
+template< class Queue >
+double throughput( int producers )
+{
+    int const items = 1000000;
+    Queue q( 64 );
+    auto const start = std::chrono::steady_clock::now();
+    std::vector< std::thread > threads;
+    for( int p = 0; p < producers; ++p )
+        threads.emplace_back( [&q, producers]() {
+            for( int i = 0; i < items / producers; ++i )
+                q.blocking_enqueue( int( i ) );
+        } );
+    int i;
+    for( int n = 0; n < items / producers * producers; ++n )
+        q.dequeue( &i, 5000 );
+    auto const seconds = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    for( auto & t : threads )
+        t.join();
+    return items / seconds;
+}
+
+
+// Median round-trip, in usec, of an item sent to another thread and back
+template< class Queue >
+double round_trip_usec()
+{
+    int const trips = 20000;
+    Queue there( 8 ), back( 8 );
+    std::thread echo( [&]() {
+        int i;
+        for( int n = 0; n < trips; ++n )
+            if( there.dequeue( &i, 5000 ) )
+                back.enqueue( int( i ) );
+    } );
+    std::vector< double > usec;
+    usec.reserve( trips );
+    for( int n = 0; n < trips; ++n )
+    {
+        auto const start = std::chrono::steady_clock::now();
+        there.enqueue( int( n ) );
+        int i;
+        back.dequeue( &i, 5000 );
+        usec.push_back( std::chrono::duration< double, std::micro >( std::chrono::steady_clock::now() - start ).count() );
+    }
+    echo.join();
+    std::nth_element( usec.begin(), usec.begin() + trips / 2, usec.end() );
+    return usec[trips / 2];
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "lock-free queue benchmark", "[.][benchmark]" )
+{
+    for( int producers : { 1, 3 } )
+    {
+        auto const locked = throughput< single_consumer_queue< int > >( producers );
+        auto const lock_free = throughput< lock_free_queue< int > >( producers );
+        std::cout << producers << " producer(s): " << locked / 1e6 << " M items/sec locked, " << lock_free / 1e6
+                  << " M items/sec lock-free" << std::endl;
+    }
+    auto const locked = round_trip_usec< single_consumer_queue< int > >();
+    auto const lock_free = round_trip_usec< lock_free_queue< int > >();
+    std::cout << "round trip: " << locked << " usec locked, " << lock_free << " usec lock-free" << std::endl;
+}
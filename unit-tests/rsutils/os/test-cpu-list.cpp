@@ -0,0 +1,47 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake:dependencies rsutils
+
+#include <unit-tests/test.h>
+#include <rsutils/os/thread.h>
+#include <stdexcept>
+
+using rsutils::os::parse_cpu_list;
+using cpus = std::vector< int >;
+
+
+TEST_CASE( "parse_cpu_list" )
+{
+    CHECK( parse_cpu_list( "" ) == cpus{} );
+    CHECK( parse_cpu_list( "3" ) == cpus{ 3 } );
+    CHECK( parse_cpu_list( "0-3" ) == cpus{ 0, 1, 2, 3 } );
+    CHECK( parse_cpu_list( "0-1,8,10-11" ) == cpus{ 0, 1, 8, 10, 11 } );
+    CHECK( parse_cpu_list( "5-5" ) == cpus{ 5 } );
+}
+
+
+TEST_CASE( "parse_cpu_list errors" )
+{
+    CHECK_THROWS_AS( parse_cpu_list( "a" ), std::invalid_argument );
+    CHECK_THROWS_AS( parse_cpu_list( "3-1" ), std::invalid_argument );
+    CHECK_THROWS_AS( parse_cpu_list( "1," ), std::invalid_argument );
+    CHECK_THROWS_AS( parse_cpu_list( "1-" ), std::invalid_argument );
+    CHECK_THROWS_AS( parse_cpu_list( "-1" ), std::invalid_argument );
+    CHECK_THROWS_AS( parse_cpu_list( "1 2" ), std::invalid_argument );
+
+    // CPUs no affinity can hold, and numbers that do not even fit an int
+    CHECK( parse_cpu_list( "1023" ) == cpus{ 1023 } );
+    CHECK_THROWS_AS( parse_cpu_list( "1024" ), std::invalid_argument );
+    CHECK_THROWS_AS( parse_cpu_list( "0-2000000000" ), std::invalid_argument );
+    CHECK_THROWS_AS( parse_cpu_list( "0-2147483647" ), std::invalid_argument );
+    CHECK_THROWS_AS( parse_cpu_list( "4294967296" ), std::invalid_argument );
+    CHECK_THROWS_AS( parse_cpu_list( "99999999999999999999999" ), std::invalid_argument );
+}
+
+
+TEST_CASE( "no-op thread settings" )
+{
+    CHECK( rsutils::os::set_current_thread_affinity( {} ) );
+    CHECK( rsutils::os::set_current_thread_realtime_priority( 0 ) );
+}
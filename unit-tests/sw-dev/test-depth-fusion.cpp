@@ -0,0 +1,182 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// Depth fusion merges the depth of calibrated cameras into the coordinate system of the first (the reference): fed two
+// cameras, it must output the points of both, the second moved by its extrinsics. When the cameras are replaced (as
+// by a restart, which gives all streams new profiles), it must pick a new reference.
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace rs2;
+
+
+namespace {
+
+
+int const W = 16, H = 12;
+float const UNITS = 0.001f;
+
+
+class camera
+{
+public:
+    camera( float ppx )
+        : _q( 10, true )
+    {
+        auto sensor = _dev.add_sensor( "Depth" );
+        _intrinsics = { W, H, ppx, H / 2.f, 20, 20, RS2_DISTORTION_NONE, { 0 } };
+        _profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, _intrinsics } );
+        sensor.add_read_only_option( RS2_OPTION_DEPTH_UNITS, UNITS );
+        sensor.open( _profile );
+        sensor.start( _q );
+        _sensor = std::make_shared< software_sensor >( sensor );
+
+        // Some holes, so only valid pixels are expected in the output
+        for( int p = 0; p < W * H; ++p )
+            _pixels.push_back( p % 5 ? uint16_t( 500 + 3 * p ) : 0 );
+    }
+
+    ~camera()
+    {
+        _sensor->stop();
+        _sensor->close();
+    }
+
+    stream_profile profile() const { return _profile; }
+
+    frame make()
+    {
+        _sensor->on_video_frame( { _pixels.data(), []( void * ) {}, W * 2, 2, rs2_time_t( _number ),
+                                   RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, _number, _profile } );
+        ++_number;
+        frame f;
+        REQUIRE( _q.try_wait_for_frame( &f, 1000 ) );
+        return f;
+    }
+
+    // The valid points, translated
+    std::vector< vertex > expected( vertex const & t ) const
+    {
+        std::vector< vertex > points;
+        for( int y = 0; y < H; ++y )
+            for( int x = 0; x < W; ++x )
+                if( auto d = _pixels[y * W + x] )
+                {
+                    float const z = d * UNITS;
+                    points.push_back( { ( x - _intrinsics.ppx ) / _intrinsics.fx * z + t.x,
+                                        ( y - _intrinsics.ppy ) / _intrinsics.fy * z + t.y,
+                                        z + t.z } );
+                }
+        return points;
+    }
+
+private:
+    int _number = 0;
+    rs2_intrinsics _intrinsics;
+    std::vector< uint16_t > _pixels;
+    software_device _dev;
+    std::shared_ptr< software_sensor > _sensor;
+    stream_profile _profile;
+    frame_queue _q;
+};
+
+
+bool less( vertex const & a, vertex const & b )
+{
+    return a.x != b.x ? a.x < b.x : a.y != b.y ? a.y < b.y : a.z < b.z;
+}
+
+
+// Points come out camera by camera, in an order of their own
+void check_same_points( points const & pts, std::vector< vertex > expected )
+{
+    REQUIRE( pts.size() == expected.size() );
+    std::vector< vertex > actual;
+    for( size_t i = 0; i < pts.size(); ++i )
+    {
+        auto & v = pts.get_vertices()[i];
+        actual.push_back( { v.x, v.y, v.z } );
+    }
+    std::sort( actual.begin(), actual.end(), less );
+    std::sort( expected.begin(), expected.end(), less );
+    for( size_t i = 0; i < actual.size(); ++i )
+    {
+        CHECK( std::abs( actual[i].x - expected[i].x ) < 1e-5f );
+        CHECK( std::abs( actual[i].y - expected[i].y ) < 1e-5f );
+        CHECK( std::abs( actual[i].z - expected[i].z ) < 1e-5f );
+    }
+}
+
+
+std::vector< vertex > operator+( std::vector< vertex > a, std::vector< vertex > const & b )
+{
+    a.insert( a.end(), b.begin(), b.end() );
+    return a;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "depth fusion of two cameras", "[software-device][post-processing]" )
+{
+    camera reference( W / 2.f ), other( W / 2.f - 1 );
+    vertex const t = { 0.1f, -0.02f, 0.005f };
+    other.profile().register_extrinsics_to( reference.profile(), { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { t.x, t.y, t.z } } );
+
+    depth_fusion fusion;
+
+    // The reference comes first, so it is the reference; alone, it is the whole cloud
+    auto out = fusion.process( reference.make() );
+    REQUIRE( out.is< points >() );
+    check_same_points( out.as< points >(), reference.expected( { 0, 0, 0 } ) );
+
+    for( int i = 0; i < 3; ++i )  // the extrinsics are cached after the first frame
+    {
+        // Frames of the other camera are kept for the next reference frame, and passed through
+        auto other_frame = other.make();
+        out = fusion.process( other_frame );
+        CHECK( out.get() == other_frame.get() );
+
+        out = fusion.process( reference.make() );
+        REQUIRE( out.is< points >() );
+        check_same_points( out.as< points >(), reference.expected( { 0, 0, 0 } ) + other.expected( t ) );
+    }
+}
+
+
+TEST_CASE( "depth fusion picks a new reference when the cameras change", "[software-device][post-processing]" )
+{
+    depth_fusion fusion;
+    {
+        camera first( W / 2.f );
+        REQUIRE( fusion.process( first.make() ).is< points >() );
+    }
+
+    // New cameras: until the first is forgotten, there is no reference frame to fuse on
+    camera reference( W / 2.f ), other( W / 2.f + 1 );
+    vertex const t = { -0.05f, 0.f, 0.01f };
+    other.profile().register_extrinsics_to( reference.profile(), { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { t.x, t.y, t.z } } );
+
+    int frames = 0;
+    frame out;
+    while( ! out.is< points >() )
+    {
+        REQUIRE( ++frames < 100 );
+        out = fusion.process( reference.make() );
+    }
+    check_same_points( out.as< points >(), reference.expected( { 0, 0, 0 } ) );
+
+    // From now on, both cameras are fused into the new reference
+    fusion.process( other.make() );
+    out = fusion.process( reference.make() );
+    REQUIRE( out.is< points >() );
+    check_same_points( out.as< points >(), reference.expected( { 0, 0, 0 } ) + other.expected( t ) );
+}
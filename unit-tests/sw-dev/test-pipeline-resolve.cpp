@@ -0,0 +1,164 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+// Resolving a pipeline config with many (software) devices connected: the first resolution pays for indexing the
+// profiles of every sensor; resolving (or starting) again should not resolve again -- until the request or the devices
+// change. can_resolve must not keep what it resolved, or it would keep its device open.
+
+#include <unit-tests/test.h>
+#include <src/context.h>
+#include <src/pipeline/config.h>
+#include <src/pipeline/pipeline.h>
+#include <src/pipeline/profile.h>
+#include <src/software-device.h>
+#include <src/software-device-info.h>
+#include <src/software-sensor.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace librealsense;
+
+
+namespace {
+
+
+int const N_DEVICES = 32;
+
+
+void add_device( std::shared_ptr< context > const & ctx, int i )
+{
+    auto info = std::make_shared< software_device_info >( ctx );
+    auto dev = std::make_shared< software_device >( info );
+    info->set_device( dev );
+    dev->register_info( RS2_CAMERA_INFO_NAME, "pipeline-resolve" );
+    dev->register_info( RS2_CAMERA_INFO_SERIAL_NUMBER, std::to_string( 1000 + i ) );
+    dev->register_info( RS2_CAMERA_INFO_PRODUCT_LINE, "D400" );
+
+    // A realistic number of profiles for each sensor, so the resolver has something to search through
+    int uid = 0;
+    std::vector< std::pair< int, int > > const resolutions
+        = { { 1280, 720 }, { 848, 480 }, { 640, 480 }, { 640, 360 }, { 480, 270 }, { 424, 240 } };
+    std::vector< int > const framerates = { 5, 15, 30, 60, 90 };
+    auto & depth = dev->add_software_sensor( "Depth" );
+    auto & color = dev->add_software_sensor( "Color" );
+    for( auto & res : resolutions )
+        for( auto fps : framerates )
+        {
+            rs2_intrinsics intr = { res.first, res.second, res.first / 2.f, res.second / 2.f, 500, 500, RS2_DISTORTION_NONE, { 0 } };
+            depth.add_video_stream( { RS2_STREAM_DEPTH, 0, uid++, res.first, res.second, fps, 2, RS2_FORMAT_Z16, intr } );
+            depth.add_video_stream( { RS2_STREAM_INFRARED, 1, uid++, res.first, res.second, fps, 1, RS2_FORMAT_Y8, intr } );
+            depth.add_video_stream( { RS2_STREAM_INFRARED, 2, uid++, res.first, res.second, fps, 1, RS2_FORMAT_Y8, intr } );
+            for( auto format : { RS2_FORMAT_YUYV, RS2_FORMAT_RGB8, RS2_FORMAT_BGR8, RS2_FORMAT_RGBA8 } )
+                color.add_video_stream( { RS2_STREAM_COLOR, 0, uid++, res.first, res.second, fps, 3, format, intr } );
+        }
+    ctx->add_device( info );
+}
+
+
+std::string serial_of( std::shared_ptr< pipeline::profile > const & profile )
+{
+    return profile->get_device()->get_info( RS2_CAMERA_INFO_SERIAL_NUMBER );
+}
+
+
+std::shared_ptr< stream_profile_interface > stream_of( std::shared_ptr< pipeline::profile > const & profile,
+                                                       rs2_stream stream )
+{
+    for( auto & sp : profile->get_active_streams() )
+        if( sp->get_stream_type() == stream )
+            return sp;
+    return {};
+}
+
+
+template< class F >
+double time_ms( F && f )
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    return std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now() - start ).count();
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "pipeline resolve with many devices", "[software-device][pipeline]" )
+{
+    auto ctx = context::make( "{\"dds\":false,\"device-mask\":256}" );  // software devices only
+    for( int i = 0; i < N_DEVICES; ++i )
+        add_device( ctx, i );
+
+    auto pipe = std::make_shared< pipeline::pipeline >( ctx );
+    auto cfg = std::make_shared< pipeline::config >();
+    cfg->enable_stream( RS2_STREAM_DEPTH, 0, 424, 240, RS2_FORMAT_Z16, 90 );
+    cfg->enable_stream( RS2_STREAM_COLOR, 0, 424, 240, RS2_FORMAT_RGB8, 90 );
+    cfg->enable_device( "1031" );  // the last one added
+    CHECK_FALSE( cfg->get_cached_resolved_profile() );
+
+    std::shared_ptr< pipeline::profile > profile;
+    auto first = time_ms( [&] { profile = cfg->resolve( pipe ); } );
+    CHECK( serial_of( profile ) == "1031" );
+    CHECK( stream_of( profile, RS2_STREAM_COLOR )->get_format() == RS2_FORMAT_RGB8 );
+    CHECK( stream_of( profile, RS2_STREAM_DEPTH )->get_framerate() == 90 );
+
+    // Kept for the pipeline to start with, and returned by the next resolve
+    CHECK( cfg->get_cached_resolved_profile() == profile );
+    std::shared_ptr< pipeline::profile > again;
+    auto cached = time_ms( [&] { again = cfg->resolve( pipe ); } );
+    CHECK( again == profile );
+
+    // A new device invalidates it
+    add_device( ctx, N_DEVICES );
+    CHECK_FALSE( cfg->get_cached_resolved_profile() );
+    auto changed = time_ms( [&] { again = cfg->resolve( pipe ); } );
+    CHECK( again != profile );
+    CHECK( serial_of( again ) == "1031" );
+    CHECK( stream_of( again, RS2_STREAM_COLOR )->get_format() == RS2_FORMAT_RGB8 );
+    profile = again;
+    CHECK( cfg->resolve( pipe ) == profile );
+
+    // So does any request change: the streams...
+    cfg->enable_stream( RS2_STREAM_COLOR, 0, 640, 480, RS2_FORMAT_BGR8, 30 );
+    CHECK_FALSE( cfg->get_cached_resolved_profile() );
+    again = cfg->resolve( pipe );
+    CHECK( again != profile );
+    auto color = As< video_stream_profile_interface >( stream_of( again, RS2_STREAM_COLOR ) );
+    REQUIRE( color );
+    CHECK( color->get_width() == 640 );
+    CHECK( color->get_format() == RS2_FORMAT_BGR8 );
+    profile = again;
+    CHECK( cfg->resolve( pipe ) == profile );
+
+    // ... or the device
+    cfg->enable_device( "1005" );
+    CHECK_FALSE( cfg->get_cached_resolved_profile() );
+    again = cfg->resolve( pipe );
+    CHECK( again != profile );
+    CHECK( serial_of( again ) == "1005" );
+
+    test::log.i( N_DEVICES, "devices: first resolve", first, "ms; cached", cached, "ms; after a device was added",
+                 changed, "ms" );
+}
+
+
+TEST_CASE( "can_resolve does not keep the resolved profile", "[software-device][pipeline]" )
+{
+    auto ctx = context::make( "{\"dds\":false,\"device-mask\":256}" );
+    add_device( ctx, 0 );
+
+    auto pipe = std::make_shared< pipeline::pipeline >( ctx );
+    auto cfg = std::make_shared< pipeline::config >();
+    cfg->enable_stream( RS2_STREAM_DEPTH, 0, 640, 480, RS2_FORMAT_Z16, 30 );
+    CHECK( cfg->can_resolve( pipe ) );
+    CHECK_FALSE( cfg->get_cached_resolved_profile() );
+
+    // Not even what an earlier resolve kept
+    auto profile = cfg->resolve( pipe );
+    CHECK( cfg->get_cached_resolved_profile() == profile );
+    CHECK( cfg->can_resolve( pipe ) );
+    CHECK_FALSE( cfg->get_cached_resolved_profile() );
+}
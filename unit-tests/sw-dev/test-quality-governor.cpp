@@ -0,0 +1,180 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// A quality governor degrades its filters, in their order, when the chain takes longer than the frame interval, and
+// restores them once there is headroom again, reporting each change as a notification.
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace rs2;
+
+
+namespace {
+
+
+int const W = 64;
+int const H = 48;
+int const FPS = 200;  // 5 ms between frames
+
+
+class depth_source
+{
+public:
+    depth_source()
+        : _pixels( W * H, 1000 )
+        , _q( 100, true )
+    {
+        auto sensor = _dev.add_sensor( "Depth" );
+        rs2_intrinsics intr = { W, H, W / 2.f, H / 2.f, 60, 60, RS2_DISTORTION_NONE, { 0 } };
+        _profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, FPS, 2, RS2_FORMAT_Z16, intr } );
+        sensor.add_read_only_option( RS2_OPTION_DEPTH_UNITS, 0.001f );
+        sensor.open( _profile );
+        sensor.start( _q );
+        _sensor = std::make_shared< software_sensor >( sensor );
+    }
+
+    ~depth_source()
+    {
+        _sensor->stop();
+        _sensor->close();
+    }
+
+    frame make()
+    {
+        _sensor->on_video_frame( { _pixels.data(), []( void * ) {}, W * 2, 2, rs2_time_t( _number ),
+                                   RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, _number, _profile } );
+        ++_number;
+        frame f;
+        REQUIRE( _q.try_wait_for_frame( &f, 1000 ) );
+        return f;
+    }
+
+private:
+    std::vector< uint16_t > _pixels;
+    int _number = 0;
+    software_device _dev;
+    std::shared_ptr< software_sensor > _sensor;
+    stream_profile _profile;
+    frame_queue _q;
+};
+
+
+// Takes cost_ms for a full-resolution frame, less for a decimated one
+filter make_slow_filter( std::atomic< float > & cost_ms )
+{
+    return filter( [&cost_ms]( frame f, frame_source & source ) {
+        auto vf = f.as< video_frame >();
+        auto const ms = cost_ms * vf.get_width() * vf.get_height() / ( W * H );
+        std::this_thread::sleep_for( std::chrono::microseconds( int( ms * 1000 ) ) );
+        source.frame_ready( f );
+    } );
+}
+
+
+class notifications
+{
+public:
+    void operator()( notification n )
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        _received.push_back( n );
+    }
+
+    // They are raised asynchronously
+    std::vector< notification > wait_for( size_t count )
+    {
+        for( int i = 0; i < 100; ++i )
+        {
+            {
+                std::lock_guard< std::mutex > lock( _mutex );
+                if( _received.size() >= count )
+                    return _received;
+            }
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        }
+        std::lock_guard< std::mutex > lock( _mutex );
+        return _received;
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector< notification > _received;
+};
+
+
+}  // namespace
+
+
+TEST_CASE( "quality governor degrades and restores", "[software-device][post-processing]" )
+{
+    depth_source source;
+    std::atomic< float > cost_ms( 15.f );  // 3 frame intervals at full resolution, 0.75 decimated by 2
+
+    decimation_filter decimation;
+    decimation.set_option( RS2_OPTION_FILTER_MAGNITUDE, 1 );
+    quality_governor governor;
+    governor.add( decimation, 0 );
+    governor.add( make_slow_filter( cost_ms ), -1 );
+    auto received = std::make_shared< notifications >();
+    governor.set_notifications_callback( [received]( notification n ) { ( *received )( n ); } );
+
+    video_frame out = governor.process( source.make() );
+    CHECK( out.get_width() == W );
+    for( int i = 0; i < 60; ++i )
+        out = governor.process( source.make() );
+
+    // Decimated just enough to keep up
+    CHECK( governor.get_level() == 1 );
+    CHECK( decimation.get_option( RS2_OPTION_FILTER_MAGNITUDE ) == 2 );
+    CHECK( out.get_width() == W / 2 );
+    auto n = received->wait_for( 1 );
+    REQUIRE( n.size() == 1 );
+    CHECK( n[0].get_category() == RS2_NOTIFICATION_CATEGORY_PROCESSING_QUALITY );
+    CHECK( n[0].get_severity() == RS2_LOG_SEVERITY_WARN );
+
+    // With the load gone, back to full resolution
+    cost_ms = 0.f;
+    for( int i = 0; i < 100; ++i )
+        out = governor.process( source.make() );
+    CHECK( governor.get_level() == 0 );
+    CHECK( decimation.get_option( RS2_OPTION_FILTER_MAGNITUDE ) == 1 );
+    CHECK( out.get_width() == W );
+    n = received->wait_for( 2 );
+    REQUIRE( n.size() == 2 );
+    CHECK( n[1].get_severity() == RS2_LOG_SEVERITY_INFO );
+}
+
+
+TEST_CASE( "quality governor degrades in order", "[software-device][post-processing]" )
+{
+    depth_source source;
+    std::atomic< float > cost_ms( 15.f );
+
+    decimation_filter decimation;
+    decimation.set_option( RS2_OPTION_FILTER_MAGNITUDE, 1 );
+    hole_filling_filter holes;
+    quality_governor governor;
+    governor.add( decimation, 1 );
+    governor.add( make_slow_filter( cost_ms ), -1 );
+    governor.add( holes, 0 );
+    auto received = std::make_shared< notifications >();
+    governor.set_notifications_callback( [received]( notification n ) { ( *received )( n ); } );
+
+    // Skipping hole filling is not enough here, so decimation follows
+    for( int i = 0; i < 60; ++i )
+        governor.process( source.make() );
+    CHECK( governor.get_level() == 2 );
+    CHECK( decimation.get_option( RS2_OPTION_FILTER_MAGNITUDE ) == 2 );
+    auto n = received->wait_for( 2 );
+    REQUIRE( n.size() == 2 );
+    CHECK( n[0].get_description().find( "Hole Filling" ) != std::string::npos );
+    CHECK( n[1].get_description().find( "Decimation" ) != std::string::npos );
+}
@@ -0,0 +1,272 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// Depth processing blocks with a region of interest compute only inside it and copy (filters) or zero (colorizer,
+// pointcloud) the rest; the region follows the frame, so region-aware blocks downstream without a region of their own
+// use it -- but not past a block that does not know about regions.
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace rs2;
+
+
+namespace {
+
+
+int const W = 64;
+int const H = 48;
+
+// Pixels [16,48) x [12,36)
+float const MIN_X = .25f, MIN_Y = .25f, MAX_X = .75f, MAX_Y = .75f;
+int const X0 = 16, Y0 = 12, X1 = 48, Y1 = 36;
+
+
+class depth_source
+{
+public:
+    depth_source( int w, int h )
+        : _w( w )
+        , _h( h )
+        , _q( 100, true )
+    {
+        auto sensor = _dev.add_sensor( "Depth" );
+        rs2_intrinsics intr = { w, h, w / 2.f, h / 2.f, 60, 60, RS2_DISTORTION_NONE, { 0 } };
+        _profile = sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, w, h, 30, 2, RS2_FORMAT_Z16, intr } );
+        sensor.add_read_only_option( RS2_OPTION_DEPTH_UNITS, 0.001f );
+        sensor.open( _profile );
+        sensor.start( _q );
+        _sensor = std::make_shared< software_sensor >( sensor );
+    }
+
+    ~depth_source()
+    {
+        _sensor->stop();
+        _sensor->close();
+    }
+
+    depth_frame make( std::vector< uint16_t > & pixels )
+    {
+        _sensor->on_video_frame( { pixels.data(), []( void * ) {}, _w * 2, 2, rs2_time_t( _number ),
+                                   RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, _number, _profile } );
+        ++_number;
+        frame f;
+        REQUIRE( _q.try_wait_for_frame( &f, 1000 ) );
+        return f.as< depth_frame >();
+    }
+
+private:
+    int _w, _h;
+    int _number = 0;
+    software_device _dev;
+    std::shared_ptr< software_sensor > _sensor;
+    stream_profile _profile;
+    frame_queue _q;
+};
+
+
+std::vector< uint16_t > random_depth( std::mt19937 & gen, int w, int h )
+{
+    // Smooth-ish surface with holes, so the filters have something to do
+    std::uniform_int_distribution< int > noise( -20, 20 ), hole( 0, 9 );
+    std::vector< uint16_t > pixels( w * h );
+    for( int y = 0; y < h; ++y )
+        for( int x = 0; x < w; ++x )
+            pixels[y * w + x] = hole( gen ) ? uint16_t( 1000 + 10 * x + 5 * y + noise( gen ) ) : 0;
+    return pixels;
+}
+
+
+std::vector< uint16_t > crop( std::vector< uint16_t > const & pixels )
+{
+    std::vector< uint16_t > cropped;
+    for( int y = Y0; y < Y1; ++y )
+        cropped.insert( cropped.end(), pixels.begin() + y * W + X0, pixels.begin() + y * W + X1 );
+    return cropped;
+}
+
+
+void set_roi( options & block )
+{
+    block.set_option( RS2_OPTION_ROI_MIN_X, MIN_X );
+    block.set_option( RS2_OPTION_ROI_MIN_Y, MIN_Y );
+    block.set_option( RS2_OPTION_ROI_MAX_X, MAX_X );
+    block.set_option( RS2_OPTION_ROI_MAX_Y, MAX_Y );
+}
+
+
+bool inside( int x, int y )
+{
+    return x >= X0 && x < X1 && y >= Y0 && y < Y1;
+}
+
+
+}  // namespace
+
+
+TEST_CASE( "spatial filter in a region of interest", "[software-device][post-processing]" )
+{
+    std::mt19937 gen( 1 );
+    depth_source full( W, H ), cropped( X1 - X0, Y1 - Y0 );
+    spatial_filter in_roi, whole;
+    set_roi( in_roi );
+
+    for( int i = 0; i < 5; ++i )
+    {
+        auto pixels = random_depth( gen, W, H );
+        auto pixels_in_roi = crop( pixels );
+        auto out = in_roi.process( full.make( pixels ) );
+        auto expected = whole.process( cropped.make( pixels_in_roi ) );
+
+        // Inside, as if the region was the whole image; outside, the input
+        auto data = reinterpret_cast< const uint16_t * >( out.get_data() );
+        auto expected_data = reinterpret_cast< const uint16_t * >( expected.get_data() );
+        for( int y = 0; y < H; ++y )
+            for( int x = 0; x < W; ++x )
+                if( inside( x, y ) )
+                    REQUIRE( data[y * W + x] == expected_data[( y - Y0 ) * ( X1 - X0 ) + x - X0] );
+                else
+                    REQUIRE( data[y * W + x] == pixels[y * W + x] );
+    }
+}
+
+
+TEST_CASE( "temporal filter in a region of interest", "[software-device][post-processing]" )
+{
+    std::mt19937 gen( 2 );
+    depth_source source( W, H );
+    temporal_filter in_roi, whole;
+    set_roi( in_roi );
+
+    for( int i = 0; i < 10; ++i )
+    {
+        auto pixels = random_depth( gen, W, H );
+        auto f = source.make( pixels );
+        auto out = in_roi.process( f );
+        auto expected = whole.process( f );
+
+        // Pixels are independent: inside, the same as filtering the whole image
+        auto data = reinterpret_cast< const uint16_t * >( out.get_data() );
+        auto expected_data = reinterpret_cast< const uint16_t * >( expected.get_data() );
+        for( int y = 0; y < H; ++y )
+            for( int x = 0; x < W; ++x )
+                REQUIRE( data[y * W + x] == ( inside( x, y ) ? expected_data[y * W + x] : pixels[y * W + x] ) );
+    }
+}
+
+
+TEST_CASE( "region of interest follows the frame", "[software-device][post-processing]" )
+{
+    std::mt19937 gen( 3 );
+    depth_source source( W, H );
+    hole_filling_filter filled;
+    set_roi( filled );
+    colorizer color;
+    pointcloud pc;
+
+    auto pixels = random_depth( gen, W, H );
+    auto f = source.make( pixels );
+    auto whole_points = pc.calculate( f );
+
+    // Neither the colorizer nor the pointcloud have a region of their own: they use the one recorded by the filter
+    auto depth = filled.process( f ).as< depth_frame >();
+    auto rgb = color.process( depth );
+    auto points = pc.calculate( depth );
+    auto rgb_data = reinterpret_cast< const uint8_t * >( rgb.get_data() );
+    auto vertices = points.get_vertices();
+    auto depth_data = reinterpret_cast< const uint16_t * >( depth.get_data() );
+    auto whole_vertices = whole_points.get_vertices();
+    for( int y = 0; y < H; ++y )
+        for( int x = 0; x < W; ++x )
+        {
+            int const i = y * W + x;
+            if( inside( x, y ) )
+            {
+                if( pixels[i] )
+                {
+                    REQUIRE( vertices[i].z == whole_vertices[i].z );
+                    REQUIRE( vertices[i].x == whole_vertices[i].x );
+                    REQUIRE( ( rgb_data[3 * i] || rgb_data[3 * i + 1] || rgb_data[3 * i + 2] ) );
+                }
+            }
+            else
+            {
+                REQUIRE( depth_data[i] == pixels[i] );
+                REQUIRE( vertices[i].z == 0 );
+                REQUIRE( ! rgb_data[3 * i] );
+                REQUIRE( ! rgb_data[3 * i + 1] );
+                REQUIRE( ! rgb_data[3 * i + 2] );
+            }
+        }
+}
+
+
+TEST_CASE( "pointcloud in a region of interest starting anywhere", "[software-device][post-processing]" )
+{
+    // A width that is 4 mod 8 (as 848 or 1280 decimated by 3), so with an odd first row the region starts in the middle
+    // of a group of 8 pixels; and an image that does not end on one
+    int const w = 284, h = 31;
+    std::mt19937 gen( 4 );
+    depth_source source( w, h );
+    pointcloud whole;
+
+    auto pixels = random_depth( gen, w, h );
+    auto f = source.make( pixels );
+    auto whole_points = whole.calculate( f );
+    auto whole_vertices = whole_points.get_vertices();
+
+    for( auto rows : { std::make_pair( 3, 27 ), std::make_pair( 1, h ), std::make_pair( 5, 6 ) } )
+    {
+        // Fractions in the middle of the edge rows, so they round to them
+        pointcloud pc;
+        pc.set_option( RS2_OPTION_ROI_MIN_Y, ( rows.first + .5f ) / h );
+        pc.set_option( RS2_OPTION_ROI_MAX_Y, ( rows.second - .5f ) / h );
+        auto points = pc.calculate( f );
+        auto vertices = points.get_vertices();
+        for( int i = 0; i < w * h; ++i )
+        {
+            int const y = i / w;
+            if( y >= rows.first && y < rows.second )
+            {
+                REQUIRE( vertices[i].x == whole_vertices[i].x );
+                REQUIRE( vertices[i].y == whole_vertices[i].y );
+                REQUIRE( vertices[i].z == whole_vertices[i].z );
+            }
+            else
+                REQUIRE( vertices[i].z == 0 );
+        }
+    }
+}
+
+
+TEST_CASE( "region of interest does not follow through other blocks", "[software-device][post-processing]" )
+{
+    std::mt19937 gen( 5 );
+    depth_source source( W, H );
+    hole_filling_filter filled;
+    set_roi( filled );
+    threshold_filter threshold;  // no region of interest
+    colorizer color;
+    pointcloud pc;
+
+    auto pixels = random_depth( gen, W, H );
+    auto depth = threshold.process( filled.process( source.make( pixels ) ) ).as< depth_frame >();
+
+    // The threshold output is a whole frame again: all of it is colorized and deprojected
+    auto rgb = color.process( depth );
+    auto points = pc.calculate( depth );
+    auto rgb_data = reinterpret_cast< const uint8_t * >( rgb.get_data() );
+    auto depth_data = reinterpret_cast< const uint16_t * >( depth.get_data() );
+    auto vertices = points.get_vertices();
+    for( int i = 0; i < W * H; ++i )
+        if( depth_data[i] )
+        {
+            REQUIRE( vertices[i].z != 0 );
+            REQUIRE( ( rgb_data[3 * i] || rgb_data[3 * i + 1] || rgb_data[3 * i + 2] ) );
+        }
+}
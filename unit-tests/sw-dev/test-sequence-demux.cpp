@@ -0,0 +1,102 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+// A depth stream captured with a sequence of exposures is split by sequence id into one logical depth stream per id,
+// each with a stable profile of its own; frames outside a sequence are untouched.
+
+#include <unit-tests/test.h>
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <cstring>
+#include <map>
+#include <vector>
+
+using namespace rs2;
+
+
+namespace {
+
+
+int const W = 16;
+int const H = 8;
+
+
+}  // namespace
+
+
+TEST_CASE( "sequence demux", "[software-device][post-processing]" )
+{
+    software_device dev;
+    auto depth_sensor = dev.add_sensor( "Depth" );
+    rs2_intrinsics intr = { W, H, W / 2.f, H / 2.f, 100, 100, RS2_DISTORTION_NONE, { 0 } };
+    auto depth_profile = depth_sensor.add_video_stream( { RS2_STREAM_DEPTH, 0, 0, W, H, 30, 2, RS2_FORMAT_Z16, intr } );
+    depth_sensor.add_read_only_option( RS2_OPTION_DEPTH_UNITS, 0.001f );
+
+    frame_queue q( 100, true );
+    depth_sensor.open( depth_profile );
+    depth_sensor.start( q );
+
+    // Alternate two exposures, then leave the sequence
+    int const N = 20;
+    std::vector< std::vector< uint16_t > > pixels( N + 2, std::vector< uint16_t >( W * H ) );
+    for( int i = 0; i < N + 2; ++i )
+    {
+        for( int p = 0; p < W * H; ++p )
+            pixels[i][p] = uint16_t( i * 1000 + p );
+        bool const in_sequence = i < N;
+        depth_sensor.set_metadata( RS2_FRAME_METADATA_SEQUENCE_SIZE, in_sequence ? 2 : 0 );
+        depth_sensor.set_metadata( RS2_FRAME_METADATA_SEQUENCE_ID, in_sequence ? i % 2 : 0 );
+        depth_sensor.on_video_frame( { pixels[i].data(), []( void * ) {}, W * 2, 2, rs2_time_t( i ),
+                                       RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, i, depth_profile } );
+    }
+
+    sequence_demux demux;
+    std::map< int, int > unique_id_by_index;
+    for( int i = 0; i < N + 2; ++i )
+    {
+        frame f;
+        REQUIRE( q.try_wait_for_frame( &f, 1000 ) );
+        auto out = demux.process( f );
+        REQUIRE( out.is< depth_frame >() );
+        auto const profile = out.get_profile();
+        CHECK( profile.stream_type() == RS2_STREAM_DEPTH );
+        CHECK( profile.format() == RS2_FORMAT_Z16 );
+        if( i < N )
+        {
+            CHECK( profile.stream_index() == i % 2 + 1 );
+            CHECK( out.get_frame_metadata( RS2_FRAME_METADATA_SEQUENCE_ID ) == i % 2 );
+            auto vp = profile.as< video_stream_profile >();
+            CHECK( vp.width() == W );
+            CHECK( vp.get_intrinsics().fx == intr.fx );
+            // The same profile is reused for all frames of an id
+            auto it = unique_id_by_index.emplace( profile.stream_index(), profile.unique_id() ).first;
+            CHECK( it->second == profile.unique_id() );
+        }
+        else
+        {
+            CHECK( profile.stream_index() == 0 );
+            CHECK( out.get() == f.get() );
+        }
+        CHECK( out.get_frame_number() == f.get_frame_number() );
+        CHECK( ! std::memcmp( out.get_data(), pixels[i].data(), W * H * 2 ) );
+        CHECK( out.as< depth_frame >().get_distance( 1, 1 ) == f.as< depth_frame >().get_distance( 1, 1 ) );
+    }
+    CHECK( unique_id_by_index.size() == 2 );
+    CHECK( unique_id_by_index[1] != unique_id_by_index[2] );
+
+    // A demuxed frame is not split again
+    depth_sensor.set_metadata( RS2_FRAME_METADATA_SEQUENCE_SIZE, 2 );
+    depth_sensor.set_metadata( RS2_FRAME_METADATA_SEQUENCE_ID, 1 );
+    depth_sensor.on_video_frame( { pixels[0].data(), []( void * ) {}, W * 2, 2, rs2_time_t( N + 2 ),
+                                   RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME, N + 2, depth_profile } );
+    frame f;
+    REQUIRE( q.try_wait_for_frame( &f, 1000 ) );
+    auto once = demux.process( f );
+    auto twice = demux.process( once );
+    CHECK( once.get_profile().stream_index() == 2 );
+    CHECK( twice.get() == once.get() );
+
+    depth_sensor.stop();
+    depth_sensor.close();
+}
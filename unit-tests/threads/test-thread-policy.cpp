@@ -0,0 +1,163 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2024 Intel Corporation. All Rights Reserved.
+
+//#cmake: static!
+
+#include <src/thread-policy.h>
+#include <src/context.h>
+#include <src/librealsense-exception.h>
+
+#include <rsutils/json.h>
+#include <rsutils/easylogging/easyloggingpp.h>
+
+#include "../catch.h"
+
+#include <thread>
+#include <vector>
+
+#if defined( __linux__ ) && ! defined( __ANDROID__ )
+#include <pthread.h>
+#include <sched.h>
+#define LINUX_THREADS
+#endif
+
+using namespace librealsense;
+using rsutils::json;
+using cpus = std::vector< int >;
+
+
+namespace {
+
+
+char const * const SETTINGS = R"({
+    "default": { "cpus": "0-7" },
+    "capture": { "cpus": [1], "priority": 50 },
+    "hid": { "cpus": "2-3" },
+    "devices": {
+        "dev1": { "cpus": "4", "capture": { "cpus": [5] } },
+        "dev2": { "hid": { "priority": 10 } }
+    }
+})";
+
+
+// Runs the function on a thread of its own, so whatever the policy does to it does not stick to the test
+template< class F >
+void on_new_thread( F && f )
+{
+    std::thread( std::forward< F >( f ) ).join();
+}
+
+
+#ifdef LINUX_THREADS
+cpus current_affinity()
+{
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    pthread_getaffinity_np( pthread_self(), sizeof( set ), &set );
+    cpus result;
+    for( int cpu = 0; cpu < CPU_SETSIZE; ++cpu )
+        if( CPU_ISSET( cpu, &set ) )
+            result.push_back( cpu );
+    return result;
+}
+#endif
+
+
+}  // namespace
+
+
+TEST_CASE( "most specific rule wins", "[thread-policy]" )
+{
+    thread_policy::configure( json::parse( SETTINGS ) );
+
+    CHECK( thread_policy::find_rule( thread_role::capture, "dev1" ).cpus == cpus{ 5 } );   // device+role
+    CHECK( thread_policy::find_rule( thread_role::hid, "dev1" ).cpus == cpus{ 4 } );       // device
+    CHECK( thread_policy::find_rule( thread_role::hid, "dev2" ).priority == 10 );          // device+role
+    CHECK( thread_policy::find_rule( thread_role::hid, "dev2" ).cpus.empty() );
+    CHECK( thread_policy::find_rule( thread_role::capture, "dev2" ).cpus == cpus{ 1 } );   // role: dev2 has no rule
+    CHECK( thread_policy::find_rule( thread_role::capture, "" ).priority == 50 );          // role
+    CHECK( thread_policy::find_rule( thread_role::hid, "dev3" ).cpus == cpus{ 2, 3 } );    // role: unknown device
+    CHECK( thread_policy::find_rule( thread_role::playback, "" ).cpus.size() == 8 );       // default
+    CHECK( thread_policy::find_rule( thread_role::playback, "dev1" ).cpus == cpus{ 4 } );  // device
+
+    thread_policy::configure( json() );
+}
+
+
+TEST_CASE( "configure replaces or clears the policy", "[thread-policy]" )
+{
+    thread_policy::configure( json::parse( SETTINGS ) );
+    thread_policy::configure( json::parse( R"({ "record": { "cpus": [0] } })" ) );
+    CHECK( thread_policy::find_rule( thread_role::record, "" ).cpus == cpus{ 0 } );
+    CHECK( thread_policy::find_rule( thread_role::capture, "dev1" ).cpus.empty() );
+    CHECK( thread_policy::find_rule( thread_role::capture, "dev1" ).priority == 0 );
+
+    thread_policy::configure( json() );
+    CHECK( thread_policy::find_rule( thread_role::record, "" ).cpus.empty() );
+
+    // Bad settings throw and leave the policy as it was
+    thread_policy::configure( json::parse( R"({ "record": { "cpus": [0] } })" ) );
+    CHECK_THROWS_AS( thread_policy::configure( json::parse( R"({ "hid": { "cpus": "x" } })" ) ), invalid_value_exception );
+    CHECK_THROWS_AS( thread_policy::configure( json::parse( R"({ "hid": { "priority": 100 } })" ) ), invalid_value_exception );
+    CHECK_THROWS_AS( thread_policy::configure( json::parse( R"([ 1 ])" ) ), invalid_value_exception );
+    CHECK( thread_policy::find_rule( thread_role::record, "" ).cpus == cpus{ 0 } );
+
+    thread_policy::configure( json() );
+}
+
+
+TEST_CASE( "a context without thread settings keeps the policy", "[thread-policy]" )
+{
+    auto with = context::make( json::parse( R"({ "threads": { "capture": { "cpus": [0] } } })" ) );
+    CHECK( thread_policy::find_rule( thread_role::capture, "" ).cpus == cpus{ 0 } );
+
+    auto without = context::make( json::object() );
+    CHECK( thread_policy::find_rule( thread_role::capture, "" ).cpus == cpus{ 0 } );
+
+    // Only null thread settings clear it
+    auto cleared = context::make( json::parse( R"({ "threads": null })" ) );
+    CHECK( thread_policy::find_rule( thread_role::capture, "" ).cpus.empty() );
+}
+
+
+TEST_CASE( "apply is cached per role, device and policy", "[thread-policy]" )
+{
+    thread_policy::configure( json() );
+    on_new_thread( [] {
+        CHECK( thread_policy::apply( thread_role::capture, "dev1" ) );
+        CHECK_FALSE( thread_policy::apply( thread_role::capture, "dev1" ) );
+        CHECK( thread_policy::apply( thread_role::capture, "dev2" ) );
+        CHECK_FALSE( thread_policy::apply( thread_role::capture, "dev2" ) );
+        CHECK( thread_policy::apply( thread_role::hid, "dev2" ) );
+        CHECK( thread_policy::apply( thread_role::hid ) );
+        CHECK_FALSE( thread_policy::apply( thread_role::hid ) );
+
+        thread_policy::configure( json() );
+        CHECK( thread_policy::apply( thread_role::hid ) );
+        CHECK_FALSE( thread_policy::apply( thread_role::hid ) );
+    } );
+}
+
+
+#ifdef LINUX_THREADS
+TEST_CASE( "apply pins and unpins", "[thread-policy]" )
+{
+    auto const all = current_affinity();
+    thread_policy::configure( json::parse( R"({ "devices": { "dev1": { "cpus": [0] } } })" ) );
+    on_new_thread( [&] {
+        CHECK( thread_policy::apply( thread_role::capture, "dev1" ) );
+        CHECK( current_affinity() == cpus{ 0 } );
+
+        // Another device, with no rule of its own, must not keep the pinning of the first
+        CHECK( thread_policy::apply( thread_role::capture, "dev2" ) );
+        CHECK( current_affinity() == all );
+
+        CHECK( thread_policy::apply( thread_role::capture, "dev1" ) );
+        CHECK( current_affinity() == cpus{ 0 } );
+
+        thread_policy::configure( json() );
+        CHECK( thread_policy::apply( thread_role::capture, "dev1" ) );
+        CHECK( current_affinity() == all );
+    } );
+}
+#endif
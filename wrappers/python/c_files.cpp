@@ -156,4 +156,30 @@ void init_c_files(py::module &m) {
             return ss.str();
         });
     /** end rs_sensor.h **/
+
+    /** rs_frame.h **/
+    // Not "depth_statistics": that is the processing block that computes them
+    py::class_<rs2_depth_statistics> depth_statistics_summary(m, "depth_statistics_summary", "Statistics of the depth of a frame, over the "
+                                                              "region of interest of the depth statistics block that computed them. Depths are in meters.");
+    depth_statistics_summary.def(py::init<>())
+        .def_readwrite("total_pixels", &rs2_depth_statistics::total_pixels, "Pixels in the region of interest")
+        .def_readwrite("valid_pixels", &rs2_depth_statistics::valid_pixels, "Pixels with depth, among them")
+        .def_readwrite("valid_fraction", &rs2_depth_statistics::valid_fraction, "valid_pixels / total_pixels")
+        .def_readwrite("min", &rs2_depth_statistics::min, "Nearest valid depth; 0 when no pixel is valid")
+        .def_readwrite("max", &rs2_depth_statistics::max, "Farthest valid depth")
+        .def_readwrite("mean", &rs2_depth_statistics::mean, "Mean valid depth")
+        .def_readwrite("percentile_5", &rs2_depth_statistics::percentile_5)
+        .def_readwrite("percentile_25", &rs2_depth_statistics::percentile_25)
+        .def_readwrite("median", &rs2_depth_statistics::median)
+        .def_readwrite("percentile_75", &rs2_depth_statistics::percentile_75)
+        .def_readwrite("percentile_95", &rs2_depth_statistics::percentile_95)
+        .def_readwrite("grid_columns", &rs2_depth_statistics::grid_columns, "Columns of the grid of region means")
+        .def_readwrite("grid_rows", &rs2_depth_statistics::grid_rows, "Rows of the grid of region means")
+        .def("__repr__", [](const rs2_depth_statistics& s) {
+            std::stringstream ss;
+            ss << "valid: " << s.valid_pixels << "/" << s.total_pixels << ", min: " << s.min << ", median: " << s.median
+               << ", max: " << s.max << ", mean: " << s.mean;
+            return ss.str();
+        });
+    /** end rs_frame.h **/
 }
@@ -101,6 +101,11 @@ void init_device(py::module &m) {
         .def("update", [](rs2::update_device& self, const std::vector<uint8_t>& fw_image, std::function<void(float)> f) { return self.update(fw_image, f); },
              "Update an updatable device to the provided firmware. This call is executed on the caller's thread and provides progress notifications via the callback.",
              "fw_image"_a, "callback"_a, py::call_guard<py::gil_scoped_release>());
+    m.def("update_firmware", [](const std::vector<rs2::update_device>& devices, const std::vector<uint8_t>& fw_image, std::function<void(int, float)> f, int max_concurrent)
+          { return rs2::update_firmware(devices, fw_image, f, max_concurrent); },
+          "Update several update devices to the provided firmware at once, at most max_concurrent (0 for all) at a time. "
+          "The callback gets each device's index and progress. Returns, for each device, why its update failed, or an empty string on success.",
+          "devices"_a, "fw_image"_a, "callback"_a, "max_concurrent"_a = 0, py::call_guard<py::gil_scoped_release>());
 
     py::class_<rs2::auto_calibrated_device, rs2::device> auto_calibrated_device(m, "auto_calibrated_device");
     auto_calibrated_device.def(py::init<rs2::device>(), "device"_a)
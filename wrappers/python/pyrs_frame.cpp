@@ -276,7 +276,14 @@ void init_frame(py::module &m) {
     py::class_<rs2::depth_frame, rs2::video_frame> depth_frame(m, "depth_frame", "Extends the video_frame class with additional depth related attributes and functions.");
     depth_frame.def(py::init<rs2::frame>())
         .def("get_distance", &rs2::depth_frame::get_distance, "x"_a, "y"_a, "Provide the depth in meters at the given pixel")
-        .def("get_units", &rs2::depth_frame::get_units, "Provide the scaling factor to use when converting from get_data() units to meters");
+        .def("get_units", &rs2::depth_frame::get_units, "Provide the scaling factor to use when converting from get_data() units to meters")
+        .def("get_statistics", [](const rs2::depth_frame& self) -> py::object {
+            rs2_depth_statistics statistics;
+            if (!self.get_statistics(statistics))
+                return py::none();
+            return py::cast(statistics);
+        }, "Retrieve the statistics a depth_statistics block attached to the frame, as a depth_statistics_summary, or None")
+        .def("get_region_means", &rs2::depth_frame::get_region_means, "Retrieve the mean depth, in meters, of each region of the depth statistics grid, row by row");
     
     // rs2::disparity_frame
     py::class_<rs2::disparity_frame, rs2::depth_frame> disparity_frame(m, "disparity_frame", "Extends the depth_frame class with additional disparity related attributes and functions.");
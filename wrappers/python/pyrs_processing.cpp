@@ -27,7 +27,7 @@ void init_processing(py::module &m) {
                                              "synchronization primitive provided by librealsense to help "
                                              "developers who are not using async APIs.");
     frame_queue.def(py::init<>())
-        .def(py::init<unsigned int, bool>(), "capacity"_a, "keep_frames"_a = false)
+        .def(py::init<unsigned int, bool, bool>(), "capacity"_a, "keep_frames"_a = false, "lock_free"_a = false)
         .def("enqueue", &rs2::frame_queue::enqueue, "Enqueue a new frame into the queue.", "f"_a)
         .def("wait_for_frame", &rs2::frame_queue::wait_for_frame, "Wait until a new frame "
              "becomes available in the queue and dequeue it.", "timeout_ms"_a = 5000, py::call_guard<py::gil_scoped_release>())
@@ -72,6 +72,14 @@ void init_processing(py::module &m) {
         .def(BIND_DOWNCAST(filter, threshold_filter))
         .def(BIND_DOWNCAST(filter, hdr_merge))
         .def(BIND_DOWNCAST(filter, sequence_id_filter))
+        .def(BIND_DOWNCAST(filter, depth_fusion))
+        .def(BIND_DOWNCAST(filter, voxel_filter))
+        .def(BIND_DOWNCAST(filter, sparse_pointcloud))
+        .def(BIND_DOWNCAST(filter, surface_normals))
+        .def(BIND_DOWNCAST(filter, sequence_demux))
+        .def(BIND_DOWNCAST(filter, quality_governor))
+        .def(BIND_DOWNCAST(filter, aligned_pointcloud))
+        .def(BIND_DOWNCAST(filter, depth_statistics))
         .def("__nonzero__", &rs2::filter::operator bool) // Called to implement truth value testing in Python 2
         .def("__bool__", &rs2::filter::operator bool);   // Called to implement truth value testing in Python 3
         // get_queue?
@@ -195,6 +203,46 @@ void init_processing(py::module &m) {
     py::class_<rs2::sequence_id_filter, rs2::filter> sequence_id_filter(m, "sequence_id_filter", "Splits depth frames with different sequence ID");
     sequence_id_filter.def(py::init<>())
         .def(py::init<float>(), "sequence_id"_a);
+
+    py::class_<rs2::depth_fusion, rs2::filter> depth_fusion(m, "depth_fusion", "Merges the depth of several calibrated cameras into a single point cloud, "
+                                                            "in the coordinate system of the first depth stream it receives");
+    depth_fusion.def(py::init<>())
+        .def(py::init<float>(), "voxel_size"_a);
+
+    py::class_<rs2::voxel_filter, rs2::filter> voxel_filter(m, "voxel_filter", "Turns depth into a point cloud with one point per occupied voxel");
+    voxel_filter.def(py::init<>())
+        .def(py::init<float>(), "voxel_size"_a);
+
+    py::class_<rs2::sparse_pointcloud, rs2::filter> sparse_pointcloud(m, "sparse_pointcloud", "Turns every Nth depth pixel in the region of interest into an organized point cloud");
+    sparse_pointcloud.def(py::init<>())
+        .def(py::init<int>(), "stride"_a);
+
+    py::class_<rs2::surface_normals, rs2::filter> surface_normals(m, "surface_normals", "Meshes organized points or depth and adds the vertex normals (XYZ32F) and per-quad mesh mask (Y8)");
+    surface_normals.def(py::init<>())
+        .def(py::init<float>(), "threshold"_a);
+
+    py::class_<rs2::sequence_demux, rs2::filter> sequence_demux(m, "sequence_demux", "Splits depth frames into one depth stream per sequence ID (stream index = sequence ID + 1)");
+    sequence_demux.def(py::init<>());
+
+    py::class_<rs2::quality_governor, rs2::filter> quality_governor(m, "quality_governor", "Runs a chain of filters and lowers their quality when it "
+                                                                    "falls behind the frame rate, restoring it when there is headroom again");
+    quality_governor.def(py::init<>())
+        .def("add", &rs2::quality_governor::add, "Append a filter to the chain; filters are degraded in increasing "
+             "degrade_order, never if negative", "block"_a, "degrade_order"_a)
+        .def("set_notifications_callback", [](const rs2::quality_governor& self, std::function<void(rs2::notification)> callback) {
+            self.set_notifications_callback(callback);
+        }, "Register a callback for the changes of quality", "callback"_a)
+        .def("get_level", &rs2::quality_governor::get_level, "Number of degradation steps currently in effect");
+
+    py::class_<rs2::aligned_pointcloud, rs2::filter> aligned_pointcloud(m, "aligned_pointcloud", "Aligns depth to a texture stream and computes the "
+                                                                        "point cloud textured by it, deprojecting each depth pixel once");
+    aligned_pointcloud.def(py::init<rs2_stream>(), "texture_stream"_a = RS2_STREAM_COLOR)
+        .def("process", (rs2::frameset(rs2::aligned_pointcloud::*)(rs2::frameset)) &rs2::aligned_pointcloud::process,
+             "Align depth and compute the point cloud from the given frames", "frames"_a);
+
+    py::class_<rs2::depth_statistics, rs2::filter> depth_statistics(m, "depth_statistics", "Computes the statistics of the depth in the region of "
+                                                                    "interest and attaches them to the output depth frame");
+    depth_statistics.def(py::init<>());
     // rs2::rates_printer
     /** end rs_processing.hpp **/
 }
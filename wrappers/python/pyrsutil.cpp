@@ -2,9 +2,21 @@
 Copyright(c) 2017 Intel Corporation. All Rights Reserved. */
 
 #include "pyrealsense2.h"
+#include <pybind11/numpy.h>
 #include <librealsense2/rsutil.h>
 
 
+// Nx<dim> float arrays, converted (copied) only if not already C-contiguous float32
+using float_array = py::array_t< float, py::array::c_style | py::array::forcecast >;
+
+static int rows_of( const float_array & a, py::ssize_t dim, const char * name )
+{
+    if( a.ndim() != 2 || a.shape( 1 ) != dim )
+        throw std::invalid_argument( std::string( name ) + " must be an Nx" + std::to_string( dim ) + " array" );
+    return static_cast< int >( a.shape( 0 ) );
+}
+
+
 void init_util(py::module &m) {
     /** rsutil.h **/
     m.def("rs2_project_point_to_pixel", [](const rs2_intrinsics& intrin, const std::array<float, 3>& point)->std::array<float, 2>
@@ -31,6 +43,51 @@ void init_util(py::module &m) {
     }, "Transform 3D coordinates relative to one sensor to 3D coordinates relative to another viewpoint",
        "extrin"_a, "from_point"_a);
 
+    m.def("rs2_project_points_to_pixels", [](const rs2_intrinsics& intrin, const float_array& points)->float_array
+    {
+        auto count = rows_of(points, 3, "points");
+        float_array pixels({ count, 2 });
+        auto out = pixels.mutable_data();
+        auto in = points.data();
+        {
+            py::gil_scoped_release release;
+            rs2_project_points_to_pixels(out, &intrin, in, count);
+        }
+        return pixels;
+    }, "Given an Nx3 array of points in 3D space, compute the Nx2 array of corresponding pixel coordinates (see rs2_project_point_to_pixel)",
+       "intrin"_a, "points"_a);
+
+    m.def("rs2_deproject_pixels_to_points", [](const rs2_intrinsics& intrin, const float_array& pixels, const float_array& depths)->float_array
+    {
+        auto count = rows_of(pixels, 2, "pixels");
+        if (depths.ndim() != 1 || depths.shape(0) != count)
+            throw std::invalid_argument("depths must be an array with one depth per pixel");
+        float_array points({ count, 3 });
+        auto out = points.mutable_data();
+        auto in = pixels.data();
+        auto d = depths.data();
+        {
+            py::gil_scoped_release release;
+            rs2_deproject_pixels_to_points(out, &intrin, in, d, count);
+        }
+        return points;
+    }, "Given an Nx2 array of pixel coordinates and an array of N depths, compute the Nx3 array of corresponding points in 3D space (see rs2_deproject_pixel_to_point)",
+       "intrin"_a, "pixels"_a, "depths"_a);
+
+    m.def("rs2_transform_points_to_points", [](const rs2_extrinsics& extrin, const float_array& from_points)->float_array
+    {
+        auto count = rows_of(from_points, 3, "from_points");
+        float_array to_points({ count, 3 });
+        auto out = to_points.mutable_data();
+        auto in = from_points.data();
+        {
+            py::gil_scoped_release release;
+            rs2_transform_points_to_points(out, &extrin, in, count);
+        }
+        return to_points;
+    }, "Transform an Nx3 array of 3D coordinates relative to one sensor to 3D coordinates relative to another viewpoint",
+       "extrin"_a, "from_points"_a);
+
     m.def("rs2_fov", [](const rs2_intrinsics& intrin)->std::array<float, 2>
     {
         std::array<float, 2> to_fow{};